@@ -0,0 +1,21 @@
+#version 450
+
+layout (location = 0) in vec2 inPosition;
+
+layout (set = 0, binding = 0) uniform Transform
+{
+	vec4 offset;
+} transform;
+
+layout (push_constant) uniform Constants
+{
+	vec4 color;
+} constants;
+
+layout (location = 0) out vec4 outColor;
+
+void main()
+{
+	gl_Position = vec4(inPosition + transform.offset.xy, 0.0f, 1.0f);
+	outColor = constants.color;
+}
@@ -0,0 +1,210 @@
+#include "benchmark.hpp"
+
+#include <fmt/core.h>
+
+#include <aetherion/gpu/gpu_engine.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+
+namespace aetherion::benchmark {
+    std::map<std::string, BenchmarkFunctor>& getBenchmarks() {
+        static std::map<std::string, BenchmarkFunctor> benchmarks;
+        return benchmarks;
+    }
+
+    BenchmarkRegistration::BenchmarkRegistration(const std::string& name,
+                                                 BenchmarkFunctor functor) {
+        getBenchmarks().emplace(name, std::move(functor));
+    }
+
+    BenchmarkDevice::BenchmarkDevice(const BenchmarkDeviceDescription& description)
+        : driver_(IGPUDriver::create({.type = DriverType::Vulkan,
+                                      .name = "Benchmark",
+                                      .version = "1.0.0",
+                                      .validationLayersEnabled = false,
+                                      .headless = true})),
+          physicalDevice_(driver_->createPhysicalDevice({})) {
+        const auto queueFamilyDescriptions = selectDedicatedGPUQueueFamilies(*physicalDevice_);
+        queueFamilyIndex_
+            = assignGPUQueueFamilies(*physicalDevice_, queueFamilyDescriptions).graphicsFamilyIndex;
+
+        device_ = driver_->createDevice({.physicalDevice = physicalDevice_.get(),
+                                         .queueFamilyDescriptions = queueFamilyDescriptions,
+                                         .pipelineCachePath = description.pipelineCachePath,
+                                         .deferredDestruction = false,
+                                         .descriptorBuffers = description.descriptorBuffers});
+        queue_ = device_->getQueue({.familyIndex = queueFamilyIndex_, .index = 0});
+    }
+
+    BenchmarkDevice::~BenchmarkDevice() noexcept {
+        try {
+            device_->waitIdle();
+        } catch (...) {
+        }
+    }
+
+    const PhysicalGPUDeviceProperties& BenchmarkDevice::getProperties() const {
+        return physicalDevice_->getProperties();
+    }
+
+    std::vector<std::byte> readShaderCode(std::string_view name) {
+        const auto path = std::filesystem::path(AETHERION_BENCHMARK_SHADER_DIRECTORY)
+                          / (std::string(name) + ".spv");
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw(std::runtime_error(fmt::format("Failed to open file '{}'.", path.string())));
+        }
+
+        std::vector<char> data((std::istreambuf_iterator<char>(file)),
+                               std::istreambuf_iterator<char>());
+        std::vector<std::byte> code(data.size());
+        std::transform(data.begin(), data.end(), code.begin(),
+                       [](char c) { return static_cast<std::byte>(c); });
+        return code;
+    }
+
+    BenchmarkPipelineLayout createBenchmarkPipelineLayout(IGPUDevice& device) {
+        BenchmarkPipelineLayout layout;
+        layout.descriptorSetLayout = device.createDescriptorSetLayout(
+            {.bindings = {{.binding = 0,
+                           .type = DescriptorType::UniformBuffer,
+                           .count = 1,
+                           .stages = ShaderStage::Vertex}}});
+        layout.pushConstantRange = device.createPushConstantRange(
+            {.offset = 0, .size = 16, .stages = ShaderStage::Vertex});
+        layout.pipelineLayout = device.createPipelineLayout(
+            {.descriptorSetLayouts = {layout.descriptorSetLayout.get()},
+             .pushConstantRanges = {layout.pushConstantRange.get()}});
+        return layout;
+    }
+
+    GraphicsPipelineDescription getBenchmarkPipelineDescription(IPipelineLayout& layout,
+                                                                IShader& vertexShader,
+                                                                IShader& fragmentShader,
+                                                                Format colorFormat) {
+        return {
+            .layout = &layout,
+            .shaders = {{.stage = ShaderStage::Vertex, .shader = &vertexShader},
+                        {.stage = ShaderStage::Fragment, .shader = &fragmentShader}},
+            .inputStateDescription
+            = {.vertexBindings
+               = {{.binding = 0, .stride = 8, .inputRate = VertexInputRate::Vertex}},
+               .vertexAttributes = {{.location = 0,
+                                     .binding = 0,
+                                     .format = VertexAttributeFormat::Float2,
+                                     .offset = 0}}},
+            .assemblyStateDescription
+            = {.primitiveType = PrimitiveTopology::TriangleList, .enablePrimitiveRestart = false},
+            .rasterizationStateDescription = {.polygonMode = PolygonMode::Fill,
+                                              .cullMode = CullMode::None,
+                                              .frontFace = FrontFace::Clockwise,
+                                              .enableDepthClamp = false,
+                                              .enableDepthBias = false,
+                                              .depthBiasConstantFactor = 0.0f,
+                                              .depthBiasClamp = 0.0f,
+                                              .depthBiasSlopeFactor = 0.0f,
+                                              .lineWidth = 1.0f},
+            .multisampleStateDescription = {.sampleCount = SampleCount::Count1,
+                                            .enableSampleShading = false,
+                                            .minSampleShading = 1.0f,
+                                            .sampleMasks = {}},
+            .depthStencilStateDescription = {.depthFormat = Format::Undefined,
+                                             .stencilFormat = Format::Undefined,
+                                             .enableDepthTest = false,
+                                             .enableDepthWrite = false,
+                                             .depthCompareOp = CompareOp::LessOrEqual,
+                                             .enableDepthBoundsTest = false,
+                                             .minDepthBounds = 0.0f,
+                                             .maxDepthBounds = 1.0f,
+                                             .enableStencilTest = false},
+            .colorBlendStateDescription
+            = {.colorAttachments = {{.format = colorFormat,
+                                     .enableBlending = false,
+                                     .srcColorBlendFactor = BlendFactor::One,
+                                     .dstColorBlendFactor = BlendFactor::Zero,
+                                     .colorBlendOp = BlendOp::Add,
+                                     .srcAlphaBlendFactor = BlendFactor::One,
+                                     .dstAlphaBlendFactor = BlendFactor::Zero,
+                                     .alphaBlendOp = BlendOp::Add,
+                                     .colorWriteMask = ColorComponent::R | ColorComponent::G
+                                                       | ColorComponent::B | ColorComponent::A}},
+               .enableLogicOp = false,
+               .logicOp = BlendingLogicOp::Copy,
+               .blendConstants = {0.0f, 0.0f, 0.0f, 0.0f}}};
+    }
+
+    BenchmarkScene::BenchmarkScene(IGPUDevice& device)
+        : allocator(device.createAllocator({})),
+          vertexShader(device.createShader({.code = readShaderCode("benchmark.vert")})),
+          fragmentShader(device.createShader({.code = readShaderCode("benchmark.frag")})),
+          layout(createBenchmarkPipelineLayout(device)) {
+        colorTarget = allocator->createImage(
+            {.format = COLOR_FORMAT,
+             .extent = {.width = EXTENT.width, .height = EXTENT.height, .depth = 1},
+             .mipLevels = 1,
+             .arrayLayers = 1,
+             .usages = GPUImageUsage::ColorAttachment,
+             .sharingMode = SharingMode::Exclusive,
+             .queueFamilies = {}},
+            {});
+        colorTargetView = device.createImageView({.image = colorTarget.get(),
+                                                  .format = COLOR_FORMAT,
+                                                  .viewType = GPUImageViewType::Tex2d,
+                                                  .swizzle = {},
+                                                  .subresource = {}});
+
+        vertexBuffer = allocator->createBuffer(
+            {.size = 1024,
+             .usages = GPUBufferUsage::Vertex | GPUBufferUsage::TransferDst,
+             .sharingMode = SharingMode::Exclusive,
+             .queueFamilies = {}},
+            {});
+        stagingBuffer = allocator->createBuffer({.size = 1024,
+                                                 .usages = GPUBufferUsage::TransferSrc,
+                                                 .sharingMode = SharingMode::Exclusive,
+                                                 .queueFamilies = {}},
+                                                {.memoryUsage = MemoryUsage::PreferCpu});
+        uniformBuffer = allocator->createBuffer({.size = 256,
+                                                 .usages = GPUBufferUsage::Uniform,
+                                                 .sharingMode = SharingMode::Exclusive,
+                                                 .queueFamilies = {}},
+                                                {});
+
+        pipeline = device.createGraphicsPipeline(getBenchmarkPipelineDescription(
+            *layout.pipelineLayout, *vertexShader, *fragmentShader, COLOR_FORMAT));
+
+        descriptorPool = device.createDescriptorPool(
+            {.maxSets = 1,
+             .poolSizes = {{.type = DescriptorType::UniformBuffer, .count = 1}},
+             .flags = {}});
+        descriptorSet = device.allocateDescriptorSet(
+            *descriptorPool, {.layout = layout.descriptorSetLayout.get()});
+
+        const DescriptorWriteDescription write{
+            .dstBinding = 0,
+            .dstArrayElement = 0,
+            .dstSet = descriptorSet.get(),
+            .descriptorType = DescriptorType::UniformBuffer,
+            .images = {},
+            .buffers = {{.buffer = uniformBuffer.get(), .offset = 0, .range = WHOLE_BUFFER_SIZE}},
+            .texelBuffers = {}};
+        device.updateDescriptorSets({&write, 1}, {});
+    }
+
+    RenderDescription BenchmarkScene::getRenderDescription(bool secondaryCommandBuffers) const {
+        return {.renderArea = {.offset = {0, 0}, .extent = EXTENT},
+                .layerCount = 1,
+                .colorAttachments = {{.image = colorTarget.get(),
+                                      .imageView = colorTargetView.get(),
+                                      .imageLayout = GPUImageLayout::ColorAttachmentOptimal,
+                                      .resolveImageView = nullptr,
+                                      .loadOp = AttachmentLoadOp::Clear,
+                                      .storeOp = AttachmentStoreOp::Store}},
+                .depthAttachment = std::nullopt,
+                .stencilAttachment = std::nullopt,
+                .secondaryCommandBuffers = secondaryCommandBuffers};
+    }
+}  // namespace aetherion::benchmark
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <aetherion/gpu/backend/buffer.hpp>
+#include <aetherion/gpu/backend/command_buffer.hpp>
+#include <aetherion/gpu/backend/descriptor_set.hpp>
+#include <aetherion/gpu/backend/device.hpp>
+#include <aetherion/gpu/backend/driver.hpp>
+#include <aetherion/gpu/backend/image.hpp>
+#include <aetherion/gpu/backend/image_view.hpp>
+#include <aetherion/gpu/backend/memory.hpp>
+#include <aetherion/gpu/backend/pipeline.hpp>
+#include <aetherion/gpu/backend/queue.hpp>
+#include <aetherion/gpu/backend/shader.hpp>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aetherion::benchmark {
+    using BenchmarkFunctor = std::function<void()>;
+
+    // NOTE: Ordered by name, which is also the order they run in.
+    std::map<std::string, BenchmarkFunctor>& getBenchmarks();
+
+    // NOTE: Declare one per benchmark at namespace scope, it registers it before main() runs.
+    struct BenchmarkRegistration {
+        BenchmarkRegistration(const std::string& name, BenchmarkFunctor functor);
+    };
+
+    struct BenchmarkDeviceDescription {
+        std::filesystem::path pipelineCachePath;
+        bool descriptorBuffers = false;
+    };
+
+    // NOTE: Headless device on the highest scoring physical device, with the queue of the graphics
+    // family.
+    class BenchmarkDevice {
+      public:
+        explicit BenchmarkDevice(const BenchmarkDeviceDescription& description = {});
+        ~BenchmarkDevice() noexcept;
+
+        BenchmarkDevice(const BenchmarkDevice&) = delete;
+        BenchmarkDevice& operator=(const BenchmarkDevice&) = delete;
+
+        BenchmarkDevice(BenchmarkDevice&&) = delete;
+        BenchmarkDevice& operator=(BenchmarkDevice&&) = delete;
+
+        inline IGPUDevice& getDevice() { return *device_; }
+
+        inline IGPUQueue& getQueue() { return *queue_; }
+
+        inline uint32_t getQueueFamilyIndex() const { return queueFamilyIndex_; }
+
+        const PhysicalGPUDeviceProperties& getProperties() const;
+
+      private:
+        std::unique_ptr<IGPUDriver> driver_;
+        std::unique_ptr<IGPUPhysicalDevice> physicalDevice_;
+        std::unique_ptr<IGPUDevice> device_;
+        std::unique_ptr<IGPUQueue> queue_;
+        uint32_t queueFamilyIndex_ = 0;
+    };
+
+    // NOTE: SPIR-V compiled from the shader directory of the benchmarks, e.g. "benchmark.vert".
+    std::vector<std::byte> readShaderCode(std::string_view name);
+
+    // NOTE: Layout of the benchmark shaders, a uniform buffer at set 0, binding 0 and a vec4 push
+    // constant, both read by the vertex shader.
+    struct BenchmarkPipelineLayout {
+        std::unique_ptr<IDescriptorSetLayout> descriptorSetLayout;
+        std::unique_ptr<IPushConstantRange> pushConstantRange;
+        std::unique_ptr<IPipelineLayout> pipelineLayout;
+    };
+
+    BenchmarkPipelineLayout createBenchmarkPipelineLayout(IGPUDevice& device);
+
+    // NOTE: Draws vec2 positions from vertex buffer binding 0 into one color attachment.
+    GraphicsPipelineDescription getBenchmarkPipelineDescription(IPipelineLayout& layout,
+                                                                IShader& vertexShader,
+                                                                IShader& fragmentShader,
+                                                                Format colorFormat);
+
+    // NOTE: Resources to record draws of the benchmark pipeline into an offscreen color target,
+    // with its descriptor set pointing at the uniform buffer. Nothing is uploaded, the recorded
+    // command buffers are never submitted.
+    struct BenchmarkScene {
+        static constexpr Format COLOR_FORMAT = Format::R8G8B8A8Unorm;
+        static constexpr Extent2Du EXTENT = {256, 256};
+
+        explicit BenchmarkScene(IGPUDevice& device);
+
+        RenderDescription getRenderDescription(bool secondaryCommandBuffers = false) const;
+
+        std::unique_ptr<IGPUAllocator> allocator;
+        std::unique_ptr<IGPUImage> colorTarget;
+        std::unique_ptr<IGPUImageView> colorTargetView;
+        std::unique_ptr<IGPUBuffer> vertexBuffer;
+        std::unique_ptr<IGPUBuffer> stagingBuffer;
+        std::unique_ptr<IGPUBuffer> uniformBuffer;
+        std::unique_ptr<IShader> vertexShader;
+        std::unique_ptr<IShader> fragmentShader;
+        BenchmarkPipelineLayout layout;
+        std::unique_ptr<IPipeline> pipeline;
+        std::unique_ptr<IDescriptorPool> descriptorPool;
+        std::unique_ptr<IDescriptorSet> descriptorSet;
+    };
+
+    template <typename Functor> std::chrono::duration<double> measure(Functor&& functor) {
+        const auto start = std::chrono::steady_clock::now();
+        functor();
+        return std::chrono::steady_clock::now() - start;
+    }
+}  // namespace aetherion::benchmark
@@ -0,0 +1,142 @@
+#include <fmt/core.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "benchmark.hpp"
+
+using namespace aetherion;
+using namespace aetherion::benchmark;
+
+namespace {
+    constexpr uint32_t SET_COUNT = 1024;
+    constexpr uint32_t ROUNDS = 100;
+    constexpr size_t RANGE = 256;
+
+    struct DescriptorUpdateTimes {
+        bool descriptorBuffers = false;
+        std::chrono::duration<double> batched{};
+        std::chrono::duration<double> perSet{};
+        size_t writeCount = 0;
+    };
+
+    // NOTE: Every set has two uniform and two storage buffer bindings, each pointing at its own
+    // range. Sets are updated all in one call and then with one call per set.
+    DescriptorUpdateTimes measureDescriptorUpdates(bool descriptorBuffers) {
+        BenchmarkDevice benchmarkDevice(
+            {.pipelineCachePath = {}, .descriptorBuffers = descriptorBuffers});
+        IGPUDevice& device = benchmarkDevice.getDevice();
+        auto allocator = device.createAllocator({});
+
+        auto uniformBuffer = allocator->createBuffer({.size = SET_COUNT * 2 * RANGE,
+                                                      .usages = GPUBufferUsage::Uniform,
+                                                      .sharingMode = SharingMode::Exclusive,
+                                                      .queueFamilies = {}},
+                                                     {});
+        auto storageBuffer = allocator->createBuffer({.size = SET_COUNT * 2 * RANGE,
+                                                      .usages = GPUBufferUsage::Storage,
+                                                      .sharingMode = SharingMode::Exclusive,
+                                                      .queueFamilies = {}},
+                                                     {});
+
+        auto layout = device.createDescriptorSetLayout(
+            {.bindings = {{.binding = 0,
+                           .type = DescriptorType::UniformBuffer,
+                           .count = 2,
+                           .stages = ShaderStage::Vertex | ShaderStage::Fragment},
+                          {.binding = 1,
+                           .type = DescriptorType::StorageBuffer,
+                           .count = 2,
+                           .stages = ShaderStage::Vertex | ShaderStage::Fragment}}});
+        auto pool = device.createDescriptorPool(
+            {.maxSets = SET_COUNT,
+             .poolSizes = {{.type = DescriptorType::UniformBuffer, .count = SET_COUNT * 2},
+                           {.type = DescriptorType::StorageBuffer, .count = SET_COUNT * 2}},
+             .flags = {}});
+        const std::vector<DescriptorSetDescription> setDescriptions(SET_COUNT,
+                                                                    {.layout = layout.get()});
+        auto sets = device.allocateDescriptorSets(*pool, setDescriptions);
+
+        std::vector<DescriptorWriteDescription> writes;
+        writes.reserve(SET_COUNT * 2);
+        for (uint32_t i = 0; i < SET_COUNT; ++i) {
+            const size_t offset = i * 2 * RANGE;
+            writes.push_back(
+                {.dstBinding = 0,
+                 .dstArrayElement = 0,
+                 .dstSet = sets[i].get(),
+                 .descriptorType = DescriptorType::UniformBuffer,
+                 .images = {},
+                 .buffers = {{.buffer = uniformBuffer.get(), .offset = offset, .range = RANGE},
+                             {.buffer = uniformBuffer.get(),
+                              .offset = offset + RANGE,
+                              .range = RANGE}},
+                 .texelBuffers = {}});
+            writes.push_back(
+                {.dstBinding = 1,
+                 .dstArrayElement = 0,
+                 .dstSet = sets[i].get(),
+                 .descriptorType = DescriptorType::StorageBuffer,
+                 .images = {},
+                 .buffers = {{.buffer = storageBuffer.get(), .offset = offset, .range = RANGE},
+                             {.buffer = storageBuffer.get(),
+                              .offset = offset + RANGE,
+                              .range = RANGE}},
+                 .texelBuffers = {}});
+        }
+
+        // NOTE: Warms up the caches of the driver and the backend.
+        device.updateDescriptorSets(writes, {});
+
+        DescriptorUpdateTimes times{.descriptorBuffers = device.usesDescriptorBuffers(),
+                                    .writeCount = static_cast<size_t>(ROUNDS) * SET_COUNT * 4};
+        times.batched = measure([&]() {
+            for (uint32_t round = 0; round < ROUNDS; ++round) {
+                device.updateDescriptorSets(writes, {});
+            }
+        });
+        const std::span<const DescriptorWriteDescription> allWrites(writes);
+        times.perSet = measure([&]() {
+            for (uint32_t round = 0; round < ROUNDS; ++round) {
+                for (uint32_t i = 0; i < SET_COUNT; ++i) {
+                    device.updateDescriptorSets(allWrites.subspan(i * 2, 2), {});
+                }
+            }
+        });
+        return times;
+    }
+
+    void benchmarkDescriptorUpdates() {
+        const auto print = [](const DescriptorUpdateTimes& times) {
+            const auto nanosecondsPerDescriptor
+                = [&times](std::chrono::duration<double> time) {
+                      return std::chrono::duration<double, std::nano>(time).count()
+                             / static_cast<double>(times.writeCount);
+                  };
+            fmt::println("  {}:",
+                         times.descriptorBuffers ? "Descriptor buffers" : "Descriptor pools");
+            fmt::println("    One call for every set: {:>8.1f} ns per descriptor",
+                         nanosecondsPerDescriptor(times.batched));
+            fmt::println("    One call per set:       {:>8.1f} ns per descriptor",
+                         nanosecondsPerDescriptor(times.perSet));
+        };
+
+        fmt::println("  {} rounds updating {} sets of 4 buffer descriptors", ROUNDS, SET_COUNT);
+        const auto pools = measureDescriptorUpdates(false);
+        print(pools);
+
+        const auto buffers = measureDescriptorUpdates(true);
+        if (!buffers.descriptorBuffers) {
+            fmt::println("  Descriptor buffers aren't supported by the device.");
+            return;
+        }
+        print(buffers);
+        fmt::println("  Descriptor buffer speedup: {:.2f}x batched, {:.2f}x per set",
+                     pools.batched / buffers.batched, pools.perSet / buffers.perSet);
+    }
+
+    const BenchmarkRegistration registration("descriptor_updates", benchmarkDescriptorUpdates);
+}  // namespace
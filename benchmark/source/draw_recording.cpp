@@ -0,0 +1,94 @@
+#include <fmt/core.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <span>
+
+#include "benchmark.hpp"
+
+using namespace aetherion;
+using namespace aetherion::benchmark;
+
+namespace {
+    constexpr uint32_t WARMUP_RECORDINGS = 4;
+    constexpr uint32_t RECORDINGS = 100;
+    constexpr uint32_t DRAWS_PER_RECORDING = 10000;
+
+#ifdef AETHERION_SINGLE_BACKEND_VULKAN
+    constexpr const char* BACKEND_MODE = "single backend (Vulkan), static backend casts";
+#else
+    constexpr const char* BACKEND_MODE = "runtime backend selection, RTTI backend casts";
+#endif
+
+    // NOTE: Every draw rebinds its pipeline, descriptor set, vertex buffer and push constants like
+    // a draw of a different object would, so each goes through the casts of the backend. Build
+    // with and without AETHERION_SINGLE_BACKEND=Vulkan to compare both modes. Both dispatch every
+    // command virtually through ICommandBuffer, the difference is only the cost of the RTTI
+    // lookups the single backend build replaces with static casts.
+    void benchmarkDrawRecording() {
+        BenchmarkDevice benchmarkDevice;
+        IGPUDevice& device = benchmarkDevice.getDevice();
+        BenchmarkScene scene(device);
+
+        auto commandPool
+            = device.createCommandPool({.queueFamilyIndex = benchmarkDevice.getQueueFamilyIndex(),
+                                        .flags = CommandPoolBehavior::ResetCommandBuffer});
+        auto commandBuffer = device.allocateCommandBuffer(*commandPool, {});
+
+        const std::array imageBarriers
+            = {ImageBarrierDescription{.image = scene.colorTarget.get(),
+                                       .oldLayout = GPUImageLayout::Undefined,
+                                       .newLayout = GPUImageLayout::ColorAttachmentOptimal,
+                                       .srcStageFlags = PipelineStage::ColorAttachmentOutput,
+                                       .dstStageFlags = PipelineStage::ColorAttachmentOutput,
+                                       .dstAccessFlags = AccessType::ColorAttachmentWrite}};
+        const std::array vertexBindings = {VertexBufferBindingDescription{
+            .buffer = scene.vertexBuffer.get(), .offset = 0, .size = 1024, .stride = 8}};
+        std::array descriptorSets = {std::ref(*scene.descriptorSet)};
+        const std::array color = {1.0f, 0.5f, 0.25f, 1.0f};
+        const auto pushConstants = std::as_bytes(std::span(color));
+        const auto renderDescription = scene.getRenderDescription();
+
+        const auto record = [&]() {
+            commandBuffer->begin(CommandBufferUsage::OneTimeSubmit);
+            commandBuffer->barrier({}, {}, imageBarriers);
+            commandBuffer->beginRendering(renderDescription);
+            commandBuffer->setViewport(
+                {.offset = {0.0f, 0.0f},
+                 .extent = {static_cast<float>(BenchmarkScene::EXTENT.width),
+                            static_cast<float>(BenchmarkScene::EXTENT.height)}});
+            commandBuffer->setScissor({.offset = {0, 0}, .extent = BenchmarkScene::EXTENT});
+            for (uint32_t i = 0; i < DRAWS_PER_RECORDING; ++i) {
+                commandBuffer->bindPipeline(*scene.pipeline);
+                commandBuffer->bindDescriptorSets(*scene.layout.pipelineLayout,
+                                                  PipelineBindPoint::Graphics, 0, descriptorSets);
+                commandBuffer->bindVertexBuffers(0, 1, vertexBindings);
+                commandBuffer->pushConstantRange(*scene.layout.pipelineLayout,
+                                                 *scene.layout.pushConstantRange, pushConstants);
+                commandBuffer->draw(3);
+            }
+            commandBuffer->endRendering();
+            commandBuffer->end();
+        };
+
+        for (uint32_t i = 0; i < WARMUP_RECORDINGS; ++i) {
+            record();
+        }
+
+        const auto time = measure([&]() {
+            for (uint32_t i = 0; i < RECORDINGS; ++i) {
+                record();
+            }
+        });
+
+        constexpr auto drawCount = static_cast<double>(RECORDINGS * DRAWS_PER_RECORDING);
+        fmt::println("  Mode: {}", BACKEND_MODE);
+        fmt::println("  {} recordings of {} draws", RECORDINGS, DRAWS_PER_RECORDING);
+        fmt::println("  Recording time:           {:.1f} ns per draw",
+                     std::chrono::duration<double, std::nano>(time).count() / drawCount);
+    }
+
+    const BenchmarkRegistration registration("draw_recording", benchmarkDrawRecording);
+}  // namespace
@@ -0,0 +1,37 @@
+#include <fmt/core.h>
+
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+
+using namespace aetherion::benchmark;
+
+int main(int argc, char** argv) {
+    try {
+        // NOTE: Runs the benchmarks named in the arguments, or every benchmark without any.
+        std::vector<std::string> names(argv + 1, argv + argc);
+        if (names.empty()) {
+            for (const auto& [name, functor] : getBenchmarks()) {
+                names.push_back(name);
+            }
+        }
+
+        for (const auto& name : names) {
+            const auto benchmark = getBenchmarks().find(name);
+            if (benchmark == getBenchmarks().end()) {
+                throw(std::invalid_argument(fmt::format("Unknown benchmark '{}'.", name)));
+            }
+
+            fmt::println("{}:", name);
+            benchmark->second();
+        }
+    } catch (const std::exception& e) {
+        fmt::println("An error occurred: {}", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
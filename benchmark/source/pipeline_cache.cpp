@@ -0,0 +1,94 @@
+#include <fmt/core.h>
+
+#include <aetherion/gpu/backend/shader.hpp>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "benchmark.hpp"
+
+using namespace aetherion;
+using namespace aetherion::benchmark;
+
+namespace {
+    constexpr std::array COLOR_FORMATS = {Format::R8G8B8A8Unorm, Format::B8G8R8A8Unorm,
+                                          Format::R8G8B8A8Srgb, Format::R16G16B16A16Sfloat};
+    constexpr std::array CULL_MODES = {CullMode::None, CullMode::Back};
+    constexpr std::array TOPOLOGIES
+        = {PrimitiveTopology::TriangleList, PrimitiveTopology::TriangleStrip};
+
+    // NOTE: Creates one pipeline per combination of color format, blending, cull mode and
+    // topology, every one of them a distinct pipeline for the driver. The device saves the cache
+    // to the path when it's destroyed.
+    std::chrono::duration<double> createPipelines(const std::filesystem::path& pipelineCachePath,
+                                                  size_t& pipelineCount) {
+        BenchmarkDevice benchmarkDevice({.pipelineCachePath = pipelineCachePath});
+        IGPUDevice& device = benchmarkDevice.getDevice();
+
+        const auto vertexShaderCode = readShaderCode("benchmark.vert");
+        const auto fragmentShaderCode = readShaderCode("benchmark.frag");
+        auto vertexShader = device.createShader({.code = vertexShaderCode});
+        auto fragmentShader = device.createShader({.code = fragmentShaderCode});
+        const auto layout = createBenchmarkPipelineLayout(device);
+
+        std::vector<GraphicsPipelineDescription> descriptions;
+        for (const auto format : COLOR_FORMATS) {
+            for (const bool blending : {false, true}) {
+                for (const auto cullMode : CULL_MODES) {
+                    for (const auto topology : TOPOLOGIES) {
+                        auto description = getBenchmarkPipelineDescription(
+                            *layout.pipelineLayout, *vertexShader, *fragmentShader, format);
+                        auto& attachment
+                            = description.colorBlendStateDescription.colorAttachments[0];
+                        attachment.enableBlending = blending;
+                        attachment.srcColorBlendFactor = BlendFactor::SrcAlpha;
+                        attachment.dstColorBlendFactor = BlendFactor::OneMinusSrcAlpha;
+                        description.rasterizationStateDescription.cullMode = cullMode;
+                        description.assemblyStateDescription.primitiveType = topology;
+                        descriptions.push_back(std::move(description));
+                    }
+                }
+            }
+        }
+        pipelineCount = descriptions.size();
+
+        std::vector<std::unique_ptr<IPipeline>> pipelines;
+        pipelines.reserve(descriptions.size());
+        return measure([&]() {
+            for (const auto& description : descriptions) {
+                pipelines.push_back(device.createGraphicsPipeline(description));
+            }
+        });
+    }
+
+    // NOTE: Drivers keep shader caches of their own (e.g. Mesa's on-disk cache), disable them
+    // (MESA_SHADER_CACHE_DISABLE=true or the equivalent) for the cold start to compile everything.
+    // The run without a cache file shows what is left to the driver alone.
+    void benchmarkPipelineCache() {
+        const auto pipelineCachePath
+            = std::filesystem::temp_directory_path() / "aetherion_benchmark_pipeline_cache.bin";
+        std::filesystem::remove(pipelineCachePath);
+
+        size_t pipelineCount = 0;
+        const auto cold = createPipelines(pipelineCachePath, pipelineCount);
+        const auto warm = createPipelines(pipelineCachePath, pipelineCount);
+        const auto uncached = createPipelines({}, pipelineCount);
+        std::filesystem::remove(pipelineCachePath);
+
+        const auto print = [pipelineCount](const char* label, std::chrono::duration<double> time) {
+            fmt::println("  {:<24} {:>10.3f} ms ({:.3f} ms per pipeline)", label,
+                         std::chrono::duration<double, std::milli>(time).count(),
+                         std::chrono::duration<double, std::milli>(time).count()
+                             / static_cast<double>(pipelineCount));
+        };
+        fmt::println("  {} graphics pipelines", pipelineCount);
+        print("Cold start:", cold);
+        print("Warm start:", warm);
+        print("Without cache file:", uncached);
+        fmt::println("  Warm start speedup: {:.2f}x", cold / warm);
+    }
+
+    const BenchmarkRegistration registration("pipeline_cache", benchmarkPipelineCache);
+}  // namespace
@@ -0,0 +1,155 @@
+#include <fmt/core.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <vector>
+
+#include "benchmark.hpp"
+
+#ifdef _WIN32
+#    include <malloc.h>
+#endif
+
+using namespace aetherion;
+using namespace aetherion::benchmark;
+
+// NOTE: Every allocation of the process through operator new is counted, including the ones of
+// the engine. Allocations of the driver don't go through it.
+namespace {
+    std::atomic<uint64_t> allocationCount = 0;
+
+    void* allocate(std::size_t size, std::size_t alignment) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        size = size == 0 ? 1 : size;
+#ifdef _WIN32
+        void* pointer = _aligned_malloc(size, alignment);
+#else
+        // NOTE: aligned_alloc() needs the size to be a multiple of the alignment.
+        void* pointer
+            = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+        if (!pointer) {
+            throw(std::bad_alloc());
+        }
+        return pointer;
+    }
+
+    void deallocate(void* pointer) noexcept {
+#ifdef _WIN32
+        _aligned_free(pointer);
+#else
+        std::free(pointer);
+#endif
+    }
+}  // namespace
+
+void* operator new(std::size_t size) { return allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](std::size_t size) {
+    return allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+void operator delete(void* pointer) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer) noexcept { deallocate(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { deallocate(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { deallocate(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+    deallocate(pointer);
+}
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept {
+    deallocate(pointer);
+}
+
+namespace {
+    constexpr uint32_t WARMUP_ITERATIONS = 16;
+    constexpr uint32_t ITERATIONS = 10000;
+    constexpr uint32_t COMMANDS_PER_ITERATION = 9;
+
+    // NOTE: Records every command translating its arguments into the scratch arena of the command
+    // buffer. Arguments are built once outside, so only the recording itself is measured.
+    void benchmarkRecordingAllocations() {
+        BenchmarkDevice benchmarkDevice;
+        IGPUDevice& device = benchmarkDevice.getDevice();
+        BenchmarkScene scene(device);
+
+        auto commandPool
+            = device.createCommandPool({.queueFamilyIndex = benchmarkDevice.getQueueFamilyIndex(),
+                                        .flags = CommandPoolBehavior::ResetCommandBuffer});
+        auto commandBuffer = device.allocateCommandBuffer(*commandPool, {});
+        auto secondaryCommandBuffer = device.allocateCommandBuffer(
+            *commandPool, {.level = CommandBufferLevel::Secondary});
+
+        secondaryCommandBuffer->begin(CommandBufferUsage::None,
+                                      {.colorAttachmentFormats = {BenchmarkScene::COLOR_FORMAT}});
+        secondaryCommandBuffer->end();
+
+        const std::array bufferBarriers
+            = {BufferBarrierDescription{.buffer = scene.vertexBuffer.get(),
+                                        .srcStageFlags = PipelineStage::VertexInput,
+                                        .dstStageFlags = PipelineStage::Transfer,
+                                        .dstAccessFlags = AccessType::TransferWrite}};
+        const std::array imageBarriers
+            = {ImageBarrierDescription{.image = scene.colorTarget.get(),
+                                       .oldLayout = GPUImageLayout::Undefined,
+                                       .newLayout = GPUImageLayout::ColorAttachmentOptimal,
+                                       .srcStageFlags = PipelineStage::ColorAttachmentOutput,
+                                       .dstStageFlags = PipelineStage::ColorAttachmentOutput,
+                                       .dstAccessFlags = AccessType::ColorAttachmentWrite}};
+        const std::vector<BufferCopyRegion> copyRegions
+            = {{.srcOffset = 0, .dstOffset = 0, .size = 1024}};
+        const std::array vertexBindings = {VertexBufferBindingDescription{
+            .buffer = scene.vertexBuffer.get(), .offset = 0, .size = 1024, .stride = 8}};
+        std::array descriptorSets = {std::ref(*scene.descriptorSet)};
+        std::array<std::reference_wrapper<ICommandBuffer>, 1> secondaryCommandBuffers
+            = {*secondaryCommandBuffer};
+        const auto renderDescription = scene.getRenderDescription(true);
+
+        const auto record = [&]() {
+            commandBuffer->begin(CommandBufferUsage::OneTimeSubmit);
+            commandBuffer->barrier({}, bufferBarriers, imageBarriers);
+            commandBuffer->copyBuffer(*scene.stagingBuffer, *scene.vertexBuffer, copyRegions);
+            commandBuffer->bindVertexBuffers(0, 1, vertexBindings);
+            commandBuffer->bindDescriptorSets(*scene.layout.pipelineLayout,
+                                              PipelineBindPoint::Graphics, 0, descriptorSets);
+            commandBuffer->beginRendering(renderDescription);
+            commandBuffer->executeCommands(secondaryCommandBuffers);
+            commandBuffer->endRendering();
+            commandBuffer->end();
+        };
+
+        // NOTE: The first recordings grow the scratch arena, it keeps its memory afterwards.
+        for (uint32_t i = 0; i < WARMUP_ITERATIONS; ++i) {
+            record();
+        }
+
+        const uint64_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+        const auto time = measure([&]() {
+            for (uint32_t i = 0; i < ITERATIONS; ++i) {
+                record();
+            }
+        });
+        const uint64_t allocations = allocationCount.load(std::memory_order_relaxed)
+                                     - allocationsBefore;
+
+        constexpr auto commandCount = static_cast<double>(ITERATIONS * COMMANDS_PER_ITERATION);
+        fmt::println("  {} recordings of {} commands", ITERATIONS, COMMANDS_PER_ITERATION);
+        fmt::println("  Heap allocations:         {} ({:.4f} per command)", allocations,
+                     static_cast<double>(allocations) / commandCount);
+        fmt::println("  Recording time:           {:.1f} ns per command",
+                     std::chrono::duration<double, std::nano>(time).count() / commandCount);
+    }
+
+    const BenchmarkRegistration registration("recording_allocations",
+                                             benchmarkRecordingAllocations);
+}  // namespace
@@ -1,179 +1,262 @@
 #include <fmt/core.h>
 
-#include <AetherionEngine/game.hpp>
-#include <AetherionEngine/rendering/backend/render_defs.hpp>
-#include <AetherionEngine/rendering/backend/render_pipeline.hpp>
-
-using namespace AetherionEngine;
-
-class Triangle : public Game {
-  public:
-    Triangle(const WindowInfo& primaryWindowInfo) : Game(primaryWindowInfo) {
-        m_primarySurface = m_driver->createRenderSurface(m_primaryWindow);
-
-        auto vertexShaderData = std::make_shared<Data>("build/triangle/triangle.vert.spv");
-        m_vertexShader = m_driver->createShader(std::make_shared<ShaderData>(vertexShaderData),
-                                                ShaderStage::Vertex);
-
-        auto fragmentShaderData = std::make_shared<Data>("build/triangle/triangle.frag.spv");
-        m_fragmentShader = m_driver->createShader(std::make_shared<ShaderData>(fragmentShaderData),
-                                                  ShaderStage::Fragment);
-
-        std::shared_ptr<GPUPipelineLayout> layout = m_driver->createGPUPipelineLayout({{}, {}});
-
-        m_pipeline = m_driver->createGraphicsPipeline(
-            {
-                .layout = layout,
-                .vertexShader = m_vertexShader,
-                .fragmentShader = m_fragmentShader,
-                .inputStateDescription = {},
-                .assemblyStateDescription = {
-                    .primitiveType = PrimitiveType::Triangles,
-                    .enablePrimitiveRestart = false,
-                },
-                .rasterizationStateDescription = {
-                    .polygonMode = PolygonMode::Fill,
-                    .cullMode = CullMode::None,
-                    .frontFace = FrontFace::Clockwise,
-                    .enableDepthClamp = false,
-                    .enableDepthBias = false,
-                    .depthBiasConstantFactor = 0.0f,
-                    .depthBiasClamp = 0.0f,
-                    .depthBiasSlopeFactor = 0.0f,
-                    .lineWidth = 1.0f
-                },
-                .multisampleStateDescription = {
-                    .sampleCount = SampleCount::Count1,
-                    .enableSampleShading = false,
-                    .minSampleShading = 1.0f,
-                    .sampleMasks = {}
-                },
-                .depthStencilStateDescription = {
-                    .depthFormat = ImageFormat::D32Sfloat,
-                    .stencilFormat = ImageFormat::Undefined,
-                    .enableDepthTest = false,
-                    .enableDepthWrite = false,
-                    .depthCompareOp = CompareOp::LessOrEqual,
-                    .enableDepthBoundsTest = false,
-                    .minDepthBounds = 0.0f,
-                    .maxDepthBounds = 1.0f,
-                    .enableStencilTest = false,
-                },
-                .colorBlendStateDescription = {
-                    .colorAttachments = {
-                        {
-                            .format = m_primarySurface->getColorFormat(),
-                            .enableBlending = true,
-                            .srcColorBlendFactor = BlendFactor::SrcAlpha,
-                            .dstColorBlendFactor = BlendFactor::OneMinusSrcAlpha,
-                            .colorBlendOp = BlendOp::Add,
-                            .srcAlphaBlendFactor = BlendFactor::One,
-                            .dstAlphaBlendFactor = BlendFactor::Zero,
-                            .alphaBlendOp = BlendOp::Add,
-                            .colorWriteMask = ColorComponent::R | ColorComponent::G | ColorComponent::B | ColorComponent::A,
-                        }
-                    },
-                    .enableLogicOp = false,
-                    .logicOp = BlendingLogicOp::Copy,
-                    .blendConstants = {0.0f, 0.0f, 0.0f, 0.0f}
-                }
-            }
-        );
+#include <aetherion/gpu/backend/command_buffer.hpp>
+#include <aetherion/gpu/backend/image.hpp>
+#include <aetherion/gpu/backend/image_view.hpp>
+#include <aetherion/gpu/backend/pipeline.hpp>
+#include <aetherion/gpu/backend/shader.hpp>
+#include <aetherion/gpu/backend/surface.hpp>
+#include <aetherion/gpu/backend/swapchain.hpp>
+#include <aetherion/gpu/backend/sync.hpp>
+#include <aetherion/gpu/frame_scheduler.hpp>
+#include <aetherion/gpu/gpu_engine.hpp>
+#include <aetherion/platform/window.hpp>
+#include <aetherion/platform/window_manager.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace aetherion;
+
+constexpr uint32_t FRAMES_IN_FLIGHT = 2;
+constexpr Extent2Du WINDOW_EXTENT = {800, 600};
+
+std::vector<std::byte> readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error(fmt::format("Failed to open file '{}'.", path));
+    }
+
+    std::vector<char> data((std::istreambuf_iterator<char>(file)),
+                           std::istreambuf_iterator<char>());
+    std::vector<std::byte> bytes(data.size());
+    std::transform(data.begin(), data.end(), bytes.begin(),
+                   [](char c) { return static_cast<std::byte>(c); });
+    return bytes;
+}
+
+// Smooth, slow color cycle along the hue.
+ColorValue getClearColor(uint64_t frameNumber) {
+    const float hue = std::fmod(static_cast<float>(frameNumber) * 0.0001f, 1.0f);
+    const float s = 0.7f, v = 0.8f;
+
+    const float c = v * s;
+    const float x = c * (1 - std::fabs(std::fmod(hue * 6.0f, 2.0f) - 1));
+    const float m = v - c;
+
+    float r, g, b;
+    if (hue < 1.0f / 6.0f) {
+        r = c, g = x, b = 0;
+    } else if (hue < 2.0f / 6.0f) {
+        r = x, g = c, b = 0;
+    } else if (hue < 3.0f / 6.0f) {
+        r = 0, g = c, b = x;
+    } else if (hue < 4.0f / 6.0f) {
+        r = 0, g = x, b = c;
+    } else if (hue < 5.0f / 6.0f) {
+        r = x, g = 0, b = c;
+    } else {
+        r = c, g = 0, b = x;
     }
 
-    virtual void onInitialization() override {}
-
-    virtual void onIteration() override {
-        m_frameCount++;
-        // Use HSV to RGB for a smooth, slow color cycle along the hue
-        float t = m_frameCount * 0.0001f;  // Slow gradient
-        float hue = std::fmod(t, 1.0f);    // Hue cycles from 0 to 1
-        float s = 0.7f, v = 0.8f;
-
-        // HSV to RGB conversion
-        float c = v * s;
-        float x = c * (1 - std::fabs(std::fmod(hue * 6.0f, 2.0f) - 1));
-        float m = v - c;
-        float r, g, b;
-        if (hue < 1.0f / 6.0f) {
-            r = c;
-            g = x;
-            b = 0;
-        } else if (hue < 2.0f / 6.0f) {
-            r = x;
-            g = c;
-            b = 0;
-        } else if (hue < 3.0f / 6.0f) {
-            r = 0;
-            g = c;
-            b = x;
-        } else if (hue < 4.0f / 6.0f) {
-            r = 0;
-            g = x;
-            b = c;
-        } else if (hue < 5.0f / 6.0f) {
-            r = x;
-            g = 0;
-            b = c;
-        } else {
-            r = c;
-            g = 0;
-            b = x;
+    return {r + m, g + m, b + m, 1.0f};
+}
+
+int main() {
+    try {
+        auto windowManager = IWindowManager::create(WindowManagerType::GLFW);
+        auto window = windowManager->createWindow({.title = "Triangle", .extent = WINDOW_EXTENT});
+
+        GPUEngine engine({.type = DriverType::Vulkan,
+                          .name = "Triangle",
+                          .version = "1.0.0",
+                          .validationLayersEnabled = true},
+                         {.primaryWindow = window.get()});
+        IGPUDevice& device = engine.getDevice();
+        IGPUQueue& queue = engine.getQueue(GPUQueueRole::Graphics);
+
+        // Swapchain
+
+        auto surface = engine.getDriver().createSurface({.window = window.get()});
+        const auto surfaceFormat = surface->getSupportedFormats(engine.getPhysicalDevice()).front();
+
+        // TODO: Recreate the swapchain when the window is resized.
+        auto swapchain = device.createSwapchain({.surface = surface.get(),
+                                                 .surfaceFormat = surfaceFormat,
+                                                 .extent = WINDOW_EXTENT,
+                                                 .imageUsages = GPUImageUsage::ColorAttachment,
+                                                 .sharingMode = SharingMode::Exclusive,
+                                                 .presentMode = PresentMode::Fifo});
+
+        std::vector<std::unique_ptr<IGPUImageView>> swapchainImageViews;
+        std::vector<std::unique_ptr<IGPUBinarySemaphore>> renderFinishedSemaphores;
+        for (uint32_t i = 0; i < swapchain->getImageCount(); ++i) {
+            swapchainImageViews.push_back(device.createImageView(
+                {.image = &swapchain->getImage(i), .format = surfaceFormat.imageFormat}));
+            renderFinishedSemaphores.push_back(device.createGPUBinarySemaphore({}));
+        }
+
+        // Pipeline
+
+        const auto vertexShaderCode = readFile("build/triangle/triangle.vert.spv");
+        const auto fragmentShaderCode = readFile("build/triangle/triangle.frag.spv");
+        auto vertexShader = device.createShader({.code = vertexShaderCode});
+        auto fragmentShader = device.createShader({.code = fragmentShaderCode});
+
+        auto pipelineLayout = device.createPipelineLayout({});
+        auto pipeline = device.createGraphicsPipeline(
+            {.layout = pipelineLayout.get(),
+             .shaders = {{.stage = ShaderStage::Vertex, .shader = vertexShader.get()},
+                         {.stage = ShaderStage::Fragment, .shader = fragmentShader.get()}},
+             .inputStateDescription = {},
+             .assemblyStateDescription = {.primitiveType = PrimitiveTopology::TriangleList,
+                                          .enablePrimitiveRestart = false},
+             .rasterizationStateDescription = {.polygonMode = PolygonMode::Fill,
+                                               .cullMode = CullMode::None,
+                                               .frontFace = FrontFace::Clockwise,
+                                               .enableDepthClamp = false,
+                                               .enableDepthBias = false,
+                                               .depthBiasConstantFactor = 0.0f,
+                                               .depthBiasClamp = 0.0f,
+                                               .depthBiasSlopeFactor = 0.0f,
+                                               .lineWidth = 1.0f},
+             .multisampleStateDescription = {.sampleCount = SampleCount::Count1,
+                                             .enableSampleShading = false,
+                                             .minSampleShading = 1.0f,
+                                             .sampleMasks = {}},
+             .depthStencilStateDescription = {.depthFormat = Format::Undefined,
+                                              .stencilFormat = Format::Undefined,
+                                              .enableDepthTest = false,
+                                              .enableDepthWrite = false,
+                                              .depthCompareOp = CompareOp::LessOrEqual,
+                                              .enableDepthBoundsTest = false,
+                                              .minDepthBounds = 0.0f,
+                                              .maxDepthBounds = 1.0f,
+                                              .enableStencilTest = false},
+             .colorBlendStateDescription
+             = {.colorAttachments = {{.format = surfaceFormat.imageFormat,
+                                      .enableBlending = false,
+                                      .srcColorBlendFactor = BlendFactor::One,
+                                      .dstColorBlendFactor = BlendFactor::Zero,
+                                      .colorBlendOp = BlendOp::Add,
+                                      .srcAlphaBlendFactor = BlendFactor::One,
+                                      .dstAlphaBlendFactor = BlendFactor::Zero,
+                                      .alphaBlendOp = BlendOp::Add,
+                                      .colorWriteMask = ColorComponent::R | ColorComponent::G
+                                                        | ColorComponent::B | ColorComponent::A}},
+                .enableLogicOp = false,
+                .logicOp = BlendingLogicOp::Copy,
+                .blendConstants = {0.0f, 0.0f, 0.0f, 0.0f}}});
+
+        // Frame loop
+
+        FrameScheduler scheduler(
+            device, {.framesInFlight = FRAMES_IN_FLIGHT,
+                     .queueFamilyIndex = engine.getQueueFamilyIndex(GPUQueueRole::Graphics)});
+
+        std::vector<std::unique_ptr<IGPUBinarySemaphore>> imageAcquiredSemaphores;
+        for (uint32_t i = 0; i < FRAMES_IN_FLIGHT; ++i) {
+            imageAcquiredSemaphores.push_back(device.createGPUBinarySemaphore({}));
         }
 
-        ColorValue clearColor{r + m, g + m, b + m, 1.0f};
-        std::shared_ptr<Image> drawImage = m_primarySurface->getDrawImage();
-        std::shared_ptr<ImageView> drawImageView = m_primarySurface->getDrawImageView();
-        std::shared_ptr<Image> depthImage = m_primarySurface->getDepthImage();
-        std::shared_ptr<ImageView> depthImageView = m_primarySurface->getDepthImageView();
-        Extent2D drawExtent = m_primarySurface->getDrawExtent();
-        m_primarySurface->drawFrame([&](RenderCommandList& commandList) {
-            commandList.beginRendering(
-                {.renderArea
-                 = {0, 0, static_cast<int>(drawExtent.width), static_cast<int>(drawExtent.height)},
+        while (!window->shouldClose()) {
+            windowManager->pollEvents();
+
+            FrameContext& frame = scheduler.beginFrame();
+            IGPUBinarySemaphore& imageAcquiredSemaphore
+                = *imageAcquiredSemaphores[frame.getFrameIndex()];
+
+            const auto acquireResult = swapchain->acquireNextImage(
+                std::numeric_limits<uint64_t>::max(), imageAcquiredSemaphore);
+            if (!acquireResult) {
+                // NOTE: The frame still has to signal its timeline value.
+                GPUQueueSubmitDescription submitDescription{
+                    .signalTimelineSemaphores = {frame.getTimelineSignal()}};
+                queue.submit({&submitDescription, 1}, nullptr);
+                scheduler.endFrame();
+                continue;
+            }
+            const uint32_t imageIndex = acquireResult.value();
+            IGPUImage& image = swapchain->getImage(imageIndex);
+
+            ICommandBuffer& commandBuffer = frame.acquireCommandBuffer();
+            commandBuffer.begin(CommandBufferUsage::OneTimeSubmit);
+            frame.beginGPUTiming(commandBuffer);
+
+            const ImageBarrierDescription toAttachmentBarrier{
+                .image = &image,
+                .oldLayout = GPUImageLayout::Undefined,
+                .newLayout = GPUImageLayout::ColorAttachmentOptimal,
+                .srcStageFlags = PipelineStage::ColorAttachmentOutput,
+                .dstStageFlags = PipelineStage::ColorAttachmentOutput,
+                .dstAccessFlags = AccessType::ColorAttachmentWrite};
+            commandBuffer.barrier({}, {}, {&toAttachmentBarrier, 1});
+
+            commandBuffer.beginRendering(
+                {.renderArea = {.offset = {0, 0}, .extent = WINDOW_EXTENT},
                  .layerCount = 1,
-                 .colorAttachments = {{.imageView = drawImageView,
-                                       .loadOp = AttachmentLoadOp::Clear,
-                                       .storeOp = AttachmentStoreOp::Store,
-                                       .clearColor = clearColor}},
-                 .depthAttachment = AttachmentDescription{.imageView = depthImageView,
-                                                          .loadOp = AttachmentLoadOp::Clear,
-                                                          .storeOp = AttachmentStoreOp::Store,
-                                                          .clearDepth = 0.0f}});
-            commandList.setViewport(0, 0, drawExtent.width, drawExtent.height);
-            commandList.setScissor(0, 0, drawExtent.width, drawExtent.height);
-            commandList.bindPipeline(m_pipeline);
-            commandList.draw(3, 1, 0, 0);
-            commandList.endRendering();
-        });
-    }
+                 .colorAttachments
+                 = {{.image = &image,
+                     .imageView = swapchainImageViews[imageIndex].get(),
+                     .imageLayout = GPUImageLayout::ColorAttachmentOptimal,
+                     .resolveImageView = nullptr,
+                     .loadOp = AttachmentLoadOp::Clear,
+                     .storeOp = AttachmentStoreOp::Store,
+                     .clearValue = ClearValue(ColorClearValue(
+                         std::in_place_index<0>, getClearColor(frame.getFrameNumber())))}}});
+            commandBuffer.setViewport(
+                {.offset = {0.0f, 0.0f},
+                 .extent = {static_cast<float>(WINDOW_EXTENT.width),
+                            static_cast<float>(WINDOW_EXTENT.height)}});
+            commandBuffer.setScissor({.offset = {0, 0}, .extent = WINDOW_EXTENT});
+            commandBuffer.bindPipeline(*pipeline);
+            commandBuffer.draw(3);
+            commandBuffer.endRendering();
 
-    virtual void onShutdown() override {
-        // Cleanup code here
-    }
+            const ImageBarrierDescription toPresentBarrier{
+                .image = &image,
+                .oldLayout = GPUImageLayout::ColorAttachmentOptimal,
+                .newLayout = GPUImageLayout::PresentSource,
+                .srcStageFlags = PipelineStage::ColorAttachmentOutput,
+                .srcAccessFlags = AccessType::ColorAttachmentWrite,
+                .dstStageFlags = PipelineStage::BottomOfPipe};
+            commandBuffer.barrier({}, {}, {&toPresentBarrier, 1});
 
-    ~Triangle() {
-        // Cleanup code here
-    }
+            frame.endGPUTiming(commandBuffer);
+            commandBuffer.end();
 
-  private:
-    std::shared_ptr<RenderSurface> m_primarySurface;
-    std::shared_ptr<Shader> m_vertexShader;
-    std::shared_ptr<Shader> m_fragmentShader;
-    std::shared_ptr<GPUPipeline> m_pipeline;
+            IGPUBinarySemaphore& renderFinishedSemaphore = *renderFinishedSemaphores[imageIndex];
+            GPUQueueSubmitDescription submitDescription{
+                .waitBinarySemaphores = {{.semaphore = &imageAcquiredSemaphore,
+                                          .waitStage = PipelineStage::ColorAttachmentOutput}},
+                .commandBuffers = {&commandBuffer},
+                .signalBinarySemaphores = {{.semaphore = &renderFinishedSemaphore,
+                                            .signalStage = PipelineStage::AllGraphics}},
+                .signalTimelineSemaphores = {frame.getTimelineSignal()}};
+            queue.submit({&submitDescription, 1}, nullptr);
 
-    uint32_t m_frameCount = 0;
-};
+            queue.present({.waitSemaphores = {&renderFinishedSemaphore},
+                           .swapchains = {{swapchain.get(), imageIndex}}});
 
-int main() {
-    Triangle game({.title = "Triangle", .extent = {800, 600}});
+            scheduler.endFrame();
+        }
 
-    try {
-        game.run();
+        const auto& timings = scheduler.getAverageFrameTimings();
+        fmt::println("Average CPU frame: {:.3f} ms, CPU wait: {:.3f} ms, slot latency: {:.3f} ms, "
+                     "GPU: {:.3f} ms",
+                     std::chrono::duration<double, std::milli>(timings.cpuFrameTime).count(),
+                     std::chrono::duration<double, std::milli>(timings.cpuWaitTime).count(),
+                     std::chrono::duration<double, std::milli>(timings.slotLatency).count(),
+                     std::chrono::duration<double, std::milli>(timings.gpuTime).count());
     } catch (const std::exception& e) {
         fmt::println("An error occurred: {}", e.what());
         return EXIT_FAILURE;
     }
 
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
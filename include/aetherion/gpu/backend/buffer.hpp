@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <span>
 #include <vector>
 
 #include "aetherion/gpu/backend/render_definitions.hpp"
@@ -20,9 +22,23 @@ namespace aetherion {
         IGPUBuffer(const IGPUBuffer&) = delete;
         IGPUBuffer& operator=(const IGPUBuffer&) = delete;
 
+        // NOTE: Persistently mapped buffers return the cached pointer and don't need unmapping.
         virtual void* map() = 0;
         virtual void unmap() = 0;
 
+        // NOTE: Empty unless the memory is persistently mapped, see AllocationProperty::Mapped.
+        virtual std::span<std::byte> getMappedSpan() = 0;
+
+        // NOTE: Required after CPU writes and before CPU reads of memory that isn't host coherent,
+        // no-ops otherwise.
+        virtual void flush(size_t offset = 0, size_t size = WHOLE_SIZE) = 0;
+        virtual void invalidate(size_t offset = 0, size_t size = WHOLE_SIZE) = 0;
+
+        virtual size_t getSize() const = 0;
+
+        // NOTE: Requires GPUBufferUsage::ShaderDeviceAddress.
+        virtual uint64_t getDeviceAddress() const = 0;
+
       protected:
         IGPUBuffer() = default;
         IGPUBuffer(IGPUBuffer&&) noexcept = default;
@@ -17,6 +17,8 @@ namespace aetherion {
     class IPipelineLayout;
     class IDescriptorSet;
     class IPushConstantRange;
+    class IQueryPool;
+    struct DescriptorWriteDescription;
 
     struct CommandPoolDescription {
         uint32_t queueFamilyIndex;
@@ -29,6 +31,19 @@ namespace aetherion {
         size_t size;
     };
 
+    // NOTE: Row length and image height of 0 mean the buffer data is tightly packed.
+    struct BufferImageCopyRegion {
+        size_t bufferOffset = 0;
+        uint32_t bufferRowLength = 0;
+        uint32_t bufferImageHeight = 0;
+        GPUImageAspectFlags aspectMask = GPUImageAspect::Color;
+        uint32_t mipLevel = 0;
+        uint32_t baseArrayLayer = 0;
+        uint32_t layerCount = 1;
+        Offset3Di imageOffset;
+        Extent3Du imageExtent;
+    };
+
     struct VertexBufferBindingDescription {
         IGPUBuffer* buffer;
         size_t offset;
@@ -56,6 +71,18 @@ namespace aetherion {
         std::vector<AttachmentDescription> colorAttachments;
         std::optional<AttachmentDescription> depthAttachment;
         std::optional<AttachmentDescription> stencilAttachment;
+        // NOTE: The pass is recorded through executeCommands() with secondary command buffers only.
+        bool secondaryCommandBuffers = false;
+    };
+
+    // NOTE: Describes the dynamic rendering pass a secondary command buffer is executed in. Must
+    // match the RenderDescription of the pass.
+    struct CommandBufferInheritanceDescription {
+        std::vector<Format> colorAttachmentFormats;
+        Format depthAttachmentFormat = Format::Undefined;
+        Format stencilAttachmentFormat = Format::Undefined;
+        uint32_t viewMask = 0;
+        SampleCount rasterizationSamples = SampleCount::Count1;
     };
 
     struct GeneralMemoryBarrierDescription {
@@ -71,8 +98,8 @@ namespace aetherion {
         AccessTypeFlags srcAccessFlags = {};
         PipelineStageFlags dstStageFlags = {};
         AccessTypeFlags dstAccessFlags = {};
-        uint32_t srcQueueFamilyIndex = 0;
-        uint32_t dstQueueFamilyIndex = 0;
+        uint32_t srcQueueFamilyIndex = QUEUE_FAMILY_IGNORED;
+        uint32_t dstQueueFamilyIndex = QUEUE_FAMILY_IGNORED;
         uint32_t offset = 0;
         uint32_t size = 0;  // NOTE: size = 0 means whole buffer.
     };
@@ -85,8 +112,8 @@ namespace aetherion {
         AccessTypeFlags srcAccessFlags = {};
         PipelineStageFlags dstStageFlags = {};
         AccessTypeFlags dstAccessFlags = {};
-        uint32_t srcQueueFamilyIndex = 0;
-        uint32_t dstQueueFamilyIndex = 0;
+        uint32_t srcQueueFamilyIndex = QUEUE_FAMILY_IGNORED;
+        uint32_t dstQueueFamilyIndex = QUEUE_FAMILY_IGNORED;
         GPUImageSubresourceDescription subresource = {};
     };
 
@@ -102,6 +129,10 @@ namespace aetherion {
         ICommandBuffer& operator=(const ICommandBuffer&) = delete;
 
         virtual void begin(CommandBufferUsageFlags flags = CommandBufferUsage::None) = 0;
+        // NOTE: Begins a secondary command buffer that continues a dynamic rendering pass.
+        virtual void begin(CommandBufferUsageFlags flags,
+                           const CommandBufferInheritanceDescription& inheritance)
+            = 0;
         virtual void reset(bool releaseResources = false) = 0;
         virtual void end() = 0;
 
@@ -135,9 +166,17 @@ namespace aetherion {
 
         virtual void bindPipeline(IPipeline& pipeline) = 0;
 
+        // NOTE: One dynamic offset per dynamic descriptor of the sets, in binding order.
         virtual void bindDescriptorSets(
             IPipelineLayout& pipelineLayout, PipelineBindPoint bindPoint, uint32_t firstSet,
-            std::span<std::reference_wrapper<IDescriptorSet>> descriptorSets)
+            std::span<std::reference_wrapper<IDescriptorSet>> descriptorSets,
+            std::span<const uint32_t> dynamicOffsets = {})
+            = 0;
+        // NOTE: Records the descriptors of a push descriptor set layout straight into the command
+        // buffer, no set is allocated. dstSet of the writes is ignored.
+        virtual void pushDescriptorSet(IPipelineLayout& pipelineLayout, PipelineBindPoint bindPoint,
+                                       uint32_t set,
+                                       std::span<const DescriptorWriteDescription> descriptorWrites)
             = 0;
         virtual void pushConstantRange(IPipelineLayout& pipelineLayout,
                                        IPushConstantRange& pushConstantRange,
@@ -152,12 +191,22 @@ namespace aetherion {
         virtual void copyBuffer(IGPUBuffer& src, IGPUBuffer& dst,
                                 const std::vector<BufferCopyRegion>& regions)
             = 0;
+        // NOTE: The image must be in the TransferDstOptimal or General layout.
+        virtual void copyBufferToImage(IGPUBuffer& src, IGPUImage& dst, GPUImageLayout dstLayout,
+                                       std::span<const BufferImageCopyRegion> regions)
+            = 0;
 
         virtual void barrier(std::span<const GeneralMemoryBarrierDescription> generalBarriers,
                              std::span<const BufferBarrierDescription> bufferBarriers,
                              std::span<const ImageBarrierDescription> imageBarriers)
             = 0;
 
+        // NOTE: Queries must be reset before they are written again, outside of rendering.
+        virtual void resetQueryPool(IQueryPool& queryPool, uint32_t firstQuery, uint32_t queryCount)
+            = 0;
+        // NOTE: Written once every previous command has completed the stage.
+        virtual void writeTimestamp(IQueryPool& queryPool, PipelineStage stage, uint32_t query) = 0;
+
       protected:
         ICommandBuffer() = default;
         ICommandBuffer(ICommandBuffer&&) noexcept = default;
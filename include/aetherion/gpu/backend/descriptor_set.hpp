@@ -1,9 +1,12 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <vector>
 
 #include "aetherion/gpu/backend/render_definitions.hpp"
 #include "aetherion/gpu/backend/resource.hpp"
+#include "aetherion/util/result_value.hpp"
 
 namespace aetherion {
     // Forward declarations
@@ -27,10 +30,16 @@ namespace aetherion {
         DescriptorType type;
         uint32_t count;
         ShaderStageFlags stages;
+        // NOTE: Update after bind bindings need a pool created with
+        // DescriptorPoolBehavior::UpdateAfterBind.
+        DescriptorBindingFlags flags = {};
     };
 
     struct DescriptorSetLayoutDescription {
         std::vector<DescriptorSetLayoutBindingDescription> bindings;
+        // NOTE: Push descriptor layouts don't allocate sets, their descriptors are recorded with
+        // ICommandBuffer::pushDescriptorSet().
+        DescriptorSetLayoutBehaviorFlags flags = {};
     };
 
     struct PushConstantRangeDescription {
@@ -43,6 +52,27 @@ namespace aetherion {
         IDescriptorSetLayout* layout;
     };
 
+    // NOTE: A descriptor in the backend's own format, filled by the IGPUDevice::pack*Descriptor()
+    // functions. Update template data is made of these, so updating a set with a template copies
+    // them as is instead of translating descriptions.
+    struct PackedDescriptor {
+        alignas(8) std::array<std::byte, 24> data{};
+    };
+
+    struct DescriptorUpdateTemplateEntryDescription {
+        uint32_t dstBinding;
+        uint32_t dstArrayElement = 0;
+        uint32_t descriptorCount = 1;
+        DescriptorType descriptorType;
+        size_t offset = 0;  // NOTE: Bytes from the start of the data to the first descriptor.
+        size_t stride = sizeof(PackedDescriptor);
+    };
+
+    struct DescriptorUpdateTemplateDescription {
+        IDescriptorSetLayout* layout;
+        std::vector<DescriptorUpdateTemplateEntryDescription> entries;
+    };
+
     class IDescriptorSetLayout {
       public:
         virtual ~IDescriptorSetLayout() = 0;
@@ -78,12 +108,32 @@ namespace aetherion {
 
         virtual void reset() = 0;
 
+        // NOTE: Allocates a set owned by the pool, valid until the next reset(). The pool recycles
+        // these sets across resets, so they don't cost a heap allocation each like
+        // IGPUDevice::allocateDescriptorSet(). Exhausting the pool is reported instead of thrown.
+        virtual ResultValue<DescriptorSetAllocateResultCode, IDescriptorSet*> allocateTransient(
+            const DescriptorSetDescription& description)
+            = 0;
+
       protected:
         IDescriptorPool() = default;
         IDescriptorPool(IDescriptorPool&&) noexcept = default;
         IDescriptorPool& operator=(IDescriptorPool&&) noexcept = default;
     };
 
+    class IDescriptorUpdateTemplate {
+      public:
+        virtual ~IDescriptorUpdateTemplate() = 0;
+
+        IDescriptorUpdateTemplate(const IDescriptorUpdateTemplate&) = delete;
+        IDescriptorUpdateTemplate& operator=(const IDescriptorUpdateTemplate&) = delete;
+
+      protected:
+        IDescriptorUpdateTemplate() = default;
+        IDescriptorUpdateTemplate(IDescriptorUpdateTemplate&&) noexcept = default;
+        IDescriptorUpdateTemplate& operator=(IDescriptorUpdateTemplate&&) noexcept = default;
+    };
+
     class IPushConstantRange {
       public:
         virtual ~IPushConstantRange() = 0;
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <cstdint>
+#include <filesystem>
+#include <functional>
 #include <memory>
 #include <span>
+#include <string>
 #include <vector>
 
 #include "aetherion/gpu/backend/render_definitions.hpp"
@@ -16,6 +20,7 @@ namespace aetherion {
     class IGPUBuffer;
     class IDescriptorPool;
     class IDescriptorSet;
+    class IDescriptorUpdateTemplate;
     class IPushConstantRange;
     class ICommandPool;
     class ICommandBuffer;
@@ -26,12 +31,15 @@ namespace aetherion {
     class IGPUFence;
     class IGPUBinarySemaphore;
     class IGPUTimelineSemaphore;
+    class IQueryPool;
     class IGPUQueue;
+    class IGPUAllocator;
     class IRenderSurface;
     class IWindow;
     struct CommandPoolDescription;
     struct CommandGPUBufferDescription;
     struct GPUBufferDescription;
+    struct GPUAllocationMemoryRequirementsDescription;
     struct GPUBufferViewDescription;
     struct GPUImageDescription;
     struct GPUImageViewDescription;
@@ -43,18 +51,45 @@ namespace aetherion {
     struct DescriptorSetLayoutDescription;
     struct DescriptorSetDescription;
     struct DescriptorPoolDescription;
+    struct DescriptorUpdateTemplateDescription;
+    struct PackedDescriptor;
     struct PushConstantRangeDescription;
     struct GPUQueueDescription;
     struct GPUFenceDescription;
     struct GPUBinarySemaphoreDescription;
     struct GPUTimelineSemaphoreDescription;
+    struct QueryPoolDescription;
     struct SwapchainDescription;
+    struct GPUAllocatorDescription;
 
     struct GPUQueueFamilyProperties {
         GPUQueueTypeFlags queueFlags;
         uint32_t queueCount;
+        bool presentSupport = false;  // NOTE: To the primary window, always false without one.
     };
 
+    struct PhysicalGPUDeviceProperties {
+        std::string name;
+        PhysicalGPUDeviceType type = PhysicalGPUDeviceType::Other;
+        uint32_t vendorID = 0;
+        uint32_t deviceID = 0;
+        uint32_t apiVersion = 0;
+        uint32_t driverVersion = 0;
+        size_t deviceLocalMemorySize = 0;
+        // NOTE: Device local memory the CPU can map, the whole heap with ReBAR or unified memory,
+        // usually 256MiB otherwise and 0 when there is none.
+        size_t hostVisibleDeviceLocalMemorySize = 0;
+    };
+
+    // NOTE: Returns the score of a candidate physical device, the highest scoring one is picked.
+    // Negative scores reject the device.
+    using PhysicalGPUDeviceScoringFunctor
+        = std::function<int64_t(const PhysicalGPUDeviceProperties& properties)>;
+
+    // NOTE: Prefers discrete over integrated over virtual over CPU devices, breaking ties by the
+    // amount of device local memory.
+    int64_t scorePhysicalGPUDevice(const PhysicalGPUDeviceProperties& properties);
+
     struct PhysicalGPUDeviceDescription {
         /*GPUQueueTypeFlags requiredQueueTypes;
         std::vector<const char*> requiredDeviceExtensions;
@@ -67,8 +102,11 @@ namespace aetherion {
         bool enableTessellationShader = false;
         bool enableWideLines = false;
         bool enableMultiViewport = false;*/
-        IWindow*
-            primaryWindow;  // NOTE: Leave this as nullptr if doesn't require swapchain support.
+        IWindow* primaryWindow{};  // NOTE: Leave this as nullptr if doesn't require swapchain
+                                   // support (e.g. headless drivers).
+        PhysicalGPUDeviceScoringFunctor scoringFunctor
+            = scorePhysicalGPUDevice;  // NOTE: Only devices meeting the engine requirements are
+                                       // scored.
     };
 
     struct GPUQueueFamilyDescription {
@@ -83,6 +121,15 @@ namespace aetherion {
     struct GPUDeviceDescription {
         class IGPUPhysicalDevice* physicalDevice;
         std::vector<GPUQueueFamilyDescription> queueFamilyDescriptions;
+        std::filesystem::path pipelineCachePath;  // NOTE: Leave empty to keep the pipeline cache
+                                                  // in memory only.
+        // NOTE: Resources destroyed by the backend are kept alive until the GPU reaches the value
+        // set by setDeferredDestructionValue(), see collectDeferredDestructions().
+        bool deferredDestruction = false;
+        // NOTE: Descriptor sets live in mapped buffers written directly by updateDescriptorSets()
+        // when the physical device supports descriptor buffers, in descriptor pools otherwise.
+        // Dynamic uniform and storage buffers aren't supported with descriptor buffers.
+        bool descriptorBuffers = false;
     };
 
     struct DescriptorWriteDescriptorGPUImageDescription {
@@ -128,6 +175,9 @@ namespace aetherion {
         IGPUPhysicalDevice(const IGPUPhysicalDevice&) = delete;
         IGPUPhysicalDevice& operator=(const IGPUPhysicalDevice&) = delete;
 
+        virtual const PhysicalGPUDeviceProperties& getProperties() const = 0;
+
+        virtual uint32_t getGPUQueueFamilyCount() const = 0;
         virtual const GPUQueueFamilyProperties& getGPUQueueFamilyProperties(
             uint32_t familyIndex) const
             = 0;
@@ -147,6 +197,26 @@ namespace aetherion {
 
         virtual void waitIdle() = 0;
 
+        // NOTE: The pipeline cache is also saved when the device is destroyed.
+        virtual void savePipelineCache() = 0;
+
+        // NOTE: Only used with deferred destruction enabled. Resources destroyed from now on are
+        // tagged with the timeline value, usually the one signaled by the next submission.
+        virtual void setDeferredDestructionValue(uint64_t timelineValue) = 0;
+        // NOTE: Destroys every deferred resource tagged with a value up to the completed one.
+        // Deferred descriptor sets are freed into their pools, so this must not run concurrently
+        // with allocations from those pools.
+        virtual void collectDeferredDestructions(uint64_t completedTimelineValue) = 0;
+
+        // NOTE: Descriptor indexing with update after bind and partially bound descriptor arrays,
+        // required by BindlessHeap.
+        virtual bool supportsBindlessDescriptors() const = 0;
+        // NOTE: Whether GPUDeviceDescription::descriptorBuffers was requested and is supported.
+        virtual bool usesDescriptorBuffers() const = 0;
+        // NOTE: Nanoseconds per timestamp tick, 0 when timestamps aren't supported on every
+        // graphics and compute queue.
+        virtual float getTimestampPeriod() const = 0;
+
         virtual std::unique_ptr<ICommandPool> createCommandPool(
             const CommandPoolDescription& description)
             = 0;
@@ -162,6 +232,11 @@ namespace aetherion {
             ICommandPool& pool, std::span<std::reference_wrapper<ICommandBuffer>> commandBuffers)
             = 0;
 
+        virtual std::unique_ptr<IGPUAllocator> createAllocator(
+            const GPUAllocatorDescription& description)
+            = 0;
+
+        // NOTE: The buffer has no memory bound, use an IGPUAllocator to create it with memory.
         virtual std::unique_ptr<IGPUBuffer> createBuffer(const GPUBufferDescription& description)
             = 0;
 
@@ -171,6 +246,15 @@ namespace aetherion {
 
         virtual std::unique_ptr<IGPUImage> createImage(const GPUImageDescription& description) = 0;
 
+        // NOTE: Memory requirements of resources that would be created with the descriptions,
+        // without creating them.
+        virtual GPUAllocationMemoryRequirementsDescription getBufferMemoryRequirements(
+            const GPUBufferDescription& description) const
+            = 0;
+        virtual GPUAllocationMemoryRequirementsDescription getImageMemoryRequirements(
+            const GPUImageDescription& description) const
+            = 0;
+
         virtual std::unique_ptr<IGPUImageView> createImageView(
             const GPUImageViewDescription& description)
             = 0;
@@ -183,6 +267,12 @@ namespace aetherion {
             const PipelineLayoutDescription& description)
             = 0;
 
+        // NOTE: Cached by contents, identical descriptions share one layout for as long as it's
+        // referenced, instead of creating a driver object each. Thread safe.
+        virtual std::shared_ptr<IPipelineLayout> getOrCreatePipelineLayout(
+            const PipelineLayoutDescription& description)
+            = 0;
+
         virtual std::unique_ptr<IPipeline> createComputePipeline(
             const ComputePipelineDescription& description)
             = 0;
@@ -195,6 +285,11 @@ namespace aetherion {
             const DescriptorSetLayoutDescription& description)
             = 0;
 
+        // NOTE: Cached by contents like getOrCreatePipelineLayout().
+        virtual std::shared_ptr<IDescriptorSetLayout> getOrCreateDescriptorSetLayout(
+            const DescriptorSetLayoutDescription& description)
+            = 0;
+
         virtual std::unique_ptr<IDescriptorPool> createDescriptorPool(
             const DescriptorPoolDescription& description)
             = 0;
@@ -217,6 +312,9 @@ namespace aetherion {
             const GPUTimelineSemaphoreDescription& description)
             = 0;
 
+        virtual std::unique_ptr<IQueryPool> createQueryPool(const QueryPoolDescription& description)
+            = 0;
+
         virtual std::unique_ptr<IGPUQueue> getQueue(const GPUQueueDescription& description) = 0;
 
         virtual std::unique_ptr<IDescriptorSet> allocateDescriptorSet(
@@ -236,6 +334,27 @@ namespace aetherion {
             std::span<const DescriptorCopyDescription> descriptorCopies)
             = 0;
 
+        virtual std::unique_ptr<IDescriptorUpdateTemplate> createDescriptorUpdateTemplate(
+            const DescriptorUpdateTemplateDescription& description)
+            = 0;
+
+        // NOTE: Only the sampler of sampler descriptors and the image view of other image
+        // descriptors are read, the rest may be null.
+        virtual PackedDescriptor packImageDescriptor(IGPUImageView* imageView, ISampler* sampler,
+                                                     GPUImageLayout imageLayout)
+            = 0;
+        virtual PackedDescriptor packBufferDescriptor(IGPUBuffer& buffer, size_t offset = 0,
+                                                      size_t range = WHOLE_BUFFER_SIZE)
+            = 0;
+        virtual PackedDescriptor packTexelBufferDescriptor(IGPUBufferView& bufferView) = 0;
+
+        // NOTE: Data holds the packed descriptors of every template entry. Packed descriptors
+        // only reference their resources, repack them when a resource is recreated.
+        virtual void updateDescriptorSetWithTemplate(IDescriptorSet& descriptorSet,
+                                                     IDescriptorUpdateTemplate& updateTemplate,
+                                                     const void* data)
+            = 0;
+
       protected:
         IGPUDevice() = default;
         IGPUDevice(IGPUDevice&&) noexcept = default;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 namespace aetherion {
     // Forward declarations
@@ -20,6 +21,8 @@ namespace aetherion {
         std::string name;
         std::string version;
         bool validationLayersEnabled = false;
+        bool headless = false;  // NOTE: Headless drivers skip window system integration, so they
+                                // can't create surfaces or swapchains.
     };
 
     class IGPUDriver {
@@ -43,6 +46,8 @@ namespace aetherion {
             const RenderSurfaceDescription& description)
             = 0;
 
+        virtual bool isHeadless() const = 0;
+
       protected:
         IGPUDriver() = default;
         IGPUDriver(IGPUDriver&&) noexcept = default;
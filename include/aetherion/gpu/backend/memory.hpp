@@ -1,6 +1,8 @@
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <vector>
 
 #include "render_definitions.hpp"
 
@@ -11,6 +13,9 @@ namespace aetherion {
     class IGPUAllocation;
     class IGPUImage;
     class IGPUBuffer;
+    class IGPUDefragmenter;
+    class IGPUTimelineSemaphore;
+    class ICommandBuffer;
     struct GPUImageDescription;
     struct GPUBufferDescription;
 
@@ -42,6 +47,43 @@ namespace aetherion {
         size_t minAllocationAlignment = 0;  // NOTE: 0 = no minimum
     };
 
+    // NOTE: Usage and budget cover the whole process when the memory budget extension is
+    // available, otherwise usage only counts this allocator's blocks and the budget is estimated.
+    struct GPUMemoryHeapBudget {
+        size_t size = 0;
+        size_t budget = 0;
+        size_t usage = 0;
+        size_t blockBytes = 0;       // NOTE: Memory allocated by this allocator.
+        size_t allocationBytes = 0;  // NOTE: Memory used by live allocations of this allocator.
+        bool deviceLocal = false;
+    };
+
+    struct GPUDefragmenterDescription {
+        // NOTE: Signaled by the submissions of recorded passes.
+        IGPUTimelineSemaphore* timeline{};
+        IGPUAllocatorPool* pool{};  // NOTE: If null, the default pools are defragmented.
+        DefragmentationAlgorithm algorithm = DefragmentationAlgorithm::Balanced;
+        size_t maxBytesPerPass = 16 * 1024 * 1024;  // NOTE: 0 = no limit.
+        uint32_t maxAllocationsPerPass = 64;        // NOTE: 0 = no limit.
+    };
+
+    struct GPUDefragmentationStats {
+        size_t bytesMoved = 0;
+        size_t bytesFreed = 0;
+        uint32_t allocationsMoved = 0;
+        uint32_t deviceMemoryBlocksFreed = 0;
+        uint32_t passCount = 0;
+        // NOTE: Memory allocated in blocks but not used by any allocation, across every heap, when
+        // the defragmentation started and when it last finished.
+        size_t unusedBytesBefore = 0;
+        size_t unusedBytesAfter = 0;
+    };
+
+    // NOTE: Called once a moved resource uses its new memory, its previous handle stays valid until
+    // the GPU is done with it. Descriptors, views and device addresses referencing the resource
+    // must be updated.
+    using GPUResourceRelocationCallback = std::function<void()>;
+
     class IGPUAllocator {
       public:
         virtual ~IGPUAllocator() = 0;
@@ -84,6 +126,14 @@ namespace aetherion {
             IGPUAllocation& allocation, const GPUBufferDescription& description, size_t offset = 0)
             = 0;
 
+        // NOTE: One entry per memory heap, refreshed every setCurrentFrameIndex() call.
+        virtual std::vector<GPUMemoryHeapBudget> getHeapBudgets() const = 0;
+        virtual void setCurrentFrameIndex(uint32_t frameIndex) = 0;
+
+        virtual std::unique_ptr<IGPUDefragmenter> createDefragmenter(
+            const GPUDefragmenterDescription& description)
+            = 0;
+
       protected:
         IGPUAllocator() = default;
         IGPUAllocator(IGPUAllocator&&) noexcept = default;
@@ -115,4 +165,45 @@ namespace aetherion {
         IGPUAllocatorPool(IGPUAllocatorPool&&) noexcept = default;
         IGPUAllocatorPool& operator=(IGPUAllocatorPool&&) noexcept = default;
     };
+
+    // NOTE: Moves allocations of registered resources into fewer memory blocks, a bounded number
+    // per pass, and releases the emptied blocks. Every pass records its copies into a command
+    // buffer that must be submitted signaling the given timeline value, and takes effect on a later
+    // recordPass() once that value is reached. Unregistered allocations never move. Registered
+    // resources must not be written by the GPU while a pass is in flight. Not thread safe.
+    class IGPUDefragmenter {
+      public:
+        virtual ~IGPUDefragmenter() = 0;
+
+        IGPUDefragmenter(const IGPUDefragmenter&) = delete;
+        IGPUDefragmenter& operator=(const IGPUDefragmenter&) = delete;
+
+        // NOTE: The description must be the one the resource was created with, plus transfer
+        // source and destination usages. Images are kept in the given layout between passes.
+        virtual void registerBuffer(IGPUBuffer& buffer, const GPUBufferDescription& description,
+                                    GPUResourceRelocationCallback onRelocated = {})
+            = 0;
+        virtual void registerImage(IGPUImage& image, const GPUImageDescription& description,
+                                   GPUImageLayout layout,
+                                   GPUResourceRelocationCallback onRelocated = {})
+            = 0;
+        // NOTE: Must be called before a registered resource is destroyed.
+        virtual void unregisterBuffer(IGPUBuffer& buffer) = 0;
+        virtual void unregisterImage(IGPUImage& image) = 0;
+
+        // NOTE: Applies the previous pass if the GPU has finished it and records the next one.
+        // Returns whether commands were recorded.
+        virtual bool recordPass(ICommandBuffer& commandBuffer, uint64_t timelineValue) = 0;
+
+        // NOTE: Starts a new defragmentation if the previous one is complete.
+        virtual void restart() = 0;
+        virtual bool isComplete() const = 0;
+
+        virtual const GPUDefragmentationStats& getStats() const = 0;
+
+      protected:
+        IGPUDefragmenter() = default;
+        IGPUDefragmenter(IGPUDefragmenter&&) noexcept = default;
+        IGPUDefragmenter& operator=(IGPUDefragmenter&&) noexcept = default;
+    };
 }  // namespace aetherion
\ No newline at end of file
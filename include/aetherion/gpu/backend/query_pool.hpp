@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "aetherion/gpu/backend/resource.hpp"
+
+namespace aetherion {
+    // NOTE: Timestamp queries, the only query type supported for now.
+    struct QueryPoolDescription {
+        uint32_t count = 0;
+    };
+
+    class IQueryPool : public IGPUResource {
+      public:
+        ~IQueryPool() override = 0;
+
+        IQueryPool(const IQueryPool&) = delete;
+        IQueryPool& operator=(const IQueryPool&) = delete;
+
+        // NOTE: Raw ticks of the queries starting at the first one, multiply their differences by
+        // IGPUDevice::getTimestampPeriod() for nanoseconds. Doesn't wait, returns false when any
+        // of them isn't available yet.
+        virtual bool getTimestamps(uint32_t firstQuery, std::span<uint64_t> timestamps) = 0;
+
+        virtual uint32_t getCount() const = 0;
+
+      protected:
+        IQueryPool() = default;
+        IQueryPool(IQueryPool&&) noexcept = default;
+        IQueryPool& operator=(IQueryPool&&) noexcept = default;
+    };
+}  // namespace aetherion
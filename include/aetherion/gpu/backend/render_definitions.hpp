@@ -18,6 +18,10 @@ namespace aetherion {
 
     using ClearValue = std::variant<ColorClearValue, DepthStencilValue>;
 
+    // --- Device ---
+
+    enum class PhysicalGPUDeviceType { Other, IntegratedGPU, DiscreteGPU, VirtualGPU, CPU };
+
     // --- Queues ---
 
     enum class GPUQueueType : FlagType {
@@ -32,6 +36,9 @@ namespace aetherion {
     constexpr GPUQueueTypeFlags ALL_QUEUE_TYPES = GPUQueueType::Graphics | GPUQueueType::Compute
                                                   | GPUQueueType::Transfer | GPUQueueType::Present;
 
+    // NOTE: Used as both queue family indices of a barrier that doesn't transfer ownership.
+    constexpr uint32_t QUEUE_FAMILY_IGNORED = ~0u;
+
     enum class QueuePresentResultCode {
         Success,
         Suboptimal,
@@ -72,6 +79,9 @@ namespace aetherion {
 
     constexpr size_t NO_HEAP_SIZE_LIMIT = 0;
 
+    // NOTE: Used as the size of a range reaching the end of the buffer or allocation.
+    constexpr size_t WHOLE_SIZE = ~size_t(0);
+
     enum class AllocationProperty : FlagType {
         None = 0,
         DedicatedMemory = 1 << 0,
@@ -82,7 +92,12 @@ namespace aetherion {
     };
     DECLARE_FLAG_ENUM(AllocationProperty)
 
-    enum class MemoryUsage { PreferGpu, PreferCpu, Auto };
+    // NOTE: PreferGpuHostVisible picks device local memory the CPU can write directly (ReBAR or
+    // unified memory), falling back to host visible system memory. Allocations using it are
+    // always persistently mapped, sequential writes are assumed unless RandomAccess is set.
+    enum class MemoryUsage { PreferGpu, PreferCpu, Auto, PreferGpuHostVisible };
+
+    enum class DefragmentationAlgorithm { Fast, Balanced, Full };
 
     enum class AllocatorPoolProperty : FlagType {
         None = 0,
@@ -156,6 +171,11 @@ namespace aetherion {
     };
     DECLARE_FLAG_ENUM(AccessType);
 
+    constexpr AccessTypeFlags WRITE_ACCESS_TYPES
+        = AccessType::ShaderWrite | AccessType::ColorAttachmentWrite
+          | AccessType::DepthStencilAttachmentWrite | AccessType::TransferWrite
+          | AccessType::HostWrite | AccessType::MemoryWrite;
+
     // --- Shader ---
 
     enum class ShaderLanguage { GLSL, HLSL, SPIRV };
@@ -187,9 +207,26 @@ namespace aetherion {
         InputAttachment
     };
 
-    enum class DescriptorPoolBehavior : FlagType { None = 0, FreeIndividualSets = 1 << 0 };
+    enum class DescriptorPoolBehavior : FlagType {
+        None = 0,
+        FreeIndividualSets = 1 << 0,
+        UpdateAfterBind = 1 << 1
+    };
     DECLARE_FLAG_ENUM(DescriptorPoolBehavior)
 
+    enum class DescriptorSetLayoutBehavior : FlagType { None = 0, PushDescriptor = 1 << 0 };
+    DECLARE_FLAG_ENUM(DescriptorSetLayoutBehavior)
+
+    enum class DescriptorSetAllocateResultCode { Success, OutOfPoolMemory, FragmentedPool };
+
+    enum class DescriptorBinding : FlagType {
+        None = 0,
+        UpdateAfterBind = 1 << 0,
+        UpdateUnusedWhilePending = 1 << 1,
+        PartiallyBound = 1 << 2
+    };
+    DECLARE_FLAG_ENUM(DescriptorBinding)
+
     // --- Resources ---
 
     enum class SharingMode { Exclusive, Concurrent };
@@ -236,7 +273,8 @@ namespace aetherion {
         Storage = 1 << 5,
         Vertex = 1 << 6,
         Index = 1 << 7,
-        Indirect = 1 << 8
+        Indirect = 1 << 8,
+        ShaderDeviceAddress = 1 << 9
     };
     DECLARE_FLAG_ENUM(GPUBufferUsage)
 
@@ -34,8 +34,10 @@ namespace aetherion {
         ISwapchain(const ISwapchain&) = delete;
         ISwapchain& operator=(const ISwapchain&) = delete;
 
+        // NOTE: The fence is optional, frames paced with a timeline semaphore only need the
+        // semaphore.
         virtual ResultValue<SwapchainAcquireResultCode, uint32_t> acquireNextImage(
-            uint64_t timeout, IGPUBinarySemaphore& semaphore, IGPUFence& fence)
+            uint64_t timeout, IGPUBinarySemaphore& semaphore, IGPUFence* fence = nullptr)
             = 0;
 
         virtual uint32_t getImageCount() const = 0;
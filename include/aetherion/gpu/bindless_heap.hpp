@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "aetherion/gpu/backend/descriptor_set.hpp"
+
+namespace aetherion {
+    // Forward declarations
+    class IGPUDevice;
+    class IGPUBuffer;
+    class IGPUImageView;
+    class ISampler;
+    struct DescriptorWriteDescription;
+
+    // NOTE: Also the binding of each resource type in the heap's descriptor set.
+    enum class BindlessResourceType { SampledImage, StorageImage, Sampler, StorageBuffer };
+
+    constexpr size_t BINDLESS_RESOURCE_TYPE_COUNT = 4;
+
+    using BindlessHandle = uint32_t;
+
+    constexpr BindlessHandle INVALID_BINDLESS_HANDLE = ~0u;
+
+    struct BindlessHeapDescription {
+        // NOTE: Bound by the device's update after bind descriptor limits.
+        uint32_t sampledImageCapacity = 16384;
+        uint32_t storageImageCapacity = 4096;
+        uint32_t samplerCapacity = 256;
+        uint32_t storageBufferCapacity = 16384;
+        ShaderStageFlags stages
+            = ShaderStage::Vertex | ShaderStage::Fragment | ShaderStage::Compute;
+    };
+
+    // NOTE: A single update after bind descriptor set with one partially bound array per resource
+    // type, bound once and indexed in shaders with the handles. Handles of each type are
+    // independent. Freed handles are reused right away, so only free them once the GPU is done
+    // with them, e.g. through FrameContext::deferDestruction(). Throws on creation if the device
+    // doesn't support bindless descriptors.
+    class BindlessHeap {
+      public:
+        BindlessHeap(IGPUDevice& device, const BindlessHeapDescription& description);
+        ~BindlessHeap() noexcept;
+
+        BindlessHeap(const BindlessHeap&) = delete;
+        BindlessHeap& operator=(const BindlessHeap&) = delete;
+
+        BindlessHeap(BindlessHeap&&) = delete;
+        BindlessHeap& operator=(BindlessHeap&&) = delete;
+
+        // NOTE: Thread safe. Throw if the type's array is full.
+        BindlessHandle addSampledImage(
+            IGPUImageView& imageView,
+            GPUImageLayout layout = GPUImageLayout::ShaderReadOnlyOptimal);
+        BindlessHandle addStorageImage(IGPUImageView& imageView);
+        BindlessHandle addSampler(ISampler& sampler);
+        BindlessHandle addStorageBuffer(IGPUBuffer& buffer, size_t offset = 0,
+                                        size_t range = WHOLE_BUFFER_SIZE);
+
+        // NOTE: Thread safe. The descriptor is left as is, partially bound arrays only require
+        // the descriptors shaders access to be valid. Throws if the handle is already free.
+        void free(BindlessResourceType type, BindlessHandle handle);
+
+        uint32_t getUsedCount(BindlessResourceType type) const;
+
+        inline IDescriptorSetLayout& getDescriptorSetLayout() { return *descriptorSetLayout_; }
+
+        inline IDescriptorSet& getDescriptorSet() { return *descriptorSet_; }
+
+      private:
+        struct Slots {
+            uint32_t capacity;
+            uint32_t next = 0;
+            std::vector<uint32_t> freeSlots;
+            std::vector<bool> usedSlots;
+        };
+
+        BindlessHandle add(BindlessResourceType type, DescriptorWriteDescription& write);
+
+        IGPUDevice* device_;
+
+        std::unique_ptr<IDescriptorSetLayout> descriptorSetLayout_;
+        std::unique_ptr<IDescriptorPool> descriptorPool_;
+        std::unique_ptr<IDescriptorSet> descriptorSet_;
+
+        mutable std::mutex mutex_;
+        std::array<Slots, BINDLESS_RESOURCE_TYPE_COUNT> slots_;
+    };
+}  // namespace aetherion
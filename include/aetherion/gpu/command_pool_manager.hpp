@@ -0,0 +1,85 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "aetherion/gpu/backend/command_buffer.hpp"
+
+namespace aetherion {
+    // Forward declarations
+    class IGPUDevice;
+    class IGPUTimelineSemaphore;
+
+    struct CommandPoolManagerDescription {
+        uint32_t queueFamilyIndex = 0;
+        uint32_t framesInFlight = 2;
+        // NOTE: Bounds the wait for the frames in flight on destruction. Past it the pools are
+        // leaked, since the GPU may still execute their command buffers.
+        std::chrono::nanoseconds shutdownTimeout = std::chrono::nanoseconds::max();
+    };
+
+    // NOTE: Gives every recording thread its own command pool per frame in flight, so recording
+    // never needs to lock a pool. Command buffers are recycled by resetting whole pools once the
+    // frame's timeline value is reached, and are only freed when the manager is destroyed.
+    class CommandPoolManager {
+      public:
+        CommandPoolManager(IGPUDevice& device, IGPUTimelineSemaphore& timeline,
+                           const CommandPoolManagerDescription& description);
+        ~CommandPoolManager() noexcept;
+
+        CommandPoolManager(const CommandPoolManager&) = delete;
+        CommandPoolManager& operator=(const CommandPoolManager&) = delete;
+
+        CommandPoolManager(CommandPoolManager&&) = delete;
+        CommandPoolManager& operator=(CommandPoolManager&&) = delete;
+
+        // NOTE: Moves to the next frame slot, waiting until the GPU has reached the timeline value
+        // of its last use. Must not run concurrently with acquire().
+        void beginFrame();
+        // NOTE: Timeline value signaled by the last submission of the current frame.
+        void endFrame(uint64_t timelineValue);
+
+        // NOTE: Thread safe. The command buffer comes from the calling thread's pool and is only
+        // valid until the same frame slot begins again.
+        ICommandBuffer& acquire(CommandBufferLevel level = CommandBufferLevel::Primary);
+
+        inline uint32_t getFrameIndex() const { return frameIndex_; }
+
+        inline uint32_t getFramesInFlight() const { return framesInFlight_; }
+
+        size_t getThreadCount() const;
+
+      private:
+        struct FramePool {
+            std::unique_ptr<ICommandPool> pool;
+            // NOTE: Declared after the pool, so they are freed before it is destroyed.
+            std::vector<std::unique_ptr<ICommandBuffer>> primaryCommandBuffers;
+            std::vector<std::unique_ptr<ICommandBuffer>> secondaryCommandBuffers;
+            size_t usedPrimaryCommandBuffers = 0;
+            size_t usedSecondaryCommandBuffers = 0;
+        };
+
+        struct ThreadPools {
+            std::vector<FramePool> frames;
+        };
+
+        ThreadPools& getThreadPools();
+
+        IGPUDevice* device_;
+        IGPUTimelineSemaphore* timeline_;
+
+        uint32_t queueFamilyIndex_;
+        uint32_t framesInFlight_;
+        uint32_t frameIndex_ = 0;
+        uint64_t frameCount_ = 0;
+        std::vector<uint64_t> frameTimelineValues_;
+        std::chrono::nanoseconds shutdownTimeout_;
+
+        mutable std::mutex threadsMutex_;
+        std::unordered_map<std::thread::id, std::unique_ptr<ThreadPools>> threads_;
+    };
+}  // namespace aetherion
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "aetherion/gpu/backend/descriptor_set.hpp"
+
+namespace aetherion {
+    // Forward declarations
+    class IGPUDevice;
+    class IGPUTimelineSemaphore;
+
+    struct DescriptorPoolSizeRatio {
+        DescriptorType type;
+        float ratio;  // NOTE: Descriptors of the type per set.
+    };
+
+    struct DescriptorAllocatorDescription {
+        uint32_t framesInFlight = 2;
+        // NOTE: Every new pool of a frame slot doubles its set count, up to the maximum.
+        uint32_t initialSetsPerPool = 64;
+        uint32_t maxSetsPerPool = 4096;
+        std::vector<DescriptorPoolSizeRatio> poolSizeRatios
+            = {{.type = DescriptorType::CombinedImageSampler, .ratio = 4.0f},
+               {.type = DescriptorType::SampledImage, .ratio = 2.0f},
+               {.type = DescriptorType::Sampler, .ratio = 1.0f},
+               {.type = DescriptorType::StorageImage, .ratio = 1.0f},
+               {.type = DescriptorType::UniformBuffer, .ratio = 2.0f},
+               {.type = DescriptorType::StorageBuffer, .ratio = 2.0f}};
+        DescriptorPoolBehaviorFlags flags = {};
+    };
+
+    // NOTE: Hands out per-frame descriptor sets from a chain of pools per frame in flight. A new
+    // pool is chained when the current one runs out of memory or gets fragmented, and sets are
+    // never freed one by one: the pools of a frame slot are reset whole once the timeline value of
+    // its last use is reached, and kept for the next frames. Pools left unused by a frame are
+    // destroyed when its slot begins again.
+    class DescriptorAllocator {
+      public:
+        DescriptorAllocator(IGPUDevice& device, IGPUTimelineSemaphore& timeline,
+                            const DescriptorAllocatorDescription& description);
+        ~DescriptorAllocator() noexcept;
+
+        DescriptorAllocator(const DescriptorAllocator&) = delete;
+        DescriptorAllocator& operator=(const DescriptorAllocator&) = delete;
+
+        DescriptorAllocator(DescriptorAllocator&&) = delete;
+        DescriptorAllocator& operator=(DescriptorAllocator&&) = delete;
+
+        // NOTE: Moves to the next frame slot, waiting until the GPU has reached the timeline value
+        // of its last use. Must not run concurrently with allocate().
+        void beginFrame();
+        // NOTE: Timeline value signaled by the last submission of the current frame.
+        void endFrame(uint64_t timelineValue);
+
+        // NOTE: Thread safe. The set is owned by the allocator and only valid until the same
+        // frame slot begins again. Throws if the set doesn't fit in an empty pool.
+        IDescriptorSet& allocate(IDescriptorSetLayout& layout);
+
+        inline uint32_t getFrameIndex() const { return frameIndex_; }
+
+        inline uint32_t getFramesInFlight() const { return framesInFlight_; }
+
+        size_t getPoolCount() const;
+
+      private:
+        struct FramePools {
+            std::vector<std::unique_ptr<IDescriptorPool>> pools;
+            size_t currentPool = 0;
+            size_t currentPoolSets = 0;
+            uint32_t setsPerPool = 0;
+        };
+
+        std::unique_ptr<IDescriptorPool> createPool(FramePools& frame);
+
+        IGPUDevice* device_;
+        IGPUTimelineSemaphore* timeline_;
+
+        std::vector<DescriptorPoolSizeRatio> poolSizeRatios_;
+        DescriptorPoolBehaviorFlags poolFlags_;
+        uint32_t initialSetsPerPool_;
+        uint32_t maxSetsPerPool_;
+
+        uint32_t framesInFlight_;
+        uint32_t frameIndex_ = 0;
+        uint64_t frameCount_ = 0;
+        std::vector<uint64_t> frameTimelineValues_;
+
+        mutable std::mutex mutex_;
+        std::vector<FramePools> frames_;
+    };
+}  // namespace aetherion
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "aetherion/gpu/backend/queue.hpp"
+#include "aetherion/gpu/backend/resource.hpp"
+#include "aetherion/gpu/command_pool_manager.hpp"
+#include "aetherion/util/linear_allocator.hpp"
+
+namespace aetherion {
+    // Forward declarations
+    class IGPUDevice;
+    class IGPUTimelineSemaphore;
+    class IQueryPool;
+
+    struct FrameSchedulerDescription {
+        uint32_t framesInFlight = 2;
+        uint32_t queueFamilyIndex = 0;
+        size_t uploadArenaBlockSize = 64 * 1024;
+        // NOTE: Bounds the wait for the frames in flight on destruction, a hung or lost device
+        // only delays it by this much. Past it everything the frames still own is leaked.
+        std::chrono::nanoseconds shutdownTimeout = std::chrono::seconds(5);
+    };
+
+    struct FrameTimings {
+        // NOTE: Time beginFrame() blocked until the GPU released the frame slot. Consistently
+        // non-zero waits mean the frame is GPU bound.
+        std::chrono::nanoseconds cpuWaitTime{};
+        // NOTE: Time between beginFrame() returning and endFrame().
+        std::chrono::nanoseconds cpuFrameTime{};
+        // NOTE: Time from endFrame() until the frame's timeline value was observed, when its slot
+        // is reused. It isn't GPU busy time: it includes the queueing behind earlier frames and the
+        // CPU time of every frame recorded in between, so it approaches framesInFlight frames when
+        // nothing waits.
+        std::chrono::nanoseconds slotLatency{};
+        // NOTE: GPU time between the timestamps of FrameContext::beginGPUTiming() and
+        // endGPUTiming(), read back when the slot is reused. Zero for frames without them and on
+        // devices without timestamp support.
+        std::chrono::nanoseconds gpuTime{};
+    };
+
+    class FrameContext {
+      public:
+        FrameContext(CommandPoolManager& commandPools, size_t uploadArenaBlockSize)
+            : commandPools_(&commandPools), uploadArena_(uploadArenaBlockSize) {}
+        ~FrameContext() noexcept = default;
+
+        FrameContext(const FrameContext&) = delete;
+        FrameContext& operator=(const FrameContext&) = delete;
+
+        FrameContext(FrameContext&&) noexcept = default;
+        FrameContext& operator=(FrameContext&&) noexcept = default;
+
+        // NOTE: Thread safe, every thread records from its own pool.
+        ICommandBuffer& acquireCommandBuffer(
+            CommandBufferLevel level = CommandBufferLevel::Primary) {
+            return commandPools_->acquire(level);
+        }
+
+        // NOTE: CPU memory reset once the frame slot is reused, not thread safe.
+        inline LinearAllocator& getUploadArena() { return uploadArena_; }
+
+        // NOTE: Destroyed once the GPU has finished this frame.
+        void deferDestruction(std::unique_ptr<IGPUResource> resource) {
+            deferredResources_.push_back(std::move(resource));
+        }
+        void deferDestruction(std::function<void()> deleter) {
+            deferredDeleters_.push_back(std::move(deleter));
+        }
+
+        // NOTE: Must be added to the last submission of the frame.
+        inline GPUQueueSubmitDescription::SignalTimelineSemaphoreInfo getTimelineSignal() const {
+            return {.semaphore = timeline_,
+                    .value = timelineValue_,
+                    .signalStage = PipelineStage::AllCommands};
+        }
+
+        inline uint64_t getFrameNumber() const { return timelineValue_; }
+
+        inline uint32_t getFrameIndex() const { return frameIndex_; }
+
+        inline uint64_t getTimelineValue() const { return timelineValue_; }
+
+        // NOTE: Timestamp the GPU work of the frame, the beginning into the first command buffer
+        // submitted and the end into the last one, both outside of rendering and on the same
+        // queue. Do nothing on devices without timestamp support.
+        void beginGPUTiming(ICommandBuffer& commandBuffer);
+        void endGPUTiming(ICommandBuffer& commandBuffer);
+
+      private:
+        friend class FrameScheduler;
+
+        void recycle() {
+            uploadArena_.reset();
+            deferredResources_.clear();
+            for (auto& deleter : deferredDeleters_) {
+                deleter();
+            }
+            deferredDeleters_.clear();
+            gpuTimingBegun_ = false;
+            gpuTimingEnded_ = false;
+        }
+
+        CommandPoolManager* commandPools_;
+        IGPUTimelineSemaphore* timeline_ = nullptr;
+        // NOTE: Shared by every frame, each slot owns two queries at twice its index.
+        IQueryPool* timestampQueries_ = nullptr;
+        bool gpuTimingBegun_ = false;
+        bool gpuTimingEnded_ = false;
+
+        uint32_t frameIndex_ = 0;
+        uint64_t timelineValue_ = 0;
+
+        LinearAllocator uploadArena_;
+        std::vector<std::unique_ptr<IGPUResource>> deferredResources_;
+        std::vector<std::function<void()>> deferredDeleters_;
+
+        std::chrono::steady_clock::time_point submitTime_;
+    };
+
+    // NOTE: Paces frames with a single timeline semaphore, frame N signals value N. Beginning a
+    // frame only waits for the frame that used the same slot, never for the whole device. Every
+    // frame must signal its value, frames without work submit an empty submission doing so.
+    // It also drives the device's deferred destruction, resources destroyed while recording frame N
+    // are destroyed once value N is reached.
+    class FrameScheduler {
+      public:
+        FrameScheduler(IGPUDevice& device, const FrameSchedulerDescription& description);
+        // NOTE: Waits for the frames still in flight, up to the shutdown timeout. On timeout their
+        // command buffers, timestamp queries, upload arenas and deferred resources are leaked
+        // instead of freed.
+        ~FrameScheduler() noexcept;
+
+        FrameScheduler(const FrameScheduler&) = delete;
+        FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+        FrameScheduler(FrameScheduler&&) = delete;
+        FrameScheduler& operator=(FrameScheduler&&) = delete;
+
+        FrameContext& beginFrame();
+        void endFrame();
+
+        inline IGPUTimelineSemaphore& getTimeline() { return *timeline_; }
+
+        inline uint32_t getFramesInFlight() const {
+            return static_cast<uint32_t>(frames_.size());
+        }
+
+        inline const FrameTimings& getLastFrameTimings() const { return lastTimings_; }
+
+        // NOTE: Exponential moving average, weights the last frame by a tenth.
+        inline const FrameTimings& getAverageFrameTimings() const { return averageTimings_; }
+
+      private:
+        void recordTimings(const FrameTimings& timings);
+        std::chrono::nanoseconds readGPUTime(const FrameContext& frame) const;
+
+        IGPUDevice* device_;
+
+        std::unique_ptr<IGPUTimelineSemaphore> timeline_;
+        // NOTE: Null on devices without timestamp support.
+        std::unique_ptr<IQueryPool> timestampQueries_;
+        CommandPoolManager commandPools_;
+
+        std::vector<FrameContext> frames_;
+        FrameContext* currentFrame_ = nullptr;
+        uint64_t frameCount_ = 0;
+        std::chrono::nanoseconds shutdownTimeout_;
+
+        std::chrono::steady_clock::time_point frameBeginTime_;
+        FrameTimings pendingTimings_;
+        FrameTimings lastTimings_;
+        FrameTimings averageTimings_;
+    };
+}  // namespace aetherion
@@ -1,19 +1,49 @@
 #pragma once
 
+#include <array>
 #include <functional>
+#include <span>
 
 #include "aetherion/gpu/backend/device.hpp"
 #include "aetherion/gpu/backend/driver.hpp"
+#include "aetherion/gpu/backend/queue.hpp"
+#include "aetherion/gpu/queue_ownership.hpp"
 
 namespace aetherion {
     using QueueSelectionFunctor = std::function<std::vector<GPUQueueFamilyDescription>(
         const IGPUPhysicalDevice& physicalDevice)>;
 
+    enum class GPUQueueRole : size_t { Graphics, Compute, Transfer };
+
+    constexpr size_t GPU_QUEUE_ROLE_COUNT = 3;
+
+    struct GPUQueueFamilyAssignment {
+        uint32_t graphicsFamilyIndex;
+        uint32_t computeFamilyIndex;
+        uint32_t transferFamilyIndex;
+    };
+
+    // NOTE: Prefers a compute family without graphics for the compute role and a family with
+    // neither graphics nor compute for the transfer role, falling back to the more general
+    // families when the candidates have no dedicated one. The graphics family must support
+    // presentation when the physical device was picked for a primary window.
+    GPUQueueFamilyAssignment assignGPUQueueFamilies(
+        const IGPUPhysicalDevice& physicalDevice,
+        std::span<const GPUQueueFamilyDescription> candidates);
+
+    // NOTE: Default queue selection, one queue from the graphics family and from the dedicated
+    // compute and transfer families when the device has them.
+    std::vector<GPUQueueFamilyDescription> selectDedicatedGPUQueueFamilies(
+        const IGPUPhysicalDevice& physicalDevice);
+
+    // NOTE: Set GPUDriverDescription::headless and leave the primary window empty to run
+    // offscreen-only, without any window system.
     class GPUEngine {
       public:
         GPUEngine(const GPUDriverDescription& driverDescription,
                   const PhysicalGPUDeviceDescription& physicalDeviceDescription,
-                  const QueueSelectionFunctor& queueSelectionFunctor);
+                  const QueueSelectionFunctor& queueSelectionFunctor
+                  = selectDedicatedGPUQueueFamilies);
         ~GPUEngine() noexcept = default;
 
         GPUEngine(const GPUEngine&) = delete;
@@ -31,9 +61,40 @@ namespace aetherion {
         IGPUDevice& getDevice();
         const IGPUDevice& getDevice() const;
 
+        bool isHeadless() const;
+
+        // NOTE: Roles without a dedicated family share the queue of the family they fall back to,
+        // so the returned queues may alias each other.
+        IGPUQueue& getQueue(GPUQueueRole role);
+        uint32_t getQueueFamilyIndex(GPUQueueRole role) const;
+        bool hasDedicatedQueue(GPUQueueRole role) const;
+
+        // NOTE: Work moving between roles of different families needs a queue family ownership
+        // transfer.
+        bool needsOwnershipTransfer(GPUQueueRole src, GPUQueueRole dst) const;
+
+        // NOTE: Thread safe. Records a use of an exclusive resource on the queue of the role and
+        // returns the ownership transfer when it was last used on another family: the release
+        // barrier goes to the previous queue and the acquire barrier to the new one, after a
+        // semaphore wait. Call forgetResource() before destroying tracked resources.
+        std::optional<QueueOwnershipTransferBarriers<BufferBarrierDescription>> useBuffer(
+            IGPUBuffer& buffer, GPUQueueRole role, PipelineStageFlags stageFlags,
+            AccessTypeFlags accessFlags);
+        std::optional<QueueOwnershipTransferBarriers<ImageBarrierDescription>> useImage(
+            IGPUImage& image, GPUQueueRole role, GPUImageLayout layout,
+            PipelineStageFlags stageFlags, AccessTypeFlags accessFlags,
+            const GPUImageSubresourceDescription& subresource = {});
+        void forgetResource(const IGPUResource& resource);
+
       private:
         std::unique_ptr<IGPUDriver> driver_;
         std::unique_ptr<IGPUPhysicalDevice> physicalDevice_;
         std::unique_ptr<IGPUDevice> device_;
+
+        std::vector<std::unique_ptr<IGPUQueue>> queues_;
+        std::array<IGPUQueue*, GPU_QUEUE_ROLE_COUNT> roleQueues_{};
+        std::array<uint32_t, GPU_QUEUE_ROLE_COUNT> roleQueueFamilyIndices_{};
+
+        QueueOwnershipTracker ownershipTracker_;
     };
-}  // namespace aetherion
\ No newline at end of file
+}  // namespace aetherion
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "aetherion/gpu/backend/memory.hpp"
+
+namespace aetherion {
+    enum class GPUMemoryCategory { Other, Texture, Mesh, Transient, Staging };
+    constexpr size_t GPU_MEMORY_CATEGORY_COUNT = 5;
+
+    // NOTE: Must release the resource's memory, possibly deferred. The resource is untracked
+    // before the callback runs.
+    using GPUMemoryEvictionCallback = std::function<void()>;
+
+    struct GPUMemoryBudgetDescription {
+        // NOTE: Fractions of the device local heaps' budget. Eviction starts once usage reaches
+        // the threshold and frees the least recently used resources down to the target.
+        float evictionThreshold = 0.9f;
+        float evictionTarget = 0.8f;
+        // NOTE: Resources used in the last frames are never evicted, the GPU may still read them.
+        uint64_t minUnusedFrames = 2;
+    };
+
+    struct GPUMemoryBudgetReport {
+        std::vector<GPUMemoryHeapBudget> heaps;
+        size_t deviceLocalBudget = 0;
+        size_t deviceLocalUsage = 0;
+        std::array<size_t, GPU_MEMORY_CATEGORY_COUNT> categoryUsage{};
+        size_t evictedSize = 0;  // NOTE: Bytes evicted by the last update.
+        uint32_t evictedCount = 0;
+        // NOTE: Evicted bytes the heap budgets don't show as freed yet, the last update's included.
+        size_t pendingEvictionSize = 0;
+    };
+
+    using GPUMemoryResourceHandle = uint64_t;
+
+    // NOTE: Reports per heap usage and budget once per frame, and tracks resources by category in
+    // least recently used order. When device local usage nears the budget, eviction callbacks of
+    // the least recently used evictable resources fire so streamed data can be dropped before the
+    // driver starts paging. Thread safe, callbacks run on the thread calling update().
+    class GPUMemoryBudget {
+      public:
+        GPUMemoryBudget(IGPUAllocator& allocator, const GPUMemoryBudgetDescription& description);
+        ~GPUMemoryBudget() noexcept = default;
+
+        GPUMemoryBudget(const GPUMemoryBudget&) = delete;
+        GPUMemoryBudget& operator=(const GPUMemoryBudget&) = delete;
+
+        GPUMemoryBudget(GPUMemoryBudget&&) = delete;
+        GPUMemoryBudget& operator=(GPUMemoryBudget&&) = delete;
+
+        // NOTE: Resources without an eviction callback are counted but never evicted.
+        GPUMemoryResourceHandle track(GPUMemoryCategory category, size_t size,
+                                      GPUMemoryEvictionCallback onEvict = {});
+        // NOTE: Unknown handles are ignored, evicted resources are already untracked.
+        void untrack(GPUMemoryResourceHandle handle);
+        // NOTE: Marks the resource as used in the current frame.
+        void touch(GPUMemoryResourceHandle handle);
+
+        // NOTE: Call once per frame, refreshes the allocator's budgets and evicts if needed.
+        // Evicted memory is usually released deferred, so it's subtracted from the reported usage
+        // until the usage drops by as much or the GPU completed the frame it was evicted in, e.g.
+        // the current value of the FrameScheduler's timeline.
+        const GPUMemoryBudgetReport& update(uint64_t frameNumber, uint64_t completedFrameNumber);
+
+        // NOTE: The report of the last update, not synchronized with update().
+        inline const GPUMemoryBudgetReport& getReport() const { return report_; }
+
+        size_t getCategoryUsage(GPUMemoryCategory category) const;
+
+      private:
+        struct Resource {
+            GPUMemoryResourceHandle handle;
+            GPUMemoryCategory category;
+            size_t size;
+            uint64_t lastUsedFrame;
+            GPUMemoryEvictionCallback onEvict;
+        };
+
+        struct PendingEviction {
+            size_t size;
+            uint64_t frameNumber;
+        };
+
+        IGPUAllocator* allocator_;
+
+        float evictionThreshold_;
+        float evictionTarget_;
+        uint64_t minUnusedFrames_;
+
+        mutable std::mutex mutex_;
+        // NOTE: Least recently used first.
+        std::list<Resource> resources_;
+        std::unordered_map<GPUMemoryResourceHandle, std::list<Resource>::iterator> handles_;
+        std::array<size_t, GPU_MEMORY_CATEGORY_COUNT> categoryUsage_{};
+        GPUMemoryResourceHandle nextHandle_ = 1;
+        uint64_t frameNumber_ = 0;
+
+        // NOTE: Oldest first, settled against the usage of the previous update.
+        std::vector<PendingEviction> pendingEvictions_;
+        size_t lastDeviceLocalUsage_ = 0;
+
+        GPUMemoryBudgetReport report_;
+    };
+}  // namespace aetherion
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <functional>
+
+#include "aetherion/gpu/backend/command_buffer.hpp"
+
+namespace aetherion {
+    // Forward declarations
+    class CommandPoolManager;
+    class ThreadPool;
+
+    // NOTE: Records items [firstItem, firstItem + itemCount) into a secondary command buffer.
+    // Secondary command buffers don't inherit dynamic state, so viewports, scissors and pipelines
+    // must be set again by every call.
+    using ParallelRecordFunctor
+        = std::function<void(ICommandBuffer& commandBuffer, size_t firstItem, size_t itemCount)>;
+
+    struct ParallelRecordDescription {
+        CommandBufferInheritanceDescription inheritance;
+        CommandBufferUsageFlags usage = CommandBufferUsage::OneTimeSubmit;
+        size_t minItemsPerChunk = 64;  // NOTE: Keeps small lists from paying the fork overhead.
+    };
+
+    // NOTE: Splits a draw list across the worker threads, one secondary command buffer per chunk,
+    // and executes the chunks in item order. Secondary command buffers come from the per-thread
+    // pools of the command pool manager, so the workers never share a pool.
+    class ParallelCommandRecorder {
+      public:
+        ParallelCommandRecorder(CommandPoolManager& commandPools, ThreadPool& workers);
+        ~ParallelCommandRecorder() noexcept = default;
+
+        ParallelCommandRecorder(const ParallelCommandRecorder&) = delete;
+        ParallelCommandRecorder& operator=(const ParallelCommandRecorder&) = delete;
+
+        ParallelCommandRecorder(ParallelCommandRecorder&&) = delete;
+        ParallelCommandRecorder& operator=(ParallelCommandRecorder&&) = delete;
+
+        // NOTE: The primary command buffer must be inside a pass begun with
+        // RenderDescription::secondaryCommandBuffers. Blocks until every chunk is recorded and
+        // rethrows the first recording error.
+        void record(ICommandBuffer& primaryCommandBuffer, size_t itemCount,
+                    const ParallelRecordFunctor& functor,
+                    const ParallelRecordDescription& description);
+
+      private:
+        CommandPoolManager* commandPools_;
+        ThreadPool* workers_;
+    };
+}  // namespace aetherion
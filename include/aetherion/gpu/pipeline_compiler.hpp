@@ -0,0 +1,75 @@
+#pragma once
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "aetherion/gpu/backend/pipeline.hpp"
+#include "aetherion/util/thread_pool.hpp"
+
+namespace aetherion {
+    // Forward declarations
+    class IGPUDevice;
+
+    struct PipelineCompilerDescription {
+        uint32_t workerCount = 0;  // NOTE: Zero uses one worker per hardware thread but one.
+    };
+
+    class PipelineCompileHandle {
+      public:
+        PipelineCompileHandle() = default;
+        explicit PipelineCompileHandle(std::future<std::unique_ptr<IPipeline>> future)
+            : future_(std::move(future)) {}
+
+        // NOTE: Never blocks, meant to be polled once per frame.
+        bool isReady() const {
+            return future_.valid()
+                   && future_.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        }
+
+        // NOTE: Blocks until the pipeline is compiled and rethrows compilation errors. The handle
+        // is invalid afterwards.
+        std::unique_ptr<IPipeline> get() { return future_.get(); }
+
+        void wait() const { future_.wait(); }
+
+        inline bool isValid() const { return future_.valid(); }
+
+      private:
+        std::future<std::unique_ptr<IPipeline>> future_;
+    };
+
+    // NOTE: Compiles pipelines on a worker pool through the device, so every worker shares the
+    // device pipeline cache. Shaders and layouts referenced by queued descriptions must outlive
+    // their compilation.
+    class PipelineCompiler {
+      public:
+        PipelineCompiler(IGPUDevice& device, const PipelineCompilerDescription& description = {});
+        ~PipelineCompiler() noexcept = default;
+
+        PipelineCompiler(const PipelineCompiler&) = delete;
+        PipelineCompiler& operator=(const PipelineCompiler&) = delete;
+
+        PipelineCompiler(PipelineCompiler&&) = delete;
+        PipelineCompiler& operator=(PipelineCompiler&&) = delete;
+
+        PipelineCompileHandle compile(const GraphicsPipelineDescription& description);
+        PipelineCompileHandle compile(const ComputePipelineDescription& description);
+
+        std::vector<PipelineCompileHandle> compile(
+            std::span<const GraphicsPipelineDescription> descriptions);
+        std::vector<PipelineCompileHandle> compile(
+            std::span<const ComputePipelineDescription> descriptions);
+
+        inline uint32_t getWorkerCount() const { return workers_.getThreadCount(); }
+
+        inline size_t getPendingCount() const { return workers_.getPendingTaskCount(); }
+
+      private:
+        IGPUDevice* device_;
+
+        ThreadPool workers_;
+    };
+}  // namespace aetherion
\ No newline at end of file
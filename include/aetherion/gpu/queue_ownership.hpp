@@ -0,0 +1,80 @@
+#pragma once
+
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include "aetherion/gpu/backend/command_buffer.hpp"
+
+namespace aetherion {
+    struct QueueOwnershipTransferDescription {
+        uint32_t srcQueueFamilyIndex;
+        PipelineStageFlags srcStageFlags = {};
+        AccessTypeFlags srcAccessFlags = {};
+        uint32_t dstQueueFamilyIndex;
+        PipelineStageFlags dstStageFlags = {};
+        AccessTypeFlags dstAccessFlags = {};
+    };
+
+    // NOTE: The release barrier is recorded on the source queue and the acquire barrier on the
+    // destination queue, whose submission must wait on a semaphore signaled after the release.
+    template <typename Barrier> struct QueueOwnershipTransferBarriers {
+        Barrier releaseBarrier;
+        // NOTE: Empty when both families are the same, the release barrier is then a regular
+        // barrier covering both scopes.
+        std::optional<Barrier> acquireBarrier;
+    };
+
+    QueueOwnershipTransferBarriers<BufferBarrierDescription> createBufferOwnershipTransfer(
+        IGPUBuffer& buffer, const QueueOwnershipTransferDescription& description,
+        uint32_t offset = 0, uint32_t size = 0);
+
+    // NOTE: Both halves perform the same layout transition, as Vulkan requires.
+    QueueOwnershipTransferBarriers<ImageBarrierDescription> createImageOwnershipTransfer(
+        IGPUImage& image, GPUImageLayout oldLayout, GPUImageLayout newLayout,
+        const QueueOwnershipTransferDescription& description,
+        const GPUImageSubresourceDescription& subresource = {});
+
+    struct QueueOwnershipAccessDescription {
+        uint32_t queueFamilyIndex;
+        PipelineStageFlags stageFlags = {};
+        AccessTypeFlags accessFlags = {};
+    };
+
+    // NOTE: Tracks the queue family owning each exclusive resource, so the ownership transfers are
+    // generated from the uses instead of recorded by hand. Concurrent resources never need them and
+    // shouldn't be tracked.
+    class QueueOwnershipTracker {
+      public:
+        QueueOwnershipTracker() = default;
+        ~QueueOwnershipTracker() noexcept = default;
+
+        QueueOwnershipTracker(const QueueOwnershipTracker&) = delete;
+        QueueOwnershipTracker& operator=(const QueueOwnershipTracker&) = delete;
+
+        QueueOwnershipTracker(QueueOwnershipTracker&&) = delete;
+        QueueOwnershipTracker& operator=(QueueOwnershipTracker&&) = delete;
+
+        // NOTE: Thread safe. Records the use and returns the transfer when the previous use was on
+        // another family, nothing on the first use or while the family doesn't change.
+        std::optional<QueueOwnershipTransferBarriers<BufferBarrierDescription>> useBuffer(
+            IGPUBuffer& buffer, const QueueOwnershipAccessDescription& access);
+        // NOTE: Thread safe. The transfer also transitions the image from the layout of the
+        // previous use.
+        std::optional<QueueOwnershipTransferBarriers<ImageBarrierDescription>> useImage(
+            IGPUImage& image, GPUImageLayout layout, const QueueOwnershipAccessDescription& access,
+            const GPUImageSubresourceDescription& subresource = {});
+
+        // NOTE: Thread safe. Must be called before the resource is destroyed.
+        void forget(const IGPUResource& resource);
+
+      private:
+        struct Owner {
+            QueueOwnershipAccessDescription access;
+            GPUImageLayout layout = GPUImageLayout::Undefined;
+        };
+
+        std::mutex mutex_;
+        std::unordered_map<const IGPUResource*, Owner> owners_;
+    };
+}  // namespace aetherion
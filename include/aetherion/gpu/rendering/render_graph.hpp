@@ -0,0 +1,304 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "aetherion/gpu/backend/buffer.hpp"
+#include "aetherion/gpu/backend/command_buffer.hpp"
+#include "aetherion/gpu/backend/image.hpp"
+#include "aetherion/gpu/backend/queue.hpp"
+#include "aetherion/gpu/transient_memory_planner.hpp"
+
+namespace aetherion {
+    // Forward declarations
+    class IGPUDevice;
+    class IGPUAllocator;
+    class IGPUTimelineSemaphore;
+    class RenderGraph;
+
+    // NOTE: Async compute passes run on the compute queue when the graph has one, on the graphics
+    // queue otherwise, so they may only record compute and transfer commands.
+    enum class RenderGraphQueue { Graphics, AsyncCompute };
+
+    enum class RenderGraphAccess {
+        IndirectBuffer,
+        IndexBuffer,
+        VertexBuffer,
+        VertexShaderUniformRead,
+        VertexShaderRead,
+        FragmentShaderUniformRead,
+        FragmentShaderRead,
+        ComputeShaderUniformRead,
+        ComputeShaderRead,
+        ComputeShaderStorageRead,
+        ComputeShaderStorageWrite,
+        ComputeShaderStorageReadWrite,
+        ColorAttachmentWrite,
+        ColorAttachmentReadWrite,
+        DepthStencilAttachmentRead,
+        DepthStencilAttachmentWrite,
+        TransferRead,
+        TransferWrite,
+        Present
+    };
+
+    struct RenderGraphAccessDescription {
+        PipelineStageFlags stageFlags = {};
+        AccessTypeFlags accessFlags = {};
+        GPUImageLayout layout = GPUImageLayout::Undefined;  // NOTE: Ignored for buffers.
+    };
+
+    RenderGraphAccessDescription getRenderGraphAccessDescription(RenderGraphAccess access);
+
+    struct RenderGraphImageHandle {
+        uint32_t index;
+    };
+
+    struct RenderGraphBufferHandle {
+        uint32_t index;
+    };
+
+    struct RenderGraphImportDescription {
+        // NOTE: The access preceding every execution, the layout the image is in when it starts.
+        RenderGraphAccessDescription initialAccess = {};
+        // NOTE: The access following every execution, empty to leave the resource as the last pass
+        // does.
+        std::optional<RenderGraphAccessDescription> finalAccess;
+        GPUImageSubresourceDescription subresource = {};  // NOTE: Ignored for buffers.
+        // NOTE: Exclusive resources are owned by the graphics queue family outside the graph, and
+        // transferred to the compute family and back around async compute passes.
+        SharingMode sharingMode = SharingMode::Exclusive;
+    };
+
+    struct RenderGraphDescription {
+        TransientMemoryPlannerDescription transientMemory = {};
+        uint32_t graphicsQueueFamilyIndex = 0;
+        // NOTE: QUEUE_FAMILY_IGNORED runs async compute passes on the graphics queue.
+        uint32_t computeQueueFamilyIndex = QUEUE_FAMILY_IGNORED;
+    };
+
+    // NOTE: Returns a primary command buffer ready to begin, allocated from a pool of the queue's
+    // family.
+    using RenderGraphCommandBufferFunctor = std::function<ICommandBuffer&(RenderGraphQueue queue)>;
+
+    struct RenderGraphSubmitDescription {
+        IGPUQueue* graphicsQueue;
+        IGPUQueue* computeQueue = nullptr;  // NOTE: Required if the graph has a compute queue.
+        RenderGraphCommandBufferFunctor acquireCommandBuffer;
+        // NOTE: Binary semaphores are waited by the first submission, timeline semaphores by the
+        // first submission of each queue.
+        std::vector<GPUQueueSubmitDescription::WaitBinarySemaphoreInfo> waitBinarySemaphores = {};
+        std::vector<GPUQueueSubmitDescription::WaitTimelineSemaphoreInfo> waitTimelineSemaphores
+            = {};
+        // NOTE: Signaled by the last submission, on the graphics queue, which waits for every
+        // other one.
+        std::vector<GPUQueueSubmitDescription::SignalBinarySemaphoreInfo> signalBinarySemaphores
+            = {};
+        std::vector<GPUQueueSubmitDescription::SignalTimelineSemaphoreInfo>
+            signalTimelineSemaphores = {};
+    };
+
+    using RenderGraphExecuteFunctor
+        = std::function<void(ICommandBuffer& commandBuffer, const RenderGraph& graph)>;
+
+    class RenderGraphPassBuilder {
+      public:
+        // NOTE: A pass accessing a resource more than once gets the union of the accesses, which
+        // must use the same layout.
+        RenderGraphPassBuilder& read(RenderGraphImageHandle image, RenderGraphAccess access);
+        RenderGraphPassBuilder& read(RenderGraphImageHandle image,
+                                     const RenderGraphAccessDescription& access);
+        RenderGraphPassBuilder& read(RenderGraphBufferHandle buffer, RenderGraphAccess access);
+        RenderGraphPassBuilder& read(RenderGraphBufferHandle buffer,
+                                     const RenderGraphAccessDescription& access);
+
+        RenderGraphPassBuilder& write(RenderGraphImageHandle image, RenderGraphAccess access);
+        RenderGraphPassBuilder& write(RenderGraphImageHandle image,
+                                      const RenderGraphAccessDescription& access);
+        RenderGraphPassBuilder& write(RenderGraphBufferHandle buffer, RenderGraphAccess access);
+        RenderGraphPassBuilder& write(RenderGraphBufferHandle buffer,
+                                      const RenderGraphAccessDescription& access);
+
+        // NOTE: Keeps the pass even if nothing reads what it writes, e.g. readbacks to the host.
+        RenderGraphPassBuilder& setSideEffects();
+
+        RenderGraphPassBuilder& setQueue(RenderGraphQueue queue);
+
+      private:
+        friend class RenderGraph;
+
+        RenderGraphPassBuilder(RenderGraph& graph, uint32_t pass);
+
+        RenderGraphPassBuilder& addAccess(uint32_t resource, bool image,
+                                          const RenderGraphAccessDescription& access, bool write);
+
+        RenderGraph* graph_;
+        uint32_t pass_;
+    };
+
+    // NOTE: Passes execute in the order they are added. Passes whose writes are never read by a
+    // later pass, an imported resource or a pass with side effects are culled. Barriers are
+    // computed once by compile(), one batch before each pass with buffer and same layout image
+    // hazards merged into a single memory barrier, and layout transitions as image barriers.
+    // Consecutive passes on the same queue form a submission, submissions wait on the timeline of
+    // the other queue only for the resources they share, so async compute overlaps graphics work.
+    class RenderGraph {
+      public:
+        RenderGraph(IGPUDevice& device, IGPUAllocator& allocator,
+                    const RenderGraphDescription& description = {});
+        ~RenderGraph() noexcept;
+
+        RenderGraph(const RenderGraph&) = delete;
+        RenderGraph& operator=(const RenderGraph&) = delete;
+
+        RenderGraph(RenderGraph&&) = delete;
+        RenderGraph& operator=(RenderGraph&&) = delete;
+
+        RenderGraphImageHandle importImage(IGPUImage& image,
+                                           const RenderGraphImportDescription& description);
+        RenderGraphBufferHandle importBuffer(IGPUBuffer& buffer,
+                                             const RenderGraphImportDescription& description);
+
+        // NOTE: Rebinds an imported resource without compiling again, e.g. to the acquired
+        // swapchain image. The new resource must be in the same state.
+        void setImage(RenderGraphImageHandle image, IGPUImage& gpuImage);
+        void setBuffer(RenderGraphBufferHandle buffer, IGPUBuffer& gpuBuffer);
+
+        // NOTE: Transient resources are created by compile() with aliased memory, their contents
+        // are undefined at their first use in every execution.
+        RenderGraphImageHandle createImage(const GPUImageDescription& description,
+                                           GPUImageAspectFlags aspectMask
+                                           = GPUImageAspect::Color);
+        RenderGraphBufferHandle createBuffer(const GPUBufferDescription& description);
+
+        RenderGraphPassBuilder addPass(std::string_view name, RenderGraphExecuteFunctor execute);
+
+        // NOTE: Compiling again destroys the previous transient resources, the GPU must be done
+        // with them.
+        void compile();
+        // NOTE: Records into a single command buffer, only for graphs without async compute
+        // submissions.
+        void execute(ICommandBuffer& commandBuffer);
+        void submit(const RenderGraphSubmitDescription& description);
+
+        // NOTE: Culled transient resources aren't created.
+        IGPUImage& getImage(RenderGraphImageHandle image) const;
+        IGPUBuffer& getBuffer(RenderGraphBufferHandle buffer) const;
+
+        inline bool isPassCulled(uint32_t pass) const { return passes_.at(pass).culled; }
+
+        inline size_t getSubmissionCount() const { return batches_.size(); }
+
+        inline const TransientMemoryPlan& getTransientMemoryPlan() const {
+            return transientMemory_;
+        }
+
+      private:
+        friend class RenderGraphPassBuilder;
+
+        struct Resource {
+            bool isImage;
+            bool imported;
+            IGPUImage* image = nullptr;
+            IGPUBuffer* buffer = nullptr;
+            GPUImageDescription imageDescription = {};    // NOTE: Transient images only.
+            GPUBufferDescription bufferDescription = {};  // NOTE: Transient buffers only.
+            GPUImageSubresourceDescription subresource = {};
+            SharingMode sharingMode = SharingMode::Exclusive;
+            RenderGraphAccessDescription initialAccess = {};
+            std::optional<RenderGraphAccessDescription> finalAccess = {};
+        };
+
+        struct ResourceAccess {
+            uint32_t resource;
+            RenderGraphAccessDescription access;
+            bool read;
+            bool write;
+        };
+
+        struct BarrierBatch {
+            GeneralMemoryBarrierDescription memoryBarrier = {};
+            std::vector<BufferBarrierDescription> bufferBarriers;  // NOTE: Ownership transfers.
+            std::vector<ImageBarrierDescription> imageBarriers;
+            // NOTE: Resolved into the barriers on execution, imported resources may be rebound.
+            std::vector<uint32_t> bufferResources;
+            std::vector<uint32_t> imageResources;
+        };
+
+        struct Pass {
+            std::string name;
+            RenderGraphExecuteFunctor execute;
+            std::vector<ResourceAccess> accesses = {};
+            bool sideEffects = false;
+            bool culled = false;
+            RenderGraphQueue queue = RenderGraphQueue::Graphics;
+            BarrierBatch barriers = {};
+        };
+
+        struct Batch {
+            RenderGraphQueue queue;
+            std::vector<uint32_t> passes = {};
+            // NOTE: Latest batch of the other queue this one waits for, possibly from the previous
+            // execution.
+            std::optional<uint32_t> waitBatch = std::nullopt;
+            bool waitPreviousExecution = false;
+            PipelineStageFlags waitStageFlags = {};
+            // NOTE: Ownership releases, recorded after the passes.
+            BarrierBatch releaseBarriers = {};
+        };
+
+        // NOTE: Writes not yet made visible to every access, the reads since the last write and
+        // the accesses the last write is already visible to.
+        struct ResourceState {
+            PipelineStageFlags writeStageFlags = {};
+            AccessTypeFlags writeAccessFlags = {};
+            PipelineStageFlags readStageFlags = {};
+            PipelineStageFlags visibleStageFlags = {};
+            AccessTypeFlags visibleAccessFlags = {};
+            GPUImageLayout layout = GPUImageLayout::Undefined;
+            // NOTE: Last batch accessing the resource. Transient resources start at their last
+            // batch of the previous execution, imported ones at the first batch.
+            RenderGraphQueue queue = RenderGraphQueue::Graphics;
+            uint32_t batch = 0;
+            bool previousExecution = false;
+            bool initial = true;
+        };
+
+        void cullPasses();
+        void scheduleBatches();
+        void createTransientResources();
+        void computeBarriers();
+
+        void addBarrier(BarrierBatch& barriers, ResourceState& state, uint32_t resource,
+                        const RenderGraphAccessDescription& access, bool write, uint32_t batch);
+        void addWait(Batch& batch, const ResourceState& state, PipelineStageFlags stageFlags);
+
+        void recordBatch(ICommandBuffer& commandBuffer, uint32_t batch);
+        void recordBarriers(ICommandBuffer& commandBuffer, BarrierBatch& barriers) const;
+
+        uint32_t getQueueFamilyIndex(RenderGraphQueue queue) const;
+
+        TransientMemoryPlanner transientMemoryPlanner_;
+        TransientMemoryPlan transientMemory_;
+
+        uint32_t graphicsQueueFamilyIndex_;
+        uint32_t computeQueueFamilyIndex_;
+
+        std::vector<Resource> resources_;
+        std::vector<Pass> passes_;
+        std::vector<Batch> batches_;
+        BarrierBatch finalBarriers_;  // NOTE: Recorded at the end of the last batch.
+
+        // NOTE: Indexed by RenderGraphQueue.
+        std::array<std::unique_ptr<IGPUTimelineSemaphore>, 2> timelines_;
+        std::array<uint64_t, 2> timelineValues_ = {};
+        std::vector<uint64_t> batchSignalValues_;
+        std::vector<uint64_t> previousBatchSignalValues_;
+    };
+}  // namespace aetherion
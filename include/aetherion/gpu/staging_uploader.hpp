@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "aetherion/gpu/backend/command_buffer.hpp"
+#include "aetherion/gpu/submission_queue.hpp"
+
+namespace aetherion {
+    // Forward declarations
+    class IGPUDevice;
+    class IGPUAllocator;
+
+    struct StagingUploaderDescription {
+        size_t stagingCapacity = 64 * 1024 * 1024;
+        // NOTE: Family of the submission queue's queue, usually the transfer role's.
+        uint32_t queueFamilyIndex = 0;
+    };
+
+    // NOTE: Destination ownership and scopes. With a different family, the release barrier is
+    // recorded by the uploader and the acquire barrier is returned by flush(), to be recorded on
+    // the destination queue after waiting on the token.
+    struct StagingUploadDestination {
+        uint32_t queueFamilyIndex = QUEUE_FAMILY_IGNORED;  // NOTE: Ignored = uploader's family.
+        PipelineStageFlags stageFlags = {};
+        AccessTypeFlags accessFlags = {};
+    };
+
+    struct BufferUploadDescription {
+        IGPUBuffer* buffer{};
+        size_t offset = 0;
+        std::span<const std::byte> data;
+        StagingUploadDestination destination;
+    };
+
+    // NOTE: Uploads tightly packed texels to one mip level of a range of layers, each subresource
+    // at most once per flush. The alignment must be a multiple of the format's texel block size.
+    struct ImageUploadDescription {
+        IGPUImage* image{};
+        std::span<const std::byte> data;
+        GPUImageAspectFlags aspectMask = GPUImageAspect::Color;
+        uint32_t mipLevel = 0;
+        uint32_t baseArrayLayer = 0;
+        uint32_t layerCount = 1;
+        Offset3Di offset;
+        Extent3Du extent;
+        size_t alignment = 16;
+        GPUImageLayout oldLayout = GPUImageLayout::Undefined;
+        GPUImageLayout newLayout = GPUImageLayout::ShaderReadOnlyOptimal;
+        StagingUploadDestination destination;
+    };
+
+    struct StagingUploadResult {
+        SubmissionToken token;
+        // NOTE: Acquire halves of ownership transfers to other queue families.
+        std::vector<BufferBarrierDescription> acquireBufferBarriers;
+        std::vector<ImageBarrierDescription> acquireImageBarriers;
+    };
+
+    // NOTE: Copies upload data into a persistently mapped staging ring as it's enqueued, and
+    // records every pending upload into a single command buffer on flush(). Uploads to the same
+    // buffer, or the same image, become one copy command, and regions that are adjacent in both
+    // the staging ring and the destination are merged into one region. Staging memory is reused
+    // once the batch that read it completes. Overlapping uploads within one flush aren't ordered.
+    // Not thread safe.
+    class StagingUploader {
+      public:
+        StagingUploader(IGPUDevice& device, IGPUAllocator& allocator,
+                        SubmissionQueue& submissionQueue,
+                        const StagingUploaderDescription& description);
+        // NOTE: Flushes pending uploads and waits for every batch.
+        ~StagingUploader() noexcept;
+
+        StagingUploader(const StagingUploader&) = delete;
+        StagingUploader& operator=(const StagingUploader&) = delete;
+
+        StagingUploader(StagingUploader&&) = delete;
+        StagingUploader& operator=(StagingUploader&&) = delete;
+
+        // NOTE: The data is copied right away. Blocks while the staging ring is full, flushing
+        // pending uploads if needed.
+        void enqueue(const BufferUploadDescription& description);
+        void enqueue(const ImageUploadDescription& description);
+
+        // NOTE: Returns an invalid token when nothing was pending. The result also covers uploads
+        // flushed early because the staging ring was full.
+        StagingUploadResult flush();
+
+        inline bool hasPendingUploads() const {
+            return !pendingBufferUploads_.empty() || !pendingImageUploads_.empty();
+        }
+
+        inline size_t getStagingCapacity() const { return stagingCapacity_; }
+
+      private:
+        struct PendingBufferUpload {
+            IGPUBuffer* buffer;
+            size_t stagingOffset;
+            size_t offset;
+            size_t size;
+            StagingUploadDestination destination;
+        };
+
+        struct PendingImageUpload {
+            ImageUploadDescription description;  // NOTE: Without its data.
+            size_t stagingOffset;
+            size_t stagingSize;
+        };
+
+        struct Batch {
+            std::unique_ptr<ICommandBuffer> commandBuffer;
+            SubmissionToken token;
+            size_t stagingSize;
+        };
+
+        std::optional<size_t> tryAllocateStaging(size_t size, size_t alignment);
+        size_t allocateStaging(size_t size, size_t alignment);
+        void retireBatches(bool waitForOldest);
+
+        StagingUploadResult submitPendingUploads();
+        void recordImageUploads(ICommandBuffer& commandBuffer, StagingUploadResult& result);
+        void recordBufferUploads(ICommandBuffer& commandBuffer, StagingUploadResult& result);
+
+        IGPUDevice* device_;
+        SubmissionQueue* submissionQueue_;
+
+        uint32_t queueFamilyIndex_;
+
+        std::unique_ptr<IGPUBuffer> stagingBuffer_;
+        std::span<std::byte> stagingData_;
+        size_t stagingCapacity_;
+        size_t stagingHead_ = 0;
+        size_t stagingUsed_ = 0;  // NOTE: Bytes used by in flight batches and pending uploads.
+        size_t pendingStagingSize_ = 0;
+
+        std::unique_ptr<ICommandPool> commandPool_;
+        std::vector<std::unique_ptr<ICommandBuffer>> freeCommandBuffers_;
+
+        std::vector<PendingBufferUpload> pendingBufferUploads_;
+        std::vector<PendingImageUpload> pendingImageUploads_;
+        std::deque<Batch> batches_;
+
+        // NOTE: Acquire barriers of batches flushed early, handed out by the next flush().
+        StagingUploadResult earlyResult_;
+    };
+}  // namespace aetherion
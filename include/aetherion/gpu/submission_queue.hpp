@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "aetherion/gpu/backend/queue.hpp"
+
+namespace aetherion {
+    // Forward declarations
+    class IGPUDevice;
+
+    // NOTE: Completion token of a submission, the value its submission queue timeline is signaled
+    // with.
+    class SubmissionToken {
+      public:
+        SubmissionToken() = default;
+        SubmissionToken(IGPUTimelineSemaphore& timeline, uint64_t value)
+            : timeline_(&timeline), value_(value) {}
+
+        bool isComplete() const;
+        void wait(uint64_t timeout = std::numeric_limits<uint64_t>::max()) const;
+
+        inline bool isValid() const { return timeline_ != nullptr; }
+
+        inline IGPUTimelineSemaphore* getTimeline() const { return timeline_; }
+
+        inline uint64_t getValue() const { return value_; }
+
+      private:
+        IGPUTimelineSemaphore* timeline_ = nullptr;
+        uint64_t value_ = 0;
+    };
+
+    // NOTE: Collects submissions from any number of threads in a lock-free queue and hands them to
+    // the driver from a dedicated thread, coalescing everything queued since the last submit into
+    // a single call. Every submission signals the next value of the queue timeline, and they reach
+    // the driver in value order. The submit thread owns the queue, nothing else may submit to it.
+    class SubmissionQueue {
+      public:
+        SubmissionQueue(IGPUDevice& device, IGPUQueue& queue);
+        // NOTE: Submits everything still queued before stopping the submit thread.
+        ~SubmissionQueue() noexcept;
+
+        SubmissionQueue(const SubmissionQueue&) = delete;
+        SubmissionQueue& operator=(const SubmissionQueue&) = delete;
+
+        SubmissionQueue(SubmissionQueue&&) = delete;
+        SubmissionQueue& operator=(SubmissionQueue&&) = delete;
+
+        // NOTE: Thread safe. Everything the description references must stay alive until the
+        // token completes. Fences aren't supported, wait on the token instead. Rethrows errors of
+        // earlier submits.
+        SubmissionToken submit(GPUQueueSubmitDescription description);
+
+        // NOTE: Blocks until everything submitted so far has been handed to the driver.
+        void flush();
+
+        inline IGPUTimelineSemaphore& getTimeline() { return *timeline_; }
+
+        inline uint64_t getLastSubmittedValue() const {
+            return submittedValue_.load(std::memory_order_acquire);
+        }
+
+      private:
+        struct Submission {
+            GPUQueueSubmitDescription description;
+            uint64_t timelineValue;
+            Submission* next;
+        };
+
+        void submitLoop();
+        void rethrowSubmitError();
+
+        IGPUQueue* queue_;
+        std::unique_ptr<IGPUTimelineSemaphore> timeline_;
+
+        std::atomic<uint64_t> nextValue_{1};
+        std::atomic<uint64_t> submittedValue_{0};
+
+        std::atomic<Submission*> submissions_{nullptr};
+        std::atomic<uint64_t> pushCount_{0};
+        std::atomic<bool> stopping_{false};
+
+        std::mutex errorMutex_;
+        std::exception_ptr submitError_;
+
+        std::thread submitThread_;
+    };
+}  // namespace aetherion
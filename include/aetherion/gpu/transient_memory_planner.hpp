@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "aetherion/gpu/backend/buffer.hpp"
+#include "aetherion/gpu/backend/image.hpp"
+#include "aetherion/gpu/backend/memory.hpp"
+
+namespace aetherion {
+    // Forward declarations
+    class IGPUDevice;
+
+    // NOTE: Uses are indices in execution order, e.g. render graph pass indices. Both ends are
+    // inclusive.
+    struct TransientImageDescription {
+        GPUImageDescription description;
+        uint32_t firstUse = 0;
+        uint32_t lastUse = 0;
+    };
+
+    struct TransientBufferDescription {
+        GPUBufferDescription description;
+        uint32_t firstUse = 0;
+        uint32_t lastUse = 0;
+    };
+
+    struct TransientMemoryPlannerDescription {
+        GPUAllocationDescription allocationDescription = {.memoryUsage = MemoryUsage::PreferGpu};
+        // NOTE: Without aliasing every resource gets its own range, useful to rule out aliasing
+        // issues.
+        bool aliasingEnabled = true;
+    };
+
+    struct TransientMemoryPlan {
+        // NOTE: Same order as the descriptions. Aliased resources have undefined contents at
+        // their first use, images must be transitioned from the undefined layout.
+        std::vector<std::unique_ptr<IGPUImage>> images;
+        std::vector<std::unique_ptr<IGPUBuffer>> buffers;
+        std::vector<std::unique_ptr<IGPUAllocation>> allocations;
+
+        size_t sizeWithoutAliasing = 0;  // NOTE: Sum of every resource's size.
+        size_t sizeWithAliasing = 0;     // NOTE: Sum of the allocations' sizes.
+        size_t peakLiveSize = 0;         // NOTE: Largest sum of simultaneously live resources.
+    };
+
+    // NOTE: Places transient resources whose lifetimes don't overlap in the same memory. Resources
+    // are grouped by kind and compatible memory types, each group becoming one allocation, and
+    // placed largest first at the lowest offset that doesn't overlap any resource alive at the
+    // same time. Buffers and images never share an allocation, so buffer-image granularity
+    // doesn't apply.
+    class TransientMemoryPlanner {
+      public:
+        TransientMemoryPlanner(IGPUDevice& device, IGPUAllocator& allocator,
+                               const TransientMemoryPlannerDescription& description);
+        ~TransientMemoryPlanner() noexcept = default;
+
+        TransientMemoryPlanner(const TransientMemoryPlanner&) = delete;
+        TransientMemoryPlanner& operator=(const TransientMemoryPlanner&) = delete;
+
+        TransientMemoryPlanner(TransientMemoryPlanner&&) = delete;
+        TransientMemoryPlanner& operator=(TransientMemoryPlanner&&) = delete;
+
+        TransientMemoryPlan plan(std::span<const TransientImageDescription> images,
+                                 std::span<const TransientBufferDescription> buffers);
+
+      private:
+        struct Resource {
+            size_t index;  // NOTE: Into the image or buffer descriptions.
+            bool image;
+            GPUAllocationMemoryRequirementsDescription memoryRequirements;
+            uint32_t firstUse;
+            uint32_t lastUse;
+            size_t heap = 0;
+            size_t offset = 0;
+        };
+
+        struct Heap {
+            bool image;
+            uint32_t memoryTypeBits;
+            size_t alignment = 1;
+            size_t size = 0;
+            std::vector<const Resource*> resources;
+        };
+
+        void place(Resource& resource, std::vector<Heap>& heaps) const;
+
+        IGPUDevice* device_;
+        IGPUAllocator* allocator_;
+
+        GPUAllocationDescription allocationDescription_;
+        bool aliasingEnabled_;
+    };
+}  // namespace aetherion
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <span>
+
+#include "aetherion/gpu/backend/buffer.hpp"
+#include "aetherion/gpu/backend/memory.hpp"
+
+namespace aetherion {
+    // Forward declarations
+    class IGPUTimelineSemaphore;
+
+    struct TransientRingBufferDescription {
+        size_t frameCapacity = 4 * 1024 * 1024;  // NOTE: Bytes per frame in flight.
+        uint32_t framesInFlight = 2;
+        GPUBufferUsageFlags usages = GPUBufferUsage::Uniform | GPUBufferUsage::Storage
+                                     | GPUBufferUsage::Vertex | GPUBufferUsage::Index
+                                     | GPUBufferUsage::ShaderDeviceAddress;
+        MemoryUsage memoryUsage = MemoryUsage::PreferGpuHostVisible;
+        // NOTE: 256 is the largest uniform and storage buffer offset alignment the spec allows, so
+        // the default is valid for dynamic offsets on every device.
+        size_t minAlignment = 256;
+    };
+
+    struct TransientAllocation {
+        IGPUBuffer* buffer{};
+        size_t offset = 0;
+        size_t size = 0;
+        std::span<std::byte> data;   // NOTE: Mapped memory, written in place.
+        uint64_t deviceAddress = 0;  // NOTE: 0 unless the buffer has ShaderDeviceAddress usage.
+
+        inline uint32_t getDynamicOffset() const { return static_cast<uint32_t>(offset); }
+    };
+
+    // NOTE: Hands out per-frame sub-allocations of one persistently mapped buffer per frame in
+    // flight by bumping an offset, instead of creating a buffer per use. A frame's buffer is
+    // reused once the timeline value of its last use is reached. Bind allocations either through
+    // dynamic descriptors pointing at getBuffer() with the allocation's dynamic offset, or through
+    // their device address.
+    class TransientRingBuffer {
+      public:
+        TransientRingBuffer(IGPUAllocator& allocator, IGPUTimelineSemaphore& timeline,
+                            const TransientRingBufferDescription& description);
+        ~TransientRingBuffer() noexcept;
+
+        TransientRingBuffer(const TransientRingBuffer&) = delete;
+        TransientRingBuffer& operator=(const TransientRingBuffer&) = delete;
+
+        TransientRingBuffer(TransientRingBuffer&&) = delete;
+        TransientRingBuffer& operator=(TransientRingBuffer&&) = delete;
+
+        // NOTE: Moves to the next frame slot, waiting until the GPU has reached the timeline value
+        // of its last use. Must not run concurrently with allocate().
+        void beginFrame();
+        // NOTE: Flushes the written range for memory that isn't host coherent.
+        void endFrame(uint64_t timelineValue);
+
+        // NOTE: Thread safe. Throws when the frame's capacity is exhausted. Alignments must be
+        // powers of two, they are raised to the description's minimum alignment.
+        TransientAllocation allocate(size_t size, size_t alignment = 0);
+
+        // NOTE: The current frame's buffer, to be referenced by dynamic descriptors.
+        inline IGPUBuffer& getBuffer() { return *frames_[frameIndex_].buffer; }
+        inline IGPUBuffer& getBuffer(uint32_t frameIndex) { return *frames_[frameIndex].buffer; }
+
+        inline size_t getFrameCapacity() const { return frameCapacity_; }
+
+        inline size_t getUsedSize() const { return frames_[frameIndex_].offset.load(); }
+
+        inline uint32_t getFrameIndex() const { return frameIndex_; }
+
+        inline uint32_t getFramesInFlight() const { return framesInFlight_; }
+
+      private:
+        struct Frame {
+            std::unique_ptr<IGPUBuffer> buffer;
+            std::span<std::byte> mappedData;
+            uint64_t deviceAddress = 0;
+            std::atomic<size_t> offset = 0;
+            uint64_t timelineValue = 0;
+        };
+
+        IGPUTimelineSemaphore* timeline_;
+
+        size_t frameCapacity_;
+        size_t minAlignment_;
+
+        // NOTE: Frames hold atomics and can't be moved, so they are never reallocated.
+        std::unique_ptr<Frame[]> frames_;
+        uint32_t framesInFlight_;
+        uint32_t frameIndex_ = 0;
+        uint64_t frameCount_ = 0;
+    };
+}  // namespace aetherion
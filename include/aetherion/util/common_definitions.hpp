@@ -16,6 +16,18 @@ namespace aetherion {
     using Offset2Du = Offset2D<uint32_t>;
     using Offset2Df = Offset2D<float>;
 
+    template <typename T> struct Offset3D {
+        static_assert(std::is_integral_v<T> || std::is_floating_point_v<T>,
+                      "Offset3D<T>: T must be an integral or floating point type");
+        T x{};
+        T y{};
+        T z{};
+    };
+
+    using Offset3Di = Offset3D<int32_t>;
+    using Offset3Du = Offset3D<uint32_t>;
+    using Offset3Df = Offset3D<float>;
+
     template <typename T> struct Extent2D {
         static_assert(std::is_integral_v<T> || std::is_floating_point_v<T>,
                       "Extent2D<T>: T must be an integral or floating point type");
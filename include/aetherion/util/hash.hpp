@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+
+namespace aetherion {
+    constexpr uint64_t FNV1A_64_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+    constexpr uint64_t FNV1A_64_PRIME = 0x100000001b3ULL;
+
+    constexpr uint64_t fnv1a64(std::span<const std::byte> data,
+                               uint64_t hash = FNV1A_64_OFFSET_BASIS) noexcept {
+        for (const std::byte byte : data) {
+            hash ^= static_cast<uint64_t>(byte);
+            hash *= FNV1A_64_PRIME;
+        }
+        return hash;
+    }
+
+    constexpr void hashCombine(size_t& seed, size_t value) noexcept {
+        seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    }
+
+    template <typename T> void hashCombine(size_t& seed, const T& value) {
+        hashCombine(seed, std::hash<T>{}(value));
+    }
+}  // namespace aetherion
\ No newline at end of file
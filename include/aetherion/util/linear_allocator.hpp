@@ -0,0 +1,105 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace aetherion {
+    // NOTE: Bump allocator for short lived scratch data. Memory is only reclaimed by reset(), which
+    // also merges all blocks into one, so after warming up it stops touching the heap.
+    class LinearAllocator {
+      public:
+        explicit LinearAllocator(size_t blockSize = 4096) : blockSize_(blockSize) {}
+        ~LinearAllocator() noexcept = default;
+
+        LinearAllocator(const LinearAllocator&) = delete;
+        LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+        LinearAllocator(LinearAllocator&&) noexcept = default;
+        LinearAllocator& operator=(LinearAllocator&&) noexcept = default;
+
+        // NOTE: Elements are default constructed and never destroyed.
+        template <typename T> std::span<T> allocate(size_t count) {
+            static_assert(std::is_trivially_destructible_v<T>,
+                          "LinearAllocator only supports trivially destructible types");
+
+            if (count == 0) {
+                return {};
+            }
+
+            T* data = static_cast<T*>(allocateBytes(sizeof(T) * count, alignof(T)));
+            std::uninitialized_default_construct_n(data, count);
+            return {data, count};
+        }
+
+        void* allocateBytes(size_t size, size_t alignment) {
+            while (currentBlock_ < blocks_.size()) {
+                if (void* data = tryAllocateFromBlock(blocks_[currentBlock_], size, alignment)) {
+                    return data;
+                }
+                ++currentBlock_;
+                offset_ = 0;
+            }
+
+            blocks_.push_back({.data = std::make_unique_for_overwrite<std::byte[]>(
+                                   std::max(blockSize_, size + alignment)),
+                               .size = std::max(blockSize_, size + alignment)});
+            currentBlock_ = blocks_.size() - 1;
+            offset_ = 0;
+            return tryAllocateFromBlock(blocks_[currentBlock_], size, alignment);
+        }
+
+        void reset() {
+            if (blocks_.size() > 1) {
+                size_t capacity = 0;
+                for (const auto& block : blocks_) {
+                    capacity += block.size;
+                }
+
+                blocks_.clear();
+                blocks_.push_back({.data = std::make_unique_for_overwrite<std::byte[]>(capacity),
+                                   .size = capacity});
+            }
+
+            currentBlock_ = 0;
+            offset_ = 0;
+        }
+
+        size_t getCapacity() const {
+            size_t capacity = 0;
+            for (const auto& block : blocks_) {
+                capacity += block.size;
+            }
+            return capacity;
+        }
+
+      private:
+        struct Block {
+            std::unique_ptr<std::byte[]> data;
+            size_t size;
+        };
+
+        void* tryAllocateFromBlock(Block& block, size_t size, size_t alignment) {
+            const auto base = reinterpret_cast<uintptr_t>(block.data.get());
+            const uintptr_t aligned = (base + offset_ + alignment - 1) & ~(alignment - 1);
+            const size_t end = static_cast<size_t>(aligned - base) + size;
+
+            if (end > block.size) {
+                return nullptr;
+            }
+
+            offset_ = end;
+            return reinterpret_cast<void*>(aligned);
+        }
+
+        size_t blockSize_;
+
+        std::vector<Block> blocks_;
+        size_t currentBlock_ = 0;
+        size_t offset_ = 0;
+    };
+}  // namespace aetherion
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace aetherion {
+    class ThreadPool {
+      public:
+        // NOTE: A thread count of zero uses one thread per hardware thread but one, so the calling
+        // thread keeps a core.
+        explicit ThreadPool(uint32_t threadCount = 0) {
+            if (threadCount == 0) {
+                threadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+            }
+
+            threads_.reserve(threadCount);
+            for (uint32_t i = 0; i < threadCount; ++i) {
+                threads_.emplace_back([this]() { workerLoop(); });
+            }
+        }
+
+        // NOTE: Queued tasks are still run before the workers are joined.
+        ~ThreadPool() noexcept {
+            {
+                std::lock_guard lock(mutex_);
+                stopping_ = true;
+            }
+            condition_.notify_all();
+
+            for (auto& thread : threads_) {
+                thread.join();
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        ThreadPool(ThreadPool&&) = delete;
+        ThreadPool& operator=(ThreadPool&&) = delete;
+
+        template <typename Task> std::future<std::invoke_result_t<Task>> submit(Task&& task) {
+            // NOTE: std::function requires copyable targets, so the move-only packaged task is
+            // shared.
+            auto packagedTask = std::make_shared<std::packaged_task<std::invoke_result_t<Task>()>>(
+                std::forward<Task>(task));
+            auto future = packagedTask->get_future();
+
+            {
+                std::lock_guard lock(mutex_);
+                tasks_.emplace_back([packagedTask]() { (*packagedTask)(); });
+            }
+            condition_.notify_one();
+
+            return future;
+        }
+
+        inline uint32_t getThreadCount() const { return static_cast<uint32_t>(threads_.size()); }
+
+        size_t getPendingTaskCount() const {
+            std::lock_guard lock(mutex_);
+            return tasks_.size();
+        }
+
+      private:
+        void workerLoop() {
+            while (true) {
+                std::function<void()> task;
+                {
+                    std::unique_lock lock(mutex_);
+                    condition_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+                    if (tasks_.empty()) {
+                        return;
+                    }
+
+                    task = std::move(tasks_.front());
+                    tasks_.pop_front();
+                }
+                task();
+            }
+        }
+
+        std::vector<std::thread> threads_;
+
+        std::deque<std::function<void()>> tasks_;
+        mutable std::mutex mutex_;
+        std::condition_variable condition_;
+        bool stopping_ = false;
+    };
+}  // namespace aetherion
\ No newline at end of file
@@ -7,5 +7,7 @@ namespace aetherion {
 
     IDescriptorPool::~IDescriptorPool() = default;
 
+    IDescriptorUpdateTemplate::~IDescriptorUpdateTemplate() = default;
+
     IPushConstantRange::~IPushConstantRange() = default;
 }  // namespace aetherion
@@ -1,6 +1,32 @@
 #include "aetherion/gpu/backend/device.hpp"
 
 namespace aetherion {
+    int64_t scorePhysicalGPUDevice(const PhysicalGPUDeviceProperties& properties) {
+        int64_t typeScore = 0;
+        switch (properties.type) {
+            case PhysicalGPUDeviceType::DiscreteGPU:
+                typeScore = 4;
+                break;
+            case PhysicalGPUDeviceType::IntegratedGPU:
+                typeScore = 3;
+                break;
+            case PhysicalGPUDeviceType::VirtualGPU:
+                typeScore = 2;
+                break;
+            case PhysicalGPUDeviceType::CPU:
+                typeScore = 1;
+                break;
+            default:
+                typeScore = 0;
+                break;
+        }
+
+        // NOTE: Memory is measured in MiB so it never outweighs the device type.
+        constexpr int64_t typeWeight = int64_t{1} << 40;
+        return typeScore * typeWeight
+               + static_cast<int64_t>(properties.deviceLocalMemorySize >> 20);
+    }
+
     IGPUPhysicalDevice::~IGPUPhysicalDevice() = default;
 
     IGPUDevice::~IGPUDevice() = default;
@@ -4,6 +4,12 @@
 
 namespace aetherion {
     std::unique_ptr<IGPUDriver> IGPUDriver::create(const GPUDriverDescription& description) {
+#ifdef AETHERION_SINGLE_BACKEND_VULKAN
+        if (description.type != DriverType::Vulkan) {
+            throw std::invalid_argument("Only the Vulkan driver is available in this build.");
+        }
+#endif
+
         switch (description.type) {
             case DriverType::Vulkan:
                 return std::make_unique<VulkanDriver>(description);
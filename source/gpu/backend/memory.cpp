@@ -6,4 +6,6 @@ namespace aetherion {
     IGPUAllocation::~IGPUAllocation() = default;
 
     IGPUAllocatorPool::~IGPUAllocatorPool() = default;
+
+    IGPUDefragmenter::~IGPUDefragmenter() = default;
 }  // namespace aetherion
\ No newline at end of file
@@ -0,0 +1,5 @@
+#include "aetherion/gpu/backend/query_pool.hpp"
+
+namespace aetherion {
+    IQueryPool::~IQueryPool() = default;
+}  // namespace aetherion
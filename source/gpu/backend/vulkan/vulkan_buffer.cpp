@@ -1,41 +1,59 @@
 #include "vulkan_buffer.hpp"
 
+#include "vulkan_cast.hpp"
 #include "vulkan_device.hpp"
 #include "vulkan_memory.hpp"
 #include "vulkan_render_definitions.hpp"
 
 namespace aetherion {
+    vk::BufferCreateInfo toVkBufferCreateInfo(const GPUBufferDescription& description,
+                                              bool descriptorBuffers) {
+        auto usage = toVkBufferUsageFlags(description.usages);
+        // NOTE: Descriptor buffers reference the buffers bound to descriptors by address.
+        if (descriptorBuffers
+            && (usage
+                & (vk::BufferUsageFlagBits::eUniformBuffer | vk::BufferUsageFlagBits::eStorageBuffer
+                   | vk::BufferUsageFlagBits::eUniformTexelBuffer
+                   | vk::BufferUsageFlagBits::eStorageTexelBuffer))) {
+            usage |= vk::BufferUsageFlagBits::eShaderDeviceAddress;
+        }
+
+        return vk::BufferCreateInfo()
+            .setSize(description.size)
+            .setUsage(usage)
+            .setSharingMode(toVkSharingMode(description.sharingMode))
+            .setQueueFamilyIndices(description.queueFamilies);
+    }
+
     VulkanBuffer::VulkanBuffer(VulkanDevice& device, const GPUBufferDescription& description)
-        : device_(device.getVkDevice()) {
-        buffer_ = device_.createBuffer(vk::BufferCreateInfo()
-                                           .setSize(description.size)
-                                           .setUsage(toVkBufferUsageFlags(description.usages))
-                                           .setSharingMode(toVkSharingMode(description.sharingMode))
-                                           .setQueueFamilyIndices(description.queueFamilies));
+        : device_(device.getVkDevice()),
+          deletionQueue_(device.getDeletionQueue()),
+          size_(description.size) {
+        buffer_ = device_.createBuffer(
+            toVkBufferCreateInfo(description, device.usesDescriptorBuffers()));
     }
 
     VulkanBuffer::VulkanBuffer(VulkanAllocator& allocator, const GPUBufferDescription& description,
                                const GPUAllocationDescription& allocationDescription)
-        : device_(allocator.getVkDevice()), allocator_(allocator.getVmaAllocator()) {
-        auto* vkAllocatorPool = dynamic_cast<VulkanAllocatorPool*>(allocationDescription.pool);
-
+        : device_(allocator.getVkDevice()),
+          allocator_(allocator.getVmaAllocator()),
+          deletionQueue_(allocator.getDeletionQueue()),
+          size_(description.size) {
         std::tie(buffer_, allocation_) = allocator_.createBuffer(
-            vk::BufferCreateInfo()
-                .setSize(description.size)
-                .setUsage(toVkBufferUsageFlags(description.usages))
-                .setSharingMode(toVkSharingMode(description.sharingMode))
-                .setQueueFamilyIndices(description.queueFamilies),
-            vma::AllocationCreateInfo()
-                //.setMemoryTypeBits(allocationDescription.memoryTypeBits)
-                .setPool(vkAllocatorPool ? vkAllocatorPool->getVmaPool() : nullptr)
-                .setPriority(allocationDescription.priority)
-                .setUsage(toVmaMemoryUsage(allocationDescription.memoryUsage))
-                .setFlags(toVmaAllocationCreateFlags(allocationDescription.properties)));
+            toVkBufferCreateInfo(description, allocator.usesDescriptorBuffers()),
+            toVmaAllocationCreateInfo(allocationDescription));
+
+        const auto allocationInfo = allocator_.getAllocationInfo(allocation_);
+        mappedData_ = static_cast<std::byte*>(allocationInfo.pMappedData);
     }
 
     VulkanBuffer::VulkanBuffer(vk::Device device, vma::Allocator allocator, vk::Buffer buffer,
-                               vma::Allocation allocation)
-        : device_(device), allocator_(allocator), buffer_(buffer), allocation_(allocation) {}
+                               vma::Allocation allocation, VulkanDeletionQueue* deletionQueue)
+        : device_(device),
+          allocator_(allocator),
+          deletionQueue_(deletionQueue),
+          buffer_(buffer),
+          allocation_(allocation) {}
 
     VulkanBuffer::~VulkanBuffer() noexcept { clear(); }
 
@@ -43,12 +61,18 @@ namespace aetherion {
         : IGPUBuffer(std::move(other)),
           device_(other.device_),
           allocator_(other.allocator_),
+          deletionQueue_(other.deletionQueue_),
           buffer_(other.buffer_),
-          allocation_(other.allocation_) {
+          allocation_(other.allocation_),
+          size_(other.size_),
+          mappedData_(other.mappedData_) {
         other.device_ = nullptr;
         other.allocator_ = nullptr;
+        other.deletionQueue_ = nullptr;
         other.buffer_ = nullptr;
         other.allocation_ = nullptr;
+        other.size_ = 0;
+        other.mappedData_ = nullptr;
     }
 
     VulkanBuffer& VulkanBuffer::operator=(VulkanBuffer&& other) noexcept {
@@ -58,8 +82,11 @@ namespace aetherion {
             IGPUBuffer::operator=(std::move(other));
             device_ = other.device_;
             allocator_ = other.allocator_;
+            deletionQueue_ = other.deletionQueue_;
             buffer_ = other.buffer_;
             allocation_ = other.allocation_;
+            size_ = other.size_;
+            mappedData_ = other.mappedData_;
 
             other.release();
         }
@@ -67,7 +94,9 @@ namespace aetherion {
     }
 
     void VulkanBuffer::clear() noexcept {
-        if (buffer_ && allocation_ && device_ && allocator_) {
+        if (buffer_ && deletionQueue_) {
+            deletionQueue_->enqueue(buffer_, allocator_, allocation_);
+        } else if (buffer_ && allocation_ && device_ && allocator_) {
             allocator_.destroyBuffer(buffer_, allocation_);
         } else if (buffer_ && device_) {
             device_.destroyBuffer(buffer_);
@@ -80,9 +109,16 @@ namespace aetherion {
         allocation_ = nullptr;
         device_ = nullptr;
         allocator_ = nullptr;
+        deletionQueue_ = nullptr;
+        size_ = 0;
+        mappedData_ = nullptr;
     }
 
     void* VulkanBuffer::map() {
+        if (mappedData_) {
+            return mappedData_;
+        }
+
         void* data = nullptr;
         if (allocator_.mapMemory(allocation_, &data) != vk::Result::eSuccess) {
             throw std::runtime_error("Failed to map Vulkan buffer memory.");
@@ -90,5 +126,35 @@ namespace aetherion {
         return data;
     }
 
-    void VulkanBuffer::unmap() { allocator_.unmapMemory(allocation_); }
+    void VulkanBuffer::unmap() {
+        if (!mappedData_) {
+            allocator_.unmapMemory(allocation_);
+        }
+    }
+
+    vk::Buffer VulkanBuffer::relocate(vk::Buffer buffer, std::byte* mappedData) {
+        const vk::Buffer oldBuffer = buffer_;
+        buffer_ = buffer;
+        // NOTE: Persistently mapped allocations are mapped at their new memory too.
+        mappedData_ = mappedData;
+        return oldBuffer;
+    }
+
+    uint64_t VulkanBuffer::getDeviceAddress() const {
+        return device_.getBufferAddress(vk::BufferDeviceAddressInfo().setBuffer(buffer_));
+    }
+
+    void VulkanBuffer::flush(size_t offset, size_t size) {
+        if (!allocation_) {
+            throw(std::runtime_error("Only buffers with allocated memory can be flushed."));
+        }
+        allocator_.flushAllocation(allocation_, offset, size);
+    }
+
+    void VulkanBuffer::invalidate(size_t offset, size_t size) {
+        if (!allocation_) {
+            throw(std::runtime_error("Only buffers with allocated memory can be invalidated."));
+        }
+        allocator_.invalidateAllocation(allocation_, offset, size);
+    }
 }  // namespace aetherion
\ No newline at end of file
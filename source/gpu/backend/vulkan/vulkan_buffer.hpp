@@ -10,15 +10,16 @@ namespace aetherion {
     // Forward declarations
     class VulkanDevice;
     class VulkanAllocator;
+    class VulkanDeletionQueue;
 
-    class VulkanBuffer : public IGPUBuffer {
+    class VulkanBuffer final : public IGPUBuffer {
       public:
         VulkanBuffer() = delete;
         VulkanBuffer(VulkanDevice& device, const GPUBufferDescription& description);
         VulkanBuffer(VulkanAllocator& allocator, const GPUBufferDescription& description,
                      const GPUAllocationDescription& allocationDescription);
         VulkanBuffer(vk::Device device, vma::Allocator allocator, vk::Buffer buffer,
-                     vma::Allocation allocation);
+                     vma::Allocation allocation, VulkanDeletionQueue* deletionQueue = nullptr);
         ~VulkanBuffer() noexcept override;
 
         VulkanBuffer(const VulkanBuffer&) = delete;
@@ -30,17 +31,41 @@ namespace aetherion {
         void* map() override;
         void unmap() override;
 
+        inline std::span<std::byte> getMappedSpan() override {
+            return {mappedData_, mappedData_ ? size_ : 0};
+        }
+
+        void flush(size_t offset = 0, size_t size = WHOLE_SIZE) override;
+        void invalidate(size_t offset = 0, size_t size = WHOLE_SIZE) override;
+
+        inline size_t getSize() const override { return size_; }
+
+        uint64_t getDeviceAddress() const override;
+
         inline vk::Buffer getVkBuffer() const { return buffer_; }
         inline vma::Allocation getVmaAllocation() const { return allocation_; }
 
+        // NOTE: Swaps in a buffer bound to the allocation's new memory after defragmentation and
+        // returns the old one, which the caller destroys once the GPU is done with it.
+        vk::Buffer relocate(vk::Buffer buffer, std::byte* mappedData);
+
         void clear() noexcept;
         void release() noexcept;
 
       private:
         vk::Device device_;
         vma::Allocator allocator_;
+        VulkanDeletionQueue* deletionQueue_ = nullptr;
 
         vk::Buffer buffer_;
         vma::Allocation allocation_;
+
+        size_t size_ = 0;
+        std::byte* mappedData_ = nullptr;  // NOTE: Only set for persistently mapped memory.
     };
+
+    // NOTE: Buffers bound to descriptors also get a device address on devices using descriptor
+    // buffers, other buffers only with GPUBufferUsage::ShaderDeviceAddress.
+    vk::BufferCreateInfo toVkBufferCreateInfo(const GPUBufferDescription& description,
+                                              bool descriptorBuffers);
 }  // namespace aetherion
\ No newline at end of file
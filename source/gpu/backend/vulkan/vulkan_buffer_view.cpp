@@ -1,24 +1,33 @@
 #include "vulkan_buffer_view.hpp"
 
 #include "vulkan_buffer.hpp"
+#include "vulkan_cast.hpp"
 #include "vulkan_device.hpp"
 #include "vulkan_render_definitions.hpp"
 
 namespace aetherion {
     VulkanBufferView::VulkanBufferView(VulkanDevice& device,
                                        const GPUBufferViewDescription& description)
-        : device_(device.getVkDevice()) {
+        : device_(device.getVkDevice()), deletionQueue_(device.getDeletionQueue()) {
         if (!description.buffer) {
             throw std::invalid_argument("Buffer in GPUBufferViewDescription is null.");
         }
 
-        auto& vkBuffer = dynamic_cast<VulkanBuffer&>(*description.buffer);
+        auto& vkBuffer = vulkanCast<VulkanBuffer>(*description.buffer);
 
         bufferView_ = device_.createBufferView(vk::BufferViewCreateInfo()
                                                    .setBuffer(vkBuffer.getVkBuffer())
                                                    .setFormat(toVkFormat(description.format))
                                                    .setOffset(description.offset)
                                                    .setRange(description.range));
+
+        if (device.usesDescriptorBuffers()) {
+            descriptorAddressInfo_
+                = vk::DescriptorAddressInfoEXT()
+                      .setAddress(vkBuffer.getDeviceAddress() + description.offset)
+                      .setRange(description.range)
+                      .setFormat(toVkFormat(description.format));
+        }
     }
 
     VulkanBufferView::VulkanBufferView(vk::Device device, vk::BufferView bufferView)
@@ -27,9 +36,15 @@ namespace aetherion {
     VulkanBufferView::~VulkanBufferView() noexcept { clear(); }
 
     VulkanBufferView::VulkanBufferView(VulkanBufferView&& other) noexcept
-        : IGPUBufferView(std::move(other)), device_(other.device_), bufferView_(other.bufferView_) {
+        : IGPUBufferView(std::move(other)),
+          device_(other.device_),
+          deletionQueue_(other.deletionQueue_),
+          bufferView_(other.bufferView_),
+          descriptorAddressInfo_(other.descriptorAddressInfo_) {
         other.device_ = nullptr;
+        other.deletionQueue_ = nullptr;
         other.bufferView_ = nullptr;
+        other.descriptorAddressInfo_ = vk::DescriptorAddressInfoEXT();
     }
 
     VulkanBufferView& VulkanBufferView::operator=(VulkanBufferView&& other) noexcept {
@@ -38,7 +53,9 @@ namespace aetherion {
 
             IGPUBufferView::operator=(std::move(other));
             device_ = other.device_;
+            deletionQueue_ = other.deletionQueue_;
             bufferView_ = other.bufferView_;
+            descriptorAddressInfo_ = other.descriptorAddressInfo_;
 
             other.release();
         }
@@ -46,15 +63,18 @@ namespace aetherion {
     }
 
     void VulkanBufferView::clear() noexcept {
-        if (bufferView_ && device_) {
+        if (bufferView_ && deletionQueue_) {
+            deletionQueue_->enqueue(bufferView_);
+        } else if (bufferView_ && device_) {
             device_.destroyBufferView(bufferView_);
-            bufferView_ = nullptr;
         }
-        device_ = nullptr;
+        release();
     }
 
     void VulkanBufferView::release() noexcept {
         bufferView_ = nullptr;
         device_ = nullptr;
+        deletionQueue_ = nullptr;
+        descriptorAddressInfo_ = vk::DescriptorAddressInfoEXT();
     }
 }  // namespace aetherion
\ No newline at end of file
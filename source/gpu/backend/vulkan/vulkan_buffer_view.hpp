@@ -7,9 +7,10 @@
 namespace aetherion {
     // Forward declarations
     class VulkanDevice;
+    class VulkanDeletionQueue;
     class VulkanBuffer;
 
-    class VulkanBufferView : public IGPUBufferView {
+    class VulkanBufferView final : public IGPUBufferView {
       public:
         VulkanBufferView() = delete;
         VulkanBufferView(VulkanDevice& device, const GPUBufferViewDescription& description);
@@ -24,12 +25,21 @@ namespace aetherion {
 
         inline vk::BufferView getVkBufferView() const { return bufferView_; }
 
+        // NOTE: Only set on devices using descriptor buffers, which reference texel buffers by
+        // address.
+        inline const vk::DescriptorAddressInfoEXT& getVkDescriptorAddressInfo() const {
+            return descriptorAddressInfo_;
+        }
+
         void clear() noexcept;
         void release() noexcept;
 
       private:
         vk::Device device_;
+        VulkanDeletionQueue* deletionQueue_ = nullptr;
 
         vk::BufferView bufferView_;
+
+        vk::DescriptorAddressInfoEXT descriptorAddressInfo_;
     };
 }  // namespace aetherion
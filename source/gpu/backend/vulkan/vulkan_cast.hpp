@@ -0,0 +1,26 @@
+#pragma once
+
+#include <type_traits>
+
+namespace aetherion {
+    // NOTE: Casts backend interfaces to their Vulkan implementation. Single backend builds
+    // (AETHERION_SINGLE_BACKEND=Vulkan) know every interface is implemented by the Vulkan backend,
+    // so the RTTI lookup is replaced by a static cast.
+    template <typename To, typename From>
+    inline std::conditional_t<std::is_const_v<From>, const To&, To&> vulkanCast(From& object) {
+#ifdef AETHERION_SINGLE_BACKEND_VULKAN
+        return static_cast<std::conditional_t<std::is_const_v<From>, const To&, To&>>(object);
+#else
+        return dynamic_cast<std::conditional_t<std::is_const_v<From>, const To&, To&>>(object);
+#endif
+    }
+
+    template <typename To, typename From>
+    inline std::conditional_t<std::is_const_v<From>, const To*, To*> vulkanCast(From* object) {
+#ifdef AETHERION_SINGLE_BACKEND_VULKAN
+        return static_cast<std::conditional_t<std::is_const_v<From>, const To*, To*>>(object);
+#else
+        return dynamic_cast<std::conditional_t<std::is_const_v<From>, const To*, To*>>(object);
+#endif
+    }
+}  // namespace aetherion
\ No newline at end of file
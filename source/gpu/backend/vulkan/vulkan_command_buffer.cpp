@@ -1,11 +1,17 @@
 #include "vulkan_command_buffer.hpp"
 
+#include <fmt/core.h>
+
+#include <algorithm>
+
 #include "vulkan_buffer.hpp"
+#include "vulkan_cast.hpp"
 #include "vulkan_descriptor_set.hpp"
 #include "vulkan_device.hpp"
 #include "vulkan_image.hpp"
 #include "vulkan_image_view.hpp"
 #include "vulkan_pipeline.hpp"
+#include "vulkan_query_pool.hpp"
 #include "vulkan_render_definitions.hpp"
 
 namespace aetherion {
@@ -13,7 +19,7 @@ namespace aetherion {
         IGPUDevice& device, ICommandPool& commandPool, uint32_t count,
         const CommandGPUBufferDescription& description) {
         return VulkanCommandBuffer::allocateCommandBuffers(
-            dynamic_cast<VulkanDevice&>(device), dynamic_cast<VulkanCommandPool&>(commandPool),
+            vulkanCast<VulkanDevice>(device), vulkanCast<VulkanCommandPool>(commandPool),
             count, description);
     }
 
@@ -50,7 +56,14 @@ namespace aetherion {
                                              const CommandGPUBufferDescription& description)
         : device_(device.getVkDevice()),
           commandPool_(commandPool.getVkCommandPool()),
-          shouldFreeCommandBuffer_(commandPool.supportsFreeCommandBuffer()) {
+          shouldFreeCommandBuffer_(commandPool.supportsFreeCommandBuffer()),
+          dispatcher_(&device.getDispatcher()),
+          maxDescriptorBufferBindings_(
+              device.getDescriptorBufferProperties().maxDescriptorBufferBindings),
+          maxSamplerDescriptorBufferBindings_(
+              device.getDescriptorBufferProperties().maxSamplerDescriptorBufferBindings),
+          maxResourceDescriptorBufferBindings_(
+              device.getDescriptorBufferProperties().maxResourceDescriptorBufferBindings) {
         vk::CommandBufferAllocateInfo allocateInfo
             = vk::CommandBufferAllocateInfo()
                   .setCommandPool(commandPool_)
@@ -76,11 +89,18 @@ namespace aetherion {
           device_(other.device_),
           commandPool_(other.commandPool_),
           commandBuffer_(other.commandBuffer_),
-          shouldFreeCommandBuffer_(other.shouldFreeCommandBuffer_) {
+          shouldFreeCommandBuffer_(other.shouldFreeCommandBuffer_),
+          scratch_(std::move(other.scratch_)),
+          dispatcher_(other.dispatcher_),
+          maxDescriptorBufferBindings_(other.maxDescriptorBufferBindings_),
+          maxSamplerDescriptorBufferBindings_(other.maxSamplerDescriptorBufferBindings_),
+          maxResourceDescriptorBufferBindings_(other.maxResourceDescriptorBufferBindings_),
+          descriptorBufferBindings_(std::move(other.descriptorBufferBindings_)) {
         other.device_ = nullptr;
         other.commandPool_ = nullptr;
         other.commandBuffer_ = nullptr;
         other.shouldFreeCommandBuffer_ = false;
+        other.dispatcher_ = nullptr;
     }
 
     VulkanCommandBuffer& VulkanCommandBuffer::operator=(VulkanCommandBuffer&& other) noexcept {
@@ -92,6 +112,12 @@ namespace aetherion {
             commandPool_ = other.commandPool_;
             commandBuffer_ = other.commandBuffer_;
             shouldFreeCommandBuffer_ = other.shouldFreeCommandBuffer_;
+            scratch_ = std::move(other.scratch_);
+            dispatcher_ = other.dispatcher_;
+            maxDescriptorBufferBindings_ = other.maxDescriptorBufferBindings_;
+            maxSamplerDescriptorBufferBindings_ = other.maxSamplerDescriptorBufferBindings_;
+            maxResourceDescriptorBufferBindings_ = other.maxResourceDescriptorBufferBindings_;
+            descriptorBufferBindings_ = std::move(other.descriptorBufferBindings_);
 
             other.release();
         }
@@ -113,6 +139,8 @@ namespace aetherion {
         device_ = nullptr;
         commandPool_ = nullptr;
         shouldFreeCommandBuffer_ = false;
+        dispatcher_ = nullptr;
+        descriptorBufferBindings_.clear();
     }
 
     void VulkanCommandBuffer::freeCommandBuffers(
@@ -122,14 +150,14 @@ namespace aetherion {
         vkCommandBuffers.reserve(commandBuffers.size());
 
         for (const auto& commandBuffer : commandBuffers) {
-            auto& vkCommandBuffer = dynamic_cast<VulkanCommandBuffer&>(commandBuffer.get());
+            auto& vkCommandBuffer = vulkanCast<VulkanCommandBuffer>(commandBuffer.get());
             vkCommandBuffers.push_back(vkCommandBuffer.getVkCommandBuffer());
             vkCommandBuffer.release();
         }
 
         VulkanCommandBuffer::freeCommandBuffers(
-            dynamic_cast<VulkanDevice&>(device).getVkDevice(),
-            dynamic_cast<VulkanCommandPool&>(commandPool).getVkCommandPool(), vkCommandBuffers);
+            vulkanCast<VulkanDevice>(device).getVkDevice(),
+            vulkanCast<VulkanCommandPool>(commandPool).getVkCommandPool(), vkCommandBuffers);
     }
 
     void VulkanCommandBuffer::freeCommandBuffers(
@@ -152,26 +180,39 @@ namespace aetherion {
         device.freeCommandBuffers(commandPool, commandBuffers);
     }
 
-    constexpr vk::BufferCopy toVkBufferCopy(const BufferCopyRegion& region) {
-        return vk::BufferCopy()
+    constexpr vk::BufferCopy2 toVkBufferCopy2(const BufferCopyRegion& region) {
+        return vk::BufferCopy2()
             .setSrcOffset(region.srcOffset)
             .setDstOffset(region.dstOffset)
             .setSize(region.size);
     }
 
+    constexpr vk::BufferImageCopy2 toVkBufferImageCopy2(const BufferImageCopyRegion& region) {
+        return vk::BufferImageCopy2()
+            .setBufferOffset(region.bufferOffset)
+            .setBufferRowLength(region.bufferRowLength)
+            .setBufferImageHeight(region.bufferImageHeight)
+            .setImageSubresource(vk::ImageSubresourceLayers()
+                                     .setAspectMask(toVkImageAspectFlags(region.aspectMask))
+                                     .setMipLevel(region.mipLevel)
+                                     .setBaseArrayLayer(region.baseArrayLayer)
+                                     .setLayerCount(region.layerCount))
+            .setImageOffset(toVkOffset3D(region.imageOffset))
+            .setImageExtent(toVkExtent3D(region.imageExtent));
+    }
+
     vk::RenderingAttachmentInfo toVkRenderingAttachmentInfo(
         const AttachmentDescription& attachment) {
         if (!attachment.image) {
             throw std::invalid_argument("Attachment image is null");
         }
-        const auto* vkImage = dynamic_cast<VulkanImage*>(attachment.image);
+        const auto* vkImage = vulkanCast<VulkanImage>(attachment.image);
         if (!attachment.imageView) {
             throw std::invalid_argument("Attachment image view is null");
         }
-        const auto* vkImageView = dynamic_cast<VulkanImageView*>(attachment.imageView);
+        const auto* vkImageView = vulkanCast<VulkanImageView>(attachment.imageView);
         // NOTE: Resolve image view is optional (depends on the attachment's resolve mode).
-        const auto* vkResolveImageView
-            = dynamic_cast<VulkanImageView*>(attachment.resolveImageView);
+        const auto* vkResolveImageView = vulkanCast<VulkanImageView>(attachment.resolveImageView);
 
         auto vkAttachment
             = vk::RenderingAttachmentInfo()
@@ -231,11 +272,44 @@ namespace aetherion {
     }
 
     void VulkanCommandBuffer::begin(CommandBufferUsageFlags flags) {
+        scratch_.reset();
+        descriptorBufferBindings_.clear();
+
         commandBuffer_.begin(
             vk::CommandBufferBeginInfo().setFlags(toVkCommandBufferUsageFlags(flags)));
     }
 
+    void VulkanCommandBuffer::begin(CommandBufferUsageFlags flags,
+                                    const CommandBufferInheritanceDescription& inheritance) {
+        scratch_.reset();
+        descriptorBufferBindings_.clear();
+
+        auto vkColorAttachmentFormats
+            = scratch_.allocate<vk::Format>(inheritance.colorAttachmentFormats.size());
+        for (size_t i = 0; i < vkColorAttachmentFormats.size(); ++i) {
+            vkColorAttachmentFormats[i] = toVkFormat(inheritance.colorAttachmentFormats[i]);
+        }
+
+        auto vkInheritanceRenderingInfo
+            = vk::CommandBufferInheritanceRenderingInfo()
+                  .setColorAttachmentFormats(vkColorAttachmentFormats)
+                  .setDepthAttachmentFormat(toVkFormat(inheritance.depthAttachmentFormat))
+                  .setStencilAttachmentFormat(toVkFormat(inheritance.stencilAttachmentFormat))
+                  .setViewMask(inheritance.viewMask)
+                  .setRasterizationSamples(toVkSampleCount(inheritance.rasterizationSamples));
+        auto vkInheritanceInfo
+            = vk::CommandBufferInheritanceInfo().setPNext(&vkInheritanceRenderingInfo);
+
+        commandBuffer_.begin(vk::CommandBufferBeginInfo()
+                                 .setFlags(toVkCommandBufferUsageFlags(flags)
+                                           | vk::CommandBufferUsageFlagBits::eRenderPassContinue)
+                                 .setPInheritanceInfo(&vkInheritanceInfo));
+    }
+
     void VulkanCommandBuffer::reset(bool releaseResources) {
+        scratch_.reset();
+        descriptorBufferBindings_.clear();
+
         commandBuffer_.reset(releaseResources ? vk::CommandBufferResetFlagBits::eReleaseResources
                                               : vk::CommandBufferResetFlags());
     }
@@ -243,10 +317,11 @@ namespace aetherion {
     void VulkanCommandBuffer::end() { commandBuffer_.end(); }
 
     void VulkanCommandBuffer::beginRendering(const RenderDescription& renderDescription) {
-        auto vkColorAttachments = std::vector<vk::RenderingAttachmentInfo>();
-        vkColorAttachments.reserve(renderDescription.colorAttachments.size());
-        for (const auto& attachment : renderDescription.colorAttachments) {
-            vkColorAttachments.push_back(toVkRenderingAttachmentInfo(attachment));
+        auto vkColorAttachments = scratch_.allocate<vk::RenderingAttachmentInfo>(
+            renderDescription.colorAttachments.size());
+        for (size_t i = 0; i < vkColorAttachments.size(); ++i) {
+            vkColorAttachments[i]
+                = toVkRenderingAttachmentInfo(renderDescription.colorAttachments[i]);
         }
 
         auto vkRenderingInfo = vk::RenderingInfo()
@@ -254,15 +329,19 @@ namespace aetherion {
                                    .setLayerCount(renderDescription.layerCount)
                                    .setViewMask(renderDescription.viewMask)
                                    .setColorAttachments(vkColorAttachments);
+        if (renderDescription.secondaryCommandBuffers) {
+            vkRenderingInfo.setFlags(vk::RenderingFlagBits::eContentsSecondaryCommandBuffers);
+        }
 
+        // NOTE: Declared here so they outlive the vk::RenderingInfo pointing to them.
+        vk::RenderingAttachmentInfo vkDepthAttachment;
+        vk::RenderingAttachmentInfo vkStencilAttachment;
         if (renderDescription.depthAttachment.has_value()) {
-            auto vkDepthAttachment
-                = toVkRenderingAttachmentInfo(*renderDescription.depthAttachment);
+            vkDepthAttachment = toVkRenderingAttachmentInfo(*renderDescription.depthAttachment);
             vkRenderingInfo.setPDepthAttachment(&vkDepthAttachment);
         }
         if (renderDescription.stencilAttachment.has_value()) {
-            auto vkStencilAttachment
-                = toVkRenderingAttachmentInfo(*renderDescription.stencilAttachment);
+            vkStencilAttachment = toVkRenderingAttachmentInfo(*renderDescription.stencilAttachment);
             vkRenderingInfo.setPStencilAttachment(&vkStencilAttachment);
         }
 
@@ -273,12 +352,10 @@ namespace aetherion {
 
     void VulkanCommandBuffer::executeCommands(
         std::span<std::reference_wrapper<ICommandBuffer>> commandBuffers) {
-        std::vector<vk::CommandBuffer> vkCommandBuffers;
-        vkCommandBuffers.reserve(commandBuffers.size());
-        for (auto commandBuffer : commandBuffers) {
-            const auto& vkCommandBuffer
-                = dynamic_cast<const VulkanCommandBuffer&>(commandBuffer.get());
-            vkCommandBuffers.push_back(vkCommandBuffer.getVkCommandBuffer());
+        auto vkCommandBuffers = scratch_.allocate<vk::CommandBuffer>(commandBuffers.size());
+        for (size_t i = 0; i < vkCommandBuffers.size(); ++i) {
+            const auto& vkCommandBuffer = vulkanCast<VulkanCommandBuffer>(commandBuffers[i].get());
+            vkCommandBuffers[i] = vkCommandBuffer.getVkCommandBuffer();
         }
 
         commandBuffer_.executeCommands(vkCommandBuffers);
@@ -317,29 +394,28 @@ namespace aetherion {
     void VulkanCommandBuffer::clear(IGPUImage& image, GPUImageLayout layout,
                                     const std::vector<GPUImageRangeDescription>& ranges,
                                     const ClearValue& clearValue) {
-        const auto& vkImage = dynamic_cast<VulkanImage&>(image);
+        const auto& vkImage = vulkanCast<VulkanImage>(image);
 
         vk::ClearValue vkClearValue = toVkClearValue(clearValue);
 
-        std::vector<vk::ImageSubresourceRange> vkRanges;
-        vkRanges.reserve(ranges.size());
+        auto vkRanges = scratch_.allocate<vk::ImageSubresourceRange>(ranges.size());
 
         // NOTE: vk::ClearValue is a naked union, so the warning about accessing inactive union
         // members is suppressed.
         if (clearValue.index() == 0) {
             // Color clear
-            for (const auto& range : ranges)
-                vkRanges.push_back(toVkImageSubresourceRange(
-                    {.aspectMask = GPUImageAspect::Color, .range = range}));
+            for (size_t i = 0; i < vkRanges.size(); ++i)
+                vkRanges[i] = toVkImageSubresourceRange(
+                    {.aspectMask = GPUImageAspect::Color, .range = ranges[i]});
             commandBuffer_.clearColorImage(
                 vkImage.getVkImage(), toVkImageLayout(layout),
                 vkClearValue.color,  // NOLINT(cppcoreguidelines-pro-type-union-access)
                 vkRanges);
         } else if (clearValue.index() == 1) {
             // Depth-stencil clear
-            for (const auto& range : ranges)
-                vkRanges.push_back(toVkImageSubresourceRange(
-                    {.aspectMask = GPUImageAspect::Depth, .range = range}));
+            for (size_t i = 0; i < vkRanges.size(); ++i)
+                vkRanges[i] = toVkImageSubresourceRange(
+                    {.aspectMask = GPUImageAspect::Depth, .range = ranges[i]});
             commandBuffer_.clearDepthStencilImage(
                 vkImage.getVkImage(), toVkImageLayout(layout),
                 vkClearValue.depthStencil,  // NOLINT(cppcoreguidelines-pro-type-union-access)
@@ -350,7 +426,7 @@ namespace aetherion {
     }
 
     void VulkanCommandBuffer::bindPipeline(IPipeline& pipeline) {
-        const auto& vkPipeline = dynamic_cast<const VulkanPipeline&>(pipeline);
+        const auto& vkPipeline = vulkanCast<VulkanPipeline>(pipeline);
 
         vk::PipelineBindPoint bindpoint = toVkPipelineBindPoint(vkPipeline.getPipelineType());
 
@@ -359,28 +435,169 @@ namespace aetherion {
 
     void VulkanCommandBuffer::bindDescriptorSets(
         IPipelineLayout& pipelineLayout, PipelineBindPoint bindPoint, uint32_t firstSet,
-        std::span<std::reference_wrapper<IDescriptorSet>> descriptorSets) {
-        const auto& vkPipelineLayout = dynamic_cast<const VulkanPipelineLayout&>(pipelineLayout);
+        std::span<std::reference_wrapper<IDescriptorSet>> descriptorSets,
+        std::span<const uint32_t> dynamicOffsets) {
+        const auto& vkPipelineLayout = vulkanCast<VulkanPipelineLayout>(pipelineLayout);
+
+        if (vkPipelineLayout.usesDescriptorBuffers()) {
+            bindDescriptorBufferSets(vkPipelineLayout, bindPoint, firstSet, descriptorSets,
+                                     dynamicOffsets);
+            return;
+        }
 
-        std::vector<vk::DescriptorSet> vkDescriptorSets;
-        vkDescriptorSets.reserve(descriptorSets.size());
-        for (auto set : descriptorSets) {
-            const auto& vkSet = dynamic_cast<const VulkanDescriptorSet&>(set.get());
+        auto vkDescriptorSets = scratch_.allocate<vk::DescriptorSet>(descriptorSets.size());
+        for (size_t i = 0; i < vkDescriptorSets.size(); ++i) {
+            const auto& vkSet = vulkanCast<VulkanDescriptorSet>(descriptorSets[i].get());
 
-            vkDescriptorSets.push_back(vkSet.getVkDescriptorSet());
+            vkDescriptorSets[i] = vkSet.getVkDescriptorSet();
         }
 
         vk::PipelineBindPoint vkBindPoint = toVkPipelineBindPoint(bindPoint);
 
         commandBuffer_.bindDescriptorSets(vkBindPoint, vkPipelineLayout.getVkPipelineLayout(),
-                                          firstSet, vkDescriptorSets, {});
+                                          firstSet, vkDescriptorSets, dynamicOffsets);
+    }
+
+    void VulkanCommandBuffer::bindDescriptorBufferSets(
+        const VulkanPipelineLayout& pipelineLayout, PipelineBindPoint bindPoint, uint32_t firstSet,
+        std::span<std::reference_wrapper<IDescriptorSet>> descriptorSets,
+        std::span<const uint32_t> dynamicOffsets) {
+        if (!dynamicOffsets.empty()) {
+            throw std::invalid_argument("Descriptor buffers don't support dynamic offsets.");
+        }
+        if (!dispatcher_) {
+            throw std::runtime_error(
+                "Descriptor buffer sets can only be bound by command buffers allocated from a "
+                "device.");
+        }
+
+        auto bufferIndices = scratch_.allocate<uint32_t>(descriptorSets.size());
+        auto offsets = scratch_.allocate<vk::DeviceSize>(descriptorSets.size());
+
+        bool rebind = false;
+        for (size_t i = 0; i < descriptorSets.size(); ++i) {
+            const auto& vkSet = vulkanCast<VulkanDescriptorSet>(descriptorSets[i].get());
+            const auto* pool = vkSet.getDescriptorBufferPool();
+            if (!pool) {
+                throw std::invalid_argument(
+                    "Pipeline layouts created for descriptor buffers can only bind descriptor "
+                    "buffer sets.");
+            }
+
+            const auto address = pool->getDescriptorBufferAddress();
+            uint32_t index = 0;
+            while (index < descriptorBufferBindings_.size()
+                   && descriptorBufferBindings_[index].address != address) {
+                ++index;
+            }
+            if (index == descriptorBufferBindings_.size()) {
+                checkDescriptorBufferBindingLimits(pool->getDescriptorBufferUsage());
+                descriptorBufferBindings_.push_back(
+                    vk::DescriptorBufferBindingInfoEXT().setAddress(address).setUsage(
+                        pool->getDescriptorBufferUsage()));
+                rebind = true;
+            }
+
+            bufferIndices[i] = index;
+            offsets[i] = vkSet.getDescriptorBufferOffset();
+        }
+
+        if (rebind) {
+            commandBuffer_.bindDescriptorBuffersEXT(descriptorBufferBindings_, *dispatcher_);
+        }
+        commandBuffer_.setDescriptorBufferOffsetsEXT(
+            toVkPipelineBindPoint(bindPoint), pipelineLayout.getVkPipelineLayout(), firstSet,
+            bufferIndices, offsets, *dispatcher_);
+    }
+
+    void VulkanCommandBuffer::checkDescriptorBufferBindingLimits(
+        vk::BufferUsageFlags usage) const {
+        // NOTE: Pools holding both samplers and other descriptors count against both limits.
+        const auto countBindings = [this](vk::BufferUsageFlagBits usageBit) {
+            return static_cast<uint32_t>(
+                std::count_if(descriptorBufferBindings_.begin(), descriptorBufferBindings_.end(),
+                              [usageBit](const vk::DescriptorBufferBindingInfoEXT& binding) {
+                                  return static_cast<bool>(binding.usage & usageBit);
+                              }));
+        };
+
+        if (descriptorBufferBindings_.size() >= maxDescriptorBufferBindings_) {
+            throw std::runtime_error(fmt::format(
+                "Too many descriptor buffer pools bound in a single command buffer, the device "
+                "supports {}.",
+                maxDescriptorBufferBindings_));
+        }
+        if ((usage & vk::BufferUsageFlagBits::eSamplerDescriptorBufferEXT)
+            && countBindings(vk::BufferUsageFlagBits::eSamplerDescriptorBufferEXT)
+                   >= maxSamplerDescriptorBufferBindings_) {
+            throw std::runtime_error(fmt::format(
+                "Too many descriptor buffer pools with samplers bound in a single command buffer, "
+                "the device supports {}.",
+                maxSamplerDescriptorBufferBindings_));
+        }
+        if ((usage & vk::BufferUsageFlagBits::eResourceDescriptorBufferEXT)
+            && countBindings(vk::BufferUsageFlagBits::eResourceDescriptorBufferEXT)
+                   >= maxResourceDescriptorBufferBindings_) {
+            throw std::runtime_error(fmt::format(
+                "Too many descriptor buffer pools with resource descriptors bound in a single "
+                "command buffer, the device supports {}.",
+                maxResourceDescriptorBufferBindings_));
+        }
+    }
+
+    void VulkanCommandBuffer::pushDescriptorSet(
+        IPipelineLayout& pipelineLayout, PipelineBindPoint bindPoint, uint32_t set,
+        std::span<const DescriptorWriteDescription> descriptorWrites) {
+        const auto& vkPipelineLayout = vulkanCast<VulkanPipelineLayout>(pipelineLayout);
+
+        if (vkPipelineLayout.usesDescriptorBuffers()) {
+            throw std::invalid_argument(
+                "Push descriptors aren't supported by pipeline layouts created for descriptor "
+                "buffers.");
+        }
+        if (!dispatcher_) {
+            throw std::runtime_error(
+                "Push descriptors can only be recorded by command buffers allocated from a "
+                "device.");
+        }
+
+        size_t bufferInfoCount = 0;
+        size_t imageInfoCount = 0;
+        size_t bufferViewCount = 0;
+        for (const auto& write : descriptorWrites) {
+            bufferInfoCount += write.buffers.size();
+            imageInfoCount += write.images.size();
+            bufferViewCount += write.texelBuffers.size();
+        }
+
+        auto vkWrites = scratch_.allocate<vk::WriteDescriptorSet>(descriptorWrites.size());
+        auto vkBufferInfos = scratch_.allocate<vk::DescriptorBufferInfo>(bufferInfoCount);
+        auto vkImageInfos = scratch_.allocate<vk::DescriptorImageInfo>(imageInfoCount);
+        auto vkBufferViews = scratch_.allocate<vk::BufferView>(bufferViewCount);
+
+        size_t bufferInfoOffset = 0;
+        size_t imageInfoOffset = 0;
+        size_t bufferViewOffset = 0;
+        for (size_t i = 0; i < descriptorWrites.size(); ++i) {
+            const auto& write = descriptorWrites[i];
+            vkWrites[i] = toVkWriteDescriptorSet(write, vkBufferInfos.data() + bufferInfoOffset,
+                                                 vkImageInfos.data() + imageInfoOffset,
+                                                 vkBufferViews.data() + bufferViewOffset);
+            bufferInfoOffset += write.buffers.size();
+            imageInfoOffset += write.images.size();
+            bufferViewOffset += write.texelBuffers.size();
+        }
+
+        commandBuffer_.pushDescriptorSetKHR(toVkPipelineBindPoint(bindPoint),
+                                            vkPipelineLayout.getVkPipelineLayout(), set, vkWrites,
+                                            *dispatcher_);
     }
 
     void VulkanCommandBuffer::pushConstantRange(IPipelineLayout& pipelineLayout,
                                                 IPushConstantRange& pushConstantRange,
                                                 std::span<const std::byte> data) {
-        const auto& vkPipelineLayout = dynamic_cast<const VulkanPipelineLayout&>(pipelineLayout);
-        const auto& vkPushConstantRange = dynamic_cast<VulkanPushConstantRange&>(pushConstantRange);
+        const auto& vkPipelineLayout = vulkanCast<VulkanPipelineLayout>(pipelineLayout);
+        const auto& vkPushConstantRange = vulkanCast<VulkanPushConstantRange>(pushConstantRange);
 
         commandBuffer_.pushConstants(vkPipelineLayout.getVkPipelineLayout(),
                                      vkPushConstantRange.getVkPushConstantRange().stageFlags,
@@ -392,25 +609,26 @@ namespace aetherion {
     void VulkanCommandBuffer::bindVertexBuffers(
         uint32_t firstBinding, uint32_t bindingCount,
         std::span<const VertexBufferBindingDescription> bindings) {
-        std::vector<vk::Buffer> vkBuffers;
-        std::vector<vk::DeviceSize> vkOffsets;
-        std::vector<vk::DeviceSize> vkSizes;
-        std::vector<vk::DeviceSize> vkStrides;
-        vkBuffers.reserve(bindingCount);
-        vkOffsets.reserve(bindingCount);
-        vkSizes.reserve(bindingCount);
-        vkStrides.reserve(bindingCount);
-
-        for (const auto& binding : bindings) {
+        if (bindingCount != bindings.size()) {
+            throw std::invalid_argument("bindingCount doesn't match the number of bindings.");
+        }
+
+        auto vkBuffers = scratch_.allocate<vk::Buffer>(bindings.size());
+        auto vkOffsets = scratch_.allocate<vk::DeviceSize>(bindings.size());
+        auto vkSizes = scratch_.allocate<vk::DeviceSize>(bindings.size());
+        auto vkStrides = scratch_.allocate<vk::DeviceSize>(bindings.size());
+
+        for (size_t i = 0; i < bindings.size(); ++i) {
+            const auto& binding = bindings[i];
             if (!binding.buffer) {
                 throw std::invalid_argument("Vertex buffer is null.");
             }
-            auto* vkBuffer = dynamic_cast<VulkanBuffer*>(binding.buffer);
+            auto* vkBuffer = vulkanCast<VulkanBuffer>(binding.buffer);
 
-            vkBuffers.push_back(vkBuffer->getVkBuffer());
-            vkOffsets.push_back(binding.offset);
-            vkSizes.push_back(binding.size);
-            vkStrides.push_back(binding.stride);
+            vkBuffers[i] = vkBuffer->getVkBuffer();
+            vkOffsets[i] = binding.offset;
+            vkSizes[i] = binding.size;
+            vkStrides[i] = binding.stride;
         }
 
         commandBuffer_.bindVertexBuffers2(firstBinding, vkBuffers, vkOffsets, vkSizes, vkStrides);
@@ -418,53 +636,75 @@ namespace aetherion {
 
     void VulkanCommandBuffer::bindIndexBuffer(IGPUBuffer& buffer, size_t offset,
                                               IndexType indexType) {
-        const auto& vkBuffer = dynamic_cast<const VulkanBuffer*>(&buffer);
+        const auto& vkBuffer = vulkanCast<VulkanBuffer>(&buffer);
 
         commandBuffer_.bindIndexBuffer(vkBuffer->getVkBuffer(), offset, toVkIndexType(indexType));
     }
 
     void VulkanCommandBuffer::copyBuffer(IGPUBuffer& src, IGPUBuffer& dst,
                                          const std::vector<BufferCopyRegion>& regions) {
-        const auto& vkSrcBuffer = dynamic_cast<const VulkanBuffer&>(src);
-        const auto& vkDstBuffer = dynamic_cast<const VulkanBuffer&>(dst);
+        const auto& vkSrcBuffer = vulkanCast<VulkanBuffer>(src);
+        const auto& vkDstBuffer = vulkanCast<VulkanBuffer>(dst);
+
+        auto vkRegions = scratch_.allocate<vk::BufferCopy2>(regions.size());
+        for (size_t i = 0; i < vkRegions.size(); ++i) {
+            vkRegions[i] = toVkBufferCopy2(regions[i]);
+        }
+
+        commandBuffer_.copyBuffer2(vk::CopyBufferInfo2()
+                                       .setSrcBuffer(vkSrcBuffer.getVkBuffer())
+                                       .setDstBuffer(vkDstBuffer.getVkBuffer())
+                                       .setRegionCount(static_cast<uint32_t>(vkRegions.size()))
+                                       .setPRegions(vkRegions.data()));
+    }
+
+    void VulkanCommandBuffer::copyBufferToImage(IGPUBuffer& src, IGPUImage& dst,
+                                                GPUImageLayout dstLayout,
+                                                std::span<const BufferImageCopyRegion> regions) {
+        const auto& vkSrcBuffer = vulkanCast<VulkanBuffer>(src);
+        const auto& vkDstImage = vulkanCast<VulkanImage>(dst);
 
-        std::vector<vk::BufferCopy> vkRegions;
-        vkRegions.reserve(regions.size());
-        for (const auto& region : regions) {
-            vkRegions.push_back(toVkBufferCopy(region));
+        auto vkRegions = scratch_.allocate<vk::BufferImageCopy2>(regions.size());
+        for (size_t i = 0; i < vkRegions.size(); ++i) {
+            vkRegions[i] = toVkBufferImageCopy2(regions[i]);
         }
 
-        commandBuffer_.copyBuffer(vkSrcBuffer.getVkBuffer(), vkDstBuffer.getVkBuffer(), vkRegions);
+        commandBuffer_.copyBufferToImage2(
+            vk::CopyBufferToImageInfo2()
+                .setSrcBuffer(vkSrcBuffer.getVkBuffer())
+                .setDstImage(vkDstImage.getVkImage())
+                .setDstImageLayout(toVkImageLayout(dstLayout))
+                .setRegionCount(static_cast<uint32_t>(vkRegions.size()))
+                .setPRegions(vkRegions.data()));
     }
 
     void VulkanCommandBuffer::barrier(
         std::span<const GeneralMemoryBarrierDescription> generalBarriers,
         std::span<const BufferBarrierDescription> bufferBarriers,
         std::span<const ImageBarrierDescription> imageBarriers) {
-        auto vkGeneralBarriers = std::vector<vk::MemoryBarrier2>();
-        vkGeneralBarriers.reserve(generalBarriers.size());
-        for (const auto& barrier : generalBarriers) {
-            vkGeneralBarriers.push_back(toVkMemoryBarrier2(barrier));
-        }
-        auto vkBufferBarriers = std::vector<vk::BufferMemoryBarrier2>();
-        vkBufferBarriers.reserve(bufferBarriers.size());
-        for (const auto& barrier : bufferBarriers) {
+        auto vkGeneralBarriers = scratch_.allocate<vk::MemoryBarrier2>(generalBarriers.size());
+        for (size_t i = 0; i < vkGeneralBarriers.size(); ++i) {
+            vkGeneralBarriers[i] = toVkMemoryBarrier2(generalBarriers[i]);
+        }
+        auto vkBufferBarriers = scratch_.allocate<vk::BufferMemoryBarrier2>(bufferBarriers.size());
+        for (size_t i = 0; i < vkBufferBarriers.size(); ++i) {
+            const auto& barrier = bufferBarriers[i];
             if (!barrier.buffer) {
                 throw std::invalid_argument("Buffer in BufferBarrierDescription is null.");
             }
-            auto* vkBuffer = dynamic_cast<VulkanBuffer*>(barrier.buffer);
+            auto* vkBuffer = vulkanCast<VulkanBuffer>(barrier.buffer);
 
-            vkBufferBarriers.push_back(toVkBufferMemoryBarrier2(barrier, vkBuffer->getVkBuffer()));
+            vkBufferBarriers[i] = toVkBufferMemoryBarrier2(barrier, vkBuffer->getVkBuffer());
         }
-        auto vkImageBarriers = std::vector<vk::ImageMemoryBarrier2>();
-        vkImageBarriers.reserve(imageBarriers.size());
-        for (const auto& barrier : imageBarriers) {
+        auto vkImageBarriers = scratch_.allocate<vk::ImageMemoryBarrier2>(imageBarriers.size());
+        for (size_t i = 0; i < vkImageBarriers.size(); ++i) {
+            const auto& barrier = imageBarriers[i];
             if (!barrier.image) {
                 throw std::invalid_argument("Image in ImageBarrierDescription is null.");
             }
-            auto* vkImage = dynamic_cast<VulkanImage*>(barrier.image);
+            auto* vkImage = vulkanCast<VulkanImage>(barrier.image);
 
-            vkImageBarriers.push_back(toVkImageMemoryBarrier2(barrier, vkImage->getVkImage()));
+            vkImageBarriers[i] = toVkImageMemoryBarrier2(barrier, vkImage->getVkImage());
         }
 
         commandBuffer_.pipelineBarrier2(vk::DependencyInfo()
@@ -473,6 +713,19 @@ namespace aetherion {
                                             .setImageMemoryBarriers(vkImageBarriers));
     }
 
+    void VulkanCommandBuffer::resetQueryPool(IQueryPool& queryPool, uint32_t firstQuery,
+                                             uint32_t queryCount) {
+        commandBuffer_.resetQueryPool(vulkanCast<VulkanQueryPool>(queryPool).getVkQueryPool(),
+                                      firstQuery, queryCount);
+    }
+
+    void VulkanCommandBuffer::writeTimestamp(IQueryPool& queryPool, PipelineStage stage,
+                                             uint32_t query) {
+        commandBuffer_.writeTimestamp2(toVkPipelineStageFlag(stage),
+                                       vulkanCast<VulkanQueryPool>(queryPool).getVkQueryPool(),
+                                       query);
+    }
+
     VulkanCommandPool::VulkanCommandPool(VulkanDevice& device,
                                          const CommandPoolDescription& description)
         : device_(device.getVkDevice()),
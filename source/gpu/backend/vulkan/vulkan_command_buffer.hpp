@@ -4,6 +4,7 @@
 #include <vulkan/vulkan.hpp>
 
 #include "aetherion/gpu/backend/command_buffer.hpp"
+#include "aetherion/util/linear_allocator.hpp"
 
 namespace aetherion {
     // Forward declarations
@@ -11,8 +12,9 @@ namespace aetherion {
     class IDescriptorPool;
     class VulkanDevice;
     class VulkanCommandPool;
+    class VulkanPipelineLayout;
 
-    class VulkanCommandBuffer : public ICommandBuffer {
+    class VulkanCommandBuffer final : public ICommandBuffer {
       public:
         static std::vector<std::unique_ptr<ICommandBuffer>> allocateCommandBuffers(
             IGPUDevice& device, ICommandPool& commandPool, uint32_t count,
@@ -47,6 +49,8 @@ namespace aetherion {
                                        std::span<vk::CommandBuffer> commandBuffers);
 
         void begin(CommandBufferUsageFlags flags = CommandBufferUsage::None) override;
+        void begin(CommandBufferUsageFlags flags,
+                   const CommandBufferInheritanceDescription& inheritance) override;
         void reset(bool releaseResources = false) override;
         void end() override;
 
@@ -75,7 +79,11 @@ namespace aetherion {
 
         void bindDescriptorSets(
             IPipelineLayout& pipelineLayout, PipelineBindPoint bindPoint, uint32_t firstSet,
-            std::span<std::reference_wrapper<IDescriptorSet>> descriptorSets) override;
+            std::span<std::reference_wrapper<IDescriptorSet>> descriptorSets,
+            std::span<const uint32_t> dynamicOffsets = {}) override;
+        void pushDescriptorSet(
+            IPipelineLayout& pipelineLayout, PipelineBindPoint bindPoint, uint32_t set,
+            std::span<const DescriptorWriteDescription> descriptorWrites) override;
         void pushConstantRange(IPipelineLayout& pipelineLayout,
                                IPushConstantRange& pushConstantRange,
                                std::span<const std::byte> data) override;
@@ -86,26 +94,51 @@ namespace aetherion {
 
         void copyBuffer(IGPUBuffer& src, IGPUBuffer& dst,
                         const std::vector<BufferCopyRegion>& regions) override;
+        void copyBufferToImage(IGPUBuffer& src, IGPUImage& dst, GPUImageLayout dstLayout,
+                               std::span<const BufferImageCopyRegion> regions) override;
 
         void barrier(std::span<const GeneralMemoryBarrierDescription> generalBarriers,
                      std::span<const BufferBarrierDescription> bufferBarriers,
                      std::span<const ImageBarrierDescription> imageBarriers) override;
 
+        void resetQueryPool(IQueryPool& queryPool, uint32_t firstQuery,
+                            uint32_t queryCount) override;
+        void writeTimestamp(IQueryPool& queryPool, PipelineStage stage, uint32_t query) override;
+
         inline vk::CommandBuffer getVkCommandBuffer() const { return commandBuffer_; }
 
         void clear() noexcept;
         void release() noexcept;
 
       private:
+        void bindDescriptorBufferSets(
+            const VulkanPipelineLayout& pipelineLayout, PipelineBindPoint bindPoint,
+            uint32_t firstSet, std::span<std::reference_wrapper<IDescriptorSet>> descriptorSets,
+            std::span<const uint32_t> dynamicOffsets);
+        void checkDescriptorBufferBindingLimits(vk::BufferUsageFlags usage) const;
+
         vk::Device device_;
         vk::CommandPool commandPool_;
 
         vk::CommandBuffer commandBuffer_;
 
         bool shouldFreeCommandBuffer_;
+
+        // NOTE: Backs the argument translations while recording, reset on begin() and reset().
+        LinearAllocator scratch_;
+
+        // NOTE: Null for command buffers created from raw handles, which can't bind descriptor
+        // buffer sets.
+        const vk::DispatchLoaderDynamic* dispatcher_ = nullptr;
+        uint32_t maxDescriptorBufferBindings_ = 0;
+        uint32_t maxSamplerDescriptorBufferBindings_ = 0;
+        uint32_t maxResourceDescriptorBufferBindings_ = 0;
+        // NOTE: Descriptor buffers bound so far, new ones are appended so the buffer indices of
+        // the sets already bound stay valid. Reset on begin() and reset().
+        std::vector<vk::DescriptorBufferBindingInfoEXT> descriptorBufferBindings_;
     };
 
-    class VulkanCommandPool : public ICommandPool {
+    class VulkanCommandPool final : public ICommandPool {
       public:
         VulkanCommandPool() = delete;
         VulkanCommandPool(VulkanDevice& device, const CommandPoolDescription& description);
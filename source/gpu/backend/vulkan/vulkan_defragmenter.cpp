@@ -0,0 +1,457 @@
+#include "vulkan_defragmenter.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "aetherion/gpu/backend/sync.hpp"
+#include "vulkan_buffer.hpp"
+#include "vulkan_cast.hpp"
+#include "vulkan_command_buffer.hpp"
+#include "vulkan_deletion_queue.hpp"
+#include "vulkan_image.hpp"
+#include "vulkan_memory.hpp"
+#include "vulkan_render_definitions.hpp"
+
+namespace aetherion {
+    VulkanDefragmenter::VulkanDefragmenter(VulkanAllocator& allocator,
+                                           const GPUDefragmenterDescription& description)
+        : allocator_(&allocator),
+          device_(allocator.getVkDevice()),
+          vmaAllocator_(allocator.getVmaAllocator()),
+          timeline_(description.timeline) {
+        if (!timeline_) {
+            throw(std::invalid_argument("A timeline is required to create a defragmenter."));
+        }
+
+        auto* vkAllocatorPool = vulkanCast<VulkanAllocatorPool>(description.pool);
+        info_ = vma::DefragmentationInfo()
+                    .setFlags(toVmaDefragmentationFlag(description.algorithm))
+                    .setPool(vkAllocatorPool ? vkAllocatorPool->getVmaPool() : nullptr)
+                    .setMaxBytesPerPass(description.maxBytesPerPass)
+                    .setMaxAllocationsPerPass(description.maxAllocationsPerPass);
+
+        restart();
+    }
+
+    VulkanDefragmenter::~VulkanDefragmenter() noexcept {
+        try {
+            // NOTE: VMA requires the pass in flight to be ended before its context.
+            if (state_ == PassState::Copying) {
+                timeline_->wait(passTimelineValue_, std::numeric_limits<uint64_t>::max());
+                for (const auto& pendingMove : pendingMoves_) {
+                    passInfo_.pMoves[pendingMove.moveIndex].operation
+                        = vma::DefragmentationMoveOperation::eIgnore;
+                    destroyHandle(pendingMove.handle);
+                }
+                pendingMoves_.clear();
+            } else if (state_ == PassState::Relocated) {
+                timeline_->wait(passTimelineValue_, std::numeric_limits<uint64_t>::max());
+            }
+            if (state_ != PassState::Idle) {
+                (void)vmaAllocator_.endDefragmentationPass(context_, &passInfo_);
+                state_ = PassState::Idle;
+            }
+            if (context_) {
+                finish();
+            }
+
+            uint64_t lastTimelineValue = 0;
+            for (const auto& retiredHandle : retiredHandles_) {
+                lastTimelineValue = std::max(lastTimelineValue, retiredHandle.timelineValue);
+            }
+            timeline_->wait(lastTimelineValue, std::numeric_limits<uint64_t>::max());
+        } catch (...) {
+        }
+
+        for (const auto& retiredHandle : retiredHandles_) {
+            destroyHandle(retiredHandle.handle);
+        }
+    }
+
+    void VulkanDefragmenter::registerBuffer(IGPUBuffer& buffer,
+                                            const GPUBufferDescription& description,
+                                            GPUResourceRelocationCallback onRelocated) {
+        if (!description.usages.contains(GPUBufferUsage::TransferSrc)
+            || !description.usages.contains(GPUBufferUsage::TransferDst)) {
+            throw(std::invalid_argument(
+                "Defragmented buffers require transfer source and destination usages."));
+        }
+
+        auto& vkBuffer = vulkanCast<VulkanBuffer>(buffer);
+        if (!vkBuffer.getVmaAllocation()) {
+            throw(std::invalid_argument("Only buffers with allocated memory can be defragmented."));
+        }
+
+        registrations_[static_cast<VmaAllocation>(vkBuffer.getVmaAllocation())]
+            = {.buffer = &vkBuffer,
+               .bufferDescription = description,
+               .imageDescription = {},
+               .onRelocated = std::move(onRelocated)};
+    }
+
+    void VulkanDefragmenter::registerImage(IGPUImage& image, const GPUImageDescription& description,
+                                           GPUImageLayout layout,
+                                           GPUResourceRelocationCallback onRelocated) {
+        if (!description.usages.contains(GPUImageUsage::TransferSrc)
+            || !description.usages.contains(GPUImageUsage::TransferDst)) {
+            throw(std::invalid_argument(
+                "Defragmented images require transfer source and destination usages."));
+        }
+        if (layout == GPUImageLayout::Undefined) {
+            throw(std::invalid_argument("Defragmented images require a defined layout."));
+        }
+
+        auto& vkImage = vulkanCast<VulkanImage>(image);
+        if (!vkImage.getVmaAllocation()) {
+            throw(std::invalid_argument("Only images with allocated memory can be defragmented."));
+        }
+
+        registrations_[static_cast<VmaAllocation>(vkImage.getVmaAllocation())]
+            = {.bufferDescription = {},
+               .image = &vkImage,
+               .imageDescription = description,
+               .layout = layout,
+               .onRelocated = std::move(onRelocated)};
+    }
+
+    void VulkanDefragmenter::unregisterBuffer(IGPUBuffer& buffer) {
+        unregister(vulkanCast<VulkanBuffer>(buffer).getVmaAllocation());
+    }
+
+    void VulkanDefragmenter::unregisterImage(IGPUImage& image) {
+        unregister(vulkanCast<VulkanImage>(image).getVmaAllocation());
+    }
+
+    void VulkanDefragmenter::unregister(vma::Allocation allocation) {
+        auto it = registrations_.find(static_cast<VmaAllocation>(allocation));
+        if (it == registrations_.end()) {
+            return;
+        }
+
+        auto pendingMove = std::find_if(pendingMoves_.begin(), pendingMoves_.end(),
+                                        [&](const PendingMove& pendingMove) {
+                                            return pendingMove.allocation == it->first;
+                                        });
+        if (pendingMove != pendingMoves_.end()) {
+            auto& move = passInfo_.pMoves[pendingMove->moveIndex];
+            if (state_ == PassState::Copying) {
+                // NOTE: The copy may still be writing the new resource.
+                move.operation = vma::DefragmentationMoveOperation::eIgnore;
+                retiredHandles_.push_back(
+                    {.handle = pendingMove->handle, .timelineValue = passTimelineValue_});
+            } else {
+                // NOTE: The resource already uses its new memory, VMA frees both places when the
+                // pass ends, so the wrapper must not free its allocation. Frames recorded after
+                // the relocation may still use it, so the handle retires with the resources
+                // destroyed now and the pass isn't ended before.
+                const auto* deletionQueue = allocator_->getDeletionQueue();
+                const uint64_t retireValue = std::max(
+                    {passTimelineValue_, lastTimelineValue_,
+                     deletionQueue ? deletionQueue->getPendingValue() : uint64_t{0}});
+                passTimelineValue_ = retireValue;
+
+                move.operation = vma::DefragmentationMoveOperation::eDestroy;
+                if (it->second.buffer) {
+                    retiredHandles_.push_back({.handle = it->second.buffer->getVkBuffer(),
+                                               .timelineValue = retireValue});
+                    it->second.buffer->release();
+                } else {
+                    retiredHandles_.push_back({.handle = it->second.image->getVkImage(),
+                                               .timelineValue = retireValue});
+                    it->second.image->release();
+                }
+            }
+            pendingMoves_.erase(pendingMove);
+        }
+
+        registrations_.erase(it);
+    }
+
+    bool VulkanDefragmenter::recordPass(ICommandBuffer& commandBuffer, uint64_t timelineValue) {
+        lastTimelineValue_ = timelineValue;
+        const uint64_t completedTimelineValue = timeline_->getCurrentValue();
+        destroyRetiredHandles(completedTimelineValue);
+
+        if (state_ == PassState::Copying) {
+            if (completedTimelineValue < passTimelineValue_) {
+                return false;
+            }
+            relocate(timelineValue);
+            return false;
+        }
+
+        if (state_ == PassState::Relocated) {
+            if (completedTimelineValue < passTimelineValue_) {
+                return false;
+            }
+            endPass();
+            destroyRetiredHandles(completedTimelineValue);
+        }
+
+        if (!context_) {
+            return false;
+        }
+
+        beginPass(vulkanCast<VulkanCommandBuffer>(commandBuffer).getVkCommandBuffer());
+        if (state_ == PassState::Copying) {
+            passTimelineValue_ = timelineValue;
+            return true;
+        }
+        return false;
+    }
+
+    void VulkanDefragmenter::restart() {
+        if (context_) {
+            return;
+        }
+
+        stats_ = {};
+        stats_.unusedBytesBefore = getUnusedBytes();
+        context_ = vmaAllocator_.beginDefragmentation(info_);
+    }
+
+    void VulkanDefragmenter::beginPass(vk::CommandBuffer commandBuffer) {
+        if (vmaAllocator_.beginDefragmentationPass(context_, &passInfo_) == vk::Result::eSuccess) {
+            // NOTE: Nothing left to move.
+            finish();
+            return;
+        }
+
+        std::vector<vk::ImageMemoryBarrier2> preCopyBarriers;
+        std::vector<vk::ImageMemoryBarrier2> postCopyBarriers;
+        std::vector<vk::ImageCopy2> imageCopyRegions;
+
+        // NOTE: Resources are recreated on the new memory and their contents copied over, the
+        // old resources stay in use until the copy completes.
+        for (uint32_t i = 0; i < passInfo_.moveCount; ++i) {
+            auto& move = passInfo_.pMoves[i];
+            auto it = registrations_.find(static_cast<VmaAllocation>(move.srcAllocation));
+            if (it == registrations_.end()) {
+                move.operation = vma::DefragmentationMoveOperation::eIgnore;
+                continue;
+            }
+            const Registration& registration = it->second;
+
+            if (registration.buffer) {
+                const vk::Buffer newBuffer = device_.createBuffer(toVkBufferCreateInfo(
+                    registration.bufferDescription, allocator_->usesDescriptorBuffers()));
+                vmaAllocator_.bindBufferMemory(move.dstTmpAllocation, newBuffer);
+
+                pendingMoves_.push_back(
+                    {.allocation = it->first, .moveIndex = i, .handle = newBuffer});
+            } else {
+                const auto& description = registration.imageDescription;
+                const vk::Image newImage = device_.createImage(
+                    toVkImageCreateInfo(description)
+                        .setInitialLayout(vk::ImageLayout::eUndefined));
+                vmaAllocator_.bindImageMemory(move.dstTmpAllocation, newImage);
+
+                const vk::Image oldImage = registration.image->getVkImage();
+                const vk::ImageLayout layout = toVkImageLayout(registration.layout);
+                const vk::ImageAspectFlags aspectMask = getVkFormatAspectFlags(description.format);
+                const auto subresourceRange = vk::ImageSubresourceRange()
+                                                  .setAspectMask(aspectMask)
+                                                  .setLevelCount(description.mipLevels)
+                                                  .setLayerCount(description.arrayLayers);
+
+                preCopyBarriers.push_back(
+                    vk::ImageMemoryBarrier2()
+                        .setSrcStageMask(vk::PipelineStageFlagBits2::eAllCommands)
+                        .setSrcAccessMask(vk::AccessFlagBits2::eMemoryWrite)
+                        .setDstStageMask(vk::PipelineStageFlagBits2::eTransfer)
+                        .setDstAccessMask(vk::AccessFlagBits2::eTransferRead)
+                        .setOldLayout(layout)
+                        .setNewLayout(vk::ImageLayout::eTransferSrcOptimal)
+                        .setImage(oldImage)
+                        .setSubresourceRange(subresourceRange));
+                preCopyBarriers.push_back(
+                    vk::ImageMemoryBarrier2()
+                        .setDstStageMask(vk::PipelineStageFlagBits2::eTransfer)
+                        .setDstAccessMask(vk::AccessFlagBits2::eTransferWrite)
+                        .setOldLayout(vk::ImageLayout::eUndefined)
+                        .setNewLayout(vk::ImageLayout::eTransferDstOptimal)
+                        .setImage(newImage)
+                        .setSubresourceRange(subresourceRange));
+
+                postCopyBarriers.push_back(
+                    vk::ImageMemoryBarrier2()
+                        .setSrcStageMask(vk::PipelineStageFlagBits2::eTransfer)
+                        .setDstStageMask(vk::PipelineStageFlagBits2::eAllCommands)
+                        .setDstAccessMask(vk::AccessFlagBits2::eMemoryRead)
+                        .setOldLayout(vk::ImageLayout::eTransferSrcOptimal)
+                        .setNewLayout(layout)
+                        .setImage(oldImage)
+                        .setSubresourceRange(subresourceRange));
+                postCopyBarriers.push_back(
+                    vk::ImageMemoryBarrier2()
+                        .setSrcStageMask(vk::PipelineStageFlagBits2::eTransfer)
+                        .setSrcAccessMask(vk::AccessFlagBits2::eTransferWrite)
+                        .setDstStageMask(vk::PipelineStageFlagBits2::eAllCommands)
+                        .setDstAccessMask(vk::AccessFlagBits2::eMemoryRead
+                                          | vk::AccessFlagBits2::eMemoryWrite)
+                        .setOldLayout(vk::ImageLayout::eTransferDstOptimal)
+                        .setNewLayout(layout)
+                        .setImage(newImage)
+                        .setSubresourceRange(subresourceRange));
+
+                pendingMoves_.push_back(
+                    {.allocation = it->first, .moveIndex = i, .handle = newImage});
+            }
+        }
+
+        if (pendingMoves_.empty()) {
+            // NOTE: Every move was of unregistered allocations.
+            endPass();
+            return;
+        }
+
+        // NOTE: Buffer copies read memory written by earlier work, they wait for it through a
+        // global barrier.
+        const auto preCopyBarrier = vk::MemoryBarrier2()
+                                        .setSrcStageMask(vk::PipelineStageFlagBits2::eAllCommands)
+                                        .setSrcAccessMask(vk::AccessFlagBits2::eMemoryWrite)
+                                        .setDstStageMask(vk::PipelineStageFlagBits2::eTransfer)
+                                        .setDstAccessMask(vk::AccessFlagBits2::eTransferRead);
+        commandBuffer.pipelineBarrier2(vk::DependencyInfo()
+                                           .setMemoryBarriers(preCopyBarrier)
+                                           .setImageMemoryBarriers(preCopyBarriers));
+
+        for (const auto& pendingMove : pendingMoves_) {
+            const Registration& registration = registrations_.at(pendingMove.allocation);
+            if (registration.buffer) {
+                const auto region = vk::BufferCopy2().setSize(registration.bufferDescription.size);
+                commandBuffer.copyBuffer2(
+                    vk::CopyBufferInfo2()
+                        .setSrcBuffer(registration.buffer->getVkBuffer())
+                        .setDstBuffer(std::get<vk::Buffer>(pendingMove.handle))
+                        .setRegions(region));
+                continue;
+            }
+
+            const auto& description = registration.imageDescription;
+            const vk::ImageAspectFlags aspectMask = getVkFormatAspectFlags(description.format);
+
+            imageCopyRegions.clear();
+            for (uint32_t mipLevel = 0; mipLevel < description.mipLevels; ++mipLevel) {
+                const auto subresource = vk::ImageSubresourceLayers()
+                                             .setAspectMask(aspectMask)
+                                             .setMipLevel(mipLevel)
+                                             .setLayerCount(description.arrayLayers);
+                imageCopyRegions.push_back(
+                    vk::ImageCopy2()
+                        .setSrcSubresource(subresource)
+                        .setDstSubresource(subresource)
+                        .setExtent(toVkExtent3D(
+                            {.width = std::max(description.extent.width >> mipLevel, 1u),
+                             .height = std::max(description.extent.height >> mipLevel, 1u),
+                             .depth = std::max(description.extent.depth >> mipLevel, 1u)})));
+            }
+
+            commandBuffer.copyImage2(vk::CopyImageInfo2()
+                                         .setSrcImage(registration.image->getVkImage())
+                                         .setSrcImageLayout(vk::ImageLayout::eTransferSrcOptimal)
+                                         .setDstImage(std::get<vk::Image>(pendingMove.handle))
+                                         .setDstImageLayout(vk::ImageLayout::eTransferDstOptimal)
+                                         .setRegions(imageCopyRegions));
+        }
+
+        // NOTE: Buffer copies are made visible by a global barrier, images by their transitions.
+        const auto bufferCopyBarrier
+            = vk::MemoryBarrier2()
+                  .setSrcStageMask(vk::PipelineStageFlagBits2::eTransfer)
+                  .setSrcAccessMask(vk::AccessFlagBits2::eTransferWrite)
+                  .setDstStageMask(vk::PipelineStageFlagBits2::eAllCommands)
+                  .setDstAccessMask(vk::AccessFlagBits2::eMemoryRead
+                                    | vk::AccessFlagBits2::eMemoryWrite);
+        commandBuffer.pipelineBarrier2(vk::DependencyInfo()
+                                           .setMemoryBarriers(bufferCopyBarrier)
+                                           .setImageMemoryBarriers(postCopyBarriers));
+
+        state_ = PassState::Copying;
+    }
+
+    void VulkanDefragmenter::relocate(uint64_t timelineValue) {
+        // NOTE: Copies are complete, resources switch to their new handles from this frame on and
+        // the old ones retire once it completes. VMA frees the old memory when the pass ends.
+        std::vector<GPUResourceRelocationCallback*> callbacks;
+        for (const auto& pendingMove : pendingMoves_) {
+            Registration& registration = registrations_.at(pendingMove.allocation);
+            const auto& move = passInfo_.pMoves[pendingMove.moveIndex];
+            const auto dstAllocationInfo = vmaAllocator_.getAllocationInfo(move.dstTmpAllocation);
+
+            if (registration.buffer) {
+                retiredHandles_.push_back(
+                    {.handle = registration.buffer->relocate(
+                         std::get<vk::Buffer>(pendingMove.handle),
+                         static_cast<std::byte*>(dstAllocationInfo.pMappedData)),
+                     .timelineValue = timelineValue});
+            } else {
+                retiredHandles_.push_back(
+                    {.handle
+                     = registration.image->relocate(std::get<vk::Image>(pendingMove.handle)),
+                     .timelineValue = timelineValue});
+            }
+
+            stats_.bytesMoved += dstAllocationInfo.size;
+            ++stats_.allocationsMoved;
+            if (registration.onRelocated) {
+                callbacks.push_back(&registration.onRelocated);
+            }
+        }
+
+        state_ = PassState::Relocated;
+        passTimelineValue_ = timelineValue;
+
+        for (auto* callback : callbacks) {
+            (*callback)();
+        }
+    }
+
+    void VulkanDefragmenter::endPass() {
+        pendingMoves_.clear();
+        state_ = PassState::Idle;
+        ++stats_.passCount;
+
+        if (vmaAllocator_.endDefragmentationPass(context_, &passInfo_) == vk::Result::eSuccess) {
+            finish();
+        }
+    }
+
+    void VulkanDefragmenter::finish() {
+        vma::DefragmentationStats vmaStats;
+        vmaAllocator_.endDefragmentation(context_, &vmaStats);
+        context_ = nullptr;
+
+        stats_.bytesFreed = vmaStats.bytesFreed;
+        stats_.deviceMemoryBlocksFreed = vmaStats.deviceMemoryBlocksFreed;
+        stats_.unusedBytesAfter = getUnusedBytes();
+    }
+
+    void VulkanDefragmenter::destroyRetiredHandles(uint64_t completedTimelineValue) {
+        std::erase_if(retiredHandles_, [&](const RetiredHandle& retiredHandle) {
+            if (retiredHandle.timelineValue > completedTimelineValue) {
+                return false;
+            }
+            destroyHandle(retiredHandle.handle);
+            return true;
+        });
+    }
+
+    void VulkanDefragmenter::destroyHandle(
+        const std::variant<vk::Buffer, vk::Image>& handle) noexcept {
+        if (std::holds_alternative<vk::Buffer>(handle)) {
+            device_.destroyBuffer(std::get<vk::Buffer>(handle));
+        } else {
+            device_.destroyImage(std::get<vk::Image>(handle));
+        }
+    }
+
+    size_t VulkanDefragmenter::getUnusedBytes() const {
+        size_t unusedBytes = 0;
+        for (const auto& heap : allocator_->getHeapBudgets()) {
+            unusedBytes += heap.blockBytes - heap.allocationBytes;
+        }
+        return unusedBytes;
+    }
+}  // namespace aetherion
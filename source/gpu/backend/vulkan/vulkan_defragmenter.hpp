@@ -0,0 +1,103 @@
+#pragma once
+
+#include <unordered_map>
+#include <variant>
+#include <vector>
+#include <vk_mem_alloc.hpp>
+#include <vulkan/vulkan.hpp>
+
+#include "aetherion/gpu/backend/buffer.hpp"
+#include "aetherion/gpu/backend/image.hpp"
+#include "aetherion/gpu/backend/memory.hpp"
+
+namespace aetherion {
+    // Forward declarations
+    class VulkanAllocator;
+    class VulkanBuffer;
+    class VulkanImage;
+
+    class VulkanDefragmenter final : public IGPUDefragmenter {
+      public:
+        VulkanDefragmenter() = delete;
+        VulkanDefragmenter(VulkanAllocator& allocator,
+                           const GPUDefragmenterDescription& description);
+        // NOTE: Waits for the pass in flight and applies it.
+        ~VulkanDefragmenter() noexcept override;
+
+        VulkanDefragmenter(const VulkanDefragmenter&) = delete;
+        VulkanDefragmenter& operator=(const VulkanDefragmenter&) = delete;
+
+        VulkanDefragmenter(VulkanDefragmenter&&) = delete;
+        VulkanDefragmenter& operator=(VulkanDefragmenter&&) = delete;
+
+        void registerBuffer(IGPUBuffer& buffer, const GPUBufferDescription& description,
+                            GPUResourceRelocationCallback onRelocated = {}) override;
+        void registerImage(IGPUImage& image, const GPUImageDescription& description,
+                           GPUImageLayout layout,
+                           GPUResourceRelocationCallback onRelocated = {}) override;
+        void unregisterBuffer(IGPUBuffer& buffer) override;
+        void unregisterImage(IGPUImage& image) override;
+
+        bool recordPass(ICommandBuffer& commandBuffer, uint64_t timelineValue) override;
+
+        void restart() override;
+        inline bool isComplete() const override { return !context_; }
+
+        inline const GPUDefragmentationStats& getStats() const override { return stats_; }
+
+      private:
+        struct Registration {
+            VulkanBuffer* buffer{};
+            GPUBufferDescription bufferDescription;
+            VulkanImage* image{};
+            GPUImageDescription imageDescription;
+            GPUImageLayout layout = GPUImageLayout::Undefined;
+            GPUResourceRelocationCallback onRelocated;
+        };
+
+        // NOTE: Copying until the GPU finishes the copies, then relocated until the frames that
+        // may use the old resources finish.
+        enum class PassState { Idle, Copying, Relocated };
+
+        struct PendingMove {
+            VmaAllocation allocation;
+            uint32_t moveIndex;
+            std::variant<vk::Buffer, vk::Image> handle;  // NOTE: Bound to the new memory.
+        };
+
+        struct RetiredHandle {
+            std::variant<vk::Buffer, vk::Image> handle;
+            uint64_t timelineValue;
+        };
+
+        void unregister(vma::Allocation allocation);
+
+        void beginPass(vk::CommandBuffer commandBuffer);
+        void relocate(uint64_t timelineValue);
+        void endPass();
+        void finish();
+
+        void destroyRetiredHandles(uint64_t completedTimelineValue);
+        void destroyHandle(const std::variant<vk::Buffer, vk::Image>& handle) noexcept;
+
+        size_t getUnusedBytes() const;
+
+        VulkanAllocator* allocator_;
+        vk::Device device_;
+        vma::Allocator vmaAllocator_;
+        IGPUTimelineSemaphore* timeline_;
+
+        vma::DefragmentationInfo info_;
+        vma::DefragmentationContext context_;
+        vma::DefragmentationPassMoveInfo passInfo_;
+        std::vector<PendingMove> pendingMoves_;
+        PassState state_ = PassState::Idle;
+        uint64_t passTimelineValue_ = 0;
+        uint64_t lastTimelineValue_ = 0;  // NOTE: Of the last recordPass() call.
+
+        std::unordered_map<VmaAllocation, Registration> registrations_;
+        std::vector<RetiredHandle> retiredHandles_;
+
+        GPUDefragmentationStats stats_;
+    };
+}  // namespace aetherion
@@ -0,0 +1,147 @@
+#include "vulkan_deletion_queue.hpp"
+
+#include <stdexcept>
+#include <type_traits>
+
+#include "vulkan_descriptor_set.hpp"
+
+namespace aetherion {
+    VulkanDeletionQueue::VulkanDeletionQueue(vk::Device device) : device_(device) {}
+
+    VulkanDeletionQueue::~VulkanDeletionQueue() noexcept {
+        for (const auto& entry : entries_) {
+            destroy(entry);
+        }
+    }
+
+    void VulkanDeletionQueue::enqueue(VulkanDeletionHandle handle, vma::Allocator allocator,
+                                      vma::Allocation allocation,
+                                      vk::DescriptorPool descriptorPool) noexcept {
+        std::lock_guard lock(mutex_);
+        try {
+            entries_.push_back({.timelineValue = pendingValue_,
+                                .handle = handle,
+                                .allocator = allocator,
+                                .allocation = allocation,
+                                .descriptorPool = descriptorPool});
+        } catch (...) {
+            // NOTE: Out of memory, the handle may still be in use but leaking it is worse.
+            destroy({.timelineValue = pendingValue_,
+                     .handle = handle,
+                     .allocator = allocator,
+                     .allocation = allocation,
+                     .descriptorPool = descriptorPool});
+        }
+    }
+
+    void VulkanDeletionQueue::setPendingValue(uint64_t timelineValue) {
+        std::lock_guard lock(mutex_);
+        if (timelineValue < pendingValue_) {
+            throw(std::invalid_argument("Deferred destruction timeline values must not decrease."));
+        }
+        pendingValue_ = timelineValue;
+    }
+
+    uint64_t VulkanDeletionQueue::getPendingValue() const {
+        std::lock_guard lock(mutex_);
+        return pendingValue_;
+    }
+
+    void VulkanDeletionQueue::collect(uint64_t completedTimelineValue) {
+        // NOTE: Entries are destroyed outside the lock so other threads can keep enqueuing.
+        std::deque<Entry> completedEntries;
+        {
+            std::lock_guard lock(mutex_);
+            while (!entries_.empty() && entries_.front().timelineValue <= completedTimelineValue) {
+                completedEntries.push_back(entries_.front());
+                entries_.pop_front();
+            }
+        }
+
+        for (const auto& entry : completedEntries) {
+            destroy(entry);
+        }
+    }
+
+    size_t VulkanDeletionQueue::getPendingCount() const {
+        std::lock_guard lock(mutex_);
+        return entries_.size();
+    }
+
+    void VulkanDeletionQueue::forgetDescriptorSets(vk::DescriptorPool descriptorPool) noexcept {
+        std::lock_guard lock(mutex_);
+        std::erase_if(entries_, [descriptorPool](const Entry& entry) {
+            return std::holds_alternative<vk::DescriptorSet>(entry.handle)
+                   && entry.descriptorPool == descriptorPool;
+        });
+    }
+
+    void VulkanDeletionQueue::forgetDescriptorBufferRanges(
+        const VulkanDescriptorPool* pool) noexcept {
+        std::lock_guard lock(mutex_);
+        std::erase_if(entries_, [pool](const Entry& entry) {
+            const auto* range = std::get_if<VulkanDescriptorBufferRange>(&entry.handle);
+            return range && range->pool == pool;
+        });
+    }
+
+    void VulkanDeletionQueue::retargetDescriptorBufferRanges(
+        const VulkanDescriptorPool* pool, VulkanDescriptorPool* newPool) noexcept {
+        std::lock_guard lock(mutex_);
+        for (auto& entry : entries_) {
+            auto* range = std::get_if<VulkanDescriptorBufferRange>(&entry.handle);
+            if (range && range->pool == pool) {
+                range->pool = newPool;
+            }
+        }
+    }
+
+    void VulkanDeletionQueue::release() noexcept {
+        std::lock_guard lock(mutex_);
+        entries_.clear();
+    }
+
+    void VulkanDeletionQueue::destroy(const Entry& entry) noexcept {
+        std::visit(
+            [this, &entry](auto handle) {
+                using Handle = decltype(handle);
+                if constexpr (std::is_same_v<Handle, vk::Buffer>) {
+                    if (entry.allocator && entry.allocation) {
+                        entry.allocator.destroyBuffer(handle, entry.allocation);
+                    } else {
+                        device_.destroyBuffer(handle);
+                    }
+                } else if constexpr (std::is_same_v<Handle, vk::Image>) {
+                    if (entry.allocator && entry.allocation) {
+                        entry.allocator.destroyImage(handle, entry.allocation);
+                    } else {
+                        device_.destroyImage(handle);
+                    }
+                } else if constexpr (std::is_same_v<Handle, vk::ImageView>) {
+                    device_.destroyImageView(handle);
+                } else if constexpr (std::is_same_v<Handle, vk::BufferView>) {
+                    device_.destroyBufferView(handle);
+                } else if constexpr (std::is_same_v<Handle, vk::Sampler>) {
+                    device_.destroySampler(handle);
+                } else if constexpr (std::is_same_v<Handle, vk::Pipeline>) {
+                    device_.destroyPipeline(handle);
+                } else if constexpr (std::is_same_v<Handle, vk::DescriptorSet>) {
+                    // NOTE: Only valid for pools created with the free descriptor set flag.
+                    device_.freeDescriptorSets(entry.descriptorPool, 1, &handle);
+                } else if constexpr (std::is_same_v<Handle, vk::DescriptorPool>) {
+                    device_.destroyDescriptorPool(handle);
+                } else if constexpr (std::is_same_v<Handle, vk::QueryPool>) {
+                    device_.destroyQueryPool(handle);
+                } else if constexpr (std::is_same_v<Handle, VulkanDescriptorBufferRange>) {
+                    handle.pool->freeDescriptorBufferRange(handle.offset, handle.size);
+                } else if constexpr (std::is_same_v<Handle, vma::Allocation>) {
+                    entry.allocator.freeMemory(handle);
+                } else if constexpr (std::is_same_v<Handle, vma::Pool>) {
+                    entry.allocator.destroyPool(handle);
+                } else if constexpr (std::is_same_v<Handle, vma::Allocator>) {
+                    handle.destroy();
+                }
+            },
+            entry.handle);
+    }
+}  // namespace aetherion
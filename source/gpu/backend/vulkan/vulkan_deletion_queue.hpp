@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <variant>
+#include <vk_mem_alloc.hpp>
+#include <vulkan/vulkan.hpp>
+
+namespace aetherion {
+    // Forward declarations
+    class VulkanDescriptorPool;
+
+    // NOTE: The range of a set allocated from a descriptor buffer pool, given back to the pool
+    // instead of destroyed. The pool isn't locked, see VulkanDescriptorPool.
+    struct VulkanDescriptorBufferRange {
+        VulkanDescriptorPool* pool;
+        vk::DeviceSize offset;
+        vk::DeviceSize size;
+    };
+
+    using VulkanDeletionHandle
+        = std::variant<vk::Buffer, vk::Image, vk::ImageView, vk::BufferView, vk::Sampler,
+                       vk::Pipeline, vk::DescriptorSet, vk::DescriptorPool, vk::QueryPool,
+                       VulkanDescriptorBufferRange, vma::Allocation, vma::Pool, vma::Allocator>;
+
+    // NOTE: Owned by VulkanDevice when deferred destruction is enabled. Wrappers hand their
+    // handles over instead of destroying them, tagged with the timeline value of the work that may
+    // still use them, and they are destroyed in bulk once the GPU reaches it. Entries are
+    // destroyed in the order they were enqueued, so VMA pools and allocators enqueued after their
+    // allocations outlive them.
+    class VulkanDeletionQueue {
+      public:
+        VulkanDeletionQueue() = delete;
+        explicit VulkanDeletionQueue(vk::Device device);
+        // NOTE: Destroys every entry left, the device must be idle.
+        ~VulkanDeletionQueue() noexcept;
+
+        VulkanDeletionQueue(const VulkanDeletionQueue&) = delete;
+        VulkanDeletionQueue& operator=(const VulkanDeletionQueue&) = delete;
+
+        VulkanDeletionQueue(VulkanDeletionQueue&&) = delete;
+        VulkanDeletionQueue& operator=(VulkanDeletionQueue&&) = delete;
+
+        // NOTE: The allocation is destroyed together with buffers and images. Descriptor sets
+        // need their pool.
+        void enqueue(VulkanDeletionHandle handle, vma::Allocator allocator = nullptr,
+                     vma::Allocation allocation = nullptr,
+                     vk::DescriptorPool descriptorPool = nullptr) noexcept;
+
+        // NOTE: Values must not decrease.
+        void setPendingValue(uint64_t timelineValue);
+        uint64_t getPendingValue() const;
+        void collect(uint64_t completedTimelineValue);
+
+        size_t getPendingCount() const;
+
+        // NOTE: Resetting a pool frees its sets at once, their pending frees would then use
+        // invalid handles, so they must be dropped before the reset.
+        void forgetDescriptorSets(vk::DescriptorPool descriptorPool) noexcept;
+        // NOTE: Same for descriptor buffer pools, whose ranges also go away with the pool.
+        void forgetDescriptorBufferRanges(const VulkanDescriptorPool* pool) noexcept;
+        // NOTE: Moving a descriptor buffer pool hands its pending range frees over to the new one.
+        void retargetDescriptorBufferRanges(const VulkanDescriptorPool* pool,
+                                            VulkanDescriptorPool* newPool) noexcept;
+
+        // NOTE: Forgets every entry without destroying it.
+        void release() noexcept;
+
+      private:
+        struct Entry {
+            uint64_t timelineValue;
+            VulkanDeletionHandle handle;
+            vma::Allocator allocator;
+            vma::Allocation allocation;
+            vk::DescriptorPool descriptorPool;
+        };
+
+        void destroy(const Entry& entry) noexcept;
+
+        vk::Device device_;
+
+        mutable std::mutex mutex_;
+        std::deque<Entry> entries_;
+        uint64_t pendingValue_ = 0;
+    };
+}  // namespace aetherion
@@ -1,26 +1,241 @@
 #include "vulkan_descriptor_set.hpp"
 
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <optional>
+
+#include "vulkan_buffer.hpp"
+#include "vulkan_buffer_view.hpp"
+#include "vulkan_cast.hpp"
 #include "vulkan_device.hpp"
+#include "vulkan_image_view.hpp"
 #include "vulkan_render_definitions.hpp"
+#include "vulkan_sampler.hpp"
 
 namespace aetherion {
+    VulkanDescriptorBufferLayout toVulkanDescriptorBufferLayout(
+        const VulkanDevice& device, vk::DescriptorSetLayout layout,
+        const DescriptorSetLayoutDescription& description) {
+        const auto vkDevice = device.getVkDevice();
+        const auto& dispatcher = device.getDispatcher();
+        const auto& properties = device.getDescriptorBufferProperties();
+
+        VulkanDescriptorBufferLayout bufferLayout;
+        bufferLayout.size = vkDevice.getDescriptorSetLayoutSizeEXT(layout, dispatcher);
+
+        for (const auto& binding : description.bindings) {
+            if (binding.binding >= bufferLayout.bindings.size()) {
+                bufferLayout.bindings.resize(binding.binding + 1);
+            }
+
+            const auto type = toVkDescriptorType(binding.type);
+            const bool split = type == vk::DescriptorType::eCombinedImageSampler
+                               && !properties.combinedImageSamplerDescriptorSingleArray;
+            bufferLayout.bindings[binding.binding] = {
+                .type = type,
+                .count = binding.count,
+                .offset = vkDevice.getDescriptorSetLayoutBindingOffsetEXT(layout, binding.binding,
+                                                                          dispatcher),
+                .descriptorSize = device.getDescriptorSize(type),
+                .splitImageSize = split ? properties.sampledImageDescriptorSize : 0};
+        }
+
+        return bufferLayout;
+    }
+
+    VulkanDescriptorSetLayoutKey toVulkanDescriptorSetLayoutKey(
+        const VulkanDevice& device, const DescriptorSetLayoutDescription& description) {
+        const bool descriptorBuffers = device.usesDescriptorBuffers();
+        // NOTE: Descriptor buffers can always be written while in use, they don't take the update
+        // after bind flags.
+        const DescriptorBindingFlags ignoredFlags
+            = descriptorBuffers ? DescriptorBinding::UpdateAfterBind
+                                      | DescriptorBinding::UpdateUnusedWhilePending
+                                : DescriptorBindingFlags();
+
+        VulkanDescriptorSetLayoutKey key;
+        key.pushDescriptor
+            = description.flags.contains(DescriptorSetLayoutBehavior::PushDescriptor);
+        if (key.pushDescriptor && !device.supportsPushDescriptors()) {
+            throw std::runtime_error("Push descriptors aren't supported by the device.");
+        }
+        // NOTE: Would need the descriptor buffer push descriptors feature, which isn't requested.
+        if (key.pushDescriptor && descriptorBuffers) {
+            throw std::runtime_error("Push descriptors aren't supported with descriptor buffers.");
+        }
+
+        key.bindings.reserve(description.bindings.size());
+        for (const auto& binding : description.bindings) {
+            const bool dynamic = binding.type == DescriptorType::UniformBufferDynamic
+                                 || binding.type == DescriptorType::StorageBufferDynamic;
+            if (descriptorBuffers && dynamic) {
+                throw std::invalid_argument(
+                    "Dynamic buffer descriptors aren't supported with descriptor buffers.");
+            }
+            if (key.pushDescriptor && dynamic) {
+                throw std::invalid_argument(
+                    "Dynamic buffer descriptors aren't supported in push descriptor layouts.");
+            }
+
+            key.bindings.push_back(
+                {.binding = vk::DescriptorSetLayoutBinding()
+                                .setBinding(binding.binding)
+                                .setDescriptorType(toVkDescriptorType(binding.type))
+                                .setDescriptorCount(binding.count)
+                                .setStageFlags(toVkShaderStageFlags(binding.stages))
+                                .setPImmutableSamplers(nullptr),
+                 .flags = toVkDescriptorBindingFlags(binding.flags & ~ignoredFlags)});
+        }
+        std::sort(key.bindings.begin(), key.bindings.end(), [](const auto& a, const auto& b) {
+            return a.binding.binding < b.binding.binding;
+        });
+
+        return key;
+    }
+
+    vk::WriteDescriptorSet toVkWriteDescriptorSet(const DescriptorWriteDescription& write,
+                                                  vk::DescriptorBufferInfo* bufferInfos,
+                                                  vk::DescriptorImageInfo* imageInfos,
+                                                  vk::BufferView* bufferViews) {
+        auto vkWrite
+            = vk::WriteDescriptorSet()
+                  .setDstBinding(write.dstBinding)
+                  .setDstArrayElement(write.dstArrayElement)
+                  .setDescriptorType(toVkDescriptorType(write.descriptorType));
+
+        const size_t nonEmptyCount = (!write.buffers.empty() ? 1 : 0)
+                                     + (!write.images.empty() ? 1 : 0)
+                                     + (!write.texelBuffers.empty() ? 1 : 0);
+
+        if (nonEmptyCount > 1) {
+            throw std::invalid_argument(
+                "Only one of buffers, images, or texelBuffers fields can be non-empty in "
+                "DescriptorWriteDescription.");
+        }
+
+        if (!write.buffers.empty()) {
+            for (size_t i = 0; i < write.buffers.size(); ++i) {
+                const auto& bufferView = write.buffers[i];
+                if (!bufferView.buffer) {
+                    throw std::invalid_argument(
+                        "buffer in DescriptorWriteDescriptorGPUBufferDescription is null.");
+                }
+
+                bufferInfos[i]
+                    = vk::DescriptorBufferInfo()
+                          .setBuffer(vulkanCast<VulkanBuffer>(*bufferView.buffer).getVkBuffer())
+                          .setOffset(bufferView.offset)
+                          .setRange(bufferView.range == WHOLE_BUFFER_SIZE ? vk::WholeSize
+                                                                          : bufferView.range);
+            }
+            return vkWrite.setDescriptorCount(static_cast<uint32_t>(write.buffers.size()))
+                .setPBufferInfo(bufferInfos);
+        } else if (!write.images.empty()) {
+            // NOTE: Samplers are only read by sampler descriptors and image views by every other
+            // image descriptor.
+            const bool sampler = write.descriptorType == DescriptorType::Sampler
+                                 || write.descriptorType == DescriptorType::CombinedImageSampler;
+            const bool imageView = write.descriptorType != DescriptorType::Sampler;
+
+            for (size_t i = 0; i < write.images.size(); ++i) {
+                const auto& image = write.images[i];
+                if (sampler && !image.sampler) {
+                    throw std::invalid_argument(
+                        "sampler in DescriptorWriteDescriptorGPUImageDescription is null.");
+                }
+                if (imageView && !image.imageView) {
+                    throw std::invalid_argument(
+                        "imageView in DescriptorWriteDescriptorGPUImageDescription is null.");
+                }
+
+                auto vkImageInfo = vk::DescriptorImageInfo();
+                if (sampler) {
+                    vkImageInfo.setSampler(
+                        vulkanCast<VulkanSampler>(*image.sampler).getVkSampler());
+                }
+                if (imageView) {
+                    vkImageInfo
+                        .setImageView(
+                            vulkanCast<VulkanImageView>(*image.imageView).getVkImageView())
+                        .setImageLayout(toVkImageLayout(image.imageLayout));
+                }
+                imageInfos[i] = vkImageInfo;
+            }
+            return vkWrite.setDescriptorCount(static_cast<uint32_t>(write.images.size()))
+                .setPImageInfo(imageInfos);
+        } else if (!write.texelBuffers.empty()) {
+            for (size_t i = 0; i < write.texelBuffers.size(); ++i) {
+                const auto& bufferView = write.texelBuffers[i];
+                if (!bufferView.bufferView) {
+                    throw std::invalid_argument(
+                        "bufferView in DescriptorWriteDescriptorTexelBufferViewDescription is "
+                        "null.");
+                }
+
+                bufferViews[i]
+                    = vulkanCast<VulkanBufferView>(*bufferView.bufferView).getVkBufferView();
+            }
+            return vkWrite.setDescriptorCount(static_cast<uint32_t>(write.texelBuffers.size()))
+                .setPTexelBufferView(bufferViews);
+        } else {
+            throw std::invalid_argument(
+                "At least one of buffers, images, or texelBuffers fields must be non-empty in "
+                "DescriptorWriteDescription.");
+        }
+
+        return vkWrite;
+    }
+
     VulkanDescriptorSetLayout::VulkanDescriptorSetLayout(
         VulkanDevice& device, const DescriptorSetLayoutDescription& description)
         : device_(device.getVkDevice()) {
+        const bool descriptorBuffers = device.usesDescriptorBuffers();
+        auto layoutKey = std::make_shared<const VulkanDescriptorSetLayoutKey>(
+            toVulkanDescriptorSetLayoutKey(device, description));
+
         std::vector<vk::DescriptorSetLayoutBinding> vkBindings;
-        vkBindings.reserve(description.bindings.size());
+        vkBindings.reserve(layoutKey->bindings.size());
+        std::vector<vk::DescriptorBindingFlags> vkBindingFlags;
+        vkBindingFlags.reserve(layoutKey->bindings.size());
 
-        for (const auto& binding : description.bindings) {
-            vkBindings.push_back(vk::DescriptorSetLayoutBinding()
-                                     .setBinding(binding.binding)
-                                     .setDescriptorType(toVkDescriptorType(binding.type))
-                                     .setDescriptorCount(binding.count)
-                                     .setStageFlags(toVkShaderStageFlags(binding.stages))
-                                     .setPImmutableSamplers(nullptr));
+        bool bindingFlags = false;
+        bool updateAfterBind = false;
+        for (const auto& binding : layoutKey->bindings) {
+            vkBindings.push_back(binding.binding);
+            vkBindingFlags.push_back(binding.flags);
+
+            bindingFlags = bindingFlags || static_cast<bool>(binding.flags);
+            updateAfterBind
+                = updateAfterBind
+                  || static_cast<bool>(binding.flags
+                                       & vk::DescriptorBindingFlagBits::eUpdateAfterBind);
+        }
+
+        auto bindingFlagsCreateInfo
+            = vk::DescriptorSetLayoutBindingFlagsCreateInfo().setBindingFlags(vkBindingFlags);
+
+        auto createInfo = vk::DescriptorSetLayoutCreateInfo().setBindings(vkBindings);
+        if (bindingFlags) {
+            createInfo.setPNext(&bindingFlagsCreateInfo);
+        }
+        if (updateAfterBind) {
+            createInfo.setFlags(vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool);
+        }
+        if (descriptorBuffers) {
+            createInfo.setFlags(vk::DescriptorSetLayoutCreateFlagBits::eDescriptorBufferEXT);
         }
+        if (layoutKey->pushDescriptor) {
+            createInfo.flags |= vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptorKHR;
+        }
+
+        descriptorSetLayout_ = device_.createDescriptorSetLayout(createInfo);
+        layoutKey_ = std::move(layoutKey);
 
-        descriptorSetLayout_ = device_.createDescriptorSetLayout(
-            vk::DescriptorSetLayoutCreateInfo().setBindings(vkBindings));
+        if (descriptorBuffers) {
+            descriptorBufferLayout_ = std::make_shared<const VulkanDescriptorBufferLayout>(
+                toVulkanDescriptorBufferLayout(device, descriptorSetLayout_, description));
+        }
     }
 
     VulkanDescriptorSetLayout::VulkanDescriptorSetLayout(
@@ -32,7 +247,9 @@ namespace aetherion {
     VulkanDescriptorSetLayout::VulkanDescriptorSetLayout(VulkanDescriptorSetLayout&& other) noexcept
         : IDescriptorSetLayout(std::move(other)),
           device_(other.device_),
-          descriptorSetLayout_(other.descriptorSetLayout_) {
+          descriptorSetLayout_(other.descriptorSetLayout_),
+          descriptorBufferLayout_(std::move(other.descriptorBufferLayout_)),
+          layoutKey_(std::move(other.layoutKey_)) {
         other.device_ = nullptr;
         other.descriptorSetLayout_ = nullptr;
     }
@@ -45,6 +262,8 @@ namespace aetherion {
             IDescriptorSetLayout::operator=(std::move(other));
             device_ = other.device_;
             descriptorSetLayout_ = other.descriptorSetLayout_;
+            descriptorBufferLayout_ = std::move(other.descriptorBufferLayout_);
+            layoutKey_ = std::move(other.layoutKey_);
 
             other.release();
         }
@@ -57,24 +276,37 @@ namespace aetherion {
             descriptorSetLayout_ = nullptr;
         }
         device_ = nullptr;
+        descriptorBufferLayout_.reset();
+        layoutKey_.reset();
     }
 
     void VulkanDescriptorSetLayout::release() noexcept {
         descriptorSetLayout_ = nullptr;
         device_ = nullptr;
+        descriptorBufferLayout_.reset();
+        layoutKey_.reset();
     }
 
     std::vector<std::unique_ptr<IDescriptorSet>> VulkanDescriptorSet::allocateDescriptorSets(
         IGPUDevice& device, IDescriptorPool& pool,
         std::span<const DescriptorSetDescription> descriptions) {
-        return allocateDescriptorSets(
-            dynamic_cast<VulkanDevice&>(device).getVkDevice(),
-            dynamic_cast<VulkanDescriptorPool&>(pool).getVkDescriptorPool(), descriptions);
+        return allocateDescriptorSets(vulkanCast<VulkanDevice>(device),
+                                      vulkanCast<VulkanDescriptorPool>(pool), descriptions);
     }
 
     std::vector<std::unique_ptr<IDescriptorSet>> VulkanDescriptorSet::allocateDescriptorSets(
         VulkanDevice& device, VulkanDescriptorPool& pool,
         std::span<const DescriptorSetDescription> descriptions) {
+        if (pool.usesDescriptorBuffer()) {
+            std::vector<std::unique_ptr<IDescriptorSet>> descriptorSets;
+            descriptorSets.reserve(descriptions.size());
+            for (const auto& description : descriptions) {
+                descriptorSets.push_back(
+                    std::make_unique<VulkanDescriptorSet>(device, pool, description));
+            }
+            return descriptorSets;
+        }
+
         return allocateDescriptorSets(device.getVkDevice(), pool.getVkDescriptorPool(),
                                       descriptions);
     }
@@ -89,8 +321,11 @@ namespace aetherion {
             if (!description.layout) {
                 throw std::invalid_argument("layout in DescriptorSetDescription is null.");
             }
-            const auto* vkLayout
-                = dynamic_cast<const VulkanDescriptorSetLayout*>(description.layout);
+            const auto* vkLayout = vulkanCast<VulkanDescriptorSetLayout>(description.layout);
+            if (vkLayout->isPushDescriptor()) {
+                throw std::invalid_argument(
+                    "Descriptor sets can't be allocated with a push descriptor layout.");
+            }
             vkLayouts.push_back(vkLayout->getVkDescriptorSetLayout());
         }
 
@@ -111,12 +346,30 @@ namespace aetherion {
     VulkanDescriptorSet::VulkanDescriptorSet(VulkanDevice& device, VulkanDescriptorPool& pool,
                                              const DescriptorSetDescription& description)
         : device_(device.getVkDevice()),
+          deletionQueue_(device.getDeletionQueue()),
           pool_(pool.getVkDescriptorPool()),
           shouldFreeDescriptorSet(pool.supportsFreeDescriptorSet()) {
         if (!description.layout) {
             throw std::invalid_argument("layout in DescriptorSetDescription is null.");
         }
-        const auto* vkLayout = dynamic_cast<const VulkanDescriptorSetLayout*>(description.layout);
+        const auto* vkLayout = vulkanCast<VulkanDescriptorSetLayout>(description.layout);
+        if (vkLayout->isPushDescriptor()) {
+            throw std::invalid_argument(
+                "Descriptor sets can't be allocated with a push descriptor layout.");
+        }
+
+        if (pool.usesDescriptorBuffer()) {
+            descriptorBufferLayout_ = vkLayout->getDescriptorBufferLayout();
+            if (!descriptorBufferLayout_) {
+                throw std::invalid_argument(
+                    "Descriptor buffer sets need a layout created for descriptor buffers.");
+            }
+            descriptorBufferOffset_
+                = pool.allocateDescriptorBufferRange(descriptorBufferLayout_->size);
+            descriptorBufferPool_ = &pool;
+            descriptorBufferPoolGeneration_ = pool.getGeneration();
+            return;
+        }
 
         auto vkLayoutHandle = vkLayout->getVkDescriptorSetLayout();
 
@@ -136,18 +389,34 @@ namespace aetherion {
           descriptorSet_(descriptorSet),
           shouldFreeDescriptorSet(shouldFree) {}
 
+    VulkanDescriptorSet::VulkanDescriptorSet(
+        VulkanDescriptorPool& pool, std::shared_ptr<const VulkanDescriptorBufferLayout> layout,
+        vk::DeviceSize offset, bool shouldFree)
+        : shouldFreeDescriptorSet(shouldFree),
+          descriptorBufferPool_(&pool),
+          descriptorBufferLayout_(std::move(layout)),
+          descriptorBufferOffset_(offset),
+          descriptorBufferPoolGeneration_(pool.getGeneration()) {}
+
     VulkanDescriptorSet::~VulkanDescriptorSet() noexcept { clear(); }
 
     VulkanDescriptorSet::VulkanDescriptorSet(VulkanDescriptorSet&& other) noexcept
         : IDescriptorSet(std::move(other)),
           device_(other.device_),
+          deletionQueue_(other.deletionQueue_),
           pool_(other.pool_),
           descriptorSet_(other.descriptorSet_),
-          shouldFreeDescriptorSet(other.shouldFreeDescriptorSet) {
+          shouldFreeDescriptorSet(other.shouldFreeDescriptorSet),
+          descriptorBufferPool_(other.descriptorBufferPool_),
+          descriptorBufferLayout_(std::move(other.descriptorBufferLayout_)),
+          descriptorBufferOffset_(other.descriptorBufferOffset_),
+          descriptorBufferPoolGeneration_(other.descriptorBufferPoolGeneration_) {
         other.device_ = nullptr;
+        other.deletionQueue_ = nullptr;
         other.pool_ = nullptr;
         other.descriptorSet_ = nullptr;
         other.shouldFreeDescriptorSet = false;
+        other.descriptorBufferPool_ = nullptr;
     }
 
     VulkanDescriptorSet& VulkanDescriptorSet::operator=(VulkanDescriptorSet&& other) noexcept {
@@ -156,9 +425,14 @@ namespace aetherion {
 
             IDescriptorSet::operator=(std::move(other));
             device_ = other.device_;
+            deletionQueue_ = other.deletionQueue_;
             pool_ = other.pool_;
             descriptorSet_ = other.descriptorSet_;
             shouldFreeDescriptorSet = other.shouldFreeDescriptorSet;
+            descriptorBufferPool_ = other.descriptorBufferPool_;
+            descriptorBufferLayout_ = std::move(other.descriptorBufferLayout_);
+            descriptorBufferOffset_ = other.descriptorBufferOffset_;
+            descriptorBufferPoolGeneration_ = other.descriptorBufferPoolGeneration_;
 
             other.release();
         }
@@ -166,42 +440,370 @@ namespace aetherion {
     }
 
     void VulkanDescriptorSet::clear() noexcept {
-        if (descriptorSet_ && device_ && pool_ && shouldFreeDescriptorSet) {
+        // NOTE: The GPU may still read the range, so it's only reused right away without deferred
+        // destruction. Sets freed by a reset of the pool are skipped.
+        const bool freeDescriptorBufferRange
+            = descriptorBufferPool_ && shouldFreeDescriptorSet
+              && descriptorBufferPoolGeneration_ == descriptorBufferPool_->getGeneration();
+        if (freeDescriptorBufferRange && deletionQueue_) {
+            deletionQueue_->enqueue(
+                VulkanDescriptorBufferRange{.pool = descriptorBufferPool_,
+                                            .offset = descriptorBufferOffset_,
+                                            .size = descriptorBufferLayout_->size});
+        } else if (freeDescriptorBufferRange) {
+            descriptorBufferPool_->freeDescriptorBufferRange(descriptorBufferOffset_,
+                                                             descriptorBufferLayout_->size);
+        } else if (descriptorSet_ && deletionQueue_ && pool_ && shouldFreeDescriptorSet) {
+            deletionQueue_->enqueue(descriptorSet_, nullptr, nullptr, pool_);
+        } else if (descriptorSet_ && device_ && pool_ && shouldFreeDescriptorSet) {
             device_.freeDescriptorSets(pool_, 1, &descriptorSet_);
-            descriptorSet_ = nullptr;
         }
-        device_ = nullptr;
-        pool_ = nullptr;
-        shouldFreeDescriptorSet = false;
+        release();
     }
 
     void VulkanDescriptorSet::release() noexcept {
         descriptorSet_ = nullptr;
         device_ = nullptr;
+        deletionQueue_ = nullptr;
         pool_ = nullptr;
         shouldFreeDescriptorSet = false;
+        descriptorBufferPool_ = nullptr;
+        descriptorBufferLayout_.reset();
+        descriptorBufferOffset_ = 0;
+        descriptorBufferPoolGeneration_ = 0;
+    }
+
+    std::span<std::byte> VulkanDescriptorSet::getDescriptorBufferElement(
+        const VulkanDescriptorBufferBinding& binding, uint32_t element, bool sampler) const {
+        std::byte* data = descriptorBufferPool_->getDescriptorBufferData() + descriptorBufferOffset_
+                          + binding.offset;
+        if (!binding.splitImageSize) {
+            return {data + element * binding.descriptorSize, binding.descriptorSize};
+        }
+
+        const size_t samplerSize = binding.descriptorSize - binding.splitImageSize;
+        if (sampler) {
+            return {data + binding.count * binding.splitImageSize + element * samplerSize,
+                    samplerSize};
+        }
+        return {data + element * binding.splitImageSize, binding.splitImageSize};
+    }
+
+    void VulkanDescriptorSet::writeDescriptors(const VulkanDevice& device,
+                                               const DescriptorWriteDescription& write) {
+        if (!descriptorBufferPool_) {
+            throw std::runtime_error("Only descriptor buffer sets can be written directly.");
+        }
+
+        const auto& bindings = descriptorBufferLayout_->bindings;
+        if (write.dstBinding >= bindings.size() || bindings[write.dstBinding].count == 0) {
+            throw std::invalid_argument(
+                "dstBinding in DescriptorWriteDescription isn't in the set layout.");
+        }
+        const auto& binding = bindings[write.dstBinding];
+
+        const auto type = toVkDescriptorType(write.descriptorType);
+        if (type != binding.type) {
+            throw std::invalid_argument(
+                "descriptorType in DescriptorWriteDescription doesn't match the binding.");
+        }
+
+        const size_t count = !write.buffers.empty()  ? write.buffers.size()
+                             : !write.images.empty() ? write.images.size()
+                                                     : write.texelBuffers.size();
+        if (count == 0) {
+            throw std::invalid_argument(
+                "At least one of buffers, images, or texelBuffers fields must be non-empty in "
+                "DescriptorWriteDescription.");
+        }
+        if (write.dstArrayElement + count > binding.count) {
+            throw std::invalid_argument(
+                "DescriptorWriteDescription writes past the end of the binding.");
+        }
+
+        // NOTE: Samplers are only read by sampler descriptors and image views by every other
+        // image descriptor.
+        const bool sampler = type == vk::DescriptorType::eSampler
+                             || type == vk::DescriptorType::eCombinedImageSampler;
+        const bool imageView = type != vk::DescriptorType::eSampler;
+
+        // NOTE: Split descriptors are built here and then scattered into both arrays.
+        std::vector<std::byte> splitDescriptor(binding.splitImageSize ? binding.descriptorSize : 0);
+
+        for (uint32_t i = 0; i < count; ++i) {
+            vk::Sampler vkSampler;
+            vk::DescriptorImageInfo vkImageInfo;
+            vk::DescriptorAddressInfoEXT vkAddressInfo;
+            vk::DescriptorDataEXT vkData;
+
+            if (!write.buffers.empty()) {
+                const auto& bufferView = write.buffers[i];
+                if (!bufferView.buffer) {
+                    throw std::invalid_argument(
+                        "buffer in DescriptorWriteDescriptorGPUBufferDescription is null.");
+                }
+
+                const auto& buffer = vulkanCast<VulkanBuffer>(*bufferView.buffer);
+                vkAddressInfo.setAddress(buffer.getDeviceAddress() + bufferView.offset)
+                    .setRange(bufferView.range == WHOLE_BUFFER_SIZE
+                                  ? buffer.getSize() - bufferView.offset
+                                  : bufferView.range);
+                if (type == vk::DescriptorType::eUniformBuffer) {
+                    vkData.setPUniformBuffer(&vkAddressInfo);
+                } else {
+                    vkData.setPStorageBuffer(&vkAddressInfo);
+                }
+            } else if (!write.images.empty()) {
+                const auto& image = write.images[i];
+                if (sampler && !image.sampler) {
+                    throw std::invalid_argument(
+                        "sampler in DescriptorWriteDescriptorGPUImageDescription is null.");
+                }
+                if (imageView && !image.imageView) {
+                    throw std::invalid_argument(
+                        "imageView in DescriptorWriteDescriptorGPUImageDescription is null.");
+                }
+
+                if (sampler) {
+                    vkSampler = vulkanCast<VulkanSampler>(*image.sampler).getVkSampler();
+                    vkImageInfo.setSampler(vkSampler);
+                }
+                if (imageView) {
+                    vkImageInfo
+                        .setImageView(
+                            vulkanCast<VulkanImageView>(*image.imageView).getVkImageView())
+                        .setImageLayout(toVkImageLayout(image.imageLayout));
+                }
+
+                switch (type) {
+                    case vk::DescriptorType::eSampler:
+                        vkData.setPSampler(&vkSampler);
+                        break;
+                    case vk::DescriptorType::eCombinedImageSampler:
+                        vkData.setPCombinedImageSampler(&vkImageInfo);
+                        break;
+                    case vk::DescriptorType::eSampledImage:
+                        vkData.setPSampledImage(&vkImageInfo);
+                        break;
+                    case vk::DescriptorType::eStorageImage:
+                        vkData.setPStorageImage(&vkImageInfo);
+                        break;
+                    case vk::DescriptorType::eInputAttachment:
+                        vkData.setPInputAttachmentImage(&vkImageInfo);
+                        break;
+                    default:
+                        throw std::invalid_argument(
+                            "images in DescriptorWriteDescription need an image descriptor type.");
+                }
+            } else {
+                const auto& texelBuffer = write.texelBuffers[i];
+                if (!texelBuffer.bufferView) {
+                    throw std::invalid_argument(
+                        "bufferView in DescriptorWriteDescriptorTexelBufferViewDescription is "
+                        "null.");
+                }
+
+                vkAddressInfo = vulkanCast<VulkanBufferView>(*texelBuffer.bufferView)
+                                    .getVkDescriptorAddressInfo();
+                if (type == vk::DescriptorType::eUniformTexelBuffer) {
+                    vkData.setPUniformTexelBuffer(&vkAddressInfo);
+                } else {
+                    vkData.setPStorageTexelBuffer(&vkAddressInfo);
+                }
+            }
+
+            writeDescriptorBufferElement(device, binding, write.dstArrayElement + i,
+                                         vk::DescriptorGetInfoEXT().setType(type).setData(vkData),
+                                         splitDescriptor);
+        }
+    }
+
+    void VulkanDescriptorSet::writePackedDescriptors(const VulkanDevice& device,
+                                                     const vk::DescriptorUpdateTemplateEntry& entry,
+                                                     const std::byte* data) {
+        if (!descriptorBufferPool_) {
+            throw std::runtime_error("Only descriptor buffer sets can be written directly.");
+        }
+
+        const auto& bindings = descriptorBufferLayout_->bindings;
+        if (entry.dstBinding >= bindings.size() || bindings[entry.dstBinding].count == 0) {
+            throw std::invalid_argument("Update template entry binding isn't in the set layout.");
+        }
+        const auto& binding = bindings[entry.dstBinding];
+        if (entry.descriptorType != binding.type) {
+            throw std::invalid_argument(
+                "Update template entry descriptor type doesn't match the binding.");
+        }
+        if (entry.dstArrayElement + entry.descriptorCount > binding.count) {
+            throw std::invalid_argument(
+                "Update template entry writes past the end of the binding.");
+        }
+
+        std::vector<std::byte> splitDescriptor(binding.splitImageSize ? binding.descriptorSize : 0);
+
+        for (uint32_t i = 0; i < entry.descriptorCount; ++i) {
+            const std::byte* packed = data + entry.offset + i * entry.stride;
+
+            vk::DescriptorImageInfo vkImageInfo;
+            VulkanPackedDescriptorAddress packedAddress;
+            vk::DescriptorAddressInfoEXT vkAddressInfo;
+            vk::DescriptorDataEXT vkData;
+
+            switch (entry.descriptorType) {
+                case vk::DescriptorType::eSampler:
+                case vk::DescriptorType::eCombinedImageSampler:
+                case vk::DescriptorType::eSampledImage:
+                case vk::DescriptorType::eStorageImage:
+                case vk::DescriptorType::eInputAttachment:
+                    std::memcpy(&vkImageInfo, packed, sizeof(vkImageInfo));
+                    break;
+                default:
+                    std::memcpy(&packedAddress, packed, sizeof(packedAddress));
+                    vkAddressInfo.setAddress(packedAddress.address)
+                        .setRange(packedAddress.range)
+                        .setFormat(packedAddress.format);
+                    break;
+            }
+
+            switch (entry.descriptorType) {
+                case vk::DescriptorType::eSampler:
+                    vkData.setPSampler(&vkImageInfo.sampler);
+                    break;
+                case vk::DescriptorType::eCombinedImageSampler:
+                    vkData.setPCombinedImageSampler(&vkImageInfo);
+                    break;
+                case vk::DescriptorType::eSampledImage:
+                    vkData.setPSampledImage(&vkImageInfo);
+                    break;
+                case vk::DescriptorType::eStorageImage:
+                    vkData.setPStorageImage(&vkImageInfo);
+                    break;
+                case vk::DescriptorType::eInputAttachment:
+                    vkData.setPInputAttachmentImage(&vkImageInfo);
+                    break;
+                case vk::DescriptorType::eUniformBuffer:
+                    vkData.setPUniformBuffer(&vkAddressInfo);
+                    break;
+                case vk::DescriptorType::eStorageBuffer:
+                    vkData.setPStorageBuffer(&vkAddressInfo);
+                    break;
+                case vk::DescriptorType::eUniformTexelBuffer:
+                    vkData.setPUniformTexelBuffer(&vkAddressInfo);
+                    break;
+                case vk::DescriptorType::eStorageTexelBuffer:
+                    vkData.setPStorageTexelBuffer(&vkAddressInfo);
+                    break;
+                default:
+                    throw std::invalid_argument(
+                        "Update template entry descriptor type isn't supported with descriptor "
+                        "buffers.");
+            }
+
+            writeDescriptorBufferElement(
+                device, binding, entry.dstArrayElement + i,
+                vk::DescriptorGetInfoEXT().setType(entry.descriptorType).setData(vkData),
+                splitDescriptor);
+        }
+    }
+
+    void VulkanDescriptorSet::writeDescriptorBufferElement(
+        const VulkanDevice& device, const VulkanDescriptorBufferBinding& binding, uint32_t element,
+        const vk::DescriptorGetInfoEXT& getInfo, std::span<std::byte> splitDescriptor) {
+        const auto vkDevice = device.getVkDevice();
+        const auto& dispatcher = device.getDispatcher();
+
+        if (!binding.splitImageSize) {
+            const auto descriptor = getDescriptorBufferElement(binding, element);
+            vkDevice.getDescriptorEXT(getInfo, descriptor.size(), descriptor.data(), dispatcher);
+            return;
+        }
+
+        vkDevice.getDescriptorEXT(getInfo, splitDescriptor.size(), splitDescriptor.data(),
+                                  dispatcher);
+
+        const auto imageDescriptor = getDescriptorBufferElement(binding, element);
+        const auto samplerDescriptor = getDescriptorBufferElement(binding, element, true);
+        std::memcpy(imageDescriptor.data(), splitDescriptor.data(), imageDescriptor.size());
+        std::memcpy(samplerDescriptor.data(), splitDescriptor.data() + imageDescriptor.size(),
+                    samplerDescriptor.size());
+    }
+
+    void VulkanDescriptorSet::copyDescriptors(const VulkanDescriptorSet& src,
+                                              const DescriptorCopyDescription& copy) {
+        if (!descriptorBufferPool_ || !src.descriptorBufferPool_) {
+            throw std::runtime_error("Only descriptor buffer sets can be copied directly.");
+        }
+
+        const auto& srcBindings = src.descriptorBufferLayout_->bindings;
+        const auto& dstBindings = descriptorBufferLayout_->bindings;
+        if (copy.srcBinding >= srcBindings.size() || copy.dstBinding >= dstBindings.size()) {
+            throw std::invalid_argument(
+                "srcBinding or dstBinding in DescriptorCopyDescription isn't in the set layout.");
+        }
+        const auto& srcBinding = srcBindings[copy.srcBinding];
+        const auto& dstBinding = dstBindings[copy.dstBinding];
+
+        if (srcBinding.type != dstBinding.type) {
+            throw std::invalid_argument(
+                "DescriptorCopyDescription copies between bindings of different types.");
+        }
+        if (copy.srcArrayElement + copy.descriptorCount > srcBinding.count
+            || copy.dstArrayElement + copy.descriptorCount > dstBinding.count) {
+            throw std::invalid_argument(
+                "DescriptorCopyDescription copies past the end of the bindings.");
+        }
+
+        for (uint32_t i = 0; i < copy.descriptorCount; ++i) {
+            const auto srcDescriptor
+                = src.getDescriptorBufferElement(srcBinding, copy.srcArrayElement + i);
+            const auto dstDescriptor
+                = getDescriptorBufferElement(dstBinding, copy.dstArrayElement + i);
+            std::memmove(dstDescriptor.data(), srcDescriptor.data(), dstDescriptor.size());
+
+            if (dstBinding.splitImageSize) {
+                const auto srcSampler
+                    = src.getDescriptorBufferElement(srcBinding, copy.srcArrayElement + i, true);
+                const auto dstSampler
+                    = getDescriptorBufferElement(dstBinding, copy.dstArrayElement + i, true);
+                std::memmove(dstSampler.data(), srcSampler.data(), dstSampler.size());
+            }
+        }
     }
 
     void VulkanDescriptorSet::freeDescriptorSets(
         IGPUDevice& device, IDescriptorPool& pool,
         std::span<std::reference_wrapper<IDescriptorSet>> descriptorSets) {
+        if (vulkanCast<VulkanDescriptorPool>(pool).usesDescriptorBuffer()) {
+            for (auto& descriptorSet : descriptorSets) {
+                vulkanCast<VulkanDescriptorSet>(descriptorSet.get()).clear();
+            }
+            return;
+        }
+
         std::vector<vk::DescriptorSet> vkDescriptorSets;
         vkDescriptorSets.reserve(descriptorSets.size());
 
         for (auto& descriptorSet : descriptorSets) {
-            auto& vkDescriptorSet = dynamic_cast<VulkanDescriptorSet&>(descriptorSet.get());
+            auto& vkDescriptorSet = vulkanCast<VulkanDescriptorSet>(descriptorSet.get());
             vkDescriptorSets.push_back(vkDescriptorSet.getVkDescriptorSet());
             vkDescriptorSet.release();
         }
 
-        freeDescriptorSets(dynamic_cast<VulkanDevice&>(device).getVkDevice(),
-                           dynamic_cast<VulkanDescriptorPool&>(pool).getVkDescriptorPool(),
+        freeDescriptorSets(vulkanCast<VulkanDevice>(device).getVkDevice(),
+                           vulkanCast<VulkanDescriptorPool>(pool).getVkDescriptorPool(),
                            vkDescriptorSets);
     }
 
     void VulkanDescriptorSet::freeDescriptorSets(
         VulkanDevice& device, VulkanDescriptorPool& pool,
         std::span<std::reference_wrapper<VulkanDescriptorSet>> descriptorSets) {
+        if (pool.usesDescriptorBuffer()) {
+            for (auto& descriptorSet : descriptorSets) {
+                descriptorSet.get().clear();
+            }
+            return;
+        }
+
         std::vector<vk::DescriptorSet> vkDescriptorSets;
         vkDescriptorSets.reserve(descriptorSets.size());
 
@@ -221,8 +823,55 @@ namespace aetherion {
     VulkanDescriptorPool::VulkanDescriptorPool(VulkanDevice& device,
                                                const DescriptorPoolDescription& description)
         : device_(device.getVkDevice()),
+          deletionQueue_(device.getDeletionQueue()),
           freeDescriptorSetSupport_(
               description.flags.contains(DescriptorPoolBehavior::FreeIndividualSets)) {
+        if (device.usesDescriptorBuffers()) {
+            allocator_ = device.getVmaAllocator();
+            descriptorBufferAlignment_
+                = device.getDescriptorBufferProperties().descriptorBufferOffsetAlignment;
+            maxSets_ = description.maxSets;
+
+            descriptorBufferUsage_ = vk::BufferUsageFlagBits::eShaderDeviceAddress;
+            for (const auto& size : description.poolSizes) {
+                const auto type = toVkDescriptorType(size.type);
+                const vk::DeviceSize descriptorSize = device.getDescriptorSize(type);
+                descriptorBufferSize_ += size.count * descriptorSize;
+                // NOTE: Layout sizes include the padding in front of every binding, which drivers
+                // align to the descriptor size. Reserved for one binding of each type per set.
+                descriptorBufferSize_ += std::min(size.count, description.maxSets)
+                                         * (std::bit_ceil(descriptorSize) - 1);
+
+                const bool sampler = type == vk::DescriptorType::eSampler
+                                     || type == vk::DescriptorType::eCombinedImageSampler;
+                descriptorBufferUsage_
+                    |= sampler ? vk::BufferUsageFlagBits::eSamplerDescriptorBufferEXT
+                               : vk::BufferUsageFlagBits::eResourceDescriptorBufferEXT;
+            }
+            // NOTE: Every set may need padding up to the offset alignment. The size is still an
+            // estimate, sets with more bindings can exhaust the buffer before maxSets. Allocations
+            // then fail with vk::OutOfPoolMemoryError and callers allocate from another pool, like
+            // they do when the pool sizes of a descriptor pool don't fit.
+            descriptorBufferSize_ += description.maxSets * descriptorBufferAlignment_;
+
+            // NOTE: Coherent so the descriptors written by the CPU don't need flushing.
+            std::tie(descriptorBuffer_, descriptorBufferAllocation_) = allocator_.createBuffer(
+                vk::BufferCreateInfo()
+                    .setSize(descriptorBufferSize_)
+                    .setUsage(descriptorBufferUsage_),
+                vma::AllocationCreateInfo()
+                    .setUsage(vma::MemoryUsage::eAuto)
+                    .setFlags(vma::AllocationCreateFlagBits::eMapped
+                              | vma::AllocationCreateFlagBits::eHostAccessSequentialWrite)
+                    .setRequiredFlags(vk::MemoryPropertyFlagBits::eHostCoherent));
+
+            descriptorBufferData_ = static_cast<std::byte*>(
+                allocator_.getAllocationInfo(descriptorBufferAllocation_).pMappedData);
+            descriptorBufferAddress_ = device_.getBufferAddress(
+                vk::BufferDeviceAddressInfo().setBuffer(descriptorBuffer_));
+            return;
+        }
+
         std::vector<vk::DescriptorPoolSize> poolSizes;
         poolSizes.reserve(description.poolSizes.size());
         for (const auto& size : description.poolSizes) {
@@ -251,11 +900,29 @@ namespace aetherion {
     VulkanDescriptorPool::VulkanDescriptorPool(VulkanDescriptorPool&& other) noexcept
         : IDescriptorPool(std::move(other)),
           device_(other.device_),
+          deletionQueue_(other.deletionQueue_),
           descriptorPool_(other.descriptorPool_),
-          freeDescriptorSetSupport_(other.freeDescriptorSetSupport_) {
-        other.device_ = nullptr;
-        other.descriptorPool_ = nullptr;
-        other.freeDescriptorSetSupport_ = false;
+          freeDescriptorSetSupport_(other.freeDescriptorSetSupport_),
+          allocator_(other.allocator_),
+          descriptorBuffer_(other.descriptorBuffer_),
+          descriptorBufferAllocation_(other.descriptorBufferAllocation_),
+          descriptorBufferUsage_(other.descriptorBufferUsage_),
+          descriptorBufferAddress_(other.descriptorBufferAddress_),
+          descriptorBufferData_(other.descriptorBufferData_),
+          descriptorBufferSize_(other.descriptorBufferSize_),
+          descriptorBufferAlignment_(other.descriptorBufferAlignment_),
+          descriptorBufferHead_(other.descriptorBufferHead_),
+          freeDescriptorBufferRanges_(std::move(other.freeDescriptorBufferRanges_)),
+          maxSets_(other.maxSets_),
+          allocatedSets_(other.allocatedSets_),
+          generation_(other.generation_),
+          transientSets_(std::move(other.transientSets_)),
+          transientSetCount_(other.transientSetCount_) {
+        // NOTE: Pending range frees would otherwise reach the moved-from pool.
+        if (descriptorBuffer_ && deletionQueue_) {
+            deletionQueue_->retargetDescriptorBufferRanges(&other, this);
+        }
+        other.release();
     }
 
     VulkanDescriptorPool& VulkanDescriptorPool::operator=(VulkanDescriptorPool&& other) noexcept {
@@ -264,29 +931,390 @@ namespace aetherion {
 
             IDescriptorPool::operator=(std::move(other));
             device_ = other.device_;
+            deletionQueue_ = other.deletionQueue_;
             descriptorPool_ = other.descriptorPool_;
             freeDescriptorSetSupport_ = other.freeDescriptorSetSupport_;
+            allocator_ = other.allocator_;
+            descriptorBuffer_ = other.descriptorBuffer_;
+            descriptorBufferAllocation_ = other.descriptorBufferAllocation_;
+            descriptorBufferUsage_ = other.descriptorBufferUsage_;
+            descriptorBufferAddress_ = other.descriptorBufferAddress_;
+            descriptorBufferData_ = other.descriptorBufferData_;
+            descriptorBufferSize_ = other.descriptorBufferSize_;
+            descriptorBufferAlignment_ = other.descriptorBufferAlignment_;
+            descriptorBufferHead_ = other.descriptorBufferHead_;
+            freeDescriptorBufferRanges_ = std::move(other.freeDescriptorBufferRanges_);
+            maxSets_ = other.maxSets_;
+            allocatedSets_ = other.allocatedSets_;
+            generation_ = other.generation_;
+            transientSets_ = std::move(other.transientSets_);
+            transientSetCount_ = other.transientSetCount_;
 
+            if (descriptorBuffer_ && deletionQueue_) {
+                deletionQueue_->retargetDescriptorBufferRanges(&other, this);
+            }
             other.release();
         }
         return *this;
     }
 
-    void VulkanDescriptorPool::reset() { device_.resetDescriptorPool(descriptorPool_); }
+    void VulkanDescriptorPool::reset() {
+        transientSetCount_ = 0;
+
+        if (descriptorBuffer_) {
+            if (deletionQueue_) {
+                deletionQueue_->forgetDescriptorBufferRanges(this);
+            }
+            descriptorBufferHead_ = 0;
+            freeDescriptorBufferRanges_.clear();
+            allocatedSets_ = 0;
+            ++generation_;
+            return;
+        }
+
+        if (deletionQueue_) {
+            deletionQueue_->forgetDescriptorSets(descriptorPool_);
+        }
+        device_.resetDescriptorPool(descriptorPool_);
+    }
+
+    ResultValue<DescriptorSetAllocateResultCode, IDescriptorSet*>
+    VulkanDescriptorPool::allocateTransient(const DescriptorSetDescription& description) {
+        if (!description.layout) {
+            throw std::invalid_argument("layout in DescriptorSetDescription is null.");
+        }
+        const auto* vkLayout = vulkanCast<VulkanDescriptorSetLayout>(description.layout);
+        if (vkLayout->isPushDescriptor()) {
+            throw std::invalid_argument(
+                "Descriptor sets can't be allocated with a push descriptor layout.");
+        }
+
+        vk::Result result;
+        std::optional<VulkanDescriptorSet> descriptorSet;
+        if (descriptorBuffer_) {
+            const auto& bufferLayout = vkLayout->getDescriptorBufferLayout();
+            if (!bufferLayout) {
+                throw std::invalid_argument(
+                    "Descriptor buffer sets need a layout created for descriptor buffers.");
+            }
+
+            vk::DeviceSize offset = 0;
+            result = tryAllocateDescriptorBufferRange(bufferLayout->size, offset);
+            if (result == vk::Result::eSuccess) {
+                descriptorSet.emplace(*this, bufferLayout, offset);
+            }
+        } else {
+            const auto vkLayoutHandle = vkLayout->getVkDescriptorSetLayout();
+            const auto allocateInfo = vk::DescriptorSetAllocateInfo()
+                                          .setDescriptorPool(descriptorPool_)
+                                          .setDescriptorSetCount(1)
+                                          .setPSetLayouts(&vkLayoutHandle);
+
+            vk::DescriptorSet vkDescriptorSet;
+            result = device_.allocateDescriptorSets(&allocateInfo, &vkDescriptorSet);
+            if (result == vk::Result::eSuccess) {
+                descriptorSet.emplace(device_, descriptorPool_, vkDescriptorSet);
+            }
+        }
+
+        switch (result) {
+            case vk::Result::eSuccess:
+                break;
+            case vk::Result::eErrorOutOfPoolMemory:
+                return ResultValue<DescriptorSetAllocateResultCode, IDescriptorSet*>(
+                    DescriptorSetAllocateResultCode::OutOfPoolMemory);
+            case vk::Result::eErrorFragmentedPool:
+                return ResultValue<DescriptorSetAllocateResultCode, IDescriptorSet*>(
+                    DescriptorSetAllocateResultCode::FragmentedPool);
+            default:
+                throw(std::runtime_error("Failed to allocate descriptor set: "
+                                         + vk::to_string(result)));
+        }
+
+        // NOTE: Transient sets are never freed one by one, only by resetting the pool.
+        if (transientSetCount_ < transientSets_.size()) {
+            transientSets_[transientSetCount_] = std::move(*descriptorSet);
+        } else {
+            transientSets_.push_back(std::move(*descriptorSet));
+        }
+
+        return ResultValue<DescriptorSetAllocateResultCode, IDescriptorSet*>(
+            &transientSets_[transientSetCount_++]);
+    }
+
+    vk::DeviceSize VulkanDescriptorPool::allocateDescriptorBufferRange(vk::DeviceSize size) {
+        vk::DeviceSize offset = 0;
+        switch (tryAllocateDescriptorBufferRange(size, offset)) {
+            case vk::Result::eSuccess:
+                return offset;
+            case vk::Result::eErrorFragmentedPool:
+                throw vk::FragmentedPoolError("Descriptor buffer pool is fragmented.");
+            default:
+                throw vk::OutOfPoolMemoryError("Descriptor buffer pool is out of memory.");
+        }
+    }
+
+    vk::Result VulkanDescriptorPool::tryAllocateDescriptorBufferRange(vk::DeviceSize size,
+                                                                      vk::DeviceSize& offset) {
+        if (allocatedSets_ >= maxSets_) {
+            return vk::Result::eErrorOutOfPoolMemory;
+        }
+        size = (size + descriptorBufferAlignment_ - 1) & ~(descriptorBufferAlignment_ - 1);
+
+        // NOTE: First fit, the free ranges are sorted by offset and merged when freed.
+        vk::DeviceSize freeSize = 0;
+        for (auto it = freeDescriptorBufferRanges_.begin(); it != freeDescriptorBufferRanges_.end();
+             ++it) {
+            if (it->size >= size) {
+                offset = it->offset;
+                it->offset += size;
+                it->size -= size;
+                if (it->size == 0) {
+                    freeDescriptorBufferRanges_.erase(it);
+                }
+                ++allocatedSets_;
+                return vk::Result::eSuccess;
+            }
+            freeSize += it->size;
+        }
+
+        if (descriptorBufferHead_ + size > descriptorBufferSize_) {
+            if (freeSize + descriptorBufferSize_ - descriptorBufferHead_ >= size) {
+                return vk::Result::eErrorFragmentedPool;
+            }
+            return vk::Result::eErrorOutOfPoolMemory;
+        }
+
+        offset = descriptorBufferHead_;
+        descriptorBufferHead_ += size;
+        ++allocatedSets_;
+        return vk::Result::eSuccess;
+    }
+
+    void VulkanDescriptorPool::freeDescriptorBufferRange(vk::DeviceSize offset,
+                                                         vk::DeviceSize size) {
+        size = (size + descriptorBufferAlignment_ - 1) & ~(descriptorBufferAlignment_ - 1);
+
+        // NOTE: Merged with the free ranges next to it, and given back to the head if it ends
+        // there.
+        auto& ranges = freeDescriptorBufferRanges_;
+        auto range = std::lower_bound(
+            ranges.begin(), ranges.end(), offset,
+            [](const DescriptorBufferRange& freeRange, vk::DeviceSize rangeOffset) {
+                return freeRange.offset < rangeOffset;
+            });
+        const auto previous = range != ranges.begin() ? std::prev(range) : ranges.end();
+        if (previous != ranges.end() && previous->offset + previous->size == offset) {
+            range = previous;
+            range->size += size;
+        } else {
+            range = ranges.insert(range, {.offset = offset, .size = size});
+        }
+
+        const auto next = std::next(range);
+        if (next != ranges.end() && range->offset + range->size == next->offset) {
+            range->size += next->size;
+            ranges.erase(next);
+        }
+        if (range->offset + range->size == descriptorBufferHead_) {
+            descriptorBufferHead_ = range->offset;
+            ranges.erase(range);
+        }
+        --allocatedSets_;
+    }
 
     void VulkanDescriptorPool::clear() noexcept {
-        if (descriptorPool_ && device_) {
+        // NOTE: Pending range frees would reach the pool after it's gone.
+        if (descriptorBuffer_ && deletionQueue_) {
+            deletionQueue_->forgetDescriptorBufferRanges(this);
+        }
+        if (descriptorPool_ && deletionQueue_) {
+            deletionQueue_->enqueue(descriptorPool_);
+        } else if (descriptorPool_ && device_) {
             device_.destroyDescriptorPool(descriptorPool_);
-            descriptorPool_ = nullptr;
         }
-        device_ = nullptr;
-        freeDescriptorSetSupport_ = false;
+        if (descriptorBuffer_ && deletionQueue_) {
+            deletionQueue_->enqueue(descriptorBuffer_, allocator_, descriptorBufferAllocation_);
+        } else if (descriptorBuffer_ && allocator_) {
+            allocator_.destroyBuffer(descriptorBuffer_, descriptorBufferAllocation_);
+        }
+        release();
     }
 
     void VulkanDescriptorPool::release() noexcept {
         descriptorPool_ = nullptr;
         device_ = nullptr;
+        deletionQueue_ = nullptr;
         freeDescriptorSetSupport_ = false;
+        allocator_ = nullptr;
+        descriptorBuffer_ = nullptr;
+        descriptorBufferAllocation_ = nullptr;
+        descriptorBufferUsage_ = {};
+        descriptorBufferAddress_ = 0;
+        descriptorBufferData_ = nullptr;
+        descriptorBufferSize_ = 0;
+        descriptorBufferHead_ = 0;
+        freeDescriptorBufferRanges_.clear();
+        maxSets_ = 0;
+        allocatedSets_ = 0;
+        // NOTE: The sets only wrap handles owned by the pool, so they are dropped with it.
+        transientSets_.clear();
+        transientSetCount_ = 0;
+    }
+
+    PackedDescriptor VulkanDescriptorUpdateTemplate::packImageDescriptor(
+        IGPUImageView* imageView, ISampler* sampler, GPUImageLayout imageLayout) {
+        static_assert(sizeof(vk::DescriptorImageInfo) <= sizeof(PackedDescriptor));
+
+        auto vkImageInfo = vk::DescriptorImageInfo().setImageLayout(toVkImageLayout(imageLayout));
+        if (imageView) {
+            vkImageInfo.setImageView(vulkanCast<VulkanImageView>(*imageView).getVkImageView());
+        }
+        if (sampler) {
+            vkImageInfo.setSampler(vulkanCast<VulkanSampler>(*sampler).getVkSampler());
+        }
+
+        PackedDescriptor packed;
+        std::memcpy(packed.data.data(), &vkImageInfo, sizeof(vkImageInfo));
+        return packed;
+    }
+
+    PackedDescriptor VulkanDescriptorUpdateTemplate::packBufferDescriptor(
+        const VulkanDevice& device, IGPUBuffer& buffer, size_t offset, size_t range) {
+        static_assert(sizeof(vk::DescriptorBufferInfo) <= sizeof(PackedDescriptor));
+        static_assert(sizeof(VulkanPackedDescriptorAddress) <= sizeof(PackedDescriptor));
+
+        const auto& vkBuffer = vulkanCast<VulkanBuffer>(buffer);
+
+        PackedDescriptor packed;
+        if (device.usesDescriptorBuffers()) {
+            const VulkanPackedDescriptorAddress packedAddress{
+                .address = vkBuffer.getDeviceAddress() + offset,
+                .range = range == WHOLE_BUFFER_SIZE ? vkBuffer.getSize() - offset : range,
+                .format = vk::Format::eUndefined};
+            std::memcpy(packed.data.data(), &packedAddress, sizeof(packedAddress));
+        } else {
+            const auto vkBufferInfo
+                = vk::DescriptorBufferInfo()
+                      .setBuffer(vkBuffer.getVkBuffer())
+                      .setOffset(offset)
+                      .setRange(range == WHOLE_BUFFER_SIZE ? vk::WholeSize : range);
+            std::memcpy(packed.data.data(), &vkBufferInfo, sizeof(vkBufferInfo));
+        }
+        return packed;
+    }
+
+    PackedDescriptor VulkanDescriptorUpdateTemplate::packTexelBufferDescriptor(
+        const VulkanDevice& device, IGPUBufferView& bufferView) {
+        const auto& vkBufferView = vulkanCast<VulkanBufferView>(bufferView);
+
+        PackedDescriptor packed;
+        if (device.usesDescriptorBuffers()) {
+            const auto& vkAddressInfo = vkBufferView.getVkDescriptorAddressInfo();
+            const VulkanPackedDescriptorAddress packedAddress{.address = vkAddressInfo.address,
+                                                              .range = vkAddressInfo.range,
+                                                              .format = vkAddressInfo.format};
+            std::memcpy(packed.data.data(), &packedAddress, sizeof(packedAddress));
+        } else {
+            const auto vkHandle = vkBufferView.getVkBufferView();
+            std::memcpy(packed.data.data(), &vkHandle, sizeof(vkHandle));
+        }
+        return packed;
+    }
+
+    VulkanDescriptorUpdateTemplate::VulkanDescriptorUpdateTemplate(
+        VulkanDevice& device, const DescriptorUpdateTemplateDescription& description)
+        : device_(device.getVkDevice()) {
+        if (!description.layout) {
+            throw std::invalid_argument("layout in DescriptorUpdateTemplateDescription is null.");
+        }
+        const auto* vkLayout = vulkanCast<VulkanDescriptorSetLayout>(description.layout);
+
+        std::vector<vk::DescriptorUpdateTemplateEntry> entries;
+        entries.reserve(description.entries.size());
+        for (const auto& entry : description.entries) {
+            entries.push_back(vk::DescriptorUpdateTemplateEntry()
+                                  .setDstBinding(entry.dstBinding)
+                                  .setDstArrayElement(entry.dstArrayElement)
+                                  .setDescriptorCount(entry.descriptorCount)
+                                  .setDescriptorType(toVkDescriptorType(entry.descriptorType))
+                                  .setOffset(entry.offset)
+                                  .setStride(entry.stride));
+        }
+
+        if (device.usesDescriptorBuffers()) {
+            entries_ = std::move(entries);
+            return;
+        }
+
+        descriptorUpdateTemplate_ = device_.createDescriptorUpdateTemplate(
+            vk::DescriptorUpdateTemplateCreateInfo()
+                .setDescriptorUpdateEntries(entries)
+                .setTemplateType(vk::DescriptorUpdateTemplateType::eDescriptorSet)
+                .setDescriptorSetLayout(vkLayout->getVkDescriptorSetLayout()));
+    }
+
+    VulkanDescriptorUpdateTemplate::VulkanDescriptorUpdateTemplate(
+        vk::Device device, vk::DescriptorUpdateTemplate descriptorUpdateTemplate)
+        : device_(device), descriptorUpdateTemplate_(descriptorUpdateTemplate) {}
+
+    VulkanDescriptorUpdateTemplate::~VulkanDescriptorUpdateTemplate() noexcept { clear(); }
+
+    VulkanDescriptorUpdateTemplate::VulkanDescriptorUpdateTemplate(
+        VulkanDescriptorUpdateTemplate&& other) noexcept
+        : IDescriptorUpdateTemplate(std::move(other)),
+          device_(other.device_),
+          descriptorUpdateTemplate_(other.descriptorUpdateTemplate_),
+          entries_(std::move(other.entries_)) {
+        other.release();
+    }
+
+    VulkanDescriptorUpdateTemplate& VulkanDescriptorUpdateTemplate::operator=(
+        VulkanDescriptorUpdateTemplate&& other) noexcept {
+        if (this != &other) {
+            clear();
+
+            IDescriptorUpdateTemplate::operator=(std::move(other));
+            device_ = other.device_;
+            descriptorUpdateTemplate_ = other.descriptorUpdateTemplate_;
+            entries_ = std::move(other.entries_);
+
+            other.release();
+        }
+        return *this;
+    }
+
+    void VulkanDescriptorUpdateTemplate::update(const VulkanDevice& device,
+                                                VulkanDescriptorSet& descriptorSet,
+                                                const void* data) const {
+        if (!data) {
+            throw std::invalid_argument("Descriptor update template data is null.");
+        }
+
+        if (descriptorSet.getDescriptorBufferPool()) {
+            for (const auto& entry : entries_) {
+                descriptorSet.writePackedDescriptors(device, entry,
+                                                     static_cast<const std::byte*>(data));
+            }
+            return;
+        }
+
+        device_.updateDescriptorSetWithTemplate(descriptorSet.getVkDescriptorSet(),
+                                                descriptorUpdateTemplate_, data);
+    }
+
+    // NOTE: Templates are only read on the host while updating, they don't need deferring.
+    void VulkanDescriptorUpdateTemplate::clear() noexcept {
+        if (descriptorUpdateTemplate_ && device_) {
+            device_.destroyDescriptorUpdateTemplate(descriptorUpdateTemplate_);
+        }
+        release();
+    }
+
+    void VulkanDescriptorUpdateTemplate::release() noexcept {
+        descriptorUpdateTemplate_ = nullptr;
+        device_ = nullptr;
+        entries_.clear();
     }
 
     VulkanPushConstantRange::VulkanPushConstantRange(
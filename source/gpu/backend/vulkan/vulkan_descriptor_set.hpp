@@ -1,6 +1,9 @@
 #pragma once
 
+#include <deque>
 #include <memory>
+#include <span>
+#include <vk_mem_alloc.hpp>
 #include <vulkan/vulkan.hpp>
 
 #include "aetherion/gpu/backend/descriptor_set.hpp"
@@ -9,9 +12,66 @@ namespace aetherion {
     // Forward declarations
     class IGPUDevice;
     class VulkanDevice;
+    class VulkanDeletionQueue;
     class VulkanDescriptorPool;
+    class IGPUBuffer;
+    class IGPUBufferView;
+    class IGPUImageView;
+    class ISampler;
+    struct DescriptorWriteDescription;
+    struct DescriptorCopyDescription;
+
+    struct VulkanDescriptorBufferBinding {
+        vk::DescriptorType type = vk::DescriptorType::eSampler;
+        uint32_t count = 0;
+        vk::DeviceSize offset = 0;
+        size_t descriptorSize = 0;
+        // NOTE: Only set for combined image sampler arrays the device lays out as an array of
+        // images followed by an array of samplers.
+        size_t splitImageSize = 0;
+    };
+
+    // NOTE: Where each binding of a layout lives in the memory of descriptor buffer sets.
+    struct VulkanDescriptorBufferLayout {
+        vk::DeviceSize size = 0;
+        std::vector<VulkanDescriptorBufferBinding> bindings;  // NOTE: Indexed by binding number.
+    };
+
+    // NOTE: How buffer and texel buffer descriptors are packed on devices using descriptor
+    // buffers, image descriptors are packed as vk::DescriptorImageInfo either way.
+    struct VulkanPackedDescriptorAddress {
+        vk::DeviceAddress address;
+        vk::DeviceSize range;
+        vk::Format format;
+    };
+
+    // NOTE: What a set layout was created from, identical keys make identical layouts.
+    struct VulkanDescriptorSetLayoutKey {
+        struct Binding {
+            vk::DescriptorSetLayoutBinding binding;
+            vk::DescriptorBindingFlags flags;
+
+            bool operator==(const Binding&) const = default;
+        };
+
+        std::vector<Binding> bindings;  // NOTE: Sorted by binding number.
+        bool pushDescriptor = false;
+
+        bool operator==(const VulkanDescriptorSetLayoutKey&) const = default;
+    };
 
-    class VulkanDescriptorSetLayout : public IDescriptorSetLayout {
+    // NOTE: Writes the infos of the write to the array matching its descriptors, which must have
+    // room for all of them. dstSet is left to the caller, push descriptors don't take one.
+    vk::WriteDescriptorSet toVkWriteDescriptorSet(const DescriptorWriteDescription& write,
+                                                  vk::DescriptorBufferInfo* bufferInfos,
+                                                  vk::DescriptorImageInfo* imageInfos,
+                                                  vk::BufferView* bufferViews);
+
+    // NOTE: Validates the description against the device, as creating the layout would.
+    VulkanDescriptorSetLayoutKey toVulkanDescriptorSetLayoutKey(
+        const VulkanDevice& device, const DescriptorSetLayoutDescription& description);
+
+    class VulkanDescriptorSetLayout final : public IDescriptorSetLayout {
       public:
         VulkanDescriptorSetLayout() = delete;
         VulkanDescriptorSetLayout(VulkanDevice& device,
@@ -29,6 +89,19 @@ namespace aetherion {
             return descriptorSetLayout_;
         }
 
+        // NOTE: Null unless the layout was created for descriptor buffers.
+        inline const std::shared_ptr<const VulkanDescriptorBufferLayout>&
+        getDescriptorBufferLayout() const {
+            return descriptorBufferLayout_;
+        }
+
+        // NOTE: Null for layouts wrapping a raw handle, their contents aren't known.
+        inline const std::shared_ptr<const VulkanDescriptorSetLayoutKey>& getLayoutKey() const {
+            return layoutKey_;
+        }
+        // NOTE: Push descriptor layouts can't allocate sets and a pipeline layout takes only one.
+        inline bool isPushDescriptor() const { return layoutKey_ && layoutKey_->pushDescriptor; }
+
         void clear() noexcept;
         void release() noexcept;
 
@@ -36,9 +109,14 @@ namespace aetherion {
         vk::Device device_;
 
         vk::DescriptorSetLayout descriptorSetLayout_;
+
+        // NOTE: Shared with the sets, which may outlive the layout.
+        std::shared_ptr<const VulkanDescriptorBufferLayout> descriptorBufferLayout_;
+
+        std::shared_ptr<const VulkanDescriptorSetLayoutKey> layoutKey_;
     };
 
-    class VulkanDescriptorSet : public IDescriptorSet {
+    class VulkanDescriptorSet final : public IDescriptorSet {
       public:
         static std::vector<std::unique_ptr<IDescriptorSet>> allocateDescriptorSets(
             IGPUDevice& device, IDescriptorPool& pool,
@@ -55,6 +133,9 @@ namespace aetherion {
                             const DescriptorSetDescription& description);
         VulkanDescriptorSet(vk::Device device, vk::DescriptorPool pool,
                             vk::DescriptorSet descriptorSet, bool shouldFree = false);
+        VulkanDescriptorSet(VulkanDescriptorPool& pool,
+                            std::shared_ptr<const VulkanDescriptorBufferLayout> layout,
+                            vk::DeviceSize offset, bool shouldFree = false);
         ~VulkanDescriptorSet() noexcept override;
 
         VulkanDescriptorSet(const VulkanDescriptorSet&) = delete;
@@ -74,19 +155,52 @@ namespace aetherion {
 
         inline vk::DescriptorSet getVkDescriptorSet() const { return descriptorSet_; }
 
+        // NOTE: Null unless the set was allocated from a descriptor buffer pool.
+        inline VulkanDescriptorPool* getDescriptorBufferPool() const {
+            return descriptorBufferPool_;
+        }
+        inline vk::DeviceSize getDescriptorBufferOffset() const { return descriptorBufferOffset_; }
+
+        // NOTE: Only for descriptor buffer sets, the descriptors are written straight into the
+        // pool's mapped memory.
+        void writeDescriptors(const VulkanDevice& device, const DescriptorWriteDescription& write);
+        void copyDescriptors(const VulkanDescriptorSet& src, const DescriptorCopyDescription& copy);
+        // NOTE: Only for descriptor buffer sets, which don't take update templates. Data holds
+        // the packed descriptors of the whole template.
+        void writePackedDescriptors(const VulkanDevice& device,
+                                    const vk::DescriptorUpdateTemplateEntry& entry,
+                                    const std::byte* data);
+
         void clear() noexcept;
         void release() noexcept;
 
       private:
+        // NOTE: The sampler part is only separate for split combined image sampler arrays.
+        std::span<std::byte> getDescriptorBufferElement(
+            const VulkanDescriptorBufferBinding& binding, uint32_t element,
+            bool sampler = false) const;
+        // NOTE: Split descriptor is scratch memory of the binding's descriptor size, only needed
+        // for split combined image sampler arrays.
+        void writeDescriptorBufferElement(const VulkanDevice& device,
+                                          const VulkanDescriptorBufferBinding& binding,
+                                          uint32_t element, const vk::DescriptorGetInfoEXT& getInfo,
+                                          std::span<std::byte> splitDescriptor);
+
         vk::Device device_;
+        VulkanDeletionQueue* deletionQueue_ = nullptr;
         vk::DescriptorPool pool_;
 
         vk::DescriptorSet descriptorSet_;
 
         bool shouldFreeDescriptorSet;
+
+        VulkanDescriptorPool* descriptorBufferPool_ = nullptr;
+        std::shared_ptr<const VulkanDescriptorBufferLayout> descriptorBufferLayout_;
+        vk::DeviceSize descriptorBufferOffset_ = 0;
+        uint64_t descriptorBufferPoolGeneration_ = 0;
     };
 
-    class VulkanDescriptorPool : public IDescriptorPool {
+    class VulkanDescriptorPool final : public IDescriptorPool {
       public:
         VulkanDescriptorPool() = delete;
         VulkanDescriptorPool(VulkanDevice& device, const DescriptorPoolDescription& description);
@@ -97,27 +211,120 @@ namespace aetherion {
         VulkanDescriptorPool(const VulkanDescriptorPool&) = delete;
         VulkanDescriptorPool& operator=(const VulkanDescriptorPool&) = delete;
 
+        // NOTE: Pending range frees follow the pool. Sets allocated from a descriptor buffer pool
+        // point at it, so it must not be moved while they're alive.
         VulkanDescriptorPool(VulkanDescriptorPool&&) noexcept;
         VulkanDescriptorPool& operator=(VulkanDescriptorPool&&) noexcept;
 
         void reset() override;
 
+        ResultValue<DescriptorSetAllocateResultCode, IDescriptorSet*> allocateTransient(
+            const DescriptorSetDescription& description) override;
+
         inline vk::DescriptorPool getVkDescriptorPool() const { return descriptorPool_; }
 
         inline bool supportsFreeDescriptorSet() const { return freeDescriptorSetSupport_; }
 
+        inline bool usesDescriptorBuffer() const { return static_cast<bool>(descriptorBuffer_); }
+        inline vk::DeviceAddress getDescriptorBufferAddress() const {
+            return descriptorBufferAddress_;
+        }
+        inline vk::BufferUsageFlags getDescriptorBufferUsage() const {
+            return descriptorBufferUsage_;
+        }
+        inline std::byte* getDescriptorBufferData() const { return descriptorBufferData_; }
+        // NOTE: Increased by reset(), which frees every set allocated before.
+        inline uint64_t getGeneration() const { return generation_; }
+
+        // NOTE: Throw vk::OutOfPoolMemoryError when the buffer or the set count is exhausted,
+        // like descriptor pools do. Like descriptor pools, allocating and freeing ranges must be
+        // externally synchronized, which includes collecting the deferred destructions that free
+        // them.
+        vk::DeviceSize allocateDescriptorBufferRange(vk::DeviceSize size);
+        // NOTE: Returns the error instead, the offset is only written on success.
+        vk::Result tryAllocateDescriptorBufferRange(vk::DeviceSize size, vk::DeviceSize& offset);
+        void freeDescriptorBufferRange(vk::DeviceSize offset, vk::DeviceSize size);
+
         void clear() noexcept;
         void release() noexcept;
 
       private:
+        struct DescriptorBufferRange {
+            vk::DeviceSize offset;
+            vk::DeviceSize size;
+        };
+
         vk::Device device_;
+        VulkanDeletionQueue* deletionQueue_ = nullptr;
 
         vk::DescriptorPool descriptorPool_;
 
         bool freeDescriptorSetSupport_ = false;
+
+        vma::Allocator allocator_;
+        vk::Buffer descriptorBuffer_;
+        vma::Allocation descriptorBufferAllocation_;
+        vk::BufferUsageFlags descriptorBufferUsage_;
+        vk::DeviceAddress descriptorBufferAddress_ = 0;
+        std::byte* descriptorBufferData_ = nullptr;
+        vk::DeviceSize descriptorBufferSize_ = 0;
+        vk::DeviceSize descriptorBufferAlignment_ = 1;
+        vk::DeviceSize descriptorBufferHead_ = 0;
+        std::vector<DescriptorBufferRange> freeDescriptorBufferRanges_;
+        uint32_t maxSets_ = 0;
+        uint32_t allocatedSets_ = 0;
+        uint64_t generation_ = 0;
+
+        // NOTE: Deque so the sets handed out keep their address while it grows. Only the first
+        // transientSetCount_ are in use, the rest are kept from earlier resets to be reused.
+        std::deque<VulkanDescriptorSet> transientSets_;
+        size_t transientSetCount_ = 0;
+    };
+
+    class VulkanDescriptorUpdateTemplate final : public IDescriptorUpdateTemplate {
+      public:
+        static PackedDescriptor packImageDescriptor(IGPUImageView* imageView, ISampler* sampler,
+                                                    GPUImageLayout imageLayout);
+        static PackedDescriptor packBufferDescriptor(const VulkanDevice& device, IGPUBuffer& buffer,
+                                                     size_t offset, size_t range);
+        static PackedDescriptor packTexelBufferDescriptor(const VulkanDevice& device,
+                                                          IGPUBufferView& bufferView);
+
+        VulkanDescriptorUpdateTemplate() = delete;
+        VulkanDescriptorUpdateTemplate(VulkanDevice& device,
+                                       const DescriptorUpdateTemplateDescription& description);
+        VulkanDescriptorUpdateTemplate(vk::Device device,
+                                       vk::DescriptorUpdateTemplate descriptorUpdateTemplate);
+        ~VulkanDescriptorUpdateTemplate() noexcept override;
+
+        VulkanDescriptorUpdateTemplate(const VulkanDescriptorUpdateTemplate&) = delete;
+        VulkanDescriptorUpdateTemplate& operator=(const VulkanDescriptorUpdateTemplate&) = delete;
+
+        VulkanDescriptorUpdateTemplate(VulkanDescriptorUpdateTemplate&&) noexcept;
+        VulkanDescriptorUpdateTemplate& operator=(VulkanDescriptorUpdateTemplate&&) noexcept;
+
+        void update(const VulkanDevice& device, VulkanDescriptorSet& descriptorSet,
+                    const void* data) const;
+
+        // NOTE: Null on devices using descriptor buffers.
+        inline vk::DescriptorUpdateTemplate getVkDescriptorUpdateTemplate() const {
+            return descriptorUpdateTemplate_;
+        }
+
+        void clear() noexcept;
+        void release() noexcept;
+
+      private:
+        vk::Device device_;
+
+        vk::DescriptorUpdateTemplate descriptorUpdateTemplate_;
+
+        // NOTE: Only kept on devices using descriptor buffers, whose set layouts can't have
+        // update templates, to write the packed descriptors one by one instead.
+        std::vector<vk::DescriptorUpdateTemplateEntry> entries_;
     };
 
-    class VulkanPushConstantRange : public IPushConstantRange {
+    class VulkanPushConstantRange final : public IPushConstantRange {
       public:
         VulkanPushConstantRange() = delete;
         VulkanPushConstantRange(VulkanDevice& device,
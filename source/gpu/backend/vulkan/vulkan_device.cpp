@@ -2,17 +2,21 @@
 
 #include <fmt/core.h>
 
+#include <optional>
 #include <stdexcept>
 
 #include "aetherion/platform/window.hpp"
 #include "vulkan_buffer.hpp"
 #include "vulkan_buffer_view.hpp"
+#include "vulkan_cast.hpp"
 #include "vulkan_command_buffer.hpp"
 #include "vulkan_descriptor_set.hpp"
 #include "vulkan_driver.hpp"
 #include "vulkan_image.hpp"
 #include "vulkan_image_view.hpp"
+#include "vulkan_memory.hpp"
 #include "vulkan_pipeline.hpp"
+#include "vulkan_query_pool.hpp"
 #include "vulkan_queue.hpp"
 #include "vulkan_render_definitions.hpp"
 #include "vulkan_sampler.hpp"
@@ -22,66 +26,157 @@
 
 namespace aetherion {
     void populateGPUQueueFamilyProperties(
-        vk::PhysicalDevice physicalDevice,
+        vk::PhysicalDevice physicalDevice, vk::SurfaceKHR surface,
         std::unordered_map<uint32_t, GPUQueueFamilyProperties>& queueFamilyProperties) {
         const auto& vkGPUQueueFamilyProperties = physicalDevice.getQueueFamilyProperties();
 
         for (size_t i = 0; i < vkGPUQueueFamilyProperties.size(); ++i) {
             const auto& vulkanProperties = vkGPUQueueFamilyProperties[i];
+            const auto familyIndex = static_cast<uint32_t>(i);
 
-            queueFamilyProperties[static_cast<uint32_t>(i)]
+            queueFamilyProperties[familyIndex]
                 = {.queueFlags = toQueueTypeFlags(vulkanProperties.queueFlags),
-                   .queueCount = vulkanProperties.queueCount};
+                   .queueCount = vulkanProperties.queueCount,
+                   .presentSupport
+                   = surface && physicalDevice.getSurfaceSupportKHR(familyIndex, surface)};
         }
     }
 
+    // NOTE: Timestamps are only used when every graphics and compute queue supports them.
+    float queryTimestampPeriod(vk::PhysicalDevice physicalDevice) {
+        const auto& limits = physicalDevice.getProperties().limits;
+        return limits.timestampComputeAndGraphics ? limits.timestampPeriod : 0.0f;
+    }
+
+    PhysicalGPUDeviceProperties queryPhysicalGPUDeviceProperties(
+        vk::PhysicalDevice physicalDevice) {
+        const auto& vkProperties = physicalDevice.getProperties();
+        const auto& vkMemoryProperties = physicalDevice.getMemoryProperties();
+
+        size_t deviceLocalMemorySize = 0;
+        for (uint32_t i = 0; i < vkMemoryProperties.memoryHeapCount; ++i) {
+            if (vkMemoryProperties.memoryHeaps[i].flags & vk::MemoryHeapFlagBits::eDeviceLocal) {
+                deviceLocalMemorySize += vkMemoryProperties.memoryHeaps[i].size;
+            }
+        }
+
+        constexpr auto hostVisibleDeviceLocal = vk::MemoryPropertyFlagBits::eDeviceLocal
+                                                | vk::MemoryPropertyFlagBits::eHostVisible;
+        std::vector<bool> hostVisibleDeviceLocalHeaps(vkMemoryProperties.memoryHeapCount, false);
+        for (uint32_t i = 0; i < vkMemoryProperties.memoryTypeCount; ++i) {
+            const auto& memoryType = vkMemoryProperties.memoryTypes[i];
+            if ((memoryType.propertyFlags & hostVisibleDeviceLocal) == hostVisibleDeviceLocal) {
+                hostVisibleDeviceLocalHeaps[memoryType.heapIndex] = true;
+            }
+        }
+
+        size_t hostVisibleDeviceLocalMemorySize = 0;
+        for (uint32_t i = 0; i < vkMemoryProperties.memoryHeapCount; ++i) {
+            if (hostVisibleDeviceLocalHeaps[i]) {
+                hostVisibleDeviceLocalMemorySize += vkMemoryProperties.memoryHeaps[i].size;
+            }
+        }
+
+        return {.name = std::string(vkProperties.deviceName.data()),
+                .type = toPhysicalGPUDeviceType(vkProperties.deviceType),
+                .vendorID = vkProperties.vendorID,
+                .deviceID = vkProperties.deviceID,
+                .apiVersion = vkProperties.apiVersion,
+                .driverVersion = vkProperties.driverVersion,
+                .deviceLocalMemorySize = deviceLocalMemorySize,
+                .hostVisibleDeviceLocalMemorySize = hostVisibleDeviceLocalMemorySize};
+    }
+
     VulkanGPUPhysicalDevice::VulkanGPUPhysicalDevice(
         VulkanDriver& driver, const PhysicalGPUDeviceDescription& description)
         : instance_(driver.getVkInstance()) {
-        // Temporal surface creation
-
-        if (!description.primaryWindow) {
-            throw(
-                std::invalid_argument("A primary window is required to create a physical device."));
+        if (description.primaryWindow && driver.isHeadless()) {
+            throw(std::invalid_argument(
+                "A primary window can't be used to create a physical device with a headless "
+                "driver."));
         }
 
-        const auto& primaryWindow = *description.primaryWindow;
-        vk::SurfaceKHR surface = primaryWindow.createVulkanSurface(driver.getVkInstance());
+        // Temporal surface creation
+
+        // NOTE: Presentation support is only required when a primary window is given, headless
+        // and offscreen-only setups never touch the window system.
+        vk::SurfaceKHR surface = description.primaryWindow
+                                     ? description.primaryWindow->createVulkanSurface(instance_)
+                                     : vk::SurfaceKHR();
 
         // Physical device selection
 
-        // TODO: Allow more customization of the selection process.
+        vkb::PhysicalDeviceSelector selector(driver.getVkBuilderInstance());
+        selector.set_minimum_version(1, 3)
+            .set_required_features(vk::PhysicalDeviceFeatures()
+                                       .setSamplerAnisotropy(vk::True)
+                                       .setFillModeNonSolid(vk::True))
+            .set_required_features_12(
+                vk::PhysicalDeviceVulkan12Features().setBufferDeviceAddress(vk::True))
+            .set_required_features_13(vk::PhysicalDeviceVulkan13Features()
+                                          .setDynamicRendering(vk::True)
+                                          .setSynchronization2(vk::True))
+            .add_desired_extension(vk::EXTMemoryBudgetExtensionName);
+
+        if (surface) {
+            selector.set_surface(surface).add_required_extension(vk::KHRSwapchainExtensionName);
+        } else {
+            selector.defer_surface_initialization().require_present(false);
+        }
+
         const auto& vkGPUPhysicalDeviceSelectorResult
-            = vkb::PhysicalDeviceSelector(driver.getVkBuilderInstance())
-                  .set_surface(surface)
-                  .set_minimum_version(1, 3)
-                  .add_required_extension(vk::KHRSwapchainExtensionName)
-                  .set_required_features(vk::PhysicalDeviceFeatures()
-                                             .setSamplerAnisotropy(vk::True)
-                                             .setFillModeNonSolid(vk::True))
-                  .set_required_features_12(
-                      vk::PhysicalDeviceVulkan12Features().setBufferDeviceAddress(vk::True))
-                  .set_required_features_13(vk::PhysicalDeviceVulkan13Features()
-                                                .setDynamicRendering(vk::True)
-                                                .setSynchronization2(vk::True))
-                  .select();
+            = selector.select_devices(vkb::DeviceSelectionMode::only_fully_suitable);
 
         if (!vkGPUPhysicalDeviceSelectorResult) {
+            if (surface) {
+                vkb::destroy_surface(driver.getVkBuilderInstance(), surface);
+            }
             throw(std::runtime_error(
                 fmt::format("Failed to pick Vulkan physical device. Error: {}",
                             vkGPUPhysicalDeviceSelectorResult.error().message())));
         }
 
-        builderGPUPhysicalDevice_ = vkGPUPhysicalDeviceSelectorResult.value();
+        // Candidate scoring
+
+        const auto& scoringFunctor
+            = description.scoringFunctor ? description.scoringFunctor : scorePhysicalGPUDevice;
+        const auto& candidates = vkGPUPhysicalDeviceSelectorResult.value();
+
+        std::optional<size_t> bestCandidate;
+        int64_t bestScore = 0;
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            auto candidateProperties = queryPhysicalGPUDeviceProperties(
+                vk::PhysicalDevice(candidates[i].physical_device));
+            const int64_t score = scoringFunctor(candidateProperties);
+
+            if (score >= 0 && (!bestCandidate || score > bestScore)) {
+                bestCandidate = i;
+                bestScore = score;
+                properties_ = std::move(candidateProperties);
+            }
+        }
+
+        if (!bestCandidate) {
+            if (surface) {
+                vkb::destroy_surface(driver.getVkBuilderInstance(), surface);
+            }
+            throw(std::runtime_error(
+                "Failed to pick Vulkan physical device. Error: All suitable devices were rejected "
+                "by the scoring functor."));
+        }
+
+        builderGPUPhysicalDevice_ = candidates[*bestCandidate];
         physicalDevice_ = vk::PhysicalDevice(builderGPUPhysicalDevice_.physical_device);
 
         // Queue family properties
 
-        populateGPUQueueFamilyProperties(physicalDevice_, queueFamilyProperties_);
+        populateGPUQueueFamilyProperties(physicalDevice_, surface, queueFamilyProperties_);
 
         // Temporary surface destruction
 
-        vkb::destroy_surface(driver.getVkBuilderInstance(), surface);
+        if (surface) {
+            vkb::destroy_surface(driver.getVkBuilderInstance(), surface);
+        }
     }
 
     VulkanGPUPhysicalDevice::VulkanGPUPhysicalDevice(vk::Instance instance,
@@ -89,10 +184,11 @@ namespace aetherion {
                                                      vk::PhysicalDevice physicalDevice)
         : instance_(instance),
           builderGPUPhysicalDevice_(builderGPUPhysicalDevice),
-          physicalDevice_(physicalDevice) {
+          physicalDevice_(physicalDevice),
+          properties_(queryPhysicalGPUDeviceProperties(physicalDevice)) {
         // Queue family properties
 
-        populateGPUQueueFamilyProperties(physicalDevice_, queueFamilyProperties_);
+        populateGPUQueueFamilyProperties(physicalDevice_, {}, queueFamilyProperties_);
     }
 
     VulkanGPUPhysicalDevice::~VulkanGPUPhysicalDevice() noexcept { clear(); }
@@ -101,6 +197,7 @@ namespace aetherion {
         : IGPUPhysicalDevice(std::move(other)),
           builderGPUPhysicalDevice_(std::move(other.builderGPUPhysicalDevice_)),
           physicalDevice_(other.physicalDevice_),
+          properties_(std::move(other.properties_)),
           queueFamilyProperties_(std::move(other.queueFamilyProperties_)),
           instance_(other.instance_) {
         other.physicalDevice_ = nullptr;
@@ -115,6 +212,7 @@ namespace aetherion {
             IGPUPhysicalDevice::operator=(std::move(other));
             builderGPUPhysicalDevice_ = std::move(other.builderGPUPhysicalDevice_);
             physicalDevice_ = other.physicalDevice_;
+            properties_ = std::move(other.properties_);
             queueFamilyProperties_ = std::move(other.queueFamilyProperties_);
             instance_ = other.instance_;
 
@@ -131,6 +229,7 @@ namespace aetherion {
     void VulkanGPUPhysicalDevice::release() noexcept {
         builderGPUPhysicalDevice_ = {};
         physicalDevice_ = nullptr;
+        properties_ = {};
         queueFamilyProperties_.clear();
         instance_ = nullptr;
     }
@@ -152,7 +251,7 @@ namespace aetherion {
                 std::invalid_argument("A physical device is required to create a render device."));
         }
         const auto& physicalDevice
-            = dynamic_cast<const VulkanGPUPhysicalDevice&>(*description.physicalDevice);
+            = vulkanCast<VulkanGPUPhysicalDevice>(*description.physicalDevice);
 
         // Logical device creation
 
@@ -177,8 +276,34 @@ namespace aetherion {
                 queueFamily.queueFamilyIndex, queueFamily.queuePriorities));
         }
 
+        auto builderPhysicalDevice = physicalDevice.getVkBuilderGPUPhysicalDevice();
+
+        // NOTE: Falls back to descriptor pools when descriptor buffers aren't supported.
+        if (description.descriptorBuffers
+            && builderPhysicalDevice.enable_extension_if_present(
+                vk::EXTDescriptorBufferExtensionName)) {
+            descriptorBuffers_ = builderPhysicalDevice.enable_extension_features_if_present(
+                vk::PhysicalDeviceDescriptorBufferFeaturesEXT().setDescriptorBuffer(vk::True));
+        }
+        // NOTE: Push descriptor layouts are rejected when the extension isn't supported.
+        pushDescriptors_
+            = builderPhysicalDevice.enable_extension_if_present(vk::KHRPushDescriptorExtensionName);
+        // NOTE: Only bindless descriptors need these, devices without them are still usable.
+        descriptorIndexing_ = builderPhysicalDevice.enable_extension_features_if_present(
+            vk::PhysicalDeviceVulkan12Features()
+                .setDescriptorIndexing(vk::True)
+                .setRuntimeDescriptorArray(vk::True)
+                .setDescriptorBindingPartiallyBound(vk::True)
+                .setDescriptorBindingUpdateUnusedWhilePending(vk::True)
+                .setDescriptorBindingSampledImageUpdateAfterBind(vk::True)
+                .setDescriptorBindingStorageImageUpdateAfterBind(vk::True)
+                .setDescriptorBindingStorageBufferUpdateAfterBind(vk::True)
+                .setShaderSampledImageArrayNonUniformIndexing(vk::True)
+                .setShaderStorageImageArrayNonUniformIndexing(vk::True)
+                .setShaderStorageBufferArrayNonUniformIndexing(vk::True));
+
         const auto& vulkanDeviceBuilderResult
-            = vkb::DeviceBuilder(physicalDevice.getVkBuilderGPUPhysicalDevice())
+            = vkb::DeviceBuilder(builderPhysicalDevice)
                   .custom_queue_setup(customQueueDescriptions)
                   .build();
 
@@ -192,14 +317,54 @@ namespace aetherion {
         device_ = vk::Device(builderDevice_.device);
         physicalDevice_ = physicalDevice.getVkGPUPhysicalDevice();
 
+        // NOTE: Desired extensions are only enabled when the physical device supports them.
+        for (const auto& extensionName : builderPhysicalDevice.get_extensions()) {
+            enabledExtensions_.insert(extensionName);
+        }
+
+        dispatcher_.init(static_cast<VkInstance>(instance_), vkGetInstanceProcAddr,
+                         static_cast<VkDevice>(device_));
+
+        if (descriptorBuffers_) {
+            descriptorBufferProperties_
+                = physicalDevice_
+                      .getProperties2<vk::PhysicalDeviceProperties2,
+                                      vk::PhysicalDeviceDescriptorBufferPropertiesEXT>()
+                      .get<vk::PhysicalDeviceDescriptorBufferPropertiesEXT>();
+            descriptorBufferProperties_.setPNext(nullptr);
+        }
+        timestampPeriod_ = queryTimestampPeriod(physicalDevice_);
+
         // Vulkan Memory Allocator
 
+        vma::AllocatorCreateFlags allocatorFlags
+            = vma::AllocatorCreateFlagBits::eBufferDeviceAddress;
+        if (isExtensionEnabled(vk::EXTMemoryBudgetExtensionName)) {
+            allocatorFlags |= vma::AllocatorCreateFlagBits::eExtMemoryBudget;
+        }
+
         allocator_ = vma::createAllocator(
             vma::AllocatorCreateInfo()
                 .setPhysicalDevice(physicalDevice.getVkGPUPhysicalDevice())
                 .setDevice(device_)
                 .setInstance(instance_)
-                .setFlags(vma::AllocatorCreateFlagBits::eBufferDeviceAddress));
+                .setFlags(allocatorFlags)
+                .setVulkanApiVersion(VK_API_VERSION_1_3));
+
+        // Pipeline cache
+
+        pipelineCache_ = std::make_unique<VulkanPipelineCache>(device_, physicalDevice_,
+                                                               description.pipelineCachePath);
+
+        // Layout cache
+
+        layoutCache_ = std::make_unique<VulkanLayoutCache>();
+
+        // Deferred destruction
+
+        if (description.deferredDestruction) {
+            deletionQueue_ = std::make_unique<VulkanDeletionQueue>(device_);
+        }
     }
 
     VulkanDevice::VulkanDevice(vk::Instance instance, vk::PhysicalDevice physicalDevice,
@@ -209,7 +374,11 @@ namespace aetherion {
           physicalDevice_(physicalDevice),
           builderDevice_(builderDevice),
           device_(device),
-          allocator_(allocator) {}
+          allocator_(allocator),
+          pipelineCache_(std::make_unique<VulkanPipelineCache>(device, physicalDevice,
+                                                               std::filesystem::path())),
+          layoutCache_(std::make_unique<VulkanLayoutCache>()),
+          timestampPeriod_(queryTimestampPeriod(physicalDevice)) {}
 
     VulkanDevice::~VulkanDevice() noexcept { clear(); }
 
@@ -219,7 +388,17 @@ namespace aetherion {
           builderDevice_(std::move(other.builderDevice_)),
           device_(other.device_),
           instance_(other.instance_),
-          physicalDevice_(other.physicalDevice_) {
+          physicalDevice_(other.physicalDevice_),
+          pipelineCache_(std::move(other.pipelineCache_)),
+          deletionQueue_(std::move(other.deletionQueue_)),
+          layoutCache_(std::move(other.layoutCache_)),
+          enabledExtensions_(std::move(other.enabledExtensions_)),
+          dispatcher_(other.dispatcher_),
+          descriptorBuffers_(other.descriptorBuffers_),
+          pushDescriptors_(other.pushDescriptors_),
+          descriptorIndexing_(other.descriptorIndexing_),
+          descriptorBufferProperties_(other.descriptorBufferProperties_),
+          timestampPeriod_(other.timestampPeriod_) {
         other.allocator_ = nullptr;
         other.device_ = nullptr;
         other.instance_ = nullptr;
@@ -236,6 +415,16 @@ namespace aetherion {
             device_ = other.device_;
             instance_ = other.instance_;
             physicalDevice_ = other.physicalDevice_;
+            pipelineCache_ = std::move(other.pipelineCache_);
+            deletionQueue_ = std::move(other.deletionQueue_);
+            layoutCache_ = std::move(other.layoutCache_);
+            enabledExtensions_ = std::move(other.enabledExtensions_);
+            dispatcher_ = other.dispatcher_;
+            descriptorBuffers_ = other.descriptorBuffers_;
+            pushDescriptors_ = other.pushDescriptors_;
+            descriptorIndexing_ = other.descriptorIndexing_;
+            descriptorBufferProperties_ = other.descriptorBufferProperties_;
+            timestampPeriod_ = other.timestampPeriod_;
 
             other.allocator_ = nullptr;
             other.device_ = nullptr;
@@ -247,6 +436,17 @@ namespace aetherion {
 
     void VulkanDevice::clear() noexcept {
         if (device_) {
+            if (pipelineCache_) {
+                // NOTE: Saving is best effort here, call savePipelineCache() to observe failures.
+                try {
+                    pipelineCache_->save();
+                } catch (...) {
+                }
+                pipelineCache_.reset();
+            }
+            // NOTE: Deferred resources may belong to the allocator, destroy them first.
+            deletionQueue_.reset();
+            layoutCache_.reset();
             if (allocator_) {
                 allocator_.destroy();
                 allocator_ = nullptr;
@@ -257,19 +457,91 @@ namespace aetherion {
             builderDevice_ = {};
             instance_ = nullptr;
             physicalDevice_ = nullptr;
+            enabledExtensions_.clear();
+            descriptorBuffers_ = false;
+            pushDescriptors_ = false;
+            descriptorIndexing_ = false;
+            timestampPeriod_ = 0.0f;
         }
     }
 
     void VulkanDevice::release() noexcept {
+        if (pipelineCache_) {
+            pipelineCache_->release();
+            pipelineCache_.reset();
+        }
+        if (deletionQueue_) {
+            deletionQueue_->release();
+            deletionQueue_.reset();
+        }
+        layoutCache_.reset();
         allocator_ = nullptr;
         device_ = nullptr;
         builderDevice_ = {};
         instance_ = nullptr;
         physicalDevice_ = nullptr;
+        enabledExtensions_.clear();
+        descriptorBuffers_ = false;
+        pushDescriptors_ = false;
+        descriptorIndexing_ = false;
+        timestampPeriod_ = 0.0f;
     }
 
     void VulkanDevice::waitIdle() { device_.waitIdle(); }
 
+    bool VulkanDevice::isExtensionEnabled(std::string_view extensionName) const {
+        return enabledExtensions_.contains(std::string(extensionName));
+    }
+
+    size_t VulkanDevice::getDescriptorSize(vk::DescriptorType type) const {
+        switch (type) {
+            case vk::DescriptorType::eSampler:
+                return descriptorBufferProperties_.samplerDescriptorSize;
+            case vk::DescriptorType::eCombinedImageSampler:
+                return descriptorBufferProperties_.combinedImageSamplerDescriptorSize;
+            case vk::DescriptorType::eSampledImage:
+                return descriptorBufferProperties_.sampledImageDescriptorSize;
+            case vk::DescriptorType::eStorageImage:
+                return descriptorBufferProperties_.storageImageDescriptorSize;
+            case vk::DescriptorType::eUniformTexelBuffer:
+                return descriptorBufferProperties_.uniformTexelBufferDescriptorSize;
+            case vk::DescriptorType::eStorageTexelBuffer:
+                return descriptorBufferProperties_.storageTexelBufferDescriptorSize;
+            case vk::DescriptorType::eUniformBuffer:
+                return descriptorBufferProperties_.uniformBufferDescriptorSize;
+            case vk::DescriptorType::eStorageBuffer:
+                return descriptorBufferProperties_.storageBufferDescriptorSize;
+            case vk::DescriptorType::eInputAttachment:
+                return descriptorBufferProperties_.inputAttachmentDescriptorSize;
+            default:
+                throw std::invalid_argument(
+                    "Descriptor type isn't supported by descriptor buffers.");
+        }
+    }
+
+    void VulkanDevice::savePipelineCache() {
+        if (pipelineCache_) {
+            pipelineCache_->save();
+        }
+    }
+
+    void VulkanDevice::setDeferredDestructionValue(uint64_t timelineValue) {
+        if (deletionQueue_) {
+            deletionQueue_->setPendingValue(timelineValue);
+        }
+    }
+
+    void VulkanDevice::collectDeferredDestructions(uint64_t completedTimelineValue) {
+        if (deletionQueue_) {
+            deletionQueue_->collect(completedTimelineValue);
+        }
+    }
+
+    std::unique_ptr<IGPUAllocator> VulkanDevice::createAllocator(
+        const GPUAllocatorDescription& description) {
+        return std::make_unique<VulkanAllocator>(*this, description);
+    }
+
     std::unique_ptr<IGPUBuffer> VulkanDevice::createBuffer(
         const GPUBufferDescription& description) {
         return std::make_unique<VulkanBuffer>(*this, description);
@@ -292,19 +564,19 @@ namespace aetherion {
 
     std::unique_ptr<ICommandBuffer> VulkanDevice::allocateCommandBuffer(
         ICommandPool& pool, const CommandGPUBufferDescription& description) {
-        return std::make_unique<VulkanCommandBuffer>(*this, dynamic_cast<VulkanCommandPool&>(pool),
+        return std::make_unique<VulkanCommandBuffer>(*this, vulkanCast<VulkanCommandPool>(pool),
                                                      description);
     }
 
     std::vector<std::unique_ptr<ICommandBuffer>> VulkanDevice::allocateCommandBuffers(
         ICommandPool& pool, uint32_t count, const CommandGPUBufferDescription& description) {
         return VulkanCommandBuffer::allocateCommandBuffers(
-            *this, dynamic_cast<VulkanCommandPool&>(pool), count, description);
+            *this, vulkanCast<VulkanCommandPool>(pool), count, description);
     }
 
     void VulkanDevice::freeCommandBuffers(
         ICommandPool& pool, std::span<std::reference_wrapper<ICommandBuffer>> commandBuffers) {
-        VulkanCommandBuffer::freeCommandBuffers(*this, dynamic_cast<VulkanCommandPool&>(pool),
+        VulkanCommandBuffer::freeCommandBuffers(*this, vulkanCast<VulkanCommandPool>(pool),
                                                 commandBuffers);
     }
 
@@ -312,6 +584,32 @@ namespace aetherion {
         return std::make_unique<VulkanImage>(*this, description);
     }
 
+    GPUAllocationMemoryRequirementsDescription VulkanDevice::getBufferMemoryRequirements(
+        const GPUBufferDescription& description) const {
+        const auto createInfo = toVkBufferCreateInfo(description, descriptorBuffers_);
+        const auto memoryRequirements
+            = device_
+                  .getBufferMemoryRequirements(
+                      vk::DeviceBufferMemoryRequirements().setPCreateInfo(&createInfo))
+                  .memoryRequirements;
+        return {.size = memoryRequirements.size,
+                .alignment = memoryRequirements.alignment,
+                .memoryTypeBits = memoryRequirements.memoryTypeBits};
+    }
+
+    GPUAllocationMemoryRequirementsDescription VulkanDevice::getImageMemoryRequirements(
+        const GPUImageDescription& description) const {
+        const auto createInfo = toVkImageCreateInfo(description);
+        const auto memoryRequirements
+            = device_
+                  .getImageMemoryRequirements(
+                      vk::DeviceImageMemoryRequirements().setPCreateInfo(&createInfo))
+                  .memoryRequirements;
+        return {.size = memoryRequirements.size,
+                .alignment = memoryRequirements.alignment,
+                .memoryTypeBits = memoryRequirements.memoryTypeBits};
+    }
+
     std::unique_ptr<ISwapchain> VulkanDevice::createSwapchain(
         const SwapchainDescription& description) {
         return std::make_unique<VulkanSwapchain>(*this, description);
@@ -332,6 +630,11 @@ namespace aetherion {
         return std::make_unique<VulkanTimelineSemaphore>(*this, description);
     }
 
+    std::unique_ptr<IQueryPool> VulkanDevice::createQueryPool(
+        const QueryPoolDescription& description) {
+        return std::make_unique<VulkanQueryPool>(*this, description);
+    }
+
     std::unique_ptr<ISampler> VulkanDevice::createSampler(const SamplerDescription& description) {
         return std::make_unique<VulkanSampler>(*this, description);
     }
@@ -345,6 +648,11 @@ namespace aetherion {
         return std::make_unique<VulkanPipelineLayout>(*this, description);
     }
 
+    std::shared_ptr<IPipelineLayout> VulkanDevice::getOrCreatePipelineLayout(
+        const PipelineLayoutDescription& description) {
+        return layoutCache_->getOrCreatePipelineLayout(*this, description);
+    }
+
     std::unique_ptr<IPipeline> VulkanDevice::createComputePipeline(
         const ComputePipelineDescription& description) {
         return std::make_unique<VulkanPipeline>(*this, description);
@@ -360,6 +668,11 @@ namespace aetherion {
         return std::make_unique<VulkanDescriptorSetLayout>(*this, description);
     }
 
+    std::shared_ptr<IDescriptorSetLayout> VulkanDevice::getOrCreateDescriptorSetLayout(
+        const DescriptorSetLayoutDescription& description) {
+        return layoutCache_->getOrCreateDescriptorSetLayout(*this, description);
+    }
+
     std::unique_ptr<IDescriptorPool> VulkanDevice::createDescriptorPool(
         const DescriptorPoolDescription& description) {
         return std::make_unique<VulkanDescriptorPool>(*this, description);
@@ -377,108 +690,42 @@ namespace aetherion {
     std::unique_ptr<IDescriptorSet> VulkanDevice::allocateDescriptorSet(
         IDescriptorPool& pool, const DescriptorSetDescription& description) {
         return std::make_unique<VulkanDescriptorSet>(
-            *this, dynamic_cast<VulkanDescriptorPool&>(pool), description);
+            *this, vulkanCast<VulkanDescriptorPool>(pool), description);
     }
 
     std::vector<std::unique_ptr<IDescriptorSet>> VulkanDevice::allocateDescriptorSets(
         IDescriptorPool& pool, std::span<const DescriptorSetDescription> descriptions) {
         return VulkanDescriptorSet::allocateDescriptorSets(
-            *this, dynamic_cast<VulkanDescriptorPool&>(pool), descriptions);
+            *this, vulkanCast<VulkanDescriptorPool>(pool), descriptions);
     }
 
     void VulkanDevice::freeDescriptorSets(
         IDescriptorPool& pool, std::span<std::reference_wrapper<IDescriptorSet>> descriptorSets) {
-        VulkanDescriptorSet::freeDescriptorSets(*this, dynamic_cast<VulkanDescriptorPool&>(pool),
+        VulkanDescriptorSet::freeDescriptorSets(*this, vulkanCast<VulkanDescriptorPool>(pool),
                                                 descriptorSets);
     }
 
-    vk::WriteDescriptorSet toVkWriteDescriptorSet(const DescriptorWriteDescription& write) {
+    // NOTE: The infos are appended to the given vectors, which must have enough capacity for the
+    // pointers in the returned write to stay valid.
+    vk::WriteDescriptorSet toVkWriteDescriptorSet(
+        const DescriptorWriteDescription& write, std::vector<vk::DescriptorBufferInfo>& bufferInfos,
+        std::vector<vk::DescriptorImageInfo>& imageInfos,
+        std::vector<vk::BufferView>& bufferViews) {
         if (!write.dstSet) {
             throw std::invalid_argument("dstSet in DescriptorWriteDescription is null.");
         }
 
-        auto vkWrite
-            = vk::WriteDescriptorSet()
-                  .setDstSet(
-                      dynamic_cast<const VulkanDescriptorSet&>(*write.dstSet).getVkDescriptorSet())
-                  .setDstBinding(write.dstBinding)
-                  .setDstArrayElement(write.dstArrayElement)
-                  .setDescriptorType(toVkDescriptorType(write.descriptorType));
-
-        const size_t nonEmptyCount = (!write.buffers.empty() ? 1 : 0)
-                                     + (!write.images.empty() ? 1 : 0)
-                                     + (!write.texelBuffers.empty() ? 1 : 0);
+        const size_t firstBufferInfo = bufferInfos.size();
+        const size_t firstImageInfo = imageInfos.size();
+        const size_t firstBufferView = bufferViews.size();
+        bufferInfos.resize(firstBufferInfo + write.buffers.size());
+        imageInfos.resize(firstImageInfo + write.images.size());
+        bufferViews.resize(firstBufferView + write.texelBuffers.size());
 
-        if (nonEmptyCount > 1) {
-            throw std::invalid_argument(
-                "Only one of buffers, images, or texelBuffers fields can be non-empty in "
-                "DescriptorWriteDescription.");
-        }
-
-        if (!write.buffers.empty()) {
-            std::vector<vk::DescriptorBufferInfo> vkBufferInfos;
-            vkBufferInfos.reserve(write.buffers.size());
-            for (const auto& bufferView : write.buffers) {
-                if (!bufferView.buffer) {
-                    throw std::invalid_argument(
-                        "buffer in DescriptorWriteDescriptorGPUBufferDescription is null.");
-                }
-
-                vkBufferInfos.push_back(
-                    vk::DescriptorBufferInfo()
-                        .setBuffer(
-                            dynamic_cast<const VulkanBuffer&>(*bufferView.buffer).getVkBuffer())
-                        .setOffset(bufferView.offset)
-                        .setRange(bufferView.range));
-            }
-            return vkWrite.setDescriptorCount(static_cast<uint32_t>(write.buffers.size()))
-                .setPBufferInfo(vkBufferInfos.data());
-        } else if (!write.images.empty()) {
-            std::vector<vk::DescriptorImageInfo> vkImageInfos;
-            vkImageInfos.reserve(write.images.size());
-            for (const auto& imageView : write.images) {
-                if (!imageView.sampler) {
-                    throw std::invalid_argument(
-                        "sampler in DescriptorWriteDescriptorGPUImageDescription is null.");
-                }
-                if (!imageView.imageView) {
-                    throw std::invalid_argument(
-                        "imageView in DescriptorWriteDescriptorGPUImageDescription is null.");
-                }
-
-                vkImageInfos.push_back(
-                    vk::DescriptorImageInfo()
-                        .setSampler(
-                            dynamic_cast<const VulkanSampler&>(*imageView.sampler).getVkSampler())
-                        .setImageView(dynamic_cast<const VulkanImageView&>(*imageView.imageView)
-                                          .getVkImageView())
-                        .setImageLayout(toVkImageLayout(imageView.imageLayout)));
-            }
-            return vkWrite.setDescriptorCount(static_cast<uint32_t>(write.images.size()))
-                .setPImageInfo(vkImageInfos.data());
-        } else if (!write.texelBuffers.empty()) {
-            std::vector<vk::BufferView> vkBufferViews;
-            vkBufferViews.reserve(write.texelBuffers.size());
-            for (const auto& bufferView : write.texelBuffers) {
-                if (!bufferView.bufferView) {
-                    throw std::invalid_argument(
-                        "bufferView in DescriptorWriteDescriptorTexelBufferViewDescription is "
-                        "null.");
-                }
-
-                vkBufferViews.push_back(
-                    dynamic_cast<const VulkanBufferView&>(*bufferView.bufferView)
-                        .getVkBufferView());
-            }
-            return vkWrite.setDescriptorCount(static_cast<uint32_t>(write.texelBuffers.size()))
-                .setPTexelBufferView(vkBufferViews.data());
-        } else {
-            throw std::invalid_argument(
-                "At least one of buffers, images, or texelBuffers fields must be non-empty in "
-                "DescriptorWriteDescription.");
-        }
-
-        return vkWrite;
+        return toVkWriteDescriptorSet(write, bufferInfos.data() + firstBufferInfo,
+                                      imageInfos.data() + firstImageInfo,
+                                      bufferViews.data() + firstBufferView)
+            .setDstSet(vulkanCast<VulkanDescriptorSet>(*write.dstSet).getVkDescriptorSet());
     }
 
     vk::CopyDescriptorSet toVkCopyDescriptorSet(const DescriptorCopyDescription& copy) {
@@ -490,10 +737,10 @@ namespace aetherion {
         }
 
         return vk::CopyDescriptorSet()
-            .setSrcSet(dynamic_cast<const VulkanDescriptorSet&>(*copy.srcSet).getVkDescriptorSet())
+            .setSrcSet(vulkanCast<VulkanDescriptorSet>(*copy.srcSet).getVkDescriptorSet())
             .setSrcBinding(copy.srcBinding)
             .setSrcArrayElement(copy.srcArrayElement)
-            .setDstSet(dynamic_cast<const VulkanDescriptorSet&>(*copy.dstSet).getVkDescriptorSet())
+            .setDstSet(vulkanCast<VulkanDescriptorSet>(*copy.dstSet).getVkDescriptorSet())
             .setDstBinding(copy.dstBinding)
             .setDstArrayElement(copy.dstArrayElement)
             .setDescriptorCount(copy.descriptorCount);
@@ -502,11 +749,49 @@ namespace aetherion {
     void VulkanDevice::updateDescriptorSets(
         std::span<const DescriptorWriteDescription> descriptorWrites,
         std::span<const DescriptorCopyDescription> descriptorCopies) {
+        // NOTE: Descriptor buffer sets are written straight into their mapped memory.
+        if (descriptorBuffers_) {
+            for (const auto& write : descriptorWrites) {
+                if (!write.dstSet) {
+                    throw std::invalid_argument("dstSet in DescriptorWriteDescription is null.");
+                }
+                vulkanCast<VulkanDescriptorSet>(*write.dstSet).writeDescriptors(*this, write);
+            }
+            for (const auto& copy : descriptorCopies) {
+                if (!copy.srcSet) {
+                    throw std::invalid_argument("srcSet in DescriptorCopyDescription is null.");
+                }
+                if (!copy.dstSet) {
+                    throw std::invalid_argument("dstSet in DescriptorCopyDescription is null.");
+                }
+                vulkanCast<VulkanDescriptorSet>(*copy.dstSet)
+                    .copyDescriptors(vulkanCast<VulkanDescriptorSet>(*copy.srcSet), copy);
+            }
+            return;
+        }
+
+        size_t bufferCount = 0;
+        size_t imageCount = 0;
+        size_t texelBufferCount = 0;
+        for (const auto& write : descriptorWrites) {
+            bufferCount += write.buffers.size();
+            imageCount += write.images.size();
+            texelBufferCount += write.texelBuffers.size();
+        }
+
+        std::vector<vk::DescriptorBufferInfo> vkBufferInfos;
+        vkBufferInfos.reserve(bufferCount);
+        std::vector<vk::DescriptorImageInfo> vkImageInfos;
+        vkImageInfos.reserve(imageCount);
+        std::vector<vk::BufferView> vkBufferViews;
+        vkBufferViews.reserve(texelBufferCount);
+
         std::vector<vk::WriteDescriptorSet> vkDescriptorWrites;
         vkDescriptorWrites.reserve(descriptorWrites.size());
 
         for (const auto& write : descriptorWrites) {
-            vkDescriptorWrites.push_back(toVkWriteDescriptorSet(write));
+            vkDescriptorWrites.push_back(
+                toVkWriteDescriptorSet(write, vkBufferInfos, vkImageInfos, vkBufferViews));
         }
 
         std::vector<vk::CopyDescriptorSet> vkDescriptorCopies;
@@ -518,4 +803,31 @@ namespace aetherion {
 
         device_.updateDescriptorSets(vkDescriptorWrites, vkDescriptorCopies);
     }
+
+    std::unique_ptr<IDescriptorUpdateTemplate> VulkanDevice::createDescriptorUpdateTemplate(
+        const DescriptorUpdateTemplateDescription& description) {
+        return std::make_unique<VulkanDescriptorUpdateTemplate>(*this, description);
+    }
+
+    PackedDescriptor VulkanDevice::packImageDescriptor(IGPUImageView* imageView, ISampler* sampler,
+                                                       GPUImageLayout imageLayout) {
+        return VulkanDescriptorUpdateTemplate::packImageDescriptor(imageView, sampler,
+                                                                   imageLayout);
+    }
+
+    PackedDescriptor VulkanDevice::packBufferDescriptor(IGPUBuffer& buffer, size_t offset,
+                                                        size_t range) {
+        return VulkanDescriptorUpdateTemplate::packBufferDescriptor(*this, buffer, offset, range);
+    }
+
+    PackedDescriptor VulkanDevice::packTexelBufferDescriptor(IGPUBufferView& bufferView) {
+        return VulkanDescriptorUpdateTemplate::packTexelBufferDescriptor(*this, bufferView);
+    }
+
+    void VulkanDevice::updateDescriptorSetWithTemplate(IDescriptorSet& descriptorSet,
+                                                       IDescriptorUpdateTemplate& updateTemplate,
+                                                       const void* data) {
+        vulkanCast<VulkanDescriptorUpdateTemplate>(updateTemplate)
+            .update(*this, vulkanCast<VulkanDescriptorSet>(descriptorSet), data);
+    }
 }  // namespace aetherion
\ No newline at end of file
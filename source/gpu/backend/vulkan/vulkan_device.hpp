@@ -2,17 +2,23 @@
 
 #include <VkBootstrap.h>
 
+#include <string>
+#include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 #include <vk_mem_alloc.hpp>
 #include <vulkan/vulkan.hpp>
 
 #include "aetherion/gpu/backend/device.hpp"
+#include "vulkan_deletion_queue.hpp"
+#include "vulkan_layout_cache.hpp"
+#include "vulkan_pipeline_cache.hpp"
 
 namespace aetherion {
     // Forward declarations
     class VulkanDriver;
 
-    class VulkanGPUPhysicalDevice : public IGPUPhysicalDevice {
+    class VulkanGPUPhysicalDevice final : public IGPUPhysicalDevice {
       public:
         VulkanGPUPhysicalDevice() = delete;
         VulkanGPUPhysicalDevice(VulkanDriver& driver,
@@ -27,6 +33,13 @@ namespace aetherion {
         VulkanGPUPhysicalDevice(VulkanGPUPhysicalDevice&&) noexcept;
         VulkanGPUPhysicalDevice& operator=(VulkanGPUPhysicalDevice&&) noexcept;
 
+        inline const PhysicalGPUDeviceProperties& getProperties() const override {
+            return properties_;
+        }
+
+        inline uint32_t getGPUQueueFamilyCount() const override {
+            return static_cast<uint32_t>(queueFamilyProperties_.size());
+        }
         const GPUQueueFamilyProperties& getGPUQueueFamilyProperties(
             uint32_t familyIndex) const override;
 
@@ -46,10 +59,11 @@ namespace aetherion {
         vkb::PhysicalDevice builderGPUPhysicalDevice_;
         vk::PhysicalDevice physicalDevice_;
 
+        PhysicalGPUDeviceProperties properties_;
         std::unordered_map<uint32_t, GPUQueueFamilyProperties> queueFamilyProperties_;
     };
 
-    class VulkanDevice : public IGPUDevice {
+    class VulkanDevice final : public IGPUDevice {
       public:
         VulkanDevice() = delete;
         VulkanDevice(VulkanDriver& driver, const GPUDeviceDescription& description);
@@ -64,6 +78,15 @@ namespace aetherion {
 
         void waitIdle() override;
 
+        void savePipelineCache() override;
+
+        void setDeferredDestructionValue(uint64_t timelineValue) override;
+        void collectDeferredDestructions(uint64_t completedTimelineValue) override;
+
+        inline bool supportsBindlessDescriptors() const override { return descriptorIndexing_; }
+        inline bool usesDescriptorBuffers() const override { return descriptorBuffers_; }
+        inline float getTimestampPeriod() const override { return timestampPeriod_; }
+
         std::unique_ptr<ICommandPool> createCommandPool(
             const CommandPoolDescription& description) override;
 
@@ -77,6 +100,9 @@ namespace aetherion {
             ICommandPool& pool,
             std::span<std::reference_wrapper<ICommandBuffer>> commandBuffers) override;
 
+        std::unique_ptr<IGPUAllocator> createAllocator(
+            const GPUAllocatorDescription& description) override;
+
         std::unique_ptr<IGPUBuffer> createBuffer(const GPUBufferDescription& description) override;
 
         std::unique_ptr<IGPUBufferView> createBufferView(
@@ -84,6 +110,11 @@ namespace aetherion {
 
         std::unique_ptr<IGPUImage> createImage(const GPUImageDescription& description) override;
 
+        GPUAllocationMemoryRequirementsDescription getBufferMemoryRequirements(
+            const GPUBufferDescription& description) const override;
+        GPUAllocationMemoryRequirementsDescription getImageMemoryRequirements(
+            const GPUImageDescription& description) const override;
+
         std::unique_ptr<IGPUImageView> createImageView(
             const GPUImageViewDescription& description) override;
 
@@ -94,6 +125,9 @@ namespace aetherion {
         std::unique_ptr<IPipelineLayout> createPipelineLayout(
             const PipelineLayoutDescription& description) override;
 
+        std::shared_ptr<IPipelineLayout> getOrCreatePipelineLayout(
+            const PipelineLayoutDescription& description) override;
+
         std::unique_ptr<IPipeline> createComputePipeline(
             const ComputePipelineDescription& description) override;
 
@@ -103,6 +137,9 @@ namespace aetherion {
         std::unique_ptr<IDescriptorSetLayout> createDescriptorSetLayout(
             const DescriptorSetLayoutDescription& description) override;
 
+        std::shared_ptr<IDescriptorSetLayout> getOrCreateDescriptorSetLayout(
+            const DescriptorSetLayoutDescription& description) override;
+
         std::unique_ptr<IDescriptorPool> createDescriptorPool(
             const DescriptorPoolDescription& description) override;
 
@@ -120,6 +157,9 @@ namespace aetherion {
         std::unique_ptr<IGPUTimelineSemaphore> createGPUTimelineSemaphore(
             const GPUTimelineSemaphoreDescription& description) override;
 
+        std::unique_ptr<IQueryPool> createQueryPool(
+            const QueryPoolDescription& description) override;
+
         std::unique_ptr<IGPUQueue> getQueue(const GPUQueueDescription& description) override;
 
         std::unique_ptr<IDescriptorSet> allocateDescriptorSet(
@@ -136,6 +176,19 @@ namespace aetherion {
             std::span<const DescriptorWriteDescription> descriptorWrites,
             std::span<const DescriptorCopyDescription> descriptorCopies) override;
 
+        std::unique_ptr<IDescriptorUpdateTemplate> createDescriptorUpdateTemplate(
+            const DescriptorUpdateTemplateDescription& description) override;
+
+        PackedDescriptor packImageDescriptor(IGPUImageView* imageView, ISampler* sampler,
+                                             GPUImageLayout imageLayout) override;
+        PackedDescriptor packBufferDescriptor(IGPUBuffer& buffer, size_t offset,
+                                              size_t range) override;
+        PackedDescriptor packTexelBufferDescriptor(IGPUBufferView& bufferView) override;
+
+        void updateDescriptorSetWithTemplate(IDescriptorSet& descriptorSet,
+                                             IDescriptorUpdateTemplate& updateTemplate,
+                                             const void* data) override;
+
         inline vk::Instance getVkInstance() const { return instance_; }
 
         inline vk::PhysicalDevice getVkPhysicalDevice() const { return physicalDevice_; }
@@ -145,6 +198,25 @@ namespace aetherion {
 
         inline vma::Allocator getVmaAllocator() const { return allocator_; }
 
+        inline vk::PipelineCache getVkPipelineCache() const {
+            return pipelineCache_ ? pipelineCache_->getVkPipelineCache() : vk::PipelineCache();
+        }
+
+        bool isExtensionEnabled(std::string_view extensionName) const;
+
+        // NOTE: Loads the extension commands the static loader doesn't export.
+        inline const vk::DispatchLoaderDynamic& getDispatcher() const { return dispatcher_; }
+
+        inline bool supportsPushDescriptors() const { return pushDescriptors_; }
+        inline const vk::PhysicalDeviceDescriptorBufferPropertiesEXT&
+        getDescriptorBufferProperties() const {
+            return descriptorBufferProperties_;
+        }
+        size_t getDescriptorSize(vk::DescriptorType type) const;
+
+        // NOTE: Null unless deferred destruction is enabled.
+        inline VulkanDeletionQueue* getDeletionQueue() const { return deletionQueue_.get(); }
+
         void clear() noexcept;
         void release() noexcept;
 
@@ -156,5 +228,19 @@ namespace aetherion {
 
         vkb::Device builderDevice_;
         vk::Device device_;
+
+        std::unique_ptr<VulkanPipelineCache> pipelineCache_;
+        std::unique_ptr<VulkanDeletionQueue> deletionQueue_;
+        std::unique_ptr<VulkanLayoutCache> layoutCache_;
+
+        std::unordered_set<std::string> enabledExtensions_;
+
+        vk::DispatchLoaderDynamic dispatcher_;
+
+        bool descriptorBuffers_ = false;
+        bool pushDescriptors_ = false;
+        bool descriptorIndexing_ = false;
+        vk::PhysicalDeviceDescriptorBufferPropertiesEXT descriptorBufferProperties_;
+        float timestampPeriod_ = 0.0f;
     };
 }  // namespace aetherion
@@ -6,11 +6,15 @@
 #include "vulkan_surface.hpp"
 
 namespace aetherion {
-    VulkanDriver::VulkanDriver(const GPUDriverDescription& description) : IGPUDriver() {
+    VulkanDriver::VulkanDriver(const GPUDriverDescription& description)
+        : IGPUDriver(), headless_(description.headless) {
+        // NOTE: Headless instances don't enable the surface extensions, so no window system is
+        // needed at all.
         const auto& vulkanBuilderInstanceResult
             = vkb::InstanceBuilder()
                   .set_app_name(description.name.c_str())
                   .set_engine_name("Aetherion engine")
+                  .set_headless(description.headless)
                   .request_validation_layers(description.validationLayersEnabled)
                   .use_default_debug_messenger()
                   .require_api_version(vk::ApiVersion13)
@@ -30,7 +34,8 @@ namespace aetherion {
     VulkanDriver::VulkanDriver(VulkanDriver&& other) noexcept
         : IGPUDriver(std::move(other)),
           builderInstance_(std::move(other.builderInstance_)),
-          instance_(other.instance_) {
+          instance_(other.instance_),
+          headless_(other.headless_) {
         other.instance_ = nullptr;
     }
 
@@ -41,6 +46,7 @@ namespace aetherion {
             IGPUDriver::operator=(std::move(other));
             builderInstance_ = std::move(other.builderInstance_);
             instance_ = other.instance_;
+            headless_ = other.headless_;
 
             other.release();
         }
@@ -61,7 +67,7 @@ namespace aetherion {
         builderInstance_ = {};
     }
 
-    std::unique_ptr<IGPUPhysicalDevice> VulkanDriver::createGPUPhysicalDevice(
+    std::unique_ptr<IGPUPhysicalDevice> VulkanDriver::createPhysicalDevice(
         const PhysicalGPUDeviceDescription& description) {
         return std::make_unique<VulkanGPUPhysicalDevice>(*this, description);
     }
@@ -73,6 +79,10 @@ namespace aetherion {
 
     std::unique_ptr<IRenderSurface> VulkanDriver::createSurface(
         const RenderSurfaceDescription& description) {
+        if (headless_) {
+            throw std::runtime_error("Surfaces can't be created by a headless driver.");
+        }
+
         return std::make_unique<VulkanSurface>(*this, description);
     }
 }  // namespace aetherion
\ No newline at end of file
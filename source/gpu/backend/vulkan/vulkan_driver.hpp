@@ -7,7 +7,7 @@
 #include "aetherion/gpu/backend/driver.hpp"
 
 namespace aetherion {
-    class VulkanDriver : public IGPUDriver {
+    class VulkanDriver final : public IGPUDriver {
       public:
         VulkanDriver() = delete;
         VulkanDriver(const GPUDriverDescription& description);
@@ -29,6 +29,8 @@ namespace aetherion {
         std::unique_ptr<IRenderSurface> createSurface(
             const RenderSurfaceDescription& description) override;
 
+        inline bool isHeadless() const override { return headless_; }
+
         inline vkb::Instance getVkBuilderInstance() const { return builderInstance_; }
         inline vk::Instance getVkInstance() const { return instance_; }
 
@@ -38,5 +40,7 @@ namespace aetherion {
       private:
         vkb::Instance builderInstance_;
         vk::Instance instance_;
+
+        bool headless_ = false;
     };
 }  // namespace aetherion
\ No newline at end of file
@@ -9,15 +9,16 @@
 namespace aetherion {
     // Forward declarations
     class VulkanDevice;
+    class VulkanDeletionQueue;
 
-    class VulkanImage : public IGPUImage {
+    class VulkanImage final : public IGPUImage {
       public:
         VulkanImage() = delete;
         VulkanImage(VulkanDevice& device, const GPUImageDescription& description);
         VulkanImage(VulkanAllocator& allocator, const GPUImageDescription& description,
                     const GPUAllocationDescription& allocationDescription);
         VulkanImage(vk::Device device, vma::Allocator allocator, vk::Image image,
-                    vma::Allocation allocation);
+                    vma::Allocation allocation, VulkanDeletionQueue* deletionQueue = nullptr);
         ~VulkanImage() noexcept override;
 
         VulkanImage(const VulkanImage&) = delete;
@@ -30,14 +31,21 @@ namespace aetherion {
         // NOTE: May be nullptr if no allocation was made (e.g. swapchain images)
         inline vma::Allocation getVmaAllocation() const { return allocation_; }
 
+        // NOTE: Swaps in an image bound to the allocation's new memory after defragmentation and
+        // returns the old one, which the caller destroys once the GPU is done with it.
+        vk::Image relocate(vk::Image image);
+
         void clear() noexcept;
         void release() noexcept;
 
       private:
         vk::Device device_;
         vma::Allocator allocator_;
+        VulkanDeletionQueue* deletionQueue_ = nullptr;
 
         vk::Image image_;
         vma::Allocation allocation_;
     };
+
+    vk::ImageCreateInfo toVkImageCreateInfo(const GPUImageDescription& description);
 }  // namespace aetherion
\ No newline at end of file
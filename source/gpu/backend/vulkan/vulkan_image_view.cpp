@@ -1,5 +1,6 @@
 #include "vulkan_image_view.hpp"
 
+#include "vulkan_cast.hpp"
 #include "vulkan_device.hpp"
 #include "vulkan_image.hpp"
 #include "vulkan_render_definitions.hpp"
@@ -7,12 +8,12 @@
 namespace aetherion {
     VulkanImageView::VulkanImageView(VulkanDevice& device,
                                      const GPUImageViewDescription& description)
-        : device_(device.getVkDevice()) {
+        : device_(device.getVkDevice()), deletionQueue_(device.getDeletionQueue()) {
         if (!description.image) {
             throw std::invalid_argument("Image in GPUImageViewDescription is null.");
         }
 
-        auto& vkImage = dynamic_cast<VulkanImage&>(*description.image);
+        auto& vkImage = vulkanCast<VulkanImage>(*description.image);
 
         imageView_ = device_.createImageView(
             vk::ImageViewCreateInfo()
@@ -28,7 +29,7 @@ namespace aetherion {
                     vk::ImageSubresourceRange()
                         .setAspectMask(toVkImageAspectFlags(description.subresource.aspectMask))
                         .setBaseMipLevel(description.subresource.range.baseMipLevel)
-                        .setLevelCount(description.subresource.range.layerCount)
+                        .setLevelCount(description.subresource.range.mipLevelCount)
                         .setBaseArrayLayer(description.subresource.range.baseArrayLayer)
                         .setLayerCount(description.subresource.range.layerCount)));
     }
@@ -39,8 +40,12 @@ namespace aetherion {
     VulkanImageView::~VulkanImageView() noexcept { clear(); }
 
     VulkanImageView::VulkanImageView(VulkanImageView&& other) noexcept
-        : IGPUImageView(std::move(other)), device_(other.device_), imageView_(other.imageView_) {
+        : IGPUImageView(std::move(other)),
+          device_(other.device_),
+          deletionQueue_(other.deletionQueue_),
+          imageView_(other.imageView_) {
         other.device_ = nullptr;
+        other.deletionQueue_ = nullptr;
         other.imageView_ = nullptr;
     }
 
@@ -50,6 +55,7 @@ namespace aetherion {
 
             IGPUImageView::operator=(std::move(other));
             device_ = other.device_;
+            deletionQueue_ = other.deletionQueue_;
             imageView_ = other.imageView_;
 
             other.release();
@@ -58,15 +64,17 @@ namespace aetherion {
     }
 
     void VulkanImageView::clear() noexcept {
-        if (imageView_ && device_) {
+        if (imageView_ && deletionQueue_) {
+            deletionQueue_->enqueue(imageView_);
+        } else if (imageView_ && device_) {
             device_.destroyImageView(imageView_);
-            imageView_ = nullptr;
         }
-        device_ = nullptr;
+        release();
     }
 
     void VulkanImageView::release() noexcept {
         imageView_ = nullptr;
         device_ = nullptr;
+        deletionQueue_ = nullptr;
     }
 }  // namespace aetherion
\ No newline at end of file
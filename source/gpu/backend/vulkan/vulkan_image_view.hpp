@@ -7,9 +7,10 @@
 namespace aetherion {
     // Forward declarations
     class VulkanDevice;
+    class VulkanDeletionQueue;
     class VulkanImage;
 
-    class VulkanImageView : public IGPUImageView {
+    class VulkanImageView final : public IGPUImageView {
       public:
         VulkanImageView() = delete;
         VulkanImageView(VulkanDevice& device, const GPUImageViewDescription& description);
@@ -30,6 +31,7 @@ namespace aetherion {
 
       private:
         vk::Device device_;
+        VulkanDeletionQueue* deletionQueue_ = nullptr;
 
         vk::ImageView imageView_;
     };
@@ -0,0 +1,105 @@
+#include "vulkan_layout_cache.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "aetherion/util/hash.hpp"
+#include "vulkan_cast.hpp"
+#include "vulkan_device.hpp"
+#include "vulkan_pipeline.hpp"
+
+namespace aetherion {
+    constexpr size_t MIN_LAYOUT_CACHE_PRUNE_SIZE = 64;
+
+    size_t VulkanDescriptorSetLayoutKeyHash::operator()(
+        const VulkanDescriptorSetLayoutKey& key) const noexcept {
+        size_t seed = key.bindings.size();
+        hashCombine(seed, key.pushDescriptor);
+        for (const auto& binding : key.bindings) {
+            hashCombine(seed, binding.binding.binding);
+            hashCombine(seed, static_cast<uint32_t>(binding.binding.descriptorType));
+            hashCombine(seed, binding.binding.descriptorCount);
+            hashCombine(seed, static_cast<VkShaderStageFlags>(binding.binding.stageFlags));
+            hashCombine(seed, static_cast<VkDescriptorBindingFlags>(binding.flags));
+        }
+        return seed;
+    }
+
+    size_t VulkanPipelineLayoutKeyHash::operator()(
+        const VulkanPipelineLayoutKey& key) const noexcept {
+        size_t seed = key.descriptorSetLayouts.size();
+        for (const auto& descriptorSetLayout : key.descriptorSetLayouts) {
+            hashCombine(seed, VulkanDescriptorSetLayoutKeyHash{}(descriptorSetLayout));
+        }
+        for (const auto& range : key.pushConstantRanges) {
+            hashCombine(seed, static_cast<VkShaderStageFlags>(range.stageFlags));
+            hashCombine(seed, range.offset);
+            hashCombine(seed, range.size);
+        }
+        return seed;
+    }
+
+    // NOTE: Drops the entries of destroyed layouts once the map doubled since the last pass.
+    template <typename Map> void pruneExpiredLayouts(Map& layouts, size_t& pruneSize) {
+        if (layouts.size() < pruneSize) {
+            return;
+        }
+        std::erase_if(layouts, [](const auto& entry) { return entry.second.expired(); });
+        pruneSize = std::max(MIN_LAYOUT_CACHE_PRUNE_SIZE, layouts.size() * 2);
+    }
+
+    std::shared_ptr<VulkanDescriptorSetLayout> VulkanLayoutCache::getOrCreateDescriptorSetLayout(
+        VulkanDevice& device, const DescriptorSetLayoutDescription& description) {
+        auto key = toVulkanDescriptorSetLayoutKey(device, description);
+
+        std::lock_guard lock(mutex_);
+        if (auto it = descriptorSetLayouts_.find(key); it != descriptorSetLayouts_.end()) {
+            if (auto layout = it->second.lock()) {
+                return layout;
+            }
+        }
+
+        pruneExpiredLayouts(descriptorSetLayouts_, descriptorSetLayoutPruneSize_);
+
+        auto layout = std::make_shared<VulkanDescriptorSetLayout>(device, description);
+        descriptorSetLayouts_.insert_or_assign(std::move(key), layout);
+        return layout;
+    }
+
+    std::shared_ptr<VulkanPipelineLayout> VulkanLayoutCache::getOrCreatePipelineLayout(
+        VulkanDevice& device, const PipelineLayoutDescription& description) {
+        VulkanPipelineLayoutKey key;
+        key.descriptorSetLayouts.reserve(description.descriptorSetLayouts.size());
+        for (const auto* layout : description.descriptorSetLayouts) {
+            const auto* vkLayout = vulkanCast<VulkanDescriptorSetLayout>(layout);
+            if (!vkLayout) {
+                throw std::invalid_argument("Invalid descriptor set layout.");
+            }
+            if (!vkLayout->getLayoutKey()) {
+                return std::make_shared<VulkanPipelineLayout>(device, description);
+            }
+            key.descriptorSetLayouts.push_back(*vkLayout->getLayoutKey());
+        }
+        key.pushConstantRanges.reserve(description.pushConstantRanges.size());
+        for (const auto* range : description.pushConstantRanges) {
+            const auto* vkRange = vulkanCast<VulkanPushConstantRange>(range);
+            if (!vkRange) {
+                throw std::invalid_argument("Invalid push constant range.");
+            }
+            key.pushConstantRanges.push_back(vkRange->getVkPushConstantRange());
+        }
+
+        std::lock_guard lock(mutex_);
+        if (auto it = pipelineLayouts_.find(key); it != pipelineLayouts_.end()) {
+            if (auto layout = it->second.lock()) {
+                return layout;
+            }
+        }
+
+        pruneExpiredLayouts(pipelineLayouts_, pipelineLayoutPruneSize_);
+
+        auto layout = std::make_shared<VulkanPipelineLayout>(device, description);
+        pipelineLayouts_.insert_or_assign(std::move(key), layout);
+        return layout;
+    }
+}  // namespace aetherion
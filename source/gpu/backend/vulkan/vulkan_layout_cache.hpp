@@ -0,0 +1,67 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+#include "vulkan_descriptor_set.hpp"
+
+namespace aetherion {
+    // Forward declarations
+    class VulkanDevice;
+    class VulkanPipelineLayout;
+    struct PipelineLayoutDescription;
+
+    // NOTE: Set layouts are compared by contents rather than handle, a handle may be reused once
+    // its layout is destroyed.
+    struct VulkanPipelineLayoutKey {
+        std::vector<VulkanDescriptorSetLayoutKey> descriptorSetLayouts;
+        std::vector<vk::PushConstantRange> pushConstantRanges;
+
+        bool operator==(const VulkanPipelineLayoutKey&) const = default;
+    };
+
+    struct VulkanDescriptorSetLayoutKeyHash {
+        size_t operator()(const VulkanDescriptorSetLayoutKey& key) const noexcept;
+    };
+
+    struct VulkanPipelineLayoutKeyHash {
+        size_t operator()(const VulkanPipelineLayoutKey& key) const noexcept;
+    };
+
+    // NOTE: Owned by VulkanDevice. Only holds weak references, a layout is destroyed once the last
+    // user releases it and its entry is pruned on a later insertion.
+    class VulkanLayoutCache {
+      public:
+        VulkanLayoutCache() = default;
+        ~VulkanLayoutCache() noexcept = default;
+
+        VulkanLayoutCache(const VulkanLayoutCache&) = delete;
+        VulkanLayoutCache& operator=(const VulkanLayoutCache&) = delete;
+
+        VulkanLayoutCache(VulkanLayoutCache&&) = delete;
+        VulkanLayoutCache& operator=(VulkanLayoutCache&&) = delete;
+
+        // NOTE: Thread safe.
+        std::shared_ptr<VulkanDescriptorSetLayout> getOrCreateDescriptorSetLayout(
+            VulkanDevice& device, const DescriptorSetLayoutDescription& description);
+        // NOTE: Thread safe. Layouts referencing set layouts that wrap raw handles aren't cached.
+        std::shared_ptr<VulkanPipelineLayout> getOrCreatePipelineLayout(
+            VulkanDevice& device, const PipelineLayoutDescription& description);
+
+      private:
+        std::mutex mutex_;
+
+        std::unordered_map<VulkanDescriptorSetLayoutKey, std::weak_ptr<VulkanDescriptorSetLayout>,
+                           VulkanDescriptorSetLayoutKeyHash>
+            descriptorSetLayouts_;
+        std::unordered_map<VulkanPipelineLayoutKey, std::weak_ptr<VulkanPipelineLayout>,
+                           VulkanPipelineLayoutKeyHash>
+            pipelineLayouts_;
+
+        size_t descriptorSetLayoutPruneSize_ = 64;
+        size_t pipelineLayoutPruneSize_ = 64;
+    };
+}  // namespace aetherion
@@ -1,21 +1,51 @@
 #include "vulkan_memory.hpp"
 
 #include "vulkan_buffer.hpp"
+#include "vulkan_cast.hpp"
+#include "vulkan_defragmenter.hpp"
 #include "vulkan_device.hpp"
 #include "vulkan_image.hpp"
 #include "vulkan_render_definitions.hpp"
 
 namespace aetherion {
+    vma::AllocationCreateInfo toVmaAllocationCreateInfo(
+        const GPUAllocationDescription& description) {
+        auto* vkAllocatorPool = vulkanCast<VulkanAllocatorPool>(description.pool);
+
+        auto flags = toVmaAllocationCreateFlags(description.properties);
+        if (description.memoryUsage == MemoryUsage::PreferGpuHostVisible) {
+            flags |= vma::AllocationCreateFlagBits::eMapped;
+            if (!description.properties.contains(AllocationProperty::RandomAccess)) {
+                flags |= vma::AllocationCreateFlagBits::eHostAccessSequentialWrite;
+            }
+        }
+
+        return vma::AllocationCreateInfo()
+            //.setMemoryTypeBits(description.memoryTypeBits)
+            .setPool(vkAllocatorPool ? vkAllocatorPool->getVmaPool() : nullptr)
+            .setPriority(description.priority)
+            .setUsage(toVmaMemoryUsage(description.memoryUsage))
+            .setFlags(flags);
+    }
+
     VulkanAllocator::VulkanAllocator(VulkanDevice& device,
                                      const GPUAllocatorDescription& description)
-        : physicalDevice_(device.getVkPhysicalDevice()), device_(device.getVkDevice()) {
+        : physicalDevice_(device.getVkPhysicalDevice()),
+          device_(device.getVkDevice()),
+          deletionQueue_(device.getDeletionQueue()),
+          descriptorBuffers_(device.usesDescriptorBuffers()) {
+        auto flags = toVmaAllocatorFlags(description.flags)
+                     | vma::AllocatorCreateFlagBits::eBufferDeviceAddress;
+        if (device.isExtensionEnabled(vk::EXTMemoryBudgetExtensionName)) {
+            flags |= vma::AllocatorCreateFlagBits::eExtMemoryBudget;
+        }
+
         allocator_ = vma::createAllocator(
             vma::AllocatorCreateInfo()
                 .setPhysicalDevice(physicalDevice_)
                 .setDevice(device_)
                 .setInstance(device.getVkInstance())
-                .setFlags(toVmaAllocatorFlags(description.flags)
-                          | vma::AllocatorCreateFlagBits::eBufferDeviceAddress)
+                .setFlags(flags)
                 //.setPHeapSizeLimit(&description.heapSizeLimit)
                 .setVulkanApiVersion(VK_API_VERSION_1_3));
     }
@@ -30,10 +60,14 @@ namespace aetherion {
         : IGPUAllocator(std::move(other)),
           physicalDevice_(other.physicalDevice_),
           device_(other.device_),
-          allocator_(other.allocator_) {
+          allocator_(other.allocator_),
+          deletionQueue_(other.deletionQueue_),
+          descriptorBuffers_(other.descriptorBuffers_) {
         other.physicalDevice_ = nullptr;
         other.device_ = nullptr;
         other.allocator_ = nullptr;
+        other.deletionQueue_ = nullptr;
+        other.descriptorBuffers_ = false;
     }
 
     VulkanAllocator& VulkanAllocator::operator=(VulkanAllocator&& other) noexcept {
@@ -44,6 +78,8 @@ namespace aetherion {
             physicalDevice_ = other.physicalDevice_;
             device_ = other.device_;
             allocator_ = other.allocator_;
+            deletionQueue_ = other.deletionQueue_;
+            descriptorBuffers_ = other.descriptorBuffers_;
 
             other.release();
         }
@@ -51,7 +87,10 @@ namespace aetherion {
     }
 
     void VulkanAllocator::clear() noexcept {
-        if (allocator_) {
+        // NOTE: Deferred after every resource it allocated, as they were enqueued before.
+        if (allocator_ && deletionQueue_) {
+            deletionQueue_->enqueue(allocator_);
+        } else if (allocator_) {
             allocator_.destroy();
         }
         release();
@@ -61,6 +100,8 @@ namespace aetherion {
         physicalDevice_ = nullptr;
         device_ = nullptr;
         allocator_ = nullptr;
+        deletionQueue_ = nullptr;
+        descriptorBuffers_ = false;
     }
 
     std::unique_ptr<IGPUAllocatorPool> VulkanAllocator::createPool(
@@ -98,52 +139,58 @@ namespace aetherion {
 
     std::unique_ptr<IGPUImage> VulkanAllocator::createAliasedImage(
         IGPUAllocation& allocation, const GPUImageDescription& description, size_t offset) {
-        auto& vkAllocation = dynamic_cast<VulkanAllocation&>(allocation);
+        auto& vkAllocation = vulkanCast<VulkanAllocation>(allocation);
 
         return std::make_unique<VulkanImage>(
             device_, allocator_,
-            allocator_.createAliasingImage2(
-                vkAllocation.getVmaAllocation(), offset,
-                vk::ImageCreateInfo()
-                    .setImageType(toVkImageType(description.type))
-                    .setFormat(toVkFormat(description.format))
-                    .setExtent(toVkExtent3D(description.extent))
-                    .setMipLevels(description.mipLevels)
-                    .setArrayLayers(description.arrayLayers)
-                    .setSamples(toVkSampleCount(description.sampleCount))
-                    .setInitialLayout(toVkImageLayout(description.initialLayout))
-                    .setTiling(toVkImageTiling(description.tiling))
-                    .setUsage(toVkImageUsageFlags(description.usages))
-                    .setSharingMode(toVkSharingMode(description.sharingMode))
-                    .setQueueFamilyIndices(description.queueFamilies)
-                    .setFlags((description.cubeCompatible ? vk::ImageCreateFlagBits::eCubeCompatible
-                                                          : vk::ImageCreateFlags())
-                              | (description.arrayCompatible
-                                     ? vk::ImageCreateFlagBits::e2DArrayCompatible
-                                     : vk::ImageCreateFlags())
-                              | (description.type == GPUImageType::Tex3d
-                                     ? vk::ImageCreateFlagBits::e2DArrayCompatible  // Assuming this
-                                                                                    // usage.
-                                     : vk::ImageCreateFlags()))),
-            nullptr);  // No allocation because aliased and as such
-                       // the allocation is managed externally.
+            allocator_.createAliasingImage2(vkAllocation.getVmaAllocation(), offset,
+                                            toVkImageCreateInfo(description)),
+            nullptr,  // No allocation because aliased and as such
+                      // the allocation is managed externally.
+            deletionQueue_);
     }
 
     std::unique_ptr<IGPUBuffer> VulkanAllocator::createAliasedBuffer(
         IGPUAllocation& allocation, const GPUBufferDescription& description, size_t offset) {
-        auto& vkAllocation = dynamic_cast<VulkanAllocation&>(allocation);
+        auto& vkAllocation = vulkanCast<VulkanAllocation>(allocation);
 
         return std::make_unique<VulkanBuffer>(
             device_, allocator_,
-            allocator_.createAliasingBuffer2(
-                vkAllocation.getVmaAllocation(), offset,
-                vk::BufferCreateInfo()
-                    .setSize(description.size)
-                    .setUsage(toVkBufferUsageFlags(description.usages))
-                    .setSharingMode(toVkSharingMode(description.sharingMode))
-                    .setQueueFamilyIndices(description.queueFamilies)),
-            nullptr);  // No allocation because aliased and as such
-                       // the allocation is managed externally.
+            allocator_.createAliasingBuffer2(vkAllocation.getVmaAllocation(), offset,
+                                             toVkBufferCreateInfo(description, descriptorBuffers_)),
+            nullptr,  // No allocation because aliased and as such
+                      // the allocation is managed externally.
+            deletionQueue_);
+    }
+
+    std::vector<GPUMemoryHeapBudget> VulkanAllocator::getHeapBudgets() const {
+        const auto memoryProperties = physicalDevice_.getMemoryProperties();
+
+        std::vector<vma::Budget> vmaBudgets(memoryProperties.memoryHeapCount);
+        allocator_.getHeapBudgets(vmaBudgets.data());
+
+        std::vector<GPUMemoryHeapBudget> budgets;
+        budgets.reserve(vmaBudgets.size());
+        for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; ++i) {
+            const auto& heap = memoryProperties.memoryHeaps[i];
+            budgets.push_back({.size = heap.size,
+                               .budget = vmaBudgets[i].budget,
+                               .usage = vmaBudgets[i].usage,
+                               .blockBytes = vmaBudgets[i].statistics.blockBytes,
+                               .allocationBytes = vmaBudgets[i].statistics.allocationBytes,
+                               .deviceLocal = static_cast<bool>(
+                                   heap.flags & vk::MemoryHeapFlagBits::eDeviceLocal)});
+        }
+        return budgets;
+    }
+
+    void VulkanAllocator::setCurrentFrameIndex(uint32_t frameIndex) {
+        allocator_.setCurrentFrameIndex(frameIndex);
+    }
+
+    std::unique_ptr<IGPUDefragmenter> VulkanAllocator::createDefragmenter(
+        const GPUDefragmenterDescription& description) {
+        return std::make_unique<VulkanDefragmenter>(*this, description);
     }
 
     constexpr vk::MemoryRequirements toVkMemoryRequirements(
@@ -159,47 +206,26 @@ namespace aetherion {
         VulkanAllocator& allocator,
         const GPUAllocationMemoryRequirementsDescription& memoryRequirements,
         const GPUAllocationDescription& description)
-        : allocator_(allocator.getVmaAllocator()) {
-        auto* vkAllocatorPool = dynamic_cast<VulkanAllocatorPool*>(description.pool);
-
+        : allocator_(allocator.getVmaAllocator()), deletionQueue_(allocator.getDeletionQueue()) {
         allocation_ = allocator_.allocateMemory(
             toVkMemoryRequirements(memoryRequirements),
-            vma::AllocationCreateInfo()
-                //.setMemoryTypeBits(description.memoryTypeBits)
-                .setPool(vkAllocatorPool ? vkAllocatorPool->getVmaPool() : nullptr)
-                .setPriority(description.priority)
-                .setUsage(toVmaMemoryUsage(description.memoryUsage))
-                .setFlags(toVmaAllocationCreateFlags(description.properties)));
+            toVmaAllocationCreateInfo(description));
     }
 
     VulkanAllocation::VulkanAllocation(VulkanAllocator& allocator, const IGPUImage& image,
                                        const GPUAllocationDescription& description)
-        : allocator_(allocator.getVmaAllocator()) {
-        auto* vkAllocatorPool = dynamic_cast<VulkanAllocatorPool*>(description.pool);
-
+        : allocator_(allocator.getVmaAllocator()), deletionQueue_(allocator.getDeletionQueue()) {
         allocation_ = allocator_.allocateMemoryForImage(
-            dynamic_cast<const VulkanImage&>(image).getVkImage(),
-            vma::AllocationCreateInfo()
-                //.setMemoryTypeBits(description.memoryTypeBits)
-                .setPool(vkAllocatorPool ? vkAllocatorPool->getVmaPool() : nullptr)
-                .setPriority(description.priority)
-                .setUsage(toVmaMemoryUsage(description.memoryUsage))
-                .setFlags(toVmaAllocationCreateFlags(description.properties)));
+            vulkanCast<VulkanImage>(image).getVkImage(),
+            toVmaAllocationCreateInfo(description));
     }
 
     VulkanAllocation::VulkanAllocation(VulkanAllocator& allocator, const IGPUBuffer& buffer,
                                        const GPUAllocationDescription& description)
-        : allocator_(allocator.getVmaAllocator()) {
-        auto* vkAllocatorPool = dynamic_cast<VulkanAllocatorPool*>(description.pool);
-
+        : allocator_(allocator.getVmaAllocator()), deletionQueue_(allocator.getDeletionQueue()) {
         allocation_ = allocator_.allocateMemoryForBuffer(
-            dynamic_cast<const VulkanBuffer&>(buffer).getVkBuffer(),
-            vma::AllocationCreateInfo()
-                //.setMemoryTypeBits(description.memoryTypeBits)
-                .setPool(vkAllocatorPool ? vkAllocatorPool->getVmaPool() : nullptr)
-                .setPriority(description.priority)
-                .setUsage(toVmaMemoryUsage(description.memoryUsage))
-                .setFlags(toVmaAllocationCreateFlags(description.properties)));
+            vulkanCast<VulkanBuffer>(buffer).getVkBuffer(),
+            toVmaAllocationCreateInfo(description));
     }
 
     VulkanAllocation::VulkanAllocation(vma::Allocator allocator, vma::Allocation allocation)
@@ -210,8 +236,10 @@ namespace aetherion {
     VulkanAllocation::VulkanAllocation(VulkanAllocation&& other) noexcept
         : IGPUAllocation(std::move(other)),
           allocator_(other.allocator_),
+          deletionQueue_(other.deletionQueue_),
           allocation_(other.allocation_) {
         other.allocator_ = nullptr;
+        other.deletionQueue_ = nullptr;
         other.allocation_ = nullptr;
     }
 
@@ -221,6 +249,7 @@ namespace aetherion {
 
             IGPUAllocation::operator=(std::move(other));
             allocator_ = other.allocator_;
+            deletionQueue_ = other.deletionQueue_;
             allocation_ = other.allocation_;
 
             other.release();
@@ -229,7 +258,9 @@ namespace aetherion {
     }
 
     void VulkanAllocation::clear() noexcept {
-        if (allocation_ && allocator_) {
+        if (allocation_ && allocator_ && deletionQueue_) {
+            deletionQueue_->enqueue(allocation_, allocator_);
+        } else if (allocation_ && allocator_) {
             allocator_.freeMemory(allocation_);
         }
         release();
@@ -237,12 +268,13 @@ namespace aetherion {
 
     void VulkanAllocation::release() noexcept {
         allocator_ = nullptr;
+        deletionQueue_ = nullptr;
         allocation_ = nullptr;
     }
 
     VulkanAllocatorPool::VulkanAllocatorPool(VulkanAllocator& allocator,
                                              const GPUAllocatorPoolDescription& description)
-        : allocator_(allocator.getVmaAllocator()) {
+        : allocator_(allocator.getVmaAllocator()), deletionQueue_(allocator.getDeletionQueue()) {
         pool_ = allocator_.createPool(vma::PoolCreateInfo()
                                           //.setMemoryTypeIndex(description.memoryTypeIndex)
                                           .setBlockSize(description.blockSize)
@@ -257,8 +289,12 @@ namespace aetherion {
     VulkanAllocatorPool::~VulkanAllocatorPool() noexcept { clear(); }
 
     VulkanAllocatorPool::VulkanAllocatorPool(VulkanAllocatorPool&& other) noexcept
-        : IGPUAllocatorPool(std::move(other)), allocator_(other.allocator_), pool_(other.pool_) {
+        : IGPUAllocatorPool(std::move(other)),
+          allocator_(other.allocator_),
+          deletionQueue_(other.deletionQueue_),
+          pool_(other.pool_) {
         other.allocator_ = nullptr;
+        other.deletionQueue_ = nullptr;
         other.pool_ = nullptr;
     }
 
@@ -268,6 +304,7 @@ namespace aetherion {
 
             IGPUAllocatorPool::operator=(std::move(other));
             allocator_ = other.allocator_;
+            deletionQueue_ = other.deletionQueue_;
             pool_ = other.pool_;
 
             other.release();
@@ -276,7 +313,9 @@ namespace aetherion {
     }
 
     void VulkanAllocatorPool::clear() noexcept {
-        if (pool_ && allocator_) {
+        if (pool_ && allocator_ && deletionQueue_) {
+            deletionQueue_->enqueue(pool_, allocator_);
+        } else if (pool_ && allocator_) {
             allocator_.destroyPool(pool_);
         }
         release();
@@ -285,5 +324,6 @@ namespace aetherion {
     void VulkanAllocatorPool::release() noexcept {
         pool_ = nullptr;
         allocator_ = nullptr;
+        deletionQueue_ = nullptr;
     }
 }  // namespace aetherion
\ No newline at end of file
@@ -8,8 +8,9 @@
 namespace aetherion {
     // Forward declarations
     class VulkanDevice;
+    class VulkanDeletionQueue;
 
-    class VulkanAllocator : public IGPUAllocator {
+    class VulkanAllocator final : public IGPUAllocator {
       public:
         VulkanAllocator() = delete;
         VulkanAllocator(VulkanDevice& device, const GPUAllocatorDescription& description);
@@ -52,12 +53,23 @@ namespace aetherion {
                                                         const GPUBufferDescription& description,
                                                         size_t offset = 0) override;
 
+        std::vector<GPUMemoryHeapBudget> getHeapBudgets() const override;
+        void setCurrentFrameIndex(uint32_t frameIndex) override;
+
+        std::unique_ptr<IGPUDefragmenter> createDefragmenter(
+            const GPUDefragmenterDescription& description) override;
+
         inline vk::PhysicalDevice getVkPhysicalDevice() const { return physicalDevice_; }
 
         inline vk::Device getVkDevice() const { return device_; }
 
         inline vma::Allocator getVmaAllocator() const { return allocator_; }
 
+        inline VulkanDeletionQueue* getDeletionQueue() const { return deletionQueue_; }
+
+        // NOTE: Always false for allocators wrapping a raw handle.
+        inline bool usesDescriptorBuffers() const { return descriptorBuffers_; }
+
         void clear() noexcept;
         void release() noexcept;
 
@@ -65,9 +77,11 @@ namespace aetherion {
         vk::PhysicalDevice physicalDevice_;
         vk::Device device_;
         vma::Allocator allocator_;
+        VulkanDeletionQueue* deletionQueue_ = nullptr;
+        bool descriptorBuffers_ = false;
     };
 
-    class VulkanAllocation : public IGPUAllocation {
+    class VulkanAllocation final : public IGPUAllocation {
       public:
         VulkanAllocation() = delete;
         VulkanAllocation(VulkanAllocator& allocator,
@@ -93,10 +107,11 @@ namespace aetherion {
 
       private:
         vma::Allocator allocator_;
+        VulkanDeletionQueue* deletionQueue_ = nullptr;
         vma::Allocation allocation_;
     };
 
-    class VulkanAllocatorPool : public IGPUAllocatorPool {
+    class VulkanAllocatorPool final : public IGPUAllocatorPool {
       public:
         VulkanAllocatorPool() = delete;
         VulkanAllocatorPool(VulkanAllocator& allocator,
@@ -117,6 +132,10 @@ namespace aetherion {
 
       private:
         vma::Allocator allocator_;
+        VulkanDeletionQueue* deletionQueue_ = nullptr;
         vma::Pool pool_;
     };
+
+    vma::AllocationCreateInfo toVmaAllocationCreateInfo(
+        const GPUAllocationDescription& description);
 }  // namespace aetherion
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <stdexcept>
 #include <unordered_set>
 
+#include "vulkan_cast.hpp"
 #include "vulkan_descriptor_set.hpp"
 #include "vulkan_device.hpp"
 #include "vulkan_render_definitions.hpp"
@@ -16,7 +17,7 @@ namespace aetherion {
         if (!description.shader) {
             throw std::invalid_argument("Shader in ShaderModuleStageDescription is null.");
         }
-        const auto* vkShader = dynamic_cast<const VulkanShader*>(description.shader);
+        const auto* vkShader = vulkanCast<VulkanShader>(description.shader);
 
         return vk::PipelineShaderStageCreateInfo()
             .setStage(toVkShaderStageFlag(description.stage))
@@ -31,7 +32,7 @@ namespace aetherion {
         if (!layout) {
             throw std::invalid_argument("Pipeline layout in ComputePipelineDescription is null.");
         }
-        auto vkLayout = dynamic_cast<const VulkanPipelineLayout*>(layout);
+        auto vkLayout = vulkanCast<VulkanPipelineLayout>(layout);
 
         // Shader stage
         auto vkComputeShader = toVkPipelineShaderStageCreateInfo(description.computeShader);
@@ -43,12 +44,18 @@ namespace aetherion {
         auto pipelineInfo = vk::ComputePipelineCreateInfo();
         pipelineInfo.setStage(vkComputeShader);
         pipelineInfo.setLayout(pipelineLayout);
+        if (vkLayout->usesDescriptorBuffers()) {
+            pipelineInfo.setFlags(vk::PipelineCreateFlagBits::eDescriptorBufferEXT);
+        }
 
         return pipelineInfo;
     }
 
-    vk::GraphicsPipelineCreateInfo toVkGraphicsPipelineCreateInfo(
-        const VulkanPipelineLayout& layout, const GraphicsPipelineDescription& description) {
+    // NOTE: Builds and creates the pipeline in one go, as the create info points into the state
+    // structures built here.
+    vk::Pipeline createVkGraphicsPipeline(vk::Device device, vk::PipelineCache pipelineCache,
+                                          const VulkanPipelineLayout& layout,
+                                          const GraphicsPipelineDescription& description) {
         // Shader stages
         // TODO: Handle more robust use cases (e.g. multiple shader stages, optional stages, etc.).
         // TODO: Missing validation that the provided shaders match the pipeline description.
@@ -186,7 +193,6 @@ namespace aetherion {
             description.depthStencilStateDescription.stencilFormat));*/
 
         // Pipeline creation
-        // TODO: Handle pipeline caching.
 
         auto pipelineInfo = vk::GraphicsPipelineCreateInfo();
         pipelineInfo.setStages(vkShaderStages);
@@ -200,12 +206,19 @@ namespace aetherion {
         pipelineInfo.setPColorBlendState(&colorBlending);
         pipelineInfo.setLayout(pipelineLayout);
         pipelineInfo.setPNext(&renderingInfo);
+        if (layout.usesDescriptorBuffers()) {
+            pipelineInfo.setFlags(vk::PipelineCreateFlagBits::eDescriptorBufferEXT);
+        }
 
-        return pipelineInfo;
+        auto result = device.createGraphicsPipeline(pipelineCache, pipelineInfo);
+        if (result.result != vk::Result::eSuccess) {
+            throw std::runtime_error("Failed to create Vulkan graphics pipeline.");
+        }
+        return result.value;
     }
 
     vk::PushConstantRange toVkPushConstantRange(const IPushConstantRange* range) {
-        const auto* vkRange = dynamic_cast<const VulkanPushConstantRange*>(range);
+        const auto* vkRange = vulkanCast<VulkanPushConstantRange>(range);
         if (!vkRange) {
             throw std::invalid_argument("Invalid push constant range.");
         }
@@ -213,7 +226,7 @@ namespace aetherion {
     }
 
     vk::DescriptorSetLayout toVkDescriptorSetLayout(const IDescriptorSetLayout* layout) {
-        const auto* vkLayout = dynamic_cast<const VulkanDescriptorSetLayout*>(layout);
+        const auto* vkLayout = vulkanCast<VulkanDescriptorSetLayout>(layout);
         if (!vkLayout) {
             throw std::invalid_argument("Invalid descriptor set layout.");
         }
@@ -249,6 +262,18 @@ namespace aetherion {
 
         auto vkSetLayouts = toVkDescriptorSetLayouts(description.descriptorSetLayouts);
 
+        bool pushDescriptor = false;
+        for (const auto* layout : description.descriptorSetLayouts) {
+            const auto* vkLayout = vulkanCast<VulkanDescriptorSetLayout>(layout);
+            descriptorBuffers_ = descriptorBuffers_ || vkLayout->getDescriptorBufferLayout();
+
+            if (pushDescriptor && vkLayout->isPushDescriptor()) {
+                throw std::invalid_argument(
+                    "Pipeline layouts can't have more than one push descriptor set layout.");
+            }
+            pushDescriptor = pushDescriptor || vkLayout->isPushDescriptor();
+        }
+
         pipelineLayout_
             = device_.createPipelineLayout(vk::PipelineLayoutCreateInfo()
                                                .setSetLayouts(vkSetLayouts)
@@ -264,9 +289,11 @@ namespace aetherion {
     VulkanPipelineLayout::VulkanPipelineLayout(VulkanPipelineLayout&& other) noexcept
         : IPipelineLayout(std::move(other)),
           device_(other.device_),
-          pipelineLayout_(other.pipelineLayout_) {
+          pipelineLayout_(other.pipelineLayout_),
+          descriptorBuffers_(other.descriptorBuffers_) {
         other.device_ = nullptr;
         other.pipelineLayout_ = nullptr;
+        other.descriptorBuffers_ = false;
     }
 
     VulkanPipelineLayout& VulkanPipelineLayout::operator=(VulkanPipelineLayout&& other) noexcept {
@@ -276,6 +303,7 @@ namespace aetherion {
             IPipelineLayout::operator=(std::move(other));
             device_ = other.device_;
             pipelineLayout_ = other.pipelineLayout_;
+            descriptorBuffers_ = other.descriptorBuffers_;
 
             other.release();
         }
@@ -293,18 +321,19 @@ namespace aetherion {
     void VulkanPipelineLayout::release() noexcept {
         pipelineLayout_ = nullptr;
         device_ = nullptr;
+        descriptorBuffers_ = false;
     }
 
     VulkanPipeline::VulkanPipeline(VulkanDevice& device,
                                    const ComputePipelineDescription& description)
-        : device_(device.getVkDevice()) {
+        : device_(device.getVkDevice()), deletionQueue_(device.getDeletionQueue()) {
         if (!description.layout) {
             throw std::invalid_argument("Pipeline layout in ComputePipelineDescription is null.");
         }
-        const auto* vkLayout = dynamic_cast<const VulkanPipelineLayout*>(description.layout);
+        const auto* vkLayout = vulkanCast<VulkanPipelineLayout>(description.layout);
 
         auto result = device_.createComputePipeline(
-            {}, toVkComputePipelineCreateInfo(vkLayout, description));
+            device.getVkPipelineCache(), toVkComputePipelineCreateInfo(vkLayout, description));
         if (result.result != vk::Result::eSuccess) {
             throw std::runtime_error("Failed to create Vulkan compute pipeline.");
         }
@@ -315,18 +344,14 @@ namespace aetherion {
 
     VulkanPipeline::VulkanPipeline(VulkanDevice& device,
                                    const GraphicsPipelineDescription& description)
-        : device_(device.getVkDevice()) {
+        : device_(device.getVkDevice()), deletionQueue_(device.getDeletionQueue()) {
         if (!description.layout) {
             throw std::invalid_argument("Pipeline layout in GraphicsPipelineDescription is null.");
         }
-        const auto* vkLayout = dynamic_cast<const VulkanPipelineLayout*>(description.layout);
+        const auto* vkLayout = vulkanCast<VulkanPipelineLayout>(description.layout);
 
-        auto result = device_.createGraphicsPipeline(
-            {}, toVkGraphicsPipelineCreateInfo(*vkLayout, description));
-        if (result.result != vk::Result::eSuccess) {
-            throw std::runtime_error("Failed to create Vulkan graphics pipeline.");
-        }
-        pipeline_ = result.value;
+        pipeline_ = createVkGraphicsPipeline(device_, device.getVkPipelineCache(), *vkLayout,
+                                             description);
 
         pipelineType_ = PipelineBindPoint::Graphics;
     }
@@ -338,8 +363,12 @@ namespace aetherion {
     VulkanPipeline::~VulkanPipeline() noexcept { clear(); }
 
     VulkanPipeline::VulkanPipeline(VulkanPipeline&& other) noexcept
-        : device_(other.device_), pipeline_(other.pipeline_), pipelineType_(other.pipelineType_) {
+        : device_(other.device_),
+          deletionQueue_(other.deletionQueue_),
+          pipeline_(other.pipeline_),
+          pipelineType_(other.pipelineType_) {
         other.device_ = nullptr;
+        other.deletionQueue_ = nullptr;
         other.pipeline_ = nullptr;
     }
 
@@ -348,7 +377,9 @@ namespace aetherion {
             clear();
 
             device_ = other.device_;
+            deletionQueue_ = other.deletionQueue_;
             pipeline_ = other.pipeline_;
+            pipelineType_ = other.pipelineType_;
 
             other.release();
         }
@@ -356,15 +387,17 @@ namespace aetherion {
     }
 
     void VulkanPipeline::clear() noexcept {
-        if (pipeline_ && device_) {
+        if (pipeline_ && deletionQueue_) {
+            deletionQueue_->enqueue(pipeline_);
+        } else if (pipeline_ && device_) {
             device_.destroyPipeline(pipeline_);
-            pipeline_ = nullptr;
         }
-        device_ = nullptr;
+        release();
     }
 
     void VulkanPipeline::release() noexcept {
         pipeline_ = nullptr;
         device_ = nullptr;
+        deletionQueue_ = nullptr;
     }
 }  // namespace aetherion
\ No newline at end of file
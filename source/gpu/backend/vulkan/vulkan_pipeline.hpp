@@ -7,8 +7,9 @@
 namespace aetherion {
     // Forward declarations
     class VulkanDevice;
+    class VulkanDeletionQueue;
 
-    class VulkanPipelineLayout : public IPipelineLayout {
+    class VulkanPipelineLayout final : public IPipelineLayout {
       public:
         VulkanPipelineLayout() = delete;
         VulkanPipelineLayout(VulkanDevice& device, const PipelineLayoutDescription& description);
@@ -23,6 +24,9 @@ namespace aetherion {
 
         inline vk::PipelineLayout getVkPipelineLayout() const { return pipelineLayout_; }
 
+        // NOTE: Pipelines using descriptor buffer set layouts are created for descriptor buffers.
+        inline bool usesDescriptorBuffers() const { return descriptorBuffers_; }
+
         void clear() noexcept;
         void release() noexcept;
 
@@ -30,9 +34,11 @@ namespace aetherion {
         vk::Device device_;
 
         vk::PipelineLayout pipelineLayout_;
+
+        bool descriptorBuffers_ = false;
     };
 
-    class VulkanPipeline : public IPipeline {
+    class VulkanPipeline final : public IPipeline {
       public:
         VulkanPipeline() = delete;
         VulkanPipeline(VulkanDevice& device, const ComputePipelineDescription& description);
@@ -55,6 +61,7 @@ namespace aetherion {
 
       private:
         vk::Device device_;
+        VulkanDeletionQueue* deletionQueue_ = nullptr;
 
         vk::Pipeline pipeline_;
 
@@ -0,0 +1,203 @@
+#include "vulkan_pipeline_cache.hpp"
+
+#include <fmt/core.h>
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "aetherion/util/hash.hpp"
+
+namespace aetherion {
+    constexpr uint32_t PIPELINE_CACHE_FILE_MAGIC = 0x43504541;  // "AEPC"
+    constexpr uint32_t PIPELINE_CACHE_FILE_VERSION = 1;
+
+    // NOTE: Prepended to the driver provided data. Files written for another device, driver or
+    // file version are discarded on load.
+    struct PipelineCacheFileHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t vendorID;
+        uint32_t deviceID;
+        uint32_t driverVersion;
+        std::array<uint8_t, vk::UuidSize> pipelineCacheUUID;
+        std::array<uint8_t, vk::UuidSize> driverUUID;
+        uint64_t dataSize;
+        uint64_t dataHash;
+    };
+
+    PipelineCacheFileHeader makePipelineCacheFileHeader(
+        const vk::PhysicalDeviceProperties& properties,
+        const vk::PhysicalDeviceIDProperties& idProperties, std::span<const std::byte> data) {
+        PipelineCacheFileHeader header{};
+        header.magic = PIPELINE_CACHE_FILE_MAGIC;
+        header.version = PIPELINE_CACHE_FILE_VERSION;
+        header.vendorID = properties.vendorID;
+        header.deviceID = properties.deviceID;
+        header.driverVersion = properties.driverVersion;
+        std::memcpy(header.pipelineCacheUUID.data(), properties.pipelineCacheUUID.data(),
+                    vk::UuidSize);
+        std::memcpy(header.driverUUID.data(), idProperties.driverUUID.data(), vk::UuidSize);
+        header.dataSize = data.size();
+        header.dataHash = fnv1a64(data);
+        return header;
+    }
+
+    bool isPipelineCacheFileHeaderCompatible(const PipelineCacheFileHeader& header,
+                                             const PipelineCacheFileHeader& expected) {
+        return header.magic == expected.magic && header.version == expected.version
+               && header.vendorID == expected.vendorID && header.deviceID == expected.deviceID
+               && header.driverVersion == expected.driverVersion
+               && header.pipelineCacheUUID == expected.pipelineCacheUUID
+               && header.driverUUID == expected.driverUUID;
+    }
+
+    bool isVkPipelineCacheDataCompatible(std::span<const std::byte> data,
+                                         const vk::PhysicalDeviceProperties& properties) {
+        VkPipelineCacheHeaderVersionOne vkHeader{};
+        if (data.size() < sizeof(vkHeader)) {
+            return false;
+        }
+        std::memcpy(&vkHeader, data.data(), sizeof(vkHeader));
+
+        return vkHeader.headerSize >= sizeof(vkHeader)
+               && vkHeader.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+               && vkHeader.vendorID == properties.vendorID
+               && vkHeader.deviceID == properties.deviceID
+               && std::memcmp(vkHeader.pipelineCacheUUID, properties.pipelineCacheUUID.data(),
+                              vk::UuidSize)
+                      == 0;
+    }
+
+    std::vector<std::byte> readPipelineCacheFile(
+        const std::filesystem::path& path, const vk::PhysicalDeviceProperties& properties,
+        const vk::PhysicalDeviceIDProperties& idProperties) {
+        std::error_code errorCode;
+        const auto fileSize = std::filesystem::file_size(path, errorCode);
+        if (errorCode || fileSize < sizeof(PipelineCacheFileHeader)) {
+            return {};
+        }
+
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            return {};
+        }
+
+        PipelineCacheFileHeader header{};
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+            || !isPipelineCacheFileHeaderCompatible(
+                header, makePipelineCacheFileHeader(properties, idProperties, {}))
+            || header.dataSize != fileSize - sizeof(header)) {
+            return {};
+        }
+
+        std::vector<std::byte> data(header.dataSize);
+        if (!file.read(reinterpret_cast<char*>(data.data()),
+                       static_cast<std::streamsize>(data.size()))
+            || fnv1a64(data) != header.dataHash
+            || !isVkPipelineCacheDataCompatible(data, properties)) {
+            return {};
+        }
+
+        return data;
+    }
+
+    VulkanPipelineCache::VulkanPipelineCache(vk::Device device, vk::PhysicalDevice physicalDevice,
+                                             const std::filesystem::path& path)
+        : device_(device), path_(path) {
+        const auto& properties = physicalDevice.getProperties2<vk::PhysicalDeviceProperties2,
+                                                               vk::PhysicalDeviceIDProperties>();
+        physicalDeviceProperties_ = properties.get<vk::PhysicalDeviceProperties2>().properties;
+        physicalDeviceIDProperties_ = properties.get<vk::PhysicalDeviceIDProperties>();
+        physicalDeviceIDProperties_.pNext = nullptr;
+
+        // NOTE: Missing, stale or corrupted files are ignored and the cache starts empty.
+        std::vector<std::byte> initialData;
+        if (!path_.empty()) {
+            initialData = readPipelineCacheFile(path_, physicalDeviceProperties_,
+                                                physicalDeviceIDProperties_);
+        }
+
+        pipelineCache_ = device_.createPipelineCache(vk::PipelineCacheCreateInfo()
+                                                         .setInitialDataSize(initialData.size())
+                                                         .setPInitialData(initialData.data()));
+    }
+
+    VulkanPipelineCache::VulkanPipelineCache(vk::Device device, vk::PipelineCache pipelineCache)
+        : device_(device), pipelineCache_(pipelineCache) {}
+
+    VulkanPipelineCache::~VulkanPipelineCache() noexcept { clear(); }
+
+    VulkanPipelineCache::VulkanPipelineCache(VulkanPipelineCache&& other) noexcept
+        : device_(other.device_),
+          pipelineCache_(other.pipelineCache_),
+          path_(std::move(other.path_)),
+          physicalDeviceProperties_(other.physicalDeviceProperties_),
+          physicalDeviceIDProperties_(other.physicalDeviceIDProperties_) {
+        other.device_ = nullptr;
+        other.pipelineCache_ = nullptr;
+    }
+
+    VulkanPipelineCache& VulkanPipelineCache::operator=(VulkanPipelineCache&& other) noexcept {
+        if (this != &other) {
+            clear();
+
+            device_ = other.device_;
+            pipelineCache_ = other.pipelineCache_;
+            path_ = std::move(other.path_);
+            physicalDeviceProperties_ = other.physicalDeviceProperties_;
+            physicalDeviceIDProperties_ = other.physicalDeviceIDProperties_;
+
+            other.release();
+        }
+        return *this;
+    }
+
+    void VulkanPipelineCache::save() const {
+        if (path_.empty() || !pipelineCache_) {
+            return;
+        }
+
+        const auto& vkData = device_.getPipelineCacheData(pipelineCache_);
+        const auto data = std::as_bytes(std::span(vkData));
+        const auto header = makePipelineCacheFileHeader(physicalDeviceProperties_,
+                                                        physicalDeviceIDProperties_, data);
+
+        if (path_.has_parent_path()) {
+            std::filesystem::create_directories(path_.parent_path());
+        }
+
+        // NOTE: Written to a temporary file first so a crash never leaves a truncated cache.
+        auto temporaryPath = path_;
+        temporaryPath += ".tmp";
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(data.data()),
+                       static_cast<std::streamsize>(data.size()));
+
+            if (!file) {
+                throw(std::runtime_error(fmt::format("Failed to write pipeline cache file {}.",
+                                                     temporaryPath.string())));
+            }
+        }
+
+        std::filesystem::rename(temporaryPath, path_);
+    }
+
+    void VulkanPipelineCache::clear() noexcept {
+        if (pipelineCache_ && device_) {
+            device_.destroyPipelineCache(pipelineCache_);
+            pipelineCache_ = nullptr;
+        }
+        device_ = nullptr;
+    }
+
+    void VulkanPipelineCache::release() noexcept {
+        pipelineCache_ = nullptr;
+        device_ = nullptr;
+    }
+}  // namespace aetherion
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <filesystem>
+#include <vulkan/vulkan.hpp>
+
+namespace aetherion {
+    // NOTE: Owned by VulkanDevice and shared by every pipeline it creates. The driver synchronizes
+    // the cache internally, so pipelines may be created from multiple threads.
+    class VulkanPipelineCache {
+      public:
+        VulkanPipelineCache() = delete;
+        VulkanPipelineCache(vk::Device device, vk::PhysicalDevice physicalDevice,
+                            const std::filesystem::path& path);
+        VulkanPipelineCache(vk::Device device, vk::PipelineCache pipelineCache);
+        ~VulkanPipelineCache() noexcept;
+
+        VulkanPipelineCache(const VulkanPipelineCache&) = delete;
+        VulkanPipelineCache& operator=(const VulkanPipelineCache&) = delete;
+
+        VulkanPipelineCache(VulkanPipelineCache&&) noexcept;
+        VulkanPipelineCache& operator=(VulkanPipelineCache&&) noexcept;
+
+        // NOTE: Does nothing when the cache has no backing file.
+        void save() const;
+
+        inline vk::PipelineCache getVkPipelineCache() const { return pipelineCache_; }
+
+        inline const std::filesystem::path& getPath() const { return path_; }
+
+        void clear() noexcept;
+        void release() noexcept;
+
+      private:
+        vk::Device device_;
+
+        vk::PipelineCache pipelineCache_;
+
+        std::filesystem::path path_;
+        vk::PhysicalDeviceProperties physicalDeviceProperties_;
+        vk::PhysicalDeviceIDProperties physicalDeviceIDProperties_;
+    };
+}  // namespace aetherion
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "vulkan_query_pool.hpp"
+
+#include <stdexcept>
+
+#include "vulkan_device.hpp"
+
+namespace aetherion {
+    VulkanQueryPool::VulkanQueryPool(VulkanDevice& device, const QueryPoolDescription& description)
+        : device_(device.getVkDevice()),
+          deletionQueue_(device.getDeletionQueue()),
+          count_(description.count) {
+        queryPool_ = device_.createQueryPool(vk::QueryPoolCreateInfo()
+                                                 .setQueryType(vk::QueryType::eTimestamp)
+                                                 .setQueryCount(description.count));
+    }
+
+    VulkanQueryPool::VulkanQueryPool(vk::Device device, vk::QueryPool queryPool, uint32_t count)
+        : device_(device), queryPool_(queryPool), count_(count) {}
+
+    VulkanQueryPool::~VulkanQueryPool() noexcept { clear(); }
+
+    VulkanQueryPool::VulkanQueryPool(VulkanQueryPool&& other) noexcept
+        : IQueryPool(std::move(other)),
+          device_(other.device_),
+          deletionQueue_(other.deletionQueue_),
+          queryPool_(other.queryPool_),
+          count_(other.count_) {
+        other.device_ = nullptr;
+        other.deletionQueue_ = nullptr;
+        other.queryPool_ = nullptr;
+        other.count_ = 0;
+    }
+
+    VulkanQueryPool& VulkanQueryPool::operator=(VulkanQueryPool&& other) noexcept {
+        if (this != &other) {
+            clear();
+
+            IQueryPool::operator=(std::move(other));
+            device_ = other.device_;
+            deletionQueue_ = other.deletionQueue_;
+            queryPool_ = other.queryPool_;
+            count_ = other.count_;
+
+            other.release();
+        }
+        return *this;
+    }
+
+    bool VulkanQueryPool::getTimestamps(uint32_t firstQuery, std::span<uint64_t> timestamps) {
+        if (firstQuery + timestamps.size() > count_) {
+            throw(std::invalid_argument("Timestamp queries out of the range of the pool."));
+        }
+
+        // NOTE: Without the wait flag unavailable queries return eNotReady instead of blocking.
+        const auto result = device_.getQueryPoolResults(
+            queryPool_, firstQuery, static_cast<uint32_t>(timestamps.size()),
+            timestamps.size_bytes(), timestamps.data(), sizeof(uint64_t),
+            vk::QueryResultFlagBits::e64);
+        if (result == vk::Result::eNotReady) {
+            return false;
+        }
+        if (result != vk::Result::eSuccess) {
+            throw(std::runtime_error("Failed to get timestamp query results: "
+                                     + vk::to_string(result)));
+        }
+        return true;
+    }
+
+    void VulkanQueryPool::clear() noexcept {
+        if (queryPool_ && deletionQueue_) {
+            deletionQueue_->enqueue(queryPool_);
+        } else if (queryPool_ && device_) {
+            device_.destroyQueryPool(queryPool_);
+        }
+        release();
+    }
+
+    void VulkanQueryPool::release() noexcept {
+        queryPool_ = nullptr;
+        device_ = nullptr;
+        deletionQueue_ = nullptr;
+        count_ = 0;
+    }
+}  // namespace aetherion
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include "aetherion/gpu/backend/query_pool.hpp"
+
+namespace aetherion {
+    // Forward declarations
+    class VulkanDevice;
+    class VulkanDeletionQueue;
+
+    class VulkanQueryPool final : public IQueryPool {
+      public:
+        VulkanQueryPool() = delete;
+        VulkanQueryPool(VulkanDevice& device, const QueryPoolDescription& description);
+        VulkanQueryPool(vk::Device device, vk::QueryPool queryPool, uint32_t count);
+        ~VulkanQueryPool() noexcept override;
+
+        VulkanQueryPool(const VulkanQueryPool&) = delete;
+        VulkanQueryPool& operator=(const VulkanQueryPool&) = delete;
+
+        VulkanQueryPool(VulkanQueryPool&&) noexcept;
+        VulkanQueryPool& operator=(VulkanQueryPool&&) noexcept;
+
+        bool getTimestamps(uint32_t firstQuery, std::span<uint64_t> timestamps) override;
+
+        inline uint32_t getCount() const override { return count_; }
+
+        inline vk::QueryPool getVkQueryPool() const { return queryPool_; }
+
+        void clear() noexcept;
+        void release() noexcept;
+
+      private:
+        vk::Device device_;
+        VulkanDeletionQueue* deletionQueue_ = nullptr;
+
+        vk::QueryPool queryPool_;
+        uint32_t count_ = 0;
+    };
+}  // namespace aetherion
@@ -2,6 +2,7 @@
 
 #include <fmt/core.h>
 
+#include "vulkan_cast.hpp"
 #include "vulkan_command_buffer.hpp"
 #include "vulkan_device.hpp"
 #include "vulkan_render_definitions.hpp"
@@ -19,7 +20,10 @@ namespace aetherion {
     VulkanQueue::~VulkanQueue() noexcept { clear(); }
 
     VulkanQueue::VulkanQueue(VulkanQueue&& other) noexcept
-        : IGPUQueue(std::move(other)), device_(other.device_), queue_(other.queue_) {
+        : IGPUQueue(std::move(other)),
+          device_(other.device_),
+          queue_(other.queue_),
+          scratch_(std::move(other.scratch_)) {
         other.device_ = nullptr;
         other.queue_ = nullptr;
     }
@@ -31,6 +35,7 @@ namespace aetherion {
             IGPUQueue::operator=(std::move(other));
             device_ = other.device_;
             queue_ = other.queue_;
+            scratch_ = std::move(other.scratch_);
 
             other.release();
         }
@@ -49,88 +54,116 @@ namespace aetherion {
 
     void VulkanQueue::submit(std::span<GPUQueueSubmitDescription> submitDescriptions,
                              IGPUFence* fence) {
+        scratch_.reset();
+
         // NOTE: It's valid to pass nullptr as fence.
-        auto* vkFence = dynamic_cast<VulkanFence*>(fence);
+        auto* vkFence = vulkanCast<VulkanFence>(fence);
 
-        std::vector<vk::SubmitInfo2> vkSubmitInfos;
-        vkSubmitInfos.reserve(submitDescriptions.size());
+        size_t waitSemaphoreCount = 0;
+        size_t commandBufferCount = 0;
+        size_t signalSemaphoreCount = 0;
         for (const auto& submitDescription : submitDescriptions) {
-            std::vector<vk::SemaphoreSubmitInfo> vkWaitSemaphoreInfos;
-            vkWaitSemaphoreInfos.reserve(submitDescription.waitBinarySemaphores.size()
-                                         + submitDescription.waitTimelineSemaphores.size());
-            std::vector<vk::CommandBufferSubmitInfo> vkCommandBufferInfos;
-            vkCommandBufferInfos.reserve(submitDescription.commandBuffers.size());
-            std::vector<vk::SemaphoreSubmitInfo> vkSignalSemaphoreInfos;
-            vkSignalSemaphoreInfos.reserve(submitDescription.signalBinarySemaphores.size()
-                                           + submitDescription.signalTimelineSemaphores.size());
+            waitSemaphoreCount += submitDescription.waitBinarySemaphores.size()
+                                  + submitDescription.waitTimelineSemaphores.size();
+            commandBufferCount += submitDescription.commandBuffers.size();
+            signalSemaphoreCount += submitDescription.signalBinarySemaphores.size()
+                                    + submitDescription.signalTimelineSemaphores.size();
+        }
+
+        // NOTE: Every submit info points into these, so they must live until submit2 returns.
+        auto vkSubmitInfos = scratch_.allocate<vk::SubmitInfo2>(submitDescriptions.size());
+        auto vkWaitSemaphoreInfos = scratch_.allocate<vk::SemaphoreSubmitInfo>(waitSemaphoreCount);
+        auto vkCommandBufferInfos
+            = scratch_.allocate<vk::CommandBufferSubmitInfo>(commandBufferCount);
+        auto vkSignalSemaphoreInfos
+            = scratch_.allocate<vk::SemaphoreSubmitInfo>(signalSemaphoreCount);
+
+        size_t waitSemaphoreOffset = 0;
+        size_t commandBufferOffset = 0;
+        size_t signalSemaphoreOffset = 0;
+        for (size_t i = 0; i < submitDescriptions.size(); ++i) {
+            const auto& submitDescription = submitDescriptions[i];
+
+            const size_t firstWaitSemaphore = waitSemaphoreOffset;
+            const size_t firstCommandBuffer = commandBufferOffset;
+            const size_t firstSignalSemaphore = signalSemaphoreOffset;
 
             for (const auto& waitBinarySemaphoreInfo : submitDescription.waitBinarySemaphores) {
                 if (!waitBinarySemaphoreInfo.semaphore) {
                     throw std::invalid_argument("Binary semaphore pointer is null");
                 }
                 auto& vkWaitSemaphore
-                    = dynamic_cast<VulkanBinarySemaphore&>(*waitBinarySemaphoreInfo.semaphore);
+                    = vulkanCast<VulkanBinarySemaphore>(*waitBinarySemaphoreInfo.semaphore);
 
-                vkWaitSemaphoreInfos.push_back(
-                    vk::SemaphoreSubmitInfo()
-                        .setSemaphore(vkWaitSemaphore.getVkSemaphore())
-                        .setStageMask(toVkPipelineStageFlags(waitBinarySemaphoreInfo.waitStage)));
+                vkWaitSemaphoreInfos[waitSemaphoreOffset++]
+                    = vk::SemaphoreSubmitInfo()
+                          .setSemaphore(vkWaitSemaphore.getVkSemaphore())
+                          .setStageMask(toVkPipelineStageFlags(waitBinarySemaphoreInfo.waitStage));
             }
             for (const auto& waitTimelineSemaphoreInfo : submitDescription.waitTimelineSemaphores) {
                 if (!waitTimelineSemaphoreInfo.semaphore) {
                     throw std::invalid_argument("Timeline semaphore pointer is null");
                 }
                 auto& vkWaitSemaphore
-                    = dynamic_cast<VulkanTimelineSemaphore&>(*waitTimelineSemaphoreInfo.semaphore);
+                    = vulkanCast<VulkanTimelineSemaphore>(*waitTimelineSemaphoreInfo.semaphore);
 
-                vkWaitSemaphoreInfos.push_back(
-                    vk::SemaphoreSubmitInfo()
-                        .setSemaphore(vkWaitSemaphore.getVkSemaphore())
-                        .setStageMask(toVkPipelineStageFlags(waitTimelineSemaphoreInfo.waitStage))
-                        .setValue(waitTimelineSemaphoreInfo.value));
+                vkWaitSemaphoreInfos[waitSemaphoreOffset++]
+                    = vk::SemaphoreSubmitInfo()
+                          .setSemaphore(vkWaitSemaphore.getVkSemaphore())
+                          .setStageMask(toVkPipelineStageFlags(waitTimelineSemaphoreInfo.waitStage))
+                          .setValue(waitTimelineSemaphoreInfo.value);
             }
             for (const auto& commandBuffer : submitDescription.commandBuffers) {
                 if (!commandBuffer) {
                     throw std::invalid_argument("Command buffer pointer is null");
                 }
-                auto& vkCommandBuffer = dynamic_cast<VulkanCommandBuffer&>(*commandBuffer);
+                auto& vkCommandBuffer = vulkanCast<VulkanCommandBuffer>(*commandBuffer);
 
-                vkCommandBufferInfos.push_back(vk::CommandBufferSubmitInfo().setCommandBuffer(
-                    vkCommandBuffer.getVkCommandBuffer()));
+                vkCommandBufferInfos[commandBufferOffset++]
+                    = vk::CommandBufferSubmitInfo().setCommandBuffer(
+                        vkCommandBuffer.getVkCommandBuffer());
             }
             for (const auto& signalBinarySemaphoreInfo : submitDescription.signalBinarySemaphores) {
                 if (!signalBinarySemaphoreInfo.semaphore) {
                     throw std::invalid_argument("Binary semaphore pointer is null");
                 }
                 auto& vkSignalSemaphore
-                    = dynamic_cast<VulkanBinarySemaphore&>(*signalBinarySemaphoreInfo.semaphore);
+                    = vulkanCast<VulkanBinarySemaphore>(*signalBinarySemaphoreInfo.semaphore);
 
-                vkSignalSemaphoreInfos.push_back(
-                    vk::SemaphoreSubmitInfo()
-                        .setSemaphore(vkSignalSemaphore.getVkSemaphore())
-                        .setStageMask(
-                            toVkPipelineStageFlags(signalBinarySemaphoreInfo.signalStage)));
+                vkSignalSemaphoreInfos[signalSemaphoreOffset++]
+                    = vk::SemaphoreSubmitInfo()
+                          .setSemaphore(vkSignalSemaphore.getVkSemaphore())
+                          .setStageMask(
+                              toVkPipelineStageFlags(signalBinarySemaphoreInfo.signalStage));
             }
             for (const auto& signalTimelineSemaphoreInfo :
                  submitDescription.signalTimelineSemaphores) {
                 if (!signalTimelineSemaphoreInfo.semaphore) {
                     throw std::invalid_argument("Timeline semaphore pointer is null");
                 }
-                auto& vkSignalSemaphore = dynamic_cast<VulkanTimelineSemaphore&>(
+                auto& vkSignalSemaphore = vulkanCast<VulkanTimelineSemaphore>(
                     *signalTimelineSemaphoreInfo.semaphore);
 
-                vkSignalSemaphoreInfos.push_back(
-                    vk::SemaphoreSubmitInfo()
-                        .setSemaphore(vkSignalSemaphore.getVkSemaphore())
-                        .setStageMask(
-                            toVkPipelineStageFlags(signalTimelineSemaphoreInfo.signalStage))
-                        .setValue(signalTimelineSemaphoreInfo.value));
+                vkSignalSemaphoreInfos[signalSemaphoreOffset++]
+                    = vk::SemaphoreSubmitInfo()
+                          .setSemaphore(vkSignalSemaphore.getVkSemaphore())
+                          .setStageMask(
+                              toVkPipelineStageFlags(signalTimelineSemaphoreInfo.signalStage))
+                          .setValue(signalTimelineSemaphoreInfo.value);
             }
 
-            vkSubmitInfos.push_back(vk::SubmitInfo2()
-                                        .setWaitSemaphoreInfos(vkWaitSemaphoreInfos)
-                                        .setCommandBufferInfos(vkCommandBufferInfos)
-                                        .setSignalSemaphoreInfos(vkSignalSemaphoreInfos));
+            vkSubmitInfos[i]
+                = vk::SubmitInfo2()
+                      .setWaitSemaphoreInfoCount(
+                          static_cast<uint32_t>(waitSemaphoreOffset - firstWaitSemaphore))
+                      .setPWaitSemaphoreInfos(vkWaitSemaphoreInfos.data() + firstWaitSemaphore)
+                      .setCommandBufferInfoCount(
+                          static_cast<uint32_t>(commandBufferOffset - firstCommandBuffer))
+                      .setPCommandBufferInfos(vkCommandBufferInfos.data() + firstCommandBuffer)
+                      .setSignalSemaphoreInfoCount(
+                          static_cast<uint32_t>(signalSemaphoreOffset - firstSignalSemaphore))
+                      .setPSignalSemaphoreInfos(vkSignalSemaphoreInfos.data()
+                                                + firstSignalSemaphore);
         }
 
         if (vkFence) {
@@ -153,7 +186,7 @@ namespace aetherion {
             if (!waitSemaphore) {
                 throw std::invalid_argument("Binary semaphore pointer is null");
             }
-            auto& vkWaitSemaphore = dynamic_cast<VulkanBinarySemaphore&>(*waitSemaphore);
+            auto& vkWaitSemaphore = vulkanCast<VulkanBinarySemaphore>(*waitSemaphore);
 
             vkWaitSemaphores.push_back(vkWaitSemaphore.getVkSemaphore());
         }
@@ -161,7 +194,7 @@ namespace aetherion {
             if (!swapchain) {
                 throw std::invalid_argument("Swapchain pointer is null");
             }
-            auto& vkSwapchain = dynamic_cast<VulkanSwapchain&>(*swapchain);
+            auto& vkSwapchain = vulkanCast<VulkanSwapchain>(*swapchain);
 
             vkSwapchains.push_back(vkSwapchain.getVkSwapchain());
             vkImageIndices.push_back(imageIndex);
@@ -3,12 +3,13 @@
 #include <vulkan/vulkan.hpp>
 
 #include "aetherion/gpu/backend/queue.hpp"
+#include "aetherion/util/linear_allocator.hpp"
 
 namespace aetherion {
     // Forward declarations
     class VulkanDevice;
 
-    class VulkanQueue : public IGPUQueue {
+    class VulkanQueue final : public IGPUQueue {
       public:
         VulkanQueue() = delete;
         VulkanQueue(VulkanDevice& device, const GPUQueueDescription& description);
@@ -38,5 +39,9 @@ namespace aetherion {
         vk::Device device_;
 
         vk::Queue queue_;
+
+        // NOTE: Backs the submit info translations. Queues are externally synchronized, so it's
+        // never used by two threads at once.
+        LinearAllocator scratch_;
     };
 }  // namespace aetherion
\ No newline at end of file
@@ -19,6 +19,10 @@ namespace aetherion {
         return vk::Extent2D{extent.width, extent.height};
     }
 
+    constexpr vk::Offset3D toVkOffset3D(const Offset3Di& offset) {
+        return vk::Offset3D{offset.x, offset.y, offset.z};
+    }
+
     constexpr vk::Extent3D toVkExtent3D(const Extent3Du& extent) {
         return vk::Extent3D{extent.width, extent.height, extent.depth};
     }
@@ -48,6 +52,25 @@ namespace aetherion {
         }
     }
 
+    // --- Device ---
+
+    constexpr PhysicalGPUDeviceType toPhysicalGPUDeviceType(const vk::PhysicalDeviceType type) {
+        switch (type) {
+            case vk::PhysicalDeviceType::eOther:
+                return PhysicalGPUDeviceType::Other;
+            case vk::PhysicalDeviceType::eIntegratedGpu:
+                return PhysicalGPUDeviceType::IntegratedGPU;
+            case vk::PhysicalDeviceType::eDiscreteGpu:
+                return PhysicalGPUDeviceType::DiscreteGPU;
+            case vk::PhysicalDeviceType::eVirtualGpu:
+                return PhysicalGPUDeviceType::VirtualGPU;
+            case vk::PhysicalDeviceType::eCpu:
+                return PhysicalGPUDeviceType::CPU;
+            default:
+                throw std::invalid_argument("Invalid vk::PhysicalDeviceType");
+        }
+    }
+
     // --- Queues ---
 
     constexpr vk::QueueFlagBits toVkQueueFlag(const GPUQueueType type) {
@@ -100,6 +123,10 @@ namespace aetherion {
         return vkFlags;
     }
 
+    static_assert(QUEUE_FAMILY_IGNORED == vk::QueueFamilyIgnored,
+                  "QUEUE_FAMILY_IGNORED must match VK_QUEUE_FAMILY_IGNORED");
+    static_assert(WHOLE_SIZE == vk::WholeSize, "WHOLE_SIZE must match VK_WHOLE_SIZE");
+
     constexpr GPUQueueTypeFlags toQueueTypeFlags(const vk::QueueFlags flags) {
         GPUQueueTypeFlags queueFlags = {};
 
@@ -268,11 +295,27 @@ namespace aetherion {
                 return vma::MemoryUsage::eGpuOnly;
             case MemoryUsage::Auto:
                 return vma::MemoryUsage::eAuto;
+            case MemoryUsage::PreferGpuHostVisible:
+                return vma::MemoryUsage::eAutoPreferDevice;
             default:
                 throw std::invalid_argument("Invalid MemoryUsage");
         }
     }
 
+    constexpr vma::DefragmentationFlagBits toVmaDefragmentationFlag(
+        const DefragmentationAlgorithm algorithm) {
+        switch (algorithm) {
+            case DefragmentationAlgorithm::Fast:
+                return vma::DefragmentationFlagBits::eAlgorithmFast;
+            case DefragmentationAlgorithm::Balanced:
+                return vma::DefragmentationFlagBits::eAlgorithmBalanced;
+            case DefragmentationAlgorithm::Full:
+                return vma::DefragmentationFlagBits::eAlgorithmFull;
+            default:
+                throw std::invalid_argument("Invalid DefragmentationAlgorithm");
+        }
+    }
+
     constexpr vma::PoolCreateFlagBits toVmaAllocatorPoolFlag(const AllocatorPoolProperty flag) {
         switch (flag) {
             case AllocatorPoolProperty::None:
@@ -654,6 +697,10 @@ namespace aetherion {
                 return vk::DescriptorType::eUniformBuffer;
             case DescriptorType::StorageBuffer:
                 return vk::DescriptorType::eStorageBuffer;
+            case DescriptorType::UniformBufferDynamic:
+                return vk::DescriptorType::eUniformBufferDynamic;
+            case DescriptorType::StorageBufferDynamic:
+                return vk::DescriptorType::eStorageBufferDynamic;
             case DescriptorType::InputAttachment:
                 return vk::DescriptorType::eInputAttachment;
             default:
@@ -668,6 +715,8 @@ namespace aetherion {
                 return {};
             case DescriptorPoolBehavior::FreeIndividualSets:
                 return vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet;
+            case DescriptorPoolBehavior::UpdateAfterBind:
+                return vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind;
             default:
                 throw std::invalid_argument("Invalid DescriptorPoolBehavior");
         }
@@ -680,6 +729,42 @@ namespace aetherion {
         if (flags.contains(DescriptorPoolBehavior::FreeIndividualSets)) {
             vkFlags |= vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet;
         }
+        if (flags.contains(DescriptorPoolBehavior::UpdateAfterBind)) {
+            vkFlags |= vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind;
+        }
+
+        return vkFlags;
+    }
+
+    constexpr vk::DescriptorBindingFlagBits toVkDescriptorBindingFlag(
+        const DescriptorBinding flag) {
+        switch (flag) {
+            case DescriptorBinding::None:
+                return {};
+            case DescriptorBinding::UpdateAfterBind:
+                return vk::DescriptorBindingFlagBits::eUpdateAfterBind;
+            case DescriptorBinding::UpdateUnusedWhilePending:
+                return vk::DescriptorBindingFlagBits::eUpdateUnusedWhilePending;
+            case DescriptorBinding::PartiallyBound:
+                return vk::DescriptorBindingFlagBits::ePartiallyBound;
+            default:
+                throw std::invalid_argument("Invalid DescriptorBinding");
+        }
+    }
+
+    constexpr vk::DescriptorBindingFlags toVkDescriptorBindingFlags(
+        const DescriptorBindingFlags flags) {
+        vk::DescriptorBindingFlags vkFlags = {};
+
+        if (flags.contains(DescriptorBinding::UpdateAfterBind)) {
+            vkFlags |= vk::DescriptorBindingFlagBits::eUpdateAfterBind;
+        }
+        if (flags.contains(DescriptorBinding::UpdateUnusedWhilePending)) {
+            vkFlags |= vk::DescriptorBindingFlagBits::eUpdateUnusedWhilePending;
+        }
+        if (flags.contains(DescriptorBinding::PartiallyBound)) {
+            vkFlags |= vk::DescriptorBindingFlagBits::ePartiallyBound;
+        }
 
         return vkFlags;
     }
@@ -819,6 +904,19 @@ namespace aetherion {
         }
     }
 
+    // NOTE: Every aspect of the format, as copies of whole images need.
+    constexpr vk::ImageAspectFlags getVkFormatAspectFlags(const Format format) {
+        switch (format) {
+            case Format::D16Unorm:
+            case Format::D32Sfloat:
+                return vk::ImageAspectFlagBits::eDepth;
+            case Format::D24UnormS8Uint:
+                return vk::ImageAspectFlagBits::eDepth | vk::ImageAspectFlagBits::eStencil;
+            default:
+                return vk::ImageAspectFlagBits::eColor;
+        }
+    }
+
     // --- Buffer ---
 
     constexpr vk::BufferUsageFlags toVkBufferUsageFlags(const GPUBufferUsageFlags usage) {
@@ -851,6 +949,9 @@ namespace aetherion {
         if (usage.contains(GPUBufferUsage::Indirect)) {
             vkFlags |= vk::BufferUsageFlagBits::eIndirectBuffer;
         }
+        if (usage.contains(GPUBufferUsage::ShaderDeviceAddress)) {
+            vkFlags |= vk::BufferUsageFlagBits::eShaderDeviceAddress;
+        }
 
         return vkFlags;
     }
@@ -1191,7 +1292,7 @@ namespace aetherion {
     constexpr vk::ImageSubresourceRange toVkImageSubresourceRange(
         const GPUImageSubresourceDescription& range) {
         return vk::ImageSubresourceRange(toVkImageAspectFlags(range.aspectMask),
-                                         range.range.baseMipLevel, range.range.layerCount,
+                                         range.range.baseMipLevel, range.range.mipLevelCount,
                                          range.range.baseArrayLayer, range.range.layerCount);
     }
 
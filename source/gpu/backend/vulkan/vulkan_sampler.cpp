@@ -5,7 +5,7 @@
 
 namespace aetherion {
     VulkanSampler::VulkanSampler(VulkanDevice& device, const SamplerDescription& description)
-        : device_(device.getVkDevice()) {
+        : device_(device.getVkDevice()), deletionQueue_(device.getDeletionQueue()) {
         sampler_ = device_.createSampler(
             vk::SamplerCreateInfo()
                 .setMagFilter(toVkFilter(description.magFilter))
@@ -31,8 +31,12 @@ namespace aetherion {
     VulkanSampler::~VulkanSampler() noexcept { clear(); }
 
     VulkanSampler::VulkanSampler(VulkanSampler&& other) noexcept
-        : ISampler(std::move(other)), device_(other.device_), sampler_(other.sampler_) {
+        : ISampler(std::move(other)),
+          device_(other.device_),
+          deletionQueue_(other.deletionQueue_),
+          sampler_(other.sampler_) {
         other.device_ = nullptr;
+        other.deletionQueue_ = nullptr;
         other.sampler_ = nullptr;
     }
 
@@ -42,6 +46,7 @@ namespace aetherion {
 
             ISampler::operator=(std::move(other));
             device_ = other.device_;
+            deletionQueue_ = other.deletionQueue_;
             sampler_ = other.sampler_;
 
             other.release();
@@ -50,15 +55,17 @@ namespace aetherion {
     }
 
     void VulkanSampler::clear() noexcept {
-        if (sampler_ && device_) {
+        if (sampler_ && deletionQueue_) {
+            deletionQueue_->enqueue(sampler_);
+        } else if (sampler_ && device_) {
             device_.destroySampler(sampler_);
-            sampler_ = nullptr;
         }
-        device_ = nullptr;
+        release();
     }
 
     void VulkanSampler::release() noexcept {
         sampler_ = nullptr;
         device_ = nullptr;
+        deletionQueue_ = nullptr;
     }
 }  // namespace aetherion
\ No newline at end of file
@@ -7,8 +7,9 @@
 namespace aetherion {
     // Forward declarations
     class VulkanDevice;
+    class VulkanDeletionQueue;
 
-    class VulkanSampler : public ISampler {
+    class VulkanSampler final : public ISampler {
       public:
         VulkanSampler() = delete;
         VulkanSampler(VulkanDevice& device, const SamplerDescription& description);
@@ -28,6 +29,7 @@ namespace aetherion {
 
       private:
         vk::Device device_;
+        VulkanDeletionQueue* deletionQueue_ = nullptr;
 
         vk::Sampler sampler_;
     };
@@ -8,7 +8,7 @@ namespace aetherion {
     // Forward declarations
     class VulkanDevice;
 
-    class VulkanShader : public IShader {
+    class VulkanShader final : public IShader {
       public:
         VulkanShader() = delete;
         VulkanShader(VulkanDevice& device, const ShaderDescription& description);
@@ -1,5 +1,6 @@
 #include "vulkan_surface.hpp"
 
+#include "vulkan_cast.hpp"
 #include "vulkan_device.hpp"
 #include "vulkan_driver.hpp"
 #include "vulkan_render_definitions.hpp"
@@ -54,7 +55,7 @@ namespace aetherion {
     std::vector<RenderSurfaceFormat> VulkanSurface::getSupportedFormats(
         const IGPUPhysicalDevice& physicalDevice) const {
         const auto& vkGPUPhysicalDevice
-            = dynamic_cast<const VulkanGPUPhysicalDevice&>(physicalDevice).getVkGPUPhysicalDevice();
+            = vulkanCast<VulkanGPUPhysicalDevice>(physicalDevice).getVkGPUPhysicalDevice();
 
         auto vkSurfaceFormats = vkGPUPhysicalDevice.getSurfaceFormatsKHR(surface_);
 
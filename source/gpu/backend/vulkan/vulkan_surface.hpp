@@ -10,7 +10,7 @@ namespace aetherion {
     class VulkanDriver;
     class VulkanImage;
 
-    class VulkanSurface : public IRenderSurface {
+    class VulkanSurface final : public IRenderSurface {
       public:
         VulkanSurface() = delete;
         VulkanSurface(VulkanDriver& driver, const RenderSurfaceDescription& description);
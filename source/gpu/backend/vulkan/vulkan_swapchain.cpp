@@ -2,6 +2,7 @@
 
 #include <fmt/core.h>
 
+#include "vulkan_cast.hpp"
 #include "vulkan_device.hpp"
 #include "vulkan_render_definitions.hpp"
 #include "vulkan_surface.hpp"
@@ -32,7 +33,7 @@ namespace aetherion {
         if (!description.surface) {
             throw(std::invalid_argument("A surface is required to create a swapchain."));
         }
-        auto vkSurface = dynamic_cast<const VulkanSurface&>(*description.surface).getVkSurface();
+        auto vkSurface = vulkanCast<VulkanSurface>(*description.surface).getVkSurface();
 
         const auto& vulkanBuilderSwapchainResult
             = vkb::SwapchainBuilder(device.getVkBuilderDevice(), vkSurface)
@@ -118,12 +119,14 @@ namespace aetherion {
     }
 
     ResultValue<SwapchainAcquireResultCode, uint32_t> VulkanSwapchain::acquireNextImage(
-        uint64_t timeout, IGPUBinarySemaphore& semaphore, IGPUFence& fence) {
-        auto& vkSemaphore = dynamic_cast<VulkanBinarySemaphore&>(semaphore);
-        auto& vkFence = dynamic_cast<VulkanFence&>(fence);
-
-        const auto result = device_.acquireNextImageKHR(
-            swapchain_, timeout, vkSemaphore.getVkSemaphore(), vkFence.getVkFence());
+        uint64_t timeout, IGPUBinarySemaphore& semaphore, IGPUFence* fence) {
+        auto& vkSemaphore = vulkanCast<VulkanBinarySemaphore>(semaphore);
+        // NOTE: It's valid to pass nullptr as fence.
+        auto* vkFence = vulkanCast<VulkanFence>(fence);
+
+        const auto result
+            = device_.acquireNextImageKHR(swapchain_, timeout, vkSemaphore.getVkSemaphore(),
+                                          vkFence ? vkFence->getVkFence() : vk::Fence());
 
         auto resultCode = toSwapchainAcquireResultCode(result.result);
 
@@ -12,7 +12,7 @@ namespace aetherion {
     class VulkanDevice;
     class VulkanImage;
 
-    class VulkanSwapchain : public ISwapchain {
+    class VulkanSwapchain final : public ISwapchain {
       public:
         VulkanSwapchain() = delete;
         VulkanSwapchain(VulkanDevice& device, const SwapchainDescription& description);
@@ -26,7 +26,7 @@ namespace aetherion {
         VulkanSwapchain& operator=(VulkanSwapchain&&) noexcept;
 
         ResultValue<SwapchainAcquireResultCode, uint32_t> acquireNextImage(
-            uint64_t timeout, IGPUBinarySemaphore& semaphore, IGPUFence& fence) override;
+            uint64_t timeout, IGPUBinarySemaphore& semaphore, IGPUFence* fence = nullptr) override;
 
         uint32_t getImageCount() const override;
 
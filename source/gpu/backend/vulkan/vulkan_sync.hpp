@@ -8,7 +8,7 @@ namespace aetherion {
     // Forward declarations
     class VulkanDevice;
 
-    class VulkanFence : public IGPUFence {
+    class VulkanFence final : public IGPUFence {
       public:
         VulkanFence() = delete;
         VulkanFence(VulkanDevice& device, const GPUFenceDescription& description);
@@ -36,7 +36,7 @@ namespace aetherion {
         vk::Fence fence_;
     };
 
-    class VulkanBinarySemaphore : public IGPUBinarySemaphore {
+    class VulkanBinarySemaphore final : public IGPUBinarySemaphore {
       public:
         VulkanBinarySemaphore() = delete;
         VulkanBinarySemaphore(VulkanDevice& device,
@@ -61,7 +61,7 @@ namespace aetherion {
         vk::Semaphore semaphore_;
     };
 
-    class VulkanTimelineSemaphore : public IGPUTimelineSemaphore {
+    class VulkanTimelineSemaphore final : public IGPUTimelineSemaphore {
       public:
         VulkanTimelineSemaphore() = delete;
         VulkanTimelineSemaphore(VulkanDevice& device,
@@ -0,0 +1,159 @@
+#include "aetherion/gpu/bindless_heap.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "aetherion/gpu/backend/device.hpp"
+
+namespace aetherion {
+    BindlessHeap::BindlessHeap(IGPUDevice& device, const BindlessHeapDescription& description)
+        : device_(&device),
+          slots_({Slots{.capacity = description.sampledImageCapacity,
+                        .freeSlots = {},
+                        .usedSlots = std::vector<bool>(description.sampledImageCapacity)},
+                  Slots{.capacity = description.storageImageCapacity,
+                        .freeSlots = {},
+                        .usedSlots = std::vector<bool>(description.storageImageCapacity)},
+                  Slots{.capacity = description.samplerCapacity,
+                        .freeSlots = {},
+                        .usedSlots = std::vector<bool>(description.samplerCapacity)},
+                  Slots{.capacity = description.storageBufferCapacity,
+                        .freeSlots = {},
+                        .usedSlots = std::vector<bool>(description.storageBufferCapacity)}}) {
+        if (!device_->supportsBindlessDescriptors()) {
+            throw(std::runtime_error("Bindless descriptors aren't supported by the device."));
+        }
+
+        constexpr std::array<DescriptorType, BINDLESS_RESOURCE_TYPE_COUNT> descriptorTypes
+            = {DescriptorType::SampledImage, DescriptorType::StorageImage, DescriptorType::Sampler,
+               DescriptorType::StorageBuffer};
+
+        DescriptorSetLayoutDescription layoutDescription;
+        DescriptorPoolDescription poolDescription{.maxSets = 1,
+                                                  .poolSizes = {},
+                                                  .flags = DescriptorPoolBehavior::UpdateAfterBind};
+        for (uint32_t i = 0; i < BINDLESS_RESOURCE_TYPE_COUNT; ++i) {
+            // NOTE: Empty arrays aren't allowed in a pool.
+            const uint32_t count = std::max(slots_[i].capacity, 1u);
+            layoutDescription.bindings.push_back(
+                {.binding = i,
+                 .type = descriptorTypes[i],
+                 .count = count,
+                 .stages = description.stages,
+                 .flags = DescriptorBinding::UpdateAfterBind
+                          | DescriptorBinding::UpdateUnusedWhilePending
+                          | DescriptorBinding::PartiallyBound});
+            poolDescription.poolSizes.push_back({.type = descriptorTypes[i], .count = count});
+        }
+
+        descriptorSetLayout_ = device_->createDescriptorSetLayout(layoutDescription);
+        descriptorPool_ = device_->createDescriptorPool(poolDescription);
+        descriptorSet_ = device_->allocateDescriptorSet(
+            *descriptorPool_, DescriptorSetDescription{.layout = descriptorSetLayout_.get()});
+    }
+
+    // NOTE: The set goes before the pool it was allocated from.
+    BindlessHeap::~BindlessHeap() noexcept { descriptorSet_.reset(); }
+
+    BindlessHandle BindlessHeap::addSampledImage(IGPUImageView& imageView, GPUImageLayout layout) {
+        DescriptorWriteDescription write{.dstBinding = 0,
+                                         .dstArrayElement = 0,
+                                         .dstSet = nullptr,
+                                         .descriptorType = DescriptorType::SampledImage,
+                                         .images = {{.imageView = &imageView,
+                                                     .sampler = nullptr,
+                                                     .imageLayout = layout}},
+                                         .buffers = {},
+                                         .texelBuffers = {}};
+        return add(BindlessResourceType::SampledImage, write);
+    }
+
+    BindlessHandle BindlessHeap::addStorageImage(IGPUImageView& imageView) {
+        DescriptorWriteDescription write{.dstBinding = 0,
+                                         .dstArrayElement = 0,
+                                         .dstSet = nullptr,
+                                         .descriptorType = DescriptorType::StorageImage,
+                                         .images = {{.imageView = &imageView,
+                                                     .sampler = nullptr,
+                                                     .imageLayout = GPUImageLayout::General}},
+                                         .buffers = {},
+                                         .texelBuffers = {}};
+        return add(BindlessResourceType::StorageImage, write);
+    }
+
+    BindlessHandle BindlessHeap::addSampler(ISampler& sampler) {
+        DescriptorWriteDescription write{.dstBinding = 0,
+                                         .dstArrayElement = 0,
+                                         .dstSet = nullptr,
+                                         .descriptorType = DescriptorType::Sampler,
+                                         .images = {{.imageView = nullptr,
+                                                     .sampler = &sampler,
+                                                     .imageLayout = GPUImageLayout::Undefined}},
+                                         .buffers = {},
+                                         .texelBuffers = {}};
+        return add(BindlessResourceType::Sampler, write);
+    }
+
+    BindlessHandle BindlessHeap::addStorageBuffer(IGPUBuffer& buffer, size_t offset,
+                                                  size_t range) {
+        DescriptorWriteDescription write{
+            .dstBinding = 0,
+            .dstArrayElement = 0,
+            .dstSet = nullptr,
+            .descriptorType = DescriptorType::StorageBuffer,
+            .images = {},
+            .buffers = {{.buffer = &buffer, .offset = offset, .range = range}},
+            .texelBuffers = {}};
+        return add(BindlessResourceType::StorageBuffer, write);
+    }
+
+    void BindlessHeap::free(BindlessResourceType type, BindlessHandle handle) {
+        std::lock_guard lock(mutex_);
+        auto& slots = slots_[static_cast<size_t>(type)];
+        if (handle >= slots.next) {
+            throw(std::invalid_argument("Invalid bindless handle."));
+        }
+        // NOTE: A handle freed twice would be handed out twice.
+        if (!slots.usedSlots[handle]) {
+            throw(std::invalid_argument("Bindless handle is already free."));
+        }
+        slots.usedSlots[handle] = false;
+        slots.freeSlots.push_back(handle);
+    }
+
+    uint32_t BindlessHeap::getUsedCount(BindlessResourceType type) const {
+        std::lock_guard lock(mutex_);
+        const auto& slots = slots_[static_cast<size_t>(type)];
+        return slots.next - static_cast<uint32_t>(slots.freeSlots.size());
+    }
+
+    BindlessHandle BindlessHeap::add(BindlessResourceType type, DescriptorWriteDescription& write) {
+        std::lock_guard lock(mutex_);
+        auto& slots = slots_[static_cast<size_t>(type)];
+
+        BindlessHandle handle;
+        if (!slots.freeSlots.empty()) {
+            handle = slots.freeSlots.back();
+            slots.freeSlots.pop_back();
+        } else if (slots.next < slots.capacity) {
+            handle = slots.next++;
+        } else {
+            throw(std::runtime_error("Bindless heap is full."));
+        }
+
+        write.dstBinding = static_cast<uint32_t>(type);
+        write.dstArrayElement = handle;
+        write.dstSet = descriptorSet_.get();
+        // NOTE: Updates to the set must be externally synchronized. The handle goes back to the
+        // free slots if the update fails.
+        try {
+            device_->updateDescriptorSets(std::span(&write, 1), {});
+        } catch (...) {
+            slots.freeSlots.push_back(handle);
+            throw;
+        }
+
+        slots.usedSlots[handle] = true;
+        return handle;
+    }
+}  // namespace aetherion
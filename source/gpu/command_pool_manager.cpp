@@ -0,0 +1,104 @@
+#include "aetherion/gpu/command_pool_manager.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "aetherion/gpu/backend/device.hpp"
+#include "aetherion/gpu/backend/sync.hpp"
+
+namespace aetherion {
+    CommandPoolManager::CommandPoolManager(IGPUDevice& device, IGPUTimelineSemaphore& timeline,
+                                           const CommandPoolManagerDescription& description)
+        : device_(&device),
+          timeline_(&timeline),
+          queueFamilyIndex_(description.queueFamilyIndex),
+          framesInFlight_(description.framesInFlight),
+          frameTimelineValues_(description.framesInFlight, 0),
+          shutdownTimeout_(description.shutdownTimeout) {
+        if (framesInFlight_ == 0) {
+            throw(std::invalid_argument(
+                "framesInFlight in CommandPoolManagerDescription must be greater than zero."));
+        }
+    }
+
+    CommandPoolManager::~CommandPoolManager() noexcept {
+        // NOTE: Pools can't be destroyed while the GPU still executes their command buffers, they
+        // are leaked when it doesn't finish in time.
+        try {
+            timeline_->wait(
+                *std::max_element(frameTimelineValues_.begin(), frameTimelineValues_.end()),
+                static_cast<uint64_t>(shutdownTimeout_.count()));
+        } catch (const std::exception& e) {
+            fmt::print(stderr, "Leaking command pools still in use by the GPU: {}\n", e.what());
+            for (auto& [threadId, threadPools] : threads_) {
+                static_cast<void>(threadPools.release());
+            }
+        }
+    }
+
+    void CommandPoolManager::beginFrame() {
+        frameIndex_ = static_cast<uint32_t>(frameCount_ % framesInFlight_);
+        ++frameCount_;
+
+        timeline_->wait(frameTimelineValues_[frameIndex_], std::numeric_limits<uint64_t>::max());
+
+        std::lock_guard lock(threadsMutex_);
+        for (auto& [threadId, threadPools] : threads_) {
+            FramePool& framePool = threadPools->frames[frameIndex_];
+            if (framePool.usedPrimaryCommandBuffers == 0
+                && framePool.usedSecondaryCommandBuffers == 0) {
+                continue;
+            }
+
+            framePool.pool->reset();
+            framePool.usedPrimaryCommandBuffers = 0;
+            framePool.usedSecondaryCommandBuffers = 0;
+        }
+    }
+
+    void CommandPoolManager::endFrame(uint64_t timelineValue) {
+        frameTimelineValues_[frameIndex_] = timelineValue;
+    }
+
+    ICommandBuffer& CommandPoolManager::acquire(CommandBufferLevel level) {
+        FramePool& framePool = getThreadPools().frames[frameIndex_];
+
+        auto& commandBuffers = level == CommandBufferLevel::Primary
+                                   ? framePool.primaryCommandBuffers
+                                   : framePool.secondaryCommandBuffers;
+        size_t& usedCommandBuffers = level == CommandBufferLevel::Primary
+                                         ? framePool.usedPrimaryCommandBuffers
+                                         : framePool.usedSecondaryCommandBuffers;
+
+        if (usedCommandBuffers == commandBuffers.size()) {
+            commandBuffers.push_back(
+                device_->allocateCommandBuffer(*framePool.pool, {.level = level}));
+        }
+
+        return *commandBuffers[usedCommandBuffers++];
+    }
+
+    size_t CommandPoolManager::getThreadCount() const {
+        std::lock_guard lock(threadsMutex_);
+        return threads_.size();
+    }
+
+    CommandPoolManager::ThreadPools& CommandPoolManager::getThreadPools() {
+        std::lock_guard lock(threadsMutex_);
+
+        auto& threadPools = threads_[std::this_thread::get_id()];
+        if (!threadPools) {
+            threadPools = std::make_unique<ThreadPools>();
+            threadPools->frames.resize(framesInFlight_);
+            const CommandPoolDescription poolDescription{
+                .queueFamilyIndex = queueFamilyIndex_, .flags = CommandPoolBehavior::Transient};
+            for (auto& framePool : threadPools->frames) {
+                framePool.pool = device_->createCommandPool(poolDescription);
+            }
+        }
+        return *threadPools;
+    }
+}  // namespace aetherion
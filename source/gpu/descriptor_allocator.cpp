@@ -0,0 +1,127 @@
+#include "aetherion/gpu/descriptor_allocator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "aetherion/gpu/backend/device.hpp"
+#include "aetherion/gpu/backend/sync.hpp"
+
+namespace aetherion {
+    DescriptorAllocator::DescriptorAllocator(IGPUDevice& device, IGPUTimelineSemaphore& timeline,
+                                             const DescriptorAllocatorDescription& description)
+        : device_(&device),
+          timeline_(&timeline),
+          poolSizeRatios_(description.poolSizeRatios),
+          poolFlags_(description.flags),
+          initialSetsPerPool_(description.initialSetsPerPool),
+          maxSetsPerPool_(std::max(description.maxSetsPerPool, description.initialSetsPerPool)),
+          framesInFlight_(description.framesInFlight),
+          frameTimelineValues_(description.framesInFlight, 0),
+          frames_(description.framesInFlight) {
+        if (framesInFlight_ == 0) {
+            throw(std::invalid_argument(
+                "framesInFlight in DescriptorAllocatorDescription must be greater than zero."));
+        }
+        if (initialSetsPerPool_ == 0) {
+            throw(std::invalid_argument("initialSetsPerPool in DescriptorAllocatorDescription must "
+                                        "be greater than zero."));
+        }
+        for (auto& frame : frames_) {
+            frame.setsPerPool = initialSetsPerPool_;
+        }
+    }
+
+    DescriptorAllocator::~DescriptorAllocator() noexcept {
+        // NOTE: Pools can't be destroyed while the GPU still uses their sets.
+        try {
+            timeline_->wait(
+                *std::max_element(frameTimelineValues_.begin(), frameTimelineValues_.end()),
+                std::numeric_limits<uint64_t>::max());
+        } catch (...) {
+        }
+    }
+
+    void DescriptorAllocator::beginFrame() {
+        frameIndex_ = static_cast<uint32_t>(frameCount_ % framesInFlight_);
+        ++frameCount_;
+
+        timeline_->wait(frameTimelineValues_[frameIndex_], std::numeric_limits<uint64_t>::max());
+
+        std::lock_guard lock(mutex_);
+        FramePools& frame = frames_[frameIndex_];
+        const size_t usedPools = std::min(frame.currentPool + 1, frame.pools.size());
+        for (size_t i = 0; i < usedPools; ++i) {
+            frame.pools[i]->reset();
+        }
+        // NOTE: Pools past the current one weren't used in the last frame of the slot, they are
+        // destroyed and the growth restarts from the pools kept.
+        if (usedPools < frame.pools.size()) {
+            frame.pools.resize(usedPools);
+            frame.setsPerPool = initialSetsPerPool_;
+            for (size_t i = 0; i < usedPools; ++i) {
+                frame.setsPerPool = std::min(frame.setsPerPool * 2, maxSetsPerPool_);
+            }
+        }
+        frame.currentPool = 0;
+        frame.currentPoolSets = 0;
+    }
+
+    void DescriptorAllocator::endFrame(uint64_t timelineValue) {
+        frameTimelineValues_[frameIndex_] = timelineValue;
+    }
+
+    IDescriptorSet& DescriptorAllocator::allocate(IDescriptorSetLayout& layout) {
+        std::lock_guard lock(mutex_);
+        FramePools& frame = frames_[frameIndex_];
+
+        const DescriptorSetDescription description{.layout = &layout};
+        while (true) {
+            if (frame.currentPool == frame.pools.size()) {
+                frame.pools.push_back(createPool(frame));
+            }
+
+            auto result = frame.pools[frame.currentPool]->allocateTransient(description);
+            if (result) {
+                ++frame.currentPoolSets;
+                return *result.value();
+            }
+
+            // NOTE: Out of memory or fragmented, either way the next pool is tried.
+            if (frame.currentPoolSets == 0) {
+                throw(std::runtime_error("Descriptor set doesn't fit in an empty pool, raise the "
+                                         "pool size ratios of the DescriptorAllocator."));
+            }
+            ++frame.currentPool;
+            frame.currentPoolSets = 0;
+        }
+    }
+
+    size_t DescriptorAllocator::getPoolCount() const {
+        std::lock_guard lock(mutex_);
+        size_t poolCount = 0;
+        for (const auto& frame : frames_) {
+            poolCount += frame.pools.size();
+        }
+        return poolCount;
+    }
+
+    std::unique_ptr<IDescriptorPool> DescriptorAllocator::createPool(FramePools& frame) {
+        DescriptorPoolDescription description{
+            .maxSets = frame.setsPerPool, .poolSizes = {}, .flags = poolFlags_};
+        description.poolSizes.reserve(poolSizeRatios_.size());
+        for (const auto& ratio : poolSizeRatios_) {
+            const auto count = static_cast<uint32_t>(
+                std::ceil(ratio.ratio * static_cast<float>(frame.setsPerPool)));
+            // NOTE: Empty pool sizes aren't allowed.
+            if (count > 0) {
+                description.poolSizes.push_back({.type = ratio.type, .count = count});
+            }
+        }
+
+        frame.setsPerPool = std::min(frame.setsPerPool * 2, maxSetsPerPool_);
+
+        return device_->createDescriptorPool(description);
+    }
+}  // namespace aetherion
@@ -0,0 +1,156 @@
+#include "aetherion/gpu/frame_scheduler.hpp"
+
+#include <fmt/core.h>
+
+#include <array>
+#include <limits>
+#include <stdexcept>
+
+#include "aetherion/gpu/backend/device.hpp"
+#include "aetherion/gpu/backend/query_pool.hpp"
+#include "aetherion/gpu/backend/sync.hpp"
+
+namespace aetherion {
+    std::chrono::nanoseconds blendFrameTime(std::chrono::nanoseconds average,
+                                            std::chrono::nanoseconds sample) {
+        return average + (sample - average) / 10;
+    }
+
+    void FrameContext::beginGPUTiming(ICommandBuffer& commandBuffer) {
+        if (!timestampQueries_) {
+            return;
+        }
+        commandBuffer.resetQueryPool(*timestampQueries_, frameIndex_ * 2, 2);
+        commandBuffer.writeTimestamp(*timestampQueries_, PipelineStage::TopOfPipe,
+                                     frameIndex_ * 2);
+        gpuTimingBegun_ = true;
+    }
+
+    void FrameContext::endGPUTiming(ICommandBuffer& commandBuffer) {
+        if (!timestampQueries_) {
+            return;
+        }
+        if (!gpuTimingBegun_) {
+            throw(std::runtime_error("endGPUTiming() called without beginGPUTiming()."));
+        }
+        commandBuffer.writeTimestamp(*timestampQueries_, PipelineStage::AllCommands,
+                                     frameIndex_ * 2 + 1);
+        gpuTimingEnded_ = true;
+    }
+
+    FrameScheduler::FrameScheduler(IGPUDevice& device,
+                                   const FrameSchedulerDescription& description)
+        : device_(&device),
+          timeline_(device.createGPUTimelineSemaphore({.initialValue = 0})),
+          timestampQueries_(device.getTimestampPeriod() > 0.0f
+                                ? device.createQueryPool({.count = description.framesInFlight * 2})
+                                : nullptr),
+          commandPools_(device, *timeline_,
+                        {.queueFamilyIndex = description.queueFamilyIndex,
+                         .framesInFlight = description.framesInFlight,
+                         .shutdownTimeout = description.shutdownTimeout}),
+          shutdownTimeout_(description.shutdownTimeout) {
+        frames_.reserve(description.framesInFlight);
+        for (uint32_t i = 0; i < description.framesInFlight; ++i) {
+            frames_.emplace_back(commandPools_, description.uploadArenaBlockSize);
+            frames_.back().timestampQueries_ = timestampQueries_.get();
+        }
+    }
+
+    FrameScheduler::~FrameScheduler() noexcept {
+        // NOTE: Past the timeout the device is assumed hung or lost. The GPU may still use what the
+        // frames own, so it's leaked rather than freed.
+        try {
+            timeline_->wait(frameCount_, static_cast<uint64_t>(shutdownTimeout_.count()));
+        } catch (const std::exception& e) {
+            fmt::print(stderr, "Leaking frames still in use by the GPU: {}\n", e.what());
+            static_cast<void>(new std::vector<FrameContext>(std::move(frames_)));
+            static_cast<void>(timestampQueries_.release());
+            return;
+        }
+
+        for (auto& frame : frames_) {
+            frame.recycle();
+        }
+
+        try {
+            device_->collectDeferredDestructions(frameCount_);
+        } catch (...) {
+        }
+    }
+
+    FrameContext& FrameScheduler::beginFrame() {
+        if (currentFrame_) {
+            throw(std::runtime_error("beginFrame() called twice without endFrame()."));
+        }
+
+        const auto frameIndex = static_cast<uint32_t>(frameCount_ % frames_.size());
+        FrameContext& frame = frames_[frameIndex];
+
+        const auto waitBeginTime = std::chrono::steady_clock::now();
+        if (frame.timelineValue_ > 0) {
+            if (timeline_->getCurrentValue() < frame.timelineValue_) {
+                timeline_->wait(frame.timelineValue_, std::numeric_limits<uint64_t>::max());
+            }
+            pendingTimings_.slotLatency = std::chrono::steady_clock::now() - frame.submitTime_;
+        }
+        pendingTimings_.cpuWaitTime = std::chrono::steady_clock::now() - waitBeginTime;
+        pendingTimings_.gpuTime = readGPUTime(frame);
+
+        frame.recycle();
+        // NOTE: Doesn't block, the slot's timeline value was already reached.
+        commandPools_.beginFrame();
+        device_->collectDeferredDestructions(timeline_->getCurrentValue());
+
+        ++frameCount_;
+        device_->setDeferredDestructionValue(frameCount_);
+        frame.timeline_ = timeline_.get();
+        frame.frameIndex_ = frameIndex;
+        frame.timelineValue_ = frameCount_;
+
+        currentFrame_ = &frame;
+        frameBeginTime_ = std::chrono::steady_clock::now();
+        return frame;
+    }
+
+    void FrameScheduler::endFrame() {
+        if (!currentFrame_) {
+            throw(std::runtime_error("endFrame() called without beginFrame()."));
+        }
+
+        currentFrame_->submitTime_ = std::chrono::steady_clock::now();
+        pendingTimings_.cpuFrameTime = currentFrame_->submitTime_ - frameBeginTime_;
+
+        commandPools_.endFrame(currentFrame_->timelineValue_);
+        currentFrame_ = nullptr;
+
+        recordTimings(pendingTimings_);
+    }
+
+    void FrameScheduler::recordTimings(const FrameTimings& timings) {
+        lastTimings_ = timings;
+
+        averageTimings_.cpuWaitTime = blendFrameTime(averageTimings_.cpuWaitTime,
+                                                     timings.cpuWaitTime);
+        averageTimings_.cpuFrameTime = blendFrameTime(averageTimings_.cpuFrameTime,
+                                                      timings.cpuFrameTime);
+        averageTimings_.slotLatency = blendFrameTime(averageTimings_.slotLatency,
+                                                     timings.slotLatency);
+        averageTimings_.gpuTime = blendFrameTime(averageTimings_.gpuTime, timings.gpuTime);
+    }
+
+    std::chrono::nanoseconds FrameScheduler::readGPUTime(const FrameContext& frame) const {
+        if (!frame.gpuTimingEnded_) {
+            return {};
+        }
+
+        // NOTE: The slot's timeline value was reached, so both timestamps should be available.
+        std::array<uint64_t, 2> timestamps{};
+        if (!timestampQueries_->getTimestamps(frame.frameIndex_ * 2, timestamps)
+            || timestamps[1] < timestamps[0]) {
+            return {};
+        }
+        return std::chrono::nanoseconds(static_cast<int64_t>(
+            static_cast<double>(timestamps[1] - timestamps[0]) * device_->getTimestampPeriod()));
+    }
+}  // namespace aetherion
@@ -1,12 +1,174 @@
 #include "aetherion/gpu/gpu_engine.hpp"
 
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+
 namespace aetherion {
+    std::optional<uint32_t> findGPUQueueFamily(
+        const IGPUPhysicalDevice& physicalDevice,
+        std::span<const GPUQueueFamilyDescription> candidates, GPUQueueType requiredType,
+        GPUQueueTypeFlags excludedTypes, bool requirePresent = false) {
+        for (const auto& candidate : candidates) {
+            const auto& properties
+                = physicalDevice.getGPUQueueFamilyProperties(candidate.queueFamilyIndex);
+            if (properties.queueFlags.contains(requiredType)
+                && !(properties.queueFlags & excludedTypes)
+                && (!requirePresent || properties.presentSupport)) {
+                return candidate.queueFamilyIndex;
+            }
+        }
+        return std::nullopt;
+    }
+
+    GPUQueueFamilyAssignment assignGPUQueueFamilies(
+        const IGPUPhysicalDevice& physicalDevice,
+        std::span<const GPUQueueFamilyDescription> candidates) {
+        // NOTE: Devices picked for a primary window have at least one family supporting
+        // presentation, the graphics family is then required to be one of them.
+        bool requirePresent = false;
+        for (uint32_t i = 0; i < physicalDevice.getGPUQueueFamilyCount(); ++i) {
+            requirePresent = requirePresent
+                             || physicalDevice.getGPUQueueFamilyProperties(i).presentSupport;
+        }
+
+        // NOTE: Compute-only devices run everything on the compute family.
+        auto graphicsFamilyIndex = findGPUQueueFamily(physicalDevice, candidates,
+                                                      GPUQueueType::Graphics, {}, requirePresent);
+        if (!graphicsFamilyIndex) {
+            graphicsFamilyIndex = findGPUQueueFamily(physicalDevice, candidates,
+                                                     GPUQueueType::Compute, {}, requirePresent);
+        }
+        if (!graphicsFamilyIndex) {
+            throw(std::runtime_error(
+                requirePresent
+                    ? "No graphics or compute queue family with present support available."
+                    : "No graphics or compute queue family available."));
+        }
+
+        const auto computeFamilyIndex = findGPUQueueFamily(
+            physicalDevice, candidates, GPUQueueType::Compute, GPUQueueType::Graphics);
+
+        auto transferFamilyIndex
+            = findGPUQueueFamily(physicalDevice, candidates, GPUQueueType::Transfer,
+                                 GPUQueueType::Graphics | GPUQueueType::Compute);
+        if (!transferFamilyIndex) {
+            transferFamilyIndex = computeFamilyIndex;
+        }
+
+        return {.graphicsFamilyIndex = *graphicsFamilyIndex,
+                .computeFamilyIndex = computeFamilyIndex.value_or(*graphicsFamilyIndex),
+                .transferFamilyIndex = transferFamilyIndex.value_or(*graphicsFamilyIndex)};
+    }
+
+    std::vector<GPUQueueFamilyDescription> selectDedicatedGPUQueueFamilies(
+        const IGPUPhysicalDevice& physicalDevice) {
+        std::vector<GPUQueueFamilyDescription> candidates;
+        candidates.reserve(physicalDevice.getGPUQueueFamilyCount());
+        for (uint32_t i = 0; i < physicalDevice.getGPUQueueFamilyCount(); ++i) {
+            candidates.push_back({.queueFamilyIndex = i, .queuePriorities = {1.0f}});
+        }
+
+        const auto assignment = assignGPUQueueFamilies(physicalDevice, candidates);
+
+        std::erase_if(candidates, [&assignment](const GPUQueueFamilyDescription& candidate) {
+            return candidate.queueFamilyIndex != assignment.graphicsFamilyIndex
+                   && candidate.queueFamilyIndex != assignment.computeFamilyIndex
+                   && candidate.queueFamilyIndex != assignment.transferFamilyIndex;
+        });
+        return candidates;
+    }
+
     GPUEngine::GPUEngine(const GPUDriverDescription& driverDescription,
                          const PhysicalGPUDeviceDescription& physicalDeviceDescription,
                          const QueueSelectionFunctor& queueSelectionFunctor)
         : driver_(IGPUDriver::create(driverDescription)),
-          physicalDevice_(driver_->createPhysicalDevice(physicalDeviceDescription)),
-          device_(driver_->createDevice(
-              {.physicalDevice = physicalDevice_.get(),
-               .queueFamilyDescriptions = queueSelectionFunctor(*physicalDevice_)})) {}
-}  // namespace aetherion
\ No newline at end of file
+          physicalDevice_(driver_->createPhysicalDevice(physicalDeviceDescription)) {
+        const auto queueFamilyDescriptions = queueSelectionFunctor(*physicalDevice_);
+
+        device_ = driver_->createDevice({.physicalDevice = physicalDevice_.get(),
+                                         .queueFamilyDescriptions = queueFamilyDescriptions});
+
+        const auto assignment = assignGPUQueueFamilies(*physicalDevice_, queueFamilyDescriptions);
+        roleQueueFamilyIndices_ = {assignment.graphicsFamilyIndex, assignment.computeFamilyIndex,
+                                   assignment.transferFamilyIndex};
+
+        // NOTE: Roles sharing a family get their own queue while the family has queues left,
+        // otherwise they share the queue of the first role on that family.
+        std::unordered_map<uint32_t, uint32_t> usedQueueCounts;
+        for (size_t role = 0; role < GPU_QUEUE_ROLE_COUNT; ++role) {
+            const uint32_t familyIndex = roleQueueFamilyIndices_[role];
+            const auto& familyDescription = *std::find_if(
+                queueFamilyDescriptions.begin(), queueFamilyDescriptions.end(),
+                [familyIndex](const GPUQueueFamilyDescription& description) {
+                    return description.queueFamilyIndex == familyIndex;
+                });
+
+            uint32_t& usedQueueCount = usedQueueCounts[familyIndex];
+            if (usedQueueCount < familyDescription.queuePriorities.size()) {
+                queues_.push_back(
+                    device_->getQueue({.familyIndex = familyIndex, .index = usedQueueCount++}));
+                roleQueues_[role] = queues_.back().get();
+            } else {
+                const auto sharedRole = std::find(roleQueueFamilyIndices_.begin(),
+                                                  roleQueueFamilyIndices_.begin() + role,
+                                                  familyIndex);
+                roleQueues_[role] = roleQueues_[sharedRole - roleQueueFamilyIndices_.begin()];
+            }
+        }
+    }
+
+    IGPUDriver& GPUEngine::getDriver() { return *driver_; }
+
+    const IGPUDriver& GPUEngine::getDriver() const { return *driver_; }
+
+    IGPUPhysicalDevice& GPUEngine::getPhysicalDevice() { return *physicalDevice_; }
+
+    const IGPUPhysicalDevice& GPUEngine::getPhysicalDevice() const { return *physicalDevice_; }
+
+    IGPUDevice& GPUEngine::getDevice() { return *device_; }
+
+    const IGPUDevice& GPUEngine::getDevice() const { return *device_; }
+
+    bool GPUEngine::isHeadless() const { return driver_->isHeadless(); }
+
+    IGPUQueue& GPUEngine::getQueue(GPUQueueRole role) {
+        return *roleQueues_[static_cast<size_t>(role)];
+    }
+
+    uint32_t GPUEngine::getQueueFamilyIndex(GPUQueueRole role) const {
+        return roleQueueFamilyIndices_[static_cast<size_t>(role)];
+    }
+
+    bool GPUEngine::hasDedicatedQueue(GPUQueueRole role) const {
+        return role == GPUQueueRole::Graphics
+               || getQueueFamilyIndex(role) != getQueueFamilyIndex(GPUQueueRole::Graphics);
+    }
+
+    bool GPUEngine::needsOwnershipTransfer(GPUQueueRole src, GPUQueueRole dst) const {
+        return getQueueFamilyIndex(src) != getQueueFamilyIndex(dst);
+    }
+
+    std::optional<QueueOwnershipTransferBarriers<BufferBarrierDescription>> GPUEngine::useBuffer(
+        IGPUBuffer& buffer, GPUQueueRole role, PipelineStageFlags stageFlags,
+        AccessTypeFlags accessFlags) {
+        return ownershipTracker_.useBuffer(buffer, {.queueFamilyIndex = getQueueFamilyIndex(role),
+                                                    .stageFlags = stageFlags,
+                                                    .accessFlags = accessFlags});
+    }
+
+    std::optional<QueueOwnershipTransferBarriers<ImageBarrierDescription>> GPUEngine::useImage(
+        IGPUImage& image, GPUQueueRole role, GPUImageLayout layout, PipelineStageFlags stageFlags,
+        AccessTypeFlags accessFlags, const GPUImageSubresourceDescription& subresource) {
+        return ownershipTracker_.useImage(image, layout,
+                                          {.queueFamilyIndex = getQueueFamilyIndex(role),
+                                           .stageFlags = stageFlags,
+                                           .accessFlags = accessFlags},
+                                          subresource);
+    }
+
+    void GPUEngine::forgetResource(const IGPUResource& resource) {
+        ownershipTracker_.forget(resource);
+    }
+}  // namespace aetherion
@@ -0,0 +1,144 @@
+#include "aetherion/gpu/memory_budget.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace aetherion {
+    GPUMemoryBudget::GPUMemoryBudget(IGPUAllocator& allocator,
+                                     const GPUMemoryBudgetDescription& description)
+        : allocator_(&allocator),
+          evictionThreshold_(description.evictionThreshold),
+          evictionTarget_(description.evictionTarget),
+          minUnusedFrames_(description.minUnusedFrames) {
+        if (evictionTarget_ > evictionThreshold_) {
+            throw(std::invalid_argument(
+                "evictionTarget in GPUMemoryBudgetDescription must not exceed "
+                "evictionThreshold."));
+        }
+    }
+
+    GPUMemoryResourceHandle GPUMemoryBudget::track(GPUMemoryCategory category, size_t size,
+                                                   GPUMemoryEvictionCallback onEvict) {
+        std::lock_guard lock(mutex_);
+        const GPUMemoryResourceHandle handle = nextHandle_++;
+        resources_.push_back({.handle = handle,
+                              .category = category,
+                              .size = size,
+                              .lastUsedFrame = frameNumber_,
+                              .onEvict = std::move(onEvict)});
+        handles_.emplace(handle, std::prev(resources_.end()));
+        categoryUsage_[static_cast<size_t>(category)] += size;
+        return handle;
+    }
+
+    void GPUMemoryBudget::untrack(GPUMemoryResourceHandle handle) {
+        std::lock_guard lock(mutex_);
+        auto it = handles_.find(handle);
+        if (it == handles_.end()) {
+            return;
+        }
+
+        categoryUsage_[static_cast<size_t>(it->second->category)] -= it->second->size;
+        resources_.erase(it->second);
+        handles_.erase(it);
+    }
+
+    void GPUMemoryBudget::touch(GPUMemoryResourceHandle handle) {
+        std::lock_guard lock(mutex_);
+        auto it = handles_.find(handle);
+        if (it == handles_.end()) {
+            return;
+        }
+
+        it->second->lastUsedFrame = frameNumber_;
+        resources_.splice(resources_.end(), resources_, it->second);
+    }
+
+    const GPUMemoryBudgetReport& GPUMemoryBudget::update(uint64_t frameNumber,
+                                                         uint64_t completedFrameNumber) {
+        allocator_->setCurrentFrameIndex(static_cast<uint32_t>(frameNumber));
+
+        report_.heaps = allocator_->getHeapBudgets();
+        report_.deviceLocalBudget = 0;
+        report_.deviceLocalUsage = 0;
+        for (const auto& heap : report_.heaps) {
+            if (heap.deviceLocal) {
+                report_.deviceLocalBudget += heap.budget;
+                report_.deviceLocalUsage += heap.usage;
+            }
+        }
+
+        const auto threshold
+            = static_cast<size_t>(static_cast<double>(report_.deviceLocalBudget)
+                                  * static_cast<double>(evictionThreshold_));
+        const auto target = static_cast<size_t>(static_cast<double>(report_.deviceLocalBudget)
+                                                * static_cast<double>(evictionTarget_));
+
+        // NOTE: Callbacks run outside the lock so they can track and untrack resources.
+        std::vector<GPUMemoryEvictionCallback> evictions;
+        size_t evictedSize = 0;
+        {
+            std::lock_guard lock(mutex_);
+            frameNumber_ = frameNumber;
+
+            // NOTE: Without subtracting the evictions still pending, every update until they are
+            // released would evict the same excess again.
+            std::erase_if(pendingEvictions_, [completedFrameNumber](const auto& eviction) {
+                return eviction.frameNumber <= completedFrameNumber;
+            });
+            size_t usageDrop = lastDeviceLocalUsage_ > report_.deviceLocalUsage
+                                   ? lastDeviceLocalUsage_ - report_.deviceLocalUsage
+                                   : 0;
+            size_t pendingSize = 0;
+            for (auto& eviction : pendingEvictions_) {
+                const size_t released = std::min(usageDrop, eviction.size);
+                eviction.size -= released;
+                usageDrop -= released;
+                pendingSize += eviction.size;
+            }
+            std::erase_if(pendingEvictions_,
+                          [](const auto& eviction) { return eviction.size == 0; });
+            lastDeviceLocalUsage_ = report_.deviceLocalUsage;
+
+            const size_t usage
+                = report_.deviceLocalUsage - std::min(pendingSize, report_.deviceLocalUsage);
+            if (usage >= threshold) {
+                const size_t excess = usage - target;
+                auto it = resources_.begin();
+                while (it != resources_.end() && evictedSize < excess
+                       && it->lastUsedFrame + minUnusedFrames_ <= frameNumber_) {
+                    if (!it->onEvict) {
+                        ++it;
+                        continue;
+                    }
+
+                    evictedSize += it->size;
+                    categoryUsage_[static_cast<size_t>(it->category)] -= it->size;
+                    evictions.push_back(std::move(it->onEvict));
+                    handles_.erase(it->handle);
+                    it = resources_.erase(it);
+                }
+            }
+
+            if (evictedSize > 0) {
+                pendingEvictions_.push_back({.size = evictedSize, .frameNumber = frameNumber_});
+                pendingSize += evictedSize;
+            }
+            report_.pendingEvictionSize = pendingSize;
+            report_.categoryUsage = categoryUsage_;
+        }
+
+        report_.evictedSize = evictedSize;
+        report_.evictedCount = static_cast<uint32_t>(evictions.size());
+        for (auto& onEvict : evictions) {
+            onEvict();
+        }
+
+        return report_;
+    }
+
+    size_t GPUMemoryBudget::getCategoryUsage(GPUMemoryCategory category) const {
+        std::lock_guard lock(mutex_);
+        return categoryUsage_[static_cast<size_t>(category)];
+    }
+}  // namespace aetherion
@@ -0,0 +1,55 @@
+#include "aetherion/gpu/parallel_command_recorder.hpp"
+
+#include <algorithm>
+#include <future>
+#include <vector>
+
+#include "aetherion/gpu/command_pool_manager.hpp"
+#include "aetherion/util/thread_pool.hpp"
+
+namespace aetherion {
+    ParallelCommandRecorder::ParallelCommandRecorder(CommandPoolManager& commandPools,
+                                                     ThreadPool& workers)
+        : commandPools_(&commandPools), workers_(&workers) {}
+
+    void ParallelCommandRecorder::record(ICommandBuffer& primaryCommandBuffer, size_t itemCount,
+                                         const ParallelRecordFunctor& functor,
+                                         const ParallelRecordDescription& description) {
+        if (itemCount == 0) {
+            return;
+        }
+
+        const size_t maxChunkCount = std::max<size_t>(workers_->getThreadCount(), 1);
+        const size_t chunkCount = std::clamp<size_t>(
+            itemCount / std::max<size_t>(description.minItemsPerChunk, 1), 1, maxChunkCount);
+        const size_t itemsPerChunk = (itemCount + chunkCount - 1) / chunkCount;
+
+        std::vector<std::future<ICommandBuffer*>> chunks;
+        chunks.reserve(chunkCount);
+        for (size_t firstItem = 0; firstItem < itemCount; firstItem += itemsPerChunk) {
+            const size_t chunkItemCount = std::min(itemsPerChunk, itemCount - firstItem);
+            chunks.push_back(workers_->submit(
+                [this, &functor, &description, firstItem, chunkItemCount]() {
+                    ICommandBuffer& commandBuffer
+                        = commandPools_->acquire(CommandBufferLevel::Secondary);
+                    commandBuffer.begin(description.usage, description.inheritance);
+                    functor(commandBuffer, firstItem, chunkItemCount);
+                    commandBuffer.end();
+                    return &commandBuffer;
+                }));
+        }
+
+        // NOTE: Every chunk must finish before rethrowing, the tasks reference the functor.
+        for (const auto& chunk : chunks) {
+            chunk.wait();
+        }
+
+        std::vector<std::reference_wrapper<ICommandBuffer>> commandBuffers;
+        commandBuffers.reserve(chunks.size());
+        for (auto& chunk : chunks) {
+            commandBuffers.push_back(*chunk.get());
+        }
+
+        primaryCommandBuffer.executeCommands(commandBuffers);
+    }
+}  // namespace aetherion
@@ -0,0 +1,45 @@
+#include "aetherion/gpu/pipeline_compiler.hpp"
+
+#include "aetherion/gpu/backend/device.hpp"
+
+namespace aetherion {
+    PipelineCompiler::PipelineCompiler(IGPUDevice& device,
+                                       const PipelineCompilerDescription& description)
+        : device_(&device), workers_(description.workerCount) {}
+
+    PipelineCompileHandle PipelineCompiler::compile(
+        const GraphicsPipelineDescription& description) {
+        return PipelineCompileHandle(workers_.submit([device = device_, description]() {
+            return device->createGraphicsPipeline(description);
+        }));
+    }
+
+    PipelineCompileHandle PipelineCompiler::compile(
+        const ComputePipelineDescription& description) {
+        return PipelineCompileHandle(workers_.submit([device = device_, description]() {
+            return device->createComputePipeline(description);
+        }));
+    }
+
+    std::vector<PipelineCompileHandle> PipelineCompiler::compile(
+        std::span<const GraphicsPipelineDescription> descriptions) {
+        std::vector<PipelineCompileHandle> handles;
+        handles.reserve(descriptions.size());
+
+        for (const auto& description : descriptions) {
+            handles.push_back(compile(description));
+        }
+        return handles;
+    }
+
+    std::vector<PipelineCompileHandle> PipelineCompiler::compile(
+        std::span<const ComputePipelineDescription> descriptions) {
+        std::vector<PipelineCompileHandle> handles;
+        handles.reserve(descriptions.size());
+
+        for (const auto& description : descriptions) {
+            handles.push_back(compile(description));
+        }
+        return handles;
+    }
+}  // namespace aetherion
\ No newline at end of file
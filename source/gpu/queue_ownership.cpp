@@ -0,0 +1,129 @@
+#include "aetherion/gpu/queue_ownership.hpp"
+
+#include <utility>
+
+#include "aetherion/gpu/backend/buffer.hpp"
+
+namespace aetherion {
+    QueueOwnershipTransferBarriers<BufferBarrierDescription> createBufferOwnershipTransfer(
+        IGPUBuffer& buffer, const QueueOwnershipTransferDescription& description,
+        uint32_t offset, uint32_t size) {
+        if (description.srcQueueFamilyIndex == description.dstQueueFamilyIndex) {
+            return {.releaseBarrier = {.buffer = &buffer,
+                                       .srcStageFlags = description.srcStageFlags,
+                                       .srcAccessFlags = description.srcAccessFlags,
+                                       .dstStageFlags = description.dstStageFlags,
+                                       .dstAccessFlags = description.dstAccessFlags,
+                                       .offset = offset,
+                                       .size = size},
+                    .acquireBarrier = std::nullopt};
+        }
+
+        // NOTE: Destination scopes are ignored by the release and source scopes by the acquire.
+        return {.releaseBarrier = {.buffer = &buffer,
+                                   .srcStageFlags = description.srcStageFlags,
+                                   .srcAccessFlags = description.srcAccessFlags,
+                                   .srcQueueFamilyIndex = description.srcQueueFamilyIndex,
+                                   .dstQueueFamilyIndex = description.dstQueueFamilyIndex,
+                                   .offset = offset,
+                                   .size = size},
+                .acquireBarrier
+                = BufferBarrierDescription{.buffer = &buffer,
+                                           .dstStageFlags = description.dstStageFlags,
+                                           .dstAccessFlags = description.dstAccessFlags,
+                                           .srcQueueFamilyIndex = description.srcQueueFamilyIndex,
+                                           .dstQueueFamilyIndex = description.dstQueueFamilyIndex,
+                                           .offset = offset,
+                                           .size = size}};
+    }
+
+    QueueOwnershipTransferBarriers<ImageBarrierDescription> createImageOwnershipTransfer(
+        IGPUImage& image, GPUImageLayout oldLayout, GPUImageLayout newLayout,
+        const QueueOwnershipTransferDescription& description,
+        const GPUImageSubresourceDescription& subresource) {
+        if (description.srcQueueFamilyIndex == description.dstQueueFamilyIndex) {
+            return {.releaseBarrier = {.image = &image,
+                                       .oldLayout = oldLayout,
+                                       .newLayout = newLayout,
+                                       .srcStageFlags = description.srcStageFlags,
+                                       .srcAccessFlags = description.srcAccessFlags,
+                                       .dstStageFlags = description.dstStageFlags,
+                                       .dstAccessFlags = description.dstAccessFlags,
+                                       .subresource = subresource},
+                    .acquireBarrier = std::nullopt};
+        }
+
+        return {.releaseBarrier = {.image = &image,
+                                   .oldLayout = oldLayout,
+                                   .newLayout = newLayout,
+                                   .srcStageFlags = description.srcStageFlags,
+                                   .srcAccessFlags = description.srcAccessFlags,
+                                   .srcQueueFamilyIndex = description.srcQueueFamilyIndex,
+                                   .dstQueueFamilyIndex = description.dstQueueFamilyIndex,
+                                   .subresource = subresource},
+                .acquireBarrier
+                = ImageBarrierDescription{.image = &image,
+                                          .oldLayout = oldLayout,
+                                          .newLayout = newLayout,
+                                          .dstStageFlags = description.dstStageFlags,
+                                          .dstAccessFlags = description.dstAccessFlags,
+                                          .srcQueueFamilyIndex = description.srcQueueFamilyIndex,
+                                          .dstQueueFamilyIndex = description.dstQueueFamilyIndex,
+                                          .subresource = subresource}};
+    }
+
+    std::optional<QueueOwnershipTransferBarriers<BufferBarrierDescription>>
+    QueueOwnershipTracker::useBuffer(IGPUBuffer& buffer,
+                                     const QueueOwnershipAccessDescription& access) {
+        std::lock_guard lock(mutex_);
+        auto [it, inserted] = owners_.try_emplace(&buffer, Owner{.access = access});
+        if (inserted) {
+            return std::nullopt;
+        }
+
+        const Owner previous = std::exchange(it->second, Owner{.access = access});
+        if (previous.access.queueFamilyIndex == access.queueFamilyIndex) {
+            return std::nullopt;
+        }
+
+        return createBufferOwnershipTransfer(
+            buffer, {.srcQueueFamilyIndex = previous.access.queueFamilyIndex,
+                     .srcStageFlags = previous.access.stageFlags,
+                     .srcAccessFlags = previous.access.accessFlags & WRITE_ACCESS_TYPES,
+                     .dstQueueFamilyIndex = access.queueFamilyIndex,
+                     .dstStageFlags = access.stageFlags,
+                     .dstAccessFlags = access.accessFlags});
+    }
+
+    std::optional<QueueOwnershipTransferBarriers<ImageBarrierDescription>>
+    QueueOwnershipTracker::useImage(IGPUImage& image, GPUImageLayout layout,
+                                    const QueueOwnershipAccessDescription& access,
+                                    const GPUImageSubresourceDescription& subresource) {
+        std::lock_guard lock(mutex_);
+        auto [it, inserted]
+            = owners_.try_emplace(&image, Owner{.access = access, .layout = layout});
+        if (inserted) {
+            return std::nullopt;
+        }
+
+        const Owner previous = std::exchange(it->second, Owner{.access = access, .layout = layout});
+        if (previous.access.queueFamilyIndex == access.queueFamilyIndex) {
+            return std::nullopt;
+        }
+
+        return createImageOwnershipTransfer(
+            image, previous.layout, layout,
+            {.srcQueueFamilyIndex = previous.access.queueFamilyIndex,
+             .srcStageFlags = previous.access.stageFlags,
+             .srcAccessFlags = previous.access.accessFlags & WRITE_ACCESS_TYPES,
+             .dstQueueFamilyIndex = access.queueFamilyIndex,
+             .dstStageFlags = access.stageFlags,
+             .dstAccessFlags = access.accessFlags},
+            subresource);
+    }
+
+    void QueueOwnershipTracker::forget(const IGPUResource& resource) {
+        std::lock_guard lock(mutex_);
+        owners_.erase(&resource);
+    }
+}  // namespace aetherion
@@ -0,0 +1,760 @@
+#include "aetherion/gpu/rendering/render_graph.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "aetherion/gpu/backend/device.hpp"
+#include "aetherion/gpu/backend/sync.hpp"
+
+namespace aetherion {
+    RenderGraphAccessDescription getRenderGraphAccessDescription(RenderGraphAccess access) {
+        switch (access) {
+            case RenderGraphAccess::IndirectBuffer:
+                return {.stageFlags = PipelineStage::DrawIndirect,
+                        .accessFlags = AccessType::IndirectCommandRead};
+            case RenderGraphAccess::IndexBuffer:
+                return {.stageFlags = PipelineStage::VertexInput,
+                        .accessFlags = AccessType::IndexRead};
+            case RenderGraphAccess::VertexBuffer:
+                return {.stageFlags = PipelineStage::VertexInput,
+                        .accessFlags = AccessType::VertexAttributeRead};
+            case RenderGraphAccess::VertexShaderUniformRead:
+                return {.stageFlags = PipelineStage::VertexShader,
+                        .accessFlags = AccessType::UniformRead,
+                        .layout = GPUImageLayout::ShaderReadOnlyOptimal};
+            case RenderGraphAccess::VertexShaderRead:
+                return {.stageFlags = PipelineStage::VertexShader,
+                        .accessFlags = AccessType::ShaderRead,
+                        .layout = GPUImageLayout::ShaderReadOnlyOptimal};
+            case RenderGraphAccess::FragmentShaderUniformRead:
+                return {.stageFlags = PipelineStage::FragmentShader,
+                        .accessFlags = AccessType::UniformRead,
+                        .layout = GPUImageLayout::ShaderReadOnlyOptimal};
+            case RenderGraphAccess::FragmentShaderRead:
+                return {.stageFlags = PipelineStage::FragmentShader,
+                        .accessFlags = AccessType::ShaderRead,
+                        .layout = GPUImageLayout::ShaderReadOnlyOptimal};
+            case RenderGraphAccess::ComputeShaderUniformRead:
+                return {.stageFlags = PipelineStage::ComputeShader,
+                        .accessFlags = AccessType::UniformRead,
+                        .layout = GPUImageLayout::ShaderReadOnlyOptimal};
+            case RenderGraphAccess::ComputeShaderRead:
+                return {.stageFlags = PipelineStage::ComputeShader,
+                        .accessFlags = AccessType::ShaderRead,
+                        .layout = GPUImageLayout::ShaderReadOnlyOptimal};
+            case RenderGraphAccess::ComputeShaderStorageRead:
+                return {.stageFlags = PipelineStage::ComputeShader,
+                        .accessFlags = AccessType::ShaderRead,
+                        .layout = GPUImageLayout::General};
+            case RenderGraphAccess::ComputeShaderStorageWrite:
+                return {.stageFlags = PipelineStage::ComputeShader,
+                        .accessFlags = AccessType::ShaderWrite,
+                        .layout = GPUImageLayout::General};
+            case RenderGraphAccess::ComputeShaderStorageReadWrite:
+                return {.stageFlags = PipelineStage::ComputeShader,
+                        .accessFlags = AccessType::ShaderRead | AccessType::ShaderWrite,
+                        .layout = GPUImageLayout::General};
+            case RenderGraphAccess::ColorAttachmentWrite:
+                return {.stageFlags = PipelineStage::ColorAttachmentOutput,
+                        .accessFlags = AccessType::ColorAttachmentWrite,
+                        .layout = GPUImageLayout::ColorAttachmentOptimal};
+            case RenderGraphAccess::ColorAttachmentReadWrite:
+                return {.stageFlags = PipelineStage::ColorAttachmentOutput,
+                        .accessFlags
+                        = AccessType::ColorAttachmentRead | AccessType::ColorAttachmentWrite,
+                        .layout = GPUImageLayout::ColorAttachmentOptimal};
+            case RenderGraphAccess::DepthStencilAttachmentRead:
+                return {.stageFlags
+                        = PipelineStage::EarlyFragmentTests | PipelineStage::LateFragmentTests,
+                        .accessFlags = AccessType::DepthStencilAttachmentRead,
+                        .layout = GPUImageLayout::DepthStencilReadOnlyOptimal};
+            case RenderGraphAccess::DepthStencilAttachmentWrite:
+                return {.stageFlags
+                        = PipelineStage::EarlyFragmentTests | PipelineStage::LateFragmentTests,
+                        .accessFlags = AccessType::DepthStencilAttachmentRead
+                                       | AccessType::DepthStencilAttachmentWrite,
+                        .layout = GPUImageLayout::DepthStencilAttachmentOptimal};
+            case RenderGraphAccess::TransferRead:
+                return {.stageFlags = PipelineStage::Transfer,
+                        .accessFlags = AccessType::TransferRead,
+                        .layout = GPUImageLayout::TransferSrcOptimal};
+            case RenderGraphAccess::TransferWrite:
+                return {.stageFlags = PipelineStage::Transfer,
+                        .accessFlags = AccessType::TransferWrite,
+                        .layout = GPUImageLayout::TransferDstOptimal};
+            case RenderGraphAccess::Present:
+                return {.stageFlags = PipelineStage::BottomOfPipe,
+                        .accessFlags = AccessType::None,
+                        .layout = GPUImageLayout::PresentSource};
+            default:
+                throw std::invalid_argument("Invalid RenderGraphAccess");
+        }
+    }
+
+    RenderGraphPassBuilder::RenderGraphPassBuilder(RenderGraph& graph, uint32_t pass)
+        : graph_(&graph), pass_(pass) {}
+
+    RenderGraphPassBuilder& RenderGraphPassBuilder::read(RenderGraphImageHandle image,
+                                                         RenderGraphAccess access) {
+        return addAccess(image.index, true, getRenderGraphAccessDescription(access), false);
+    }
+
+    RenderGraphPassBuilder& RenderGraphPassBuilder::read(
+        RenderGraphImageHandle image, const RenderGraphAccessDescription& access) {
+        return addAccess(image.index, true, access, false);
+    }
+
+    RenderGraphPassBuilder& RenderGraphPassBuilder::read(RenderGraphBufferHandle buffer,
+                                                         RenderGraphAccess access) {
+        return addAccess(buffer.index, false, getRenderGraphAccessDescription(access), false);
+    }
+
+    RenderGraphPassBuilder& RenderGraphPassBuilder::read(
+        RenderGraphBufferHandle buffer, const RenderGraphAccessDescription& access) {
+        return addAccess(buffer.index, false, access, false);
+    }
+
+    RenderGraphPassBuilder& RenderGraphPassBuilder::write(RenderGraphImageHandle image,
+                                                          RenderGraphAccess access) {
+        return addAccess(image.index, true, getRenderGraphAccessDescription(access), true);
+    }
+
+    RenderGraphPassBuilder& RenderGraphPassBuilder::write(
+        RenderGraphImageHandle image, const RenderGraphAccessDescription& access) {
+        return addAccess(image.index, true, access, true);
+    }
+
+    RenderGraphPassBuilder& RenderGraphPassBuilder::write(RenderGraphBufferHandle buffer,
+                                                          RenderGraphAccess access) {
+        return addAccess(buffer.index, false, getRenderGraphAccessDescription(access), true);
+    }
+
+    RenderGraphPassBuilder& RenderGraphPassBuilder::write(
+        RenderGraphBufferHandle buffer, const RenderGraphAccessDescription& access) {
+        return addAccess(buffer.index, false, access, true);
+    }
+
+    RenderGraphPassBuilder& RenderGraphPassBuilder::setSideEffects() {
+        graph_->passes_[pass_].sideEffects = true;
+        return *this;
+    }
+
+    RenderGraphPassBuilder& RenderGraphPassBuilder::setQueue(RenderGraphQueue queue) {
+        graph_->passes_[pass_].queue = queue;
+        return *this;
+    }
+
+    RenderGraphPassBuilder& RenderGraphPassBuilder::addAccess(
+        uint32_t resource, bool image, const RenderGraphAccessDescription& access, bool write) {
+        if (resource >= graph_->resources_.size()
+            || graph_->resources_[resource].isImage != image) {
+            throw(std::invalid_argument("Invalid render graph resource handle."));
+        }
+
+        auto& accesses = graph_->passes_[pass_].accesses;
+        auto it = std::find_if(accesses.begin(), accesses.end(),
+                               [&](const auto& other) { return other.resource == resource; });
+        if (it == accesses.end()) {
+            accesses.push_back(
+                {.resource = resource, .access = access, .read = !write, .write = write});
+            return *this;
+        }
+
+        if (image && it->access.layout != access.layout) {
+            throw(std::invalid_argument(
+                "A render graph pass must access an image in a single layout."));
+        }
+        it->access.stageFlags = it->access.stageFlags | access.stageFlags;
+        it->access.accessFlags = it->access.accessFlags | access.accessFlags;
+        it->read = it->read || !write;
+        it->write = it->write || write;
+        return *this;
+    }
+
+    RenderGraph::RenderGraph(IGPUDevice& device, IGPUAllocator& allocator,
+                             const RenderGraphDescription& description)
+        : transientMemoryPlanner_(device, allocator, description.transientMemory),
+          graphicsQueueFamilyIndex_(description.graphicsQueueFamilyIndex),
+          computeQueueFamilyIndex_(description.computeQueueFamilyIndex),
+          timelines_({device.createGPUTimelineSemaphore({.initialValue = 0}),
+                      device.createGPUTimelineSemaphore({.initialValue = 0})}) {}
+
+    RenderGraph::~RenderGraph() noexcept = default;
+
+    RenderGraphImageHandle RenderGraph::importImage(
+        IGPUImage& image, const RenderGraphImportDescription& description) {
+        resources_.push_back({.isImage = true,
+                              .imported = true,
+                              .image = &image,
+                              .subresource = description.subresource,
+                              .sharingMode = description.sharingMode,
+                              .initialAccess = description.initialAccess,
+                              .finalAccess = description.finalAccess});
+        return {static_cast<uint32_t>(resources_.size() - 1)};
+    }
+
+    RenderGraphBufferHandle RenderGraph::importBuffer(
+        IGPUBuffer& buffer, const RenderGraphImportDescription& description) {
+        resources_.push_back({.isImage = false,
+                              .imported = true,
+                              .buffer = &buffer,
+                              .sharingMode = description.sharingMode,
+                              .initialAccess = description.initialAccess,
+                              .finalAccess = description.finalAccess});
+        return {static_cast<uint32_t>(resources_.size() - 1)};
+    }
+
+    void RenderGraph::setImage(RenderGraphImageHandle image, IGPUImage& gpuImage) {
+        auto& resource = resources_.at(image.index);
+        if (!resource.isImage || !resource.imported) {
+            throw(std::invalid_argument("Only imported render graph images can be rebound."));
+        }
+        resource.image = &gpuImage;
+    }
+
+    void RenderGraph::setBuffer(RenderGraphBufferHandle buffer, IGPUBuffer& gpuBuffer) {
+        auto& resource = resources_.at(buffer.index);
+        if (resource.isImage || !resource.imported) {
+            throw(std::invalid_argument("Only imported render graph buffers can be rebound."));
+        }
+        resource.buffer = &gpuBuffer;
+    }
+
+    RenderGraphImageHandle RenderGraph::createImage(const GPUImageDescription& description,
+                                                    GPUImageAspectFlags aspectMask) {
+        resources_.push_back({.isImage = true,
+                              .imported = false,
+                              .imageDescription = description,
+                              .subresource = {.aspectMask = aspectMask,
+                                              .range = {.baseArrayLayer = 0,
+                                                        .layerCount = description.arrayLayers,
+                                                        .baseMipLevel = 0,
+                                                        .mipLevelCount = description.mipLevels}},
+                              .sharingMode = description.sharingMode});
+        return {static_cast<uint32_t>(resources_.size() - 1)};
+    }
+
+    RenderGraphBufferHandle RenderGraph::createBuffer(const GPUBufferDescription& description) {
+        resources_.push_back({.isImage = false,
+                              .imported = false,
+                              .bufferDescription = description,
+                              .sharingMode = description.sharingMode});
+        return {static_cast<uint32_t>(resources_.size() - 1)};
+    }
+
+    RenderGraphPassBuilder RenderGraph::addPass(std::string_view name,
+                                                RenderGraphExecuteFunctor execute) {
+        passes_.push_back({.name = std::string(name), .execute = std::move(execute)});
+        return RenderGraphPassBuilder(*this, static_cast<uint32_t>(passes_.size() - 1));
+    }
+
+    void RenderGraph::compile() {
+        cullPasses();
+        scheduleBatches();
+        createTransientResources();
+        computeBarriers();
+
+        batchSignalValues_.assign(batches_.size(), 0);
+        previousBatchSignalValues_.assign(batches_.size(), 0);
+    }
+
+    void RenderGraph::execute(ICommandBuffer& commandBuffer) {
+        if (batches_.size() != 1) {
+            throw(std::runtime_error(
+                "Render graph isn't compiled or has async compute submissions, use submit()."));
+        }
+
+        recordBatch(commandBuffer, 0);
+    }
+
+    void RenderGraph::submit(const RenderGraphSubmitDescription& description) {
+        if (batches_.empty()) {
+            throw(std::runtime_error("Render graph isn't compiled."));
+        }
+        if (!description.graphicsQueue || (batches_.size() > 1 && !description.computeQueue)) {
+            throw(std::invalid_argument(
+                "RenderGraphSubmitDescription is missing a queue the render graph submits to."));
+        }
+
+        std::swap(batchSignalValues_, previousBatchSignalValues_);
+
+        std::array<bool, 2> firstSubmissions = {true, true};
+        for (uint32_t i = 0; i < batches_.size(); ++i) {
+            const auto& batch = batches_[i];
+            const auto queue = static_cast<size_t>(batch.queue);
+            const bool last = i == batches_.size() - 1;
+
+            auto& commandBuffer = description.acquireCommandBuffer(batch.queue);
+            commandBuffer.begin(CommandBufferUsage::OneTimeSubmit);
+            recordBatch(commandBuffer, i);
+            commandBuffer.end();
+
+            GPUQueueSubmitDescription submitDescription;
+            if (batch.waitBatch) {
+                const uint64_t waitValue = batch.waitPreviousExecution
+                                               ? previousBatchSignalValues_[*batch.waitBatch]
+                                               : batchSignalValues_[*batch.waitBatch];
+                // NOTE: Nothing to wait for in the first execution.
+                if (waitValue != 0) {
+                    submitDescription.waitTimelineSemaphores.push_back(
+                        {.semaphore = timelines_[1 - queue].get(),
+                         .value = waitValue,
+                         .waitStage = batch.waitStageFlags});
+                }
+            }
+            if (firstSubmissions[queue]) {
+                if (i == 0) {
+                    submitDescription.waitBinarySemaphores = description.waitBinarySemaphores;
+                }
+                submitDescription.waitTimelineSemaphores.insert(
+                    submitDescription.waitTimelineSemaphores.end(),
+                    description.waitTimelineSemaphores.begin(),
+                    description.waitTimelineSemaphores.end());
+                firstSubmissions[queue] = false;
+            }
+
+            submitDescription.commandBuffers.push_back(&commandBuffer);
+
+            batchSignalValues_[i] = ++timelineValues_[queue];
+            submitDescription.signalTimelineSemaphores.push_back(
+                {.semaphore = timelines_[queue].get(),
+                 .value = batchSignalValues_[i],
+                 .signalStage = PipelineStage::AllCommands});
+            if (last) {
+                submitDescription.signalBinarySemaphores = description.signalBinarySemaphores;
+                submitDescription.signalTimelineSemaphores.insert(
+                    submitDescription.signalTimelineSemaphores.end(),
+                    description.signalTimelineSemaphores.begin(),
+                    description.signalTimelineSemaphores.end());
+            }
+
+            auto& gpuQueue = batch.queue == RenderGraphQueue::Graphics ? *description.graphicsQueue
+                                                                      : *description.computeQueue;
+            gpuQueue.submit(std::span<GPUQueueSubmitDescription>(&submitDescription, 1), nullptr);
+        }
+    }
+
+    void RenderGraph::recordBatch(ICommandBuffer& commandBuffer, uint32_t batch) {
+        for (const auto pass : batches_[batch].passes) {
+            recordBarriers(commandBuffer, passes_[pass].barriers);
+            if (passes_[pass].execute) {
+                passes_[pass].execute(commandBuffer, *this);
+            }
+        }
+        recordBarriers(commandBuffer, batches_[batch].releaseBarriers);
+
+        if (batch == batches_.size() - 1) {
+            recordBarriers(commandBuffer, finalBarriers_);
+        }
+    }
+
+    IGPUImage& RenderGraph::getImage(RenderGraphImageHandle image) const {
+        const auto& resource = resources_.at(image.index);
+        if (!resource.isImage || !resource.image) {
+            throw(std::runtime_error("Render graph image is culled or the graph isn't compiled."));
+        }
+        return *resource.image;
+    }
+
+    IGPUBuffer& RenderGraph::getBuffer(RenderGraphBufferHandle buffer) const {
+        const auto& resource = resources_.at(buffer.index);
+        if (resource.isImage || !resource.buffer) {
+            throw(
+                std::runtime_error("Render graph buffer is culled or the graph isn't compiled."));
+        }
+        return *resource.buffer;
+    }
+
+    void RenderGraph::cullPasses() {
+        // NOTE: Walking backwards, a pass is kept if it writes a resource a kept pass reads later,
+        // which then makes the resources it reads needed too.
+        std::vector<bool> needed(resources_.size(), false);
+        for (size_t i = 0; i < resources_.size(); ++i) {
+            needed[i] = resources_[i].imported;
+        }
+
+        for (auto pass = passes_.rbegin(); pass != passes_.rend(); ++pass) {
+            pass->culled = !pass->sideEffects
+                           && std::none_of(pass->accesses.begin(), pass->accesses.end(),
+                                           [&](const ResourceAccess& access) {
+                                               return access.write && needed[access.resource];
+                                           });
+            if (pass->culled) {
+                continue;
+            }
+
+            for (const auto& access : pass->accesses) {
+                if (access.read) {
+                    needed[access.resource] = true;
+                }
+            }
+        }
+    }
+
+    void RenderGraph::scheduleBatches() {
+        const bool asyncCompute = computeQueueFamilyIndex_ != QUEUE_FAMILY_IGNORED;
+
+        batches_.clear();
+        for (uint32_t i = 0; i < passes_.size(); ++i) {
+            if (passes_[i].culled) {
+                continue;
+            }
+
+            const auto queue = asyncCompute ? passes_[i].queue : RenderGraphQueue::Graphics;
+            if (batches_.empty() || batches_.back().queue != queue) {
+                batches_.push_back({.queue = queue});
+            }
+            batches_.back().passes.push_back(i);
+        }
+
+        // NOTE: The first batch takes the external waits and hands imported resources to the
+        // compute queue, the last one takes them back and signals completion, both on the graphics
+        // queue.
+        if (!batches_.empty() && batches_.front().queue != RenderGraphQueue::Graphics) {
+            batches_.insert(batches_.begin(), Batch{.queue = RenderGraphQueue::Graphics});
+        }
+        if (batches_.empty() || batches_.back().queue != RenderGraphQueue::Graphics) {
+            batches_.push_back({.queue = RenderGraphQueue::Graphics});
+        }
+    }
+
+    void RenderGraph::createTransientResources() {
+        // NOTE: Releases the previous resources before creating the new ones.
+        transientMemory_ = {};
+        for (auto& resource : resources_) {
+            if (!resource.imported) {
+                resource.image = nullptr;
+                resource.buffer = nullptr;
+            }
+        }
+
+        std::vector<std::optional<std::pair<uint32_t, uint32_t>>> lifetimes(resources_.size());
+        std::vector<bool> computeResources(resources_.size(), false);
+        for (const auto& batch : batches_) {
+            for (const auto pass : batch.passes) {
+                for (const auto& access : passes_[pass].accesses) {
+                    auto& lifetime = lifetimes[access.resource];
+                    lifetime = lifetime ? std::make_pair(lifetime->first, pass)
+                                        : std::make_pair(pass, pass);
+                    computeResources[access.resource]
+                        = computeResources[access.resource]
+                          || batch.queue == RenderGraphQueue::AsyncCompute;
+                }
+            }
+        }
+
+        std::vector<TransientImageDescription> images;
+        std::vector<uint32_t> imageResources;
+        std::vector<TransientBufferDescription> buffers;
+        std::vector<uint32_t> bufferResources;
+        for (uint32_t i = 0; i < resources_.size(); ++i) {
+            const auto& resource = resources_[i];
+            if (resource.imported || !lifetimes[i]) {
+                continue;
+            }
+
+            // NOTE: The queues only synchronize on shared resources, so resources used by async
+            // compute can't alias any other.
+            if (computeResources[i]) {
+                lifetimes[i] = std::make_pair(0u, static_cast<uint32_t>(passes_.size() - 1));
+            }
+
+            if (resource.isImage) {
+                images.push_back({.description = resource.imageDescription,
+                                  .firstUse = lifetimes[i]->first,
+                                  .lastUse = lifetimes[i]->second});
+                imageResources.push_back(i);
+            } else {
+                buffers.push_back({.description = resource.bufferDescription,
+                                   .firstUse = lifetimes[i]->first,
+                                   .lastUse = lifetimes[i]->second});
+                bufferResources.push_back(i);
+            }
+        }
+
+        transientMemory_ = transientMemoryPlanner_.plan(images, buffers);
+        for (size_t i = 0; i < imageResources.size(); ++i) {
+            resources_[imageResources[i]].image = transientMemory_.images[i].get();
+        }
+        for (size_t i = 0; i < bufferResources.size(); ++i) {
+            resources_[bufferResources[i]].buffer = transientMemory_.buffers[i].get();
+        }
+    }
+
+    void RenderGraph::computeBarriers() {
+        // NOTE: Transient resources share memory with the resources aliasing them and with
+        // themselves in the previous execution, so their first use waits for every transient
+        // access. Resources used by async compute alias nothing and the queues synchronize on
+        // their switches, so only the accesses of the queue the resource was last used on are
+        // waited for, which keeps graphics stages out of the barriers of a compute queue. Indexed
+        // by RenderGraphQueue.
+        std::array<PipelineStageFlags, 2> transientStageFlags = {};
+        std::array<AccessTypeFlags, 2> transientAccessFlags = {};
+        std::vector<std::optional<uint32_t>> lastBatches(resources_.size());
+        for (uint32_t i = 0; i < batches_.size(); ++i) {
+            const auto queue = static_cast<size_t>(batches_[i].queue);
+            for (const auto pass : batches_[i].passes) {
+                for (const auto& access : passes_[pass].accesses) {
+                    lastBatches[access.resource] = i;
+                    if (!resources_[access.resource].imported) {
+                        transientStageFlags[queue]
+                            = transientStageFlags[queue] | access.access.stageFlags;
+                        transientAccessFlags[queue]
+                            = transientAccessFlags[queue]
+                              | (access.access.accessFlags & WRITE_ACCESS_TYPES);
+                    }
+                }
+            }
+        }
+
+        std::vector<ResourceState> states(resources_.size());
+        for (size_t i = 0; i < resources_.size(); ++i) {
+            const auto& resource = resources_[i];
+            auto& state = states[i];
+            if (!resource.imported) {
+                if (lastBatches[i]) {
+                    state.queue = batches_[*lastBatches[i]].queue;
+                    state.batch = *lastBatches[i];
+                    state.previousExecution = true;
+                }
+                state.writeStageFlags = transientStageFlags[static_cast<size_t>(state.queue)];
+                state.writeAccessFlags = transientAccessFlags[static_cast<size_t>(state.queue)];
+                continue;
+            }
+
+            const auto& initialAccess = resource.initialAccess;
+            if (initialAccess.accessFlags & WRITE_ACCESS_TYPES) {
+                state.writeStageFlags = initialAccess.stageFlags;
+                state.writeAccessFlags = initialAccess.accessFlags & WRITE_ACCESS_TYPES;
+            } else {
+                state.readStageFlags = initialAccess.stageFlags;
+            }
+            state.layout = initialAccess.layout;
+        }
+
+        for (auto& pass : passes_) {
+            pass.barriers = {};
+        }
+        for (uint32_t i = 0; i < batches_.size(); ++i) {
+            for (const auto pass : batches_[i].passes) {
+                for (const auto& access : passes_[pass].accesses) {
+                    addBarrier(passes_[pass].barriers, states[access.resource], access.resource,
+                               access.access, access.write, i);
+                }
+            }
+        }
+
+        // NOTE: Imported resources go back to the graphics queue, which waits for the last
+        // compute batch so the final signal covers every submission.
+        const auto lastBatch = static_cast<uint32_t>(batches_.size() - 1);
+        finalBarriers_ = {};
+        for (uint32_t i = 0; i < resources_.size(); ++i) {
+            const auto& resource = resources_[i];
+            auto& state = states[i];
+            if (!resource.imported
+                || (!resource.finalAccess && state.queue == RenderGraphQueue::Graphics)) {
+                continue;
+            }
+
+            const auto finalAccess = resource.finalAccess.value_or(RenderGraphAccessDescription{
+                .stageFlags = PipelineStage::AllCommands,
+                .accessFlags = AccessType::MemoryRead | AccessType::MemoryWrite,
+                .layout = state.layout});
+            addBarrier(finalBarriers_, state, i, finalAccess,
+                       static_cast<bool>(finalAccess.accessFlags & WRITE_ACCESS_TYPES), lastBatch);
+        }
+
+        for (uint32_t i = lastBatch; i-- > 0;) {
+            if (batches_[i].queue == RenderGraphQueue::AsyncCompute) {
+                addWait(batches_[lastBatch],
+                        {.queue = RenderGraphQueue::AsyncCompute, .batch = i},
+                        PipelineStage::AllCommands);
+                break;
+            }
+        }
+    }
+
+    void RenderGraph::addBarrier(BarrierBatch& barriers, ResourceState& state, uint32_t resource,
+                                 const RenderGraphAccessDescription& access, bool write,
+                                 uint32_t batch) {
+        const auto& graphResource = resources_[resource];
+        const auto queue = batches_[batch].queue;
+        auto& memoryBarrier = barriers.memoryBarrier;
+
+        if (state.queue != queue) {
+            // NOTE: The semaphore wait makes every previous access available and visible, only
+            // layout transitions and ownership transfers are left. Transient resources are
+            // discarded at their first use, so they don't need a transfer.
+            addWait(batches_[batch], state, access.stageFlags);
+
+            const bool discard = !graphResource.imported && state.initial;
+            const auto oldLayout = discard ? GPUImageLayout::Undefined : state.layout;
+            const bool layoutTransition = graphResource.isImage && access.layout != oldLayout;
+            const bool ownershipTransfer
+                = !discard && graphResource.sharingMode == SharingMode::Exclusive
+                  && getQueueFamilyIndex(state.queue) != getQueueFamilyIndex(queue);
+
+            if (ownershipTransfer) {
+                auto& releaseBarriers = batches_[state.batch].releaseBarriers;
+                if (graphResource.isImage) {
+                    releaseBarriers.imageBarriers.push_back(
+                        {.image = nullptr,
+                         .oldLayout = oldLayout,
+                         .newLayout = access.layout,
+                         .srcStageFlags = state.writeStageFlags | state.readStageFlags,
+                         .srcAccessFlags = state.writeAccessFlags,
+                         .srcQueueFamilyIndex = getQueueFamilyIndex(state.queue),
+                         .dstQueueFamilyIndex = getQueueFamilyIndex(queue),
+                         .subresource = graphResource.subresource});
+                    releaseBarriers.imageResources.push_back(resource);
+
+                    barriers.imageBarriers.push_back(
+                        {.image = nullptr,
+                         .oldLayout = oldLayout,
+                         .newLayout = access.layout,
+                         .srcStageFlags = access.stageFlags,
+                         .dstStageFlags = access.stageFlags,
+                         .dstAccessFlags = access.accessFlags,
+                         .srcQueueFamilyIndex = getQueueFamilyIndex(state.queue),
+                         .dstQueueFamilyIndex = getQueueFamilyIndex(queue),
+                         .subresource = graphResource.subresource});
+                    barriers.imageResources.push_back(resource);
+                } else {
+                    releaseBarriers.bufferBarriers.push_back(
+                        {.buffer = nullptr,
+                         .srcStageFlags = state.writeStageFlags | state.readStageFlags,
+                         .srcAccessFlags = state.writeAccessFlags,
+                         .srcQueueFamilyIndex = getQueueFamilyIndex(state.queue),
+                         .dstQueueFamilyIndex = getQueueFamilyIndex(queue)});
+                    releaseBarriers.bufferResources.push_back(resource);
+
+                    barriers.bufferBarriers.push_back(
+                        {.buffer = nullptr,
+                         .srcStageFlags = access.stageFlags,
+                         .dstStageFlags = access.stageFlags,
+                         .dstAccessFlags = access.accessFlags,
+                         .srcQueueFamilyIndex = getQueueFamilyIndex(state.queue),
+                         .dstQueueFamilyIndex = getQueueFamilyIndex(queue)});
+                    barriers.bufferResources.push_back(resource);
+                }
+            } else if (layoutTransition) {
+                // NOTE: The source scope matches the wait stages, so the transition happens after
+                // the wait.
+                barriers.imageBarriers.push_back({.image = nullptr,
+                                                  .oldLayout = oldLayout,
+                                                  .newLayout = access.layout,
+                                                  .srcStageFlags = access.stageFlags,
+                                                  .dstStageFlags = access.stageFlags,
+                                                  .dstAccessFlags = access.accessFlags,
+                                                  .subresource = graphResource.subresource});
+                barriers.imageResources.push_back(resource);
+            }
+
+            const bool transitioned = layoutTransition || ownershipTransfer;
+            state.writeStageFlags
+                = write || transitioned ? access.stageFlags : PipelineStageFlags();
+            state.writeAccessFlags
+                = write ? access.accessFlags & WRITE_ACCESS_TYPES : AccessTypeFlags();
+            state.readStageFlags = write ? PipelineStageFlags() : access.stageFlags;
+            state.visibleStageFlags = write ? PipelineStageFlags() : access.stageFlags;
+            state.visibleAccessFlags = write ? AccessTypeFlags() : access.accessFlags;
+            state.layout = access.layout;
+        } else {
+            const bool layoutTransition = graphResource.isImage && access.layout != state.layout;
+            if (write || layoutTransition) {
+                // NOTE: Writes and layout transitions wait for the previous reads and writes.
+                const auto srcStageFlags = state.writeStageFlags | state.readStageFlags;
+                if (layoutTransition) {
+                    barriers.imageBarriers.push_back({.image = nullptr,
+                                                      .oldLayout = state.layout,
+                                                      .newLayout = access.layout,
+                                                      .srcStageFlags = srcStageFlags,
+                                                      .srcAccessFlags = state.writeAccessFlags,
+                                                      .dstStageFlags = access.stageFlags,
+                                                      .dstAccessFlags = access.accessFlags,
+                                                      .subresource = graphResource.subresource});
+                    barriers.imageResources.push_back(resource);
+                } else if (srcStageFlags) {
+                    memoryBarrier.srcStageFlags = memoryBarrier.srcStageFlags | srcStageFlags;
+                    memoryBarrier.srcAccessFlags
+                        = memoryBarrier.srcAccessFlags | state.writeAccessFlags;
+                    memoryBarrier.dstStageFlags = memoryBarrier.dstStageFlags | access.stageFlags;
+                    memoryBarrier.dstAccessFlags
+                        = memoryBarrier.dstAccessFlags | access.accessFlags;
+                }
+
+                // NOTE: A read only layout transition is still a write later reads must wait for.
+                state.writeStageFlags = access.stageFlags;
+                state.writeAccessFlags = access.accessFlags & WRITE_ACCESS_TYPES;
+                state.readStageFlags = write ? PipelineStageFlags() : access.stageFlags;
+                state.visibleStageFlags = write ? PipelineStageFlags() : access.stageFlags;
+                state.visibleAccessFlags = write ? AccessTypeFlags() : access.accessFlags;
+                state.layout = access.layout;
+            } else {
+                const bool visible = !(access.stageFlags & ~state.visibleStageFlags)
+                                     && !(access.accessFlags & ~state.visibleAccessFlags);
+                if (state.writeStageFlags && !visible) {
+                    memoryBarrier.srcStageFlags
+                        = memoryBarrier.srcStageFlags | state.writeStageFlags;
+                    memoryBarrier.srcAccessFlags
+                        = memoryBarrier.srcAccessFlags | state.writeAccessFlags;
+                    memoryBarrier.dstStageFlags = memoryBarrier.dstStageFlags | access.stageFlags;
+                    memoryBarrier.dstAccessFlags
+                        = memoryBarrier.dstAccessFlags | access.accessFlags;
+
+                    state.visibleStageFlags = state.visibleStageFlags | access.stageFlags;
+                    state.visibleAccessFlags = state.visibleAccessFlags | access.accessFlags;
+                }
+                state.readStageFlags = state.readStageFlags | access.stageFlags;
+            }
+        }
+
+        state.queue = queue;
+        state.batch = batch;
+        state.previousExecution = false;
+        state.initial = false;
+    }
+
+    void RenderGraph::addWait(Batch& batch, const ResourceState& state,
+                              PipelineStageFlags stageFlags) {
+        // NOTE: Timeline values only grow, waiting for the latest batch covers the earlier ones.
+        const bool later = !batch.waitBatch
+                           || (batch.waitPreviousExecution && !state.previousExecution)
+                           || (batch.waitPreviousExecution == state.previousExecution
+                               && state.batch > *batch.waitBatch);
+        if (later) {
+            batch.waitBatch = state.batch;
+            batch.waitPreviousExecution = state.previousExecution;
+        }
+        batch.waitStageFlags = batch.waitStageFlags | stageFlags;
+    }
+
+    void RenderGraph::recordBarriers(ICommandBuffer& commandBuffer,
+                                     BarrierBatch& barriers) const {
+        const bool hasMemoryBarrier
+            = barriers.memoryBarrier.srcStageFlags || barriers.memoryBarrier.dstStageFlags;
+        if (!hasMemoryBarrier && barriers.bufferBarriers.empty()
+            && barriers.imageBarriers.empty()) {
+            return;
+        }
+
+        for (size_t i = 0; i < barriers.bufferBarriers.size(); ++i) {
+            barriers.bufferBarriers[i].buffer = resources_[barriers.bufferResources[i]].buffer;
+        }
+        for (size_t i = 0; i < barriers.imageBarriers.size(); ++i) {
+            barriers.imageBarriers[i].image = resources_[barriers.imageResources[i]].image;
+        }
+
+        const auto memoryBarriers = hasMemoryBarrier
+                                        ? std::span<const GeneralMemoryBarrierDescription>(
+                                              &barriers.memoryBarrier, 1)
+                                        : std::span<const GeneralMemoryBarrierDescription>();
+        commandBuffer.barrier(memoryBarriers, barriers.bufferBarriers, barriers.imageBarriers);
+    }
+
+    uint32_t RenderGraph::getQueueFamilyIndex(RenderGraphQueue queue) const {
+        return queue == RenderGraphQueue::AsyncCompute ? computeQueueFamilyIndex_
+                                                       : graphicsQueueFamilyIndex_;
+    }
+}  // namespace aetherion
@@ -0,0 +1,413 @@
+#include "aetherion/gpu/staging_uploader.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+
+#include "aetherion/gpu/backend/buffer.hpp"
+#include "aetherion/gpu/backend/device.hpp"
+#include "aetherion/gpu/backend/memory.hpp"
+#include "aetherion/gpu/queue_ownership.hpp"
+
+namespace aetherion {
+    StagingUploader::StagingUploader(IGPUDevice& device, IGPUAllocator& allocator,
+                                     SubmissionQueue& submissionQueue,
+                                     const StagingUploaderDescription& description)
+        : device_(&device),
+          submissionQueue_(&submissionQueue),
+          queueFamilyIndex_(description.queueFamilyIndex),
+          stagingCapacity_(description.stagingCapacity) {
+        if (stagingCapacity_ == 0) {
+            throw(std::invalid_argument(
+                "stagingCapacity in StagingUploaderDescription must be greater than zero."));
+        }
+
+        stagingBuffer_ = allocator.createBuffer(
+            {.size = stagingCapacity_,
+             .usages = GPUBufferUsage::TransferSrc,
+             .sharingMode = SharingMode::Exclusive,
+             .queueFamilies = {}},
+            {.properties = AllocationProperty::Mapped | AllocationProperty::SequentialAccess,
+             .memoryUsage = MemoryUsage::PreferCpu});
+
+        stagingData_ = stagingBuffer_->getMappedSpan();
+        if (stagingData_.empty()) {
+            throw(std::runtime_error("StagingUploader memory couldn't be mapped."));
+        }
+
+        commandPool_ = device_->createCommandPool(
+            {.queueFamilyIndex = queueFamilyIndex_,
+             .flags = CommandPoolBehavior::Transient | CommandPoolBehavior::ResetCommandBuffer});
+    }
+
+    StagingUploader::~StagingUploader() noexcept {
+        try {
+            flush();
+            for (const auto& batch : batches_) {
+                batch.token.wait();
+            }
+        } catch (...) {
+        }
+    }
+
+    void StagingUploader::enqueue(const BufferUploadDescription& description) {
+        if (!description.buffer) {
+            throw(std::invalid_argument("BufferUploadDescription must reference a buffer."));
+        }
+        if (description.data.empty()) {
+            return;
+        }
+
+        // NOTE: Buffer copies have no alignment requirements, so consecutive uploads stay adjacent
+        // in the staging ring and can be merged.
+        const size_t stagingOffset = allocateStaging(description.data.size(), 1);
+        std::memcpy(stagingData_.data() + stagingOffset, description.data.data(),
+                    description.data.size());
+
+        pendingBufferUploads_.push_back({.buffer = description.buffer,
+                                         .stagingOffset = stagingOffset,
+                                         .offset = description.offset,
+                                         .size = description.data.size(),
+                                         .destination = description.destination});
+    }
+
+    void StagingUploader::enqueue(const ImageUploadDescription& description) {
+        if (!description.image) {
+            throw(std::invalid_argument("ImageUploadDescription must reference an image."));
+        }
+        if (description.layerCount == 0 || description.alignment == 0) {
+            throw(std::invalid_argument(
+                "layerCount and alignment in ImageUploadDescription must be greater than zero."));
+        }
+        if (description.data.empty()) {
+            return;
+        }
+
+        // NOTE: Buffer offsets of image copies must also be multiples of 4 on transfer queues.
+        const size_t alignment = std::lcm(description.alignment, size_t(4));
+        const size_t stagingOffset = allocateStaging(description.data.size(), alignment);
+        std::memcpy(stagingData_.data() + stagingOffset, description.data.data(),
+                    description.data.size());
+
+        pendingImageUploads_.push_back({.description = description,
+                                        .stagingOffset = stagingOffset,
+                                        .stagingSize = description.data.size()});
+        pendingImageUploads_.back().description.data = {};
+    }
+
+    StagingUploadResult StagingUploader::flush() {
+        StagingUploadResult result = std::move(earlyResult_);
+        earlyResult_ = {};
+
+        StagingUploadResult submitResult = submitPendingUploads();
+        if (submitResult.token.isValid()) {
+            // NOTE: Submissions complete in order, so the latest token covers the early ones.
+            result.token = submitResult.token;
+        }
+        result.acquireBufferBarriers.insert(result.acquireBufferBarriers.end(),
+                                            submitResult.acquireBufferBarriers.begin(),
+                                            submitResult.acquireBufferBarriers.end());
+        result.acquireImageBarriers.insert(result.acquireImageBarriers.end(),
+                                           submitResult.acquireImageBarriers.begin(),
+                                           submitResult.acquireImageBarriers.end());
+
+        retireBatches(false);
+
+        return result;
+    }
+
+    StagingUploadResult StagingUploader::submitPendingUploads() {
+        StagingUploadResult result;
+        if (!hasPendingUploads()) {
+            return result;
+        }
+
+        std::unique_ptr<ICommandBuffer> commandBuffer;
+        if (!freeCommandBuffers_.empty()) {
+            commandBuffer = std::move(freeCommandBuffers_.back());
+            freeCommandBuffers_.pop_back();
+        } else {
+            commandBuffer = device_->allocateCommandBuffer(*commandPool_, {});
+        }
+
+        commandBuffer->begin(CommandBufferUsage::OneTimeSubmit);
+        recordImageUploads(*commandBuffer, result);
+        recordBufferUploads(*commandBuffer, result);
+        commandBuffer->end();
+
+        // NOTE: No-op for host coherent memory.
+        stagingBuffer_->flush();
+
+        GPUQueueSubmitDescription submitDescription;
+        submitDescription.commandBuffers.push_back(commandBuffer.get());
+        result.token = submissionQueue_->submit(std::move(submitDescription));
+
+        batches_.push_back({.commandBuffer = std::move(commandBuffer),
+                            .token = result.token,
+                            .stagingSize = pendingStagingSize_});
+        pendingStagingSize_ = 0;
+        pendingBufferUploads_.clear();
+        pendingImageUploads_.clear();
+
+        return result;
+    }
+
+    void StagingUploader::recordBufferUploads(ICommandBuffer& commandBuffer,
+                                              StagingUploadResult& result) {
+        if (pendingBufferUploads_.empty()) {
+            return;
+        }
+
+        std::stable_sort(pendingBufferUploads_.begin(), pendingBufferUploads_.end(),
+                         [](const PendingBufferUpload& a, const PendingBufferUpload& b) {
+                             if (a.buffer != b.buffer) {
+                                 return std::less<IGPUBuffer*>{}(a.buffer, b.buffer);
+                             }
+                             return a.offset < b.offset;
+                         });
+
+        std::vector<BufferBarrierDescription> releaseBarriers;
+        std::vector<BufferCopyRegion> regions;
+        size_t first = 0;
+        while (first < pendingBufferUploads_.size()) {
+            IGPUBuffer* buffer = pendingBufferUploads_[first].buffer;
+            regions.clear();
+
+            size_t last = first;
+            while (last < pendingBufferUploads_.size()
+                   && pendingBufferUploads_[last].buffer == buffer) {
+                // NOTE: Merges uploads adjacent in both the staging ring and the buffer.
+                PendingBufferUpload run = pendingBufferUploads_[last++];
+                while (last < pendingBufferUploads_.size()) {
+                    const PendingBufferUpload& next = pendingBufferUploads_[last];
+                    if (next.buffer != buffer || next.offset != run.offset + run.size
+                        || next.stagingOffset != run.stagingOffset + run.size
+                        || next.destination.queueFamilyIndex
+                               != run.destination.queueFamilyIndex) {
+                        break;
+                    }
+                    run.size += next.size;
+                    run.destination.stageFlags = run.destination.stageFlags
+                                                 | next.destination.stageFlags;
+                    run.destination.accessFlags = run.destination.accessFlags
+                                                  | next.destination.accessFlags;
+                    ++last;
+                }
+
+                regions.push_back(
+                    {.srcOffset = run.stagingOffset, .dstOffset = run.offset, .size = run.size});
+
+                const uint32_t dstQueueFamilyIndex
+                    = run.destination.queueFamilyIndex == QUEUE_FAMILY_IGNORED
+                          ? queueFamilyIndex_
+                          : run.destination.queueFamilyIndex;
+                auto transfer = createBufferOwnershipTransfer(
+                    *buffer,
+                    {.srcQueueFamilyIndex = queueFamilyIndex_,
+                     .srcStageFlags = PipelineStage::Transfer,
+                     .srcAccessFlags = AccessType::TransferWrite,
+                     .dstQueueFamilyIndex = dstQueueFamilyIndex,
+                     .dstStageFlags = run.destination.stageFlags,
+                     .dstAccessFlags = run.destination.accessFlags},
+                    static_cast<uint32_t>(run.offset), static_cast<uint32_t>(run.size));
+                releaseBarriers.push_back(transfer.releaseBarrier);
+                if (transfer.acquireBarrier) {
+                    result.acquireBufferBarriers.push_back(*transfer.acquireBarrier);
+                }
+            }
+
+            commandBuffer.copyBuffer(*stagingBuffer_, *buffer, regions);
+            first = last;
+        }
+
+        commandBuffer.barrier({}, releaseBarriers, {});
+    }
+
+    void StagingUploader::recordImageUploads(ICommandBuffer& commandBuffer,
+                                             StagingUploadResult& result) {
+        if (pendingImageUploads_.empty()) {
+            return;
+        }
+
+        std::stable_sort(pendingImageUploads_.begin(), pendingImageUploads_.end(),
+                         [](const PendingImageUpload& a, const PendingImageUpload& b) {
+                             const auto& x = a.description;
+                             const auto& y = b.description;
+                             if (x.image != y.image) {
+                                 return std::less<IGPUImage*>{}(x.image, y.image);
+                             }
+                             if (x.mipLevel != y.mipLevel) {
+                                 return x.mipLevel < y.mipLevel;
+                             }
+                             return x.baseArrayLayer < y.baseArrayLayer;
+                         });
+
+        // NOTE: Merges consecutive layers of the same mip level and area that are adjacent in the
+        // staging ring into one region, which also shares its layout transitions.
+        const auto hasSameFlags = [](GPUImageAspectFlags a, GPUImageAspectFlags b) {
+            return !static_cast<bool>(a & ~b) && !static_cast<bool>(b & ~a);
+        };
+        std::vector<PendingImageUpload> runs;
+        for (const auto& upload : pendingImageUploads_) {
+            const auto& description = upload.description;
+            if (!runs.empty()) {
+                PendingImageUpload& run = runs.back();
+                const auto& current = run.description;
+                if (description.image == current.image && description.mipLevel == current.mipLevel
+                    && hasSameFlags(description.aspectMask, current.aspectMask)
+                    && description.baseArrayLayer == current.baseArrayLayer + current.layerCount
+                    && description.offset.x == current.offset.x
+                    && description.offset.y == current.offset.y
+                    && description.offset.z == current.offset.z
+                    && description.extent.width == current.extent.width
+                    && description.extent.height == current.extent.height
+                    && description.extent.depth == current.extent.depth
+                    && description.oldLayout == current.oldLayout
+                    && description.newLayout == current.newLayout
+                    && description.destination.queueFamilyIndex
+                           == current.destination.queueFamilyIndex
+                    && upload.stagingOffset == run.stagingOffset + run.stagingSize
+                    && upload.stagingSize * current.layerCount
+                           == run.stagingSize * description.layerCount) {
+                    run.description.layerCount += description.layerCount;
+                    run.description.destination.stageFlags
+                        = current.destination.stageFlags | description.destination.stageFlags;
+                    run.description.destination.accessFlags
+                        = current.destination.accessFlags | description.destination.accessFlags;
+                    run.stagingSize += upload.stagingSize;
+                    continue;
+                }
+            }
+            runs.push_back(upload);
+        }
+
+        std::vector<ImageBarrierDescription> preCopyBarriers;
+        std::vector<ImageBarrierDescription> releaseBarriers;
+        for (const auto& run : runs) {
+            const auto& description = run.description;
+            const GPUImageSubresourceDescription subresource{
+                .aspectMask = description.aspectMask,
+                .range = {.baseArrayLayer = description.baseArrayLayer,
+                          .layerCount = description.layerCount,
+                          .baseMipLevel = description.mipLevel,
+                          .mipLevelCount = 1}};
+
+            preCopyBarriers.push_back({.image = description.image,
+                                       .oldLayout = description.oldLayout,
+                                       .newLayout = GPUImageLayout::TransferDstOptimal,
+                                       .dstStageFlags = PipelineStage::Transfer,
+                                       .dstAccessFlags = AccessType::TransferWrite,
+                                       .subresource = subresource});
+
+            const uint32_t dstQueueFamilyIndex
+                = description.destination.queueFamilyIndex == QUEUE_FAMILY_IGNORED
+                      ? queueFamilyIndex_
+                      : description.destination.queueFamilyIndex;
+            auto transfer = createImageOwnershipTransfer(
+                *description.image, GPUImageLayout::TransferDstOptimal, description.newLayout,
+                {.srcQueueFamilyIndex = queueFamilyIndex_,
+                 .srcStageFlags = PipelineStage::Transfer,
+                 .srcAccessFlags = AccessType::TransferWrite,
+                 .dstQueueFamilyIndex = dstQueueFamilyIndex,
+                 .dstStageFlags = description.destination.stageFlags,
+                 .dstAccessFlags = description.destination.accessFlags},
+                subresource);
+            releaseBarriers.push_back(transfer.releaseBarrier);
+            if (transfer.acquireBarrier) {
+                result.acquireImageBarriers.push_back(*transfer.acquireBarrier);
+            }
+        }
+
+        commandBuffer.barrier({}, {}, preCopyBarriers);
+
+        std::vector<BufferImageCopyRegion> regions;
+        size_t first = 0;
+        while (first < runs.size()) {
+            IGPUImage* image = runs[first].description.image;
+            regions.clear();
+            for (; first < runs.size() && runs[first].description.image == image; ++first) {
+                const auto& description = runs[first].description;
+                regions.push_back({.bufferOffset = runs[first].stagingOffset,
+                                   .aspectMask = description.aspectMask,
+                                   .mipLevel = description.mipLevel,
+                                   .baseArrayLayer = description.baseArrayLayer,
+                                   .layerCount = description.layerCount,
+                                   .imageOffset = description.offset,
+                                   .imageExtent = description.extent});
+            }
+            commandBuffer.copyBufferToImage(*stagingBuffer_, *image,
+                                            GPUImageLayout::TransferDstOptimal, regions);
+        }
+
+        commandBuffer.barrier({}, {}, releaseBarriers);
+    }
+
+    std::optional<size_t> StagingUploader::tryAllocateStaging(size_t size, size_t alignment) {
+        if (stagingUsed_ == 0) {
+            stagingHead_ = 0;
+        }
+
+        size_t offset = (stagingHead_ + alignment - 1) / alignment * alignment;
+        if (offset + size > stagingCapacity_) {
+            // NOTE: Wraps around, the tail of the ring is skipped.
+            offset = 0;
+        }
+        const size_t consumed
+            = (offset >= stagingHead_ ? offset - stagingHead_ : stagingCapacity_ - stagingHead_)
+              + size;
+        if (stagingUsed_ + consumed > stagingCapacity_) {
+            return std::nullopt;
+        }
+
+        stagingHead_ = offset + size;
+        stagingUsed_ += consumed;
+        pendingStagingSize_ += consumed;
+        return offset;
+    }
+
+    size_t StagingUploader::allocateStaging(size_t size, size_t alignment) {
+        if (size > stagingCapacity_) {
+            throw(std::invalid_argument("Upload is larger than the StagingUploader capacity."));
+        }
+
+        while (true) {
+            if (auto offset = tryAllocateStaging(size, alignment)) {
+                return *offset;
+            }
+
+            if (!batches_.empty()) {
+                retireBatches(true);
+            } else if (hasPendingUploads()) {
+                // NOTE: Pending uploads alone fill the ring, submits them early.
+                StagingUploadResult submitResult = submitPendingUploads();
+                earlyResult_.token = submitResult.token;
+                earlyResult_.acquireBufferBarriers.insert(
+                    earlyResult_.acquireBufferBarriers.end(),
+                    submitResult.acquireBufferBarriers.begin(),
+                    submitResult.acquireBufferBarriers.end());
+                earlyResult_.acquireImageBarriers.insert(
+                    earlyResult_.acquireImageBarriers.end(),
+                    submitResult.acquireImageBarriers.begin(),
+                    submitResult.acquireImageBarriers.end());
+            } else {
+                throw(std::runtime_error("StagingUploader ran out of staging memory."));
+            }
+        }
+    }
+
+    void StagingUploader::retireBatches(bool waitForOldest) {
+        if (waitForOldest && !batches_.empty()) {
+            batches_.front().token.wait();
+        }
+
+        while (!batches_.empty() && batches_.front().token.isComplete()) {
+            Batch& batch = batches_.front();
+            stagingUsed_ -= batch.stagingSize;
+            batch.commandBuffer->reset();
+            freeCommandBuffers_.push_back(std::move(batch.commandBuffer));
+            batches_.pop_front();
+        }
+    }
+}  // namespace aetherion
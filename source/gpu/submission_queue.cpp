@@ -0,0 +1,148 @@
+#include "aetherion/gpu/submission_queue.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "aetherion/gpu/backend/device.hpp"
+#include "aetherion/gpu/backend/sync.hpp"
+
+namespace aetherion {
+    bool SubmissionToken::isComplete() const {
+        return timeline_ && timeline_->getCurrentValue() >= value_;
+    }
+
+    void SubmissionToken::wait(uint64_t timeout) const {
+        if (timeline_) {
+            timeline_->wait(value_, timeout);
+        }
+    }
+
+    SubmissionQueue::SubmissionQueue(IGPUDevice& device, IGPUQueue& queue)
+        : queue_(&queue), timeline_(device.createGPUTimelineSemaphore({.initialValue = 0})) {
+        submitThread_ = std::thread([this]() { submitLoop(); });
+    }
+
+    SubmissionQueue::~SubmissionQueue() noexcept {
+        stopping_.store(true, std::memory_order_release);
+        pushCount_.fetch_add(1, std::memory_order_release);
+        pushCount_.notify_one();
+
+        submitThread_.join();
+    }
+
+    SubmissionToken SubmissionQueue::submit(GPUQueueSubmitDescription description) {
+        rethrowSubmitError();
+
+        if (description.fence.has_value()) {
+            throw(std::invalid_argument(
+                "Fences are not supported by SubmissionQueue, wait on the token instead."));
+        }
+
+        // NOTE: The value is reserved right before publishing, so the submit thread only waits
+        // for late pushes for a few instructions.
+        const uint64_t timelineValue = nextValue_.fetch_add(1, std::memory_order_relaxed);
+        description.signalTimelineSemaphores.push_back({.semaphore = timeline_.get(),
+                                                        .value = timelineValue,
+                                                        .signalStage = PipelineStage::AllCommands});
+
+        // NOTE: The submit thread owns the submission as soon as it's published.
+        auto* submission = new Submission{
+            .description = std::move(description), .timelineValue = timelineValue, .next = nullptr};
+        submission->next = submissions_.load(std::memory_order_relaxed);
+        while (!submissions_.compare_exchange_weak(submission->next, submission,
+                                                   std::memory_order_release,
+                                                   std::memory_order_relaxed)) {
+        }
+
+        pushCount_.fetch_add(1, std::memory_order_release);
+        pushCount_.notify_one();
+
+        return SubmissionToken(*timeline_, timelineValue);
+    }
+
+    void SubmissionQueue::flush() {
+        const uint64_t targetValue = nextValue_.load(std::memory_order_relaxed) - 1;
+
+        uint64_t submittedValue = submittedValue_.load(std::memory_order_acquire);
+        while (submittedValue < targetValue) {
+            submittedValue_.wait(submittedValue, std::memory_order_acquire);
+            submittedValue = submittedValue_.load(std::memory_order_acquire);
+        }
+
+        rethrowSubmitError();
+    }
+
+    void SubmissionQueue::submitLoop() {
+        std::vector<Submission*> pending;
+        std::vector<GPUQueueSubmitDescription> batch;
+
+        while (true) {
+            const uint64_t pushCount = pushCount_.load(std::memory_order_acquire);
+
+            // NOTE: The stack is drained at once, so its order doesn't matter, pending submissions
+            // are sorted by value instead.
+            for (Submission* submission = submissions_.exchange(nullptr, std::memory_order_acquire);
+                 submission;) {
+                Submission* next = submission->next;
+                pending.push_back(submission);
+                submission = next;
+            }
+            std::sort(pending.begin(), pending.end(), [](const auto* a, const auto* b) {
+                return a->timelineValue < b->timelineValue;
+            });
+
+            // NOTE: Timeline signals must increase in submission order, so only the contiguous run
+            // of values after the last submitted one is ready.
+            const uint64_t submittedValue = submittedValue_.load(std::memory_order_relaxed);
+            size_t readyCount = 0;
+            while (readyCount < pending.size()
+                   && pending[readyCount]->timelineValue == submittedValue + readyCount + 1) {
+                ++readyCount;
+            }
+
+            if (readyCount > 0) {
+                batch.clear();
+                for (size_t i = 0; i < readyCount; ++i) {
+                    batch.push_back(std::move(pending[i]->description));
+                    delete pending[i];
+                }
+                pending.erase(pending.begin(), pending.begin() + readyCount);
+
+                const uint64_t lastValue = submittedValue + readyCount;
+                try {
+                    queue_->submit(batch, nullptr);
+                } catch (...) {
+                    std::lock_guard lock(errorMutex_);
+                    if (!submitError_) {
+                        submitError_ = std::current_exception();
+                    }
+
+                    // NOTE: Signaled from the host so token waits don't deadlock.
+                    try {
+                        timeline_->signal(lastValue);
+                    } catch (...) {
+                    }
+                }
+
+                submittedValue_.store(lastValue, std::memory_order_release);
+                submittedValue_.notify_all();
+                continue;
+            }
+
+            if (stopping_.load(std::memory_order_acquire) && pending.empty()) {
+                break;
+            }
+
+            pushCount_.wait(pushCount, std::memory_order_acquire);
+        }
+    }
+
+    void SubmissionQueue::rethrowSubmitError() {
+        std::lock_guard lock(errorMutex_);
+        if (submitError_) {
+            std::rethrow_exception(std::exchange(submitError_, nullptr));
+        }
+    }
+}  // namespace aetherion
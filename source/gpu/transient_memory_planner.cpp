@@ -0,0 +1,155 @@
+#include "aetherion/gpu/transient_memory_planner.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "aetherion/gpu/backend/device.hpp"
+
+namespace aetherion {
+    TransientMemoryPlanner::TransientMemoryPlanner(
+        IGPUDevice& device, IGPUAllocator& allocator,
+        const TransientMemoryPlannerDescription& description)
+        : device_(&device),
+          allocator_(&allocator),
+          allocationDescription_(description.allocationDescription),
+          aliasingEnabled_(description.aliasingEnabled) {}
+
+    TransientMemoryPlan TransientMemoryPlanner::plan(
+        std::span<const TransientImageDescription> images,
+        std::span<const TransientBufferDescription> buffers) {
+        TransientMemoryPlan plan;
+
+        std::vector<Resource> resources;
+        resources.reserve(images.size() + buffers.size());
+        for (size_t i = 0; i < images.size(); ++i) {
+            resources.push_back(
+                {.index = i,
+                 .image = true,
+                 .memoryRequirements = device_->getImageMemoryRequirements(images[i].description),
+                 .firstUse = images[i].firstUse,
+                 .lastUse = images[i].lastUse});
+        }
+        for (size_t i = 0; i < buffers.size(); ++i) {
+            resources.push_back({.index = i,
+                                 .image = false,
+                                 .memoryRequirements
+                                 = device_->getBufferMemoryRequirements(buffers[i].description),
+                                 .firstUse = buffers[i].firstUse,
+                                 .lastUse = buffers[i].lastUse});
+        }
+
+        // Statistics
+
+        for (const auto& resource : resources) {
+            if (resource.firstUse > resource.lastUse) {
+                throw(std::invalid_argument(
+                    "Transient resources must not be last used before their first use."));
+            }
+            plan.sizeWithoutAliasing += resource.memoryRequirements.size;
+        }
+
+        // NOTE: The live size only grows at first uses, so the peak is at one of them. Bounds are
+        // compared inclusively, lastUse may be the largest use.
+        for (const auto& resource : resources) {
+            size_t liveSize = 0;
+            for (const auto& other : resources) {
+                if (other.firstUse <= resource.firstUse && resource.firstUse <= other.lastUse) {
+                    liveSize += other.memoryRequirements.size;
+                }
+            }
+            plan.peakLiveSize = std::max(plan.peakLiveSize, liveSize);
+        }
+
+        // Placement
+
+        // NOTE: Largest first packs tighter, ties are broken by first use to keep it stable.
+        std::vector<Resource*> placementOrder;
+        placementOrder.reserve(resources.size());
+        for (auto& resource : resources) {
+            placementOrder.push_back(&resource);
+        }
+        std::stable_sort(placementOrder.begin(), placementOrder.end(),
+                         [](const Resource* a, const Resource* b) {
+                             if (a->memoryRequirements.size != b->memoryRequirements.size) {
+                                 return a->memoryRequirements.size > b->memoryRequirements.size;
+                             }
+                             return a->firstUse < b->firstUse;
+                         });
+
+        std::vector<Heap> heaps;
+        for (auto* resource : placementOrder) {
+            place(*resource, heaps);
+        }
+
+        // Allocation
+
+        plan.allocations.reserve(heaps.size());
+        for (const auto& heap : heaps) {
+            plan.allocations.push_back(allocator_->allocate({.size = heap.size,
+                                                             .alignment = heap.alignment,
+                                                             .memoryTypeBits = heap.memoryTypeBits},
+                                                            allocationDescription_));
+            plan.sizeWithAliasing += heap.size;
+        }
+
+        plan.images.resize(images.size());
+        plan.buffers.resize(buffers.size());
+        for (const auto& resource : resources) {
+            auto& allocation = *plan.allocations[resource.heap];
+            if (resource.image) {
+                plan.images[resource.index] = allocator_->createAliasedImage(
+                    allocation, images[resource.index].description, resource.offset);
+            } else {
+                plan.buffers[resource.index] = allocator_->createAliasedBuffer(
+                    allocation, buffers[resource.index].description, resource.offset);
+            }
+        }
+
+        return plan;
+    }
+
+    void TransientMemoryPlanner::place(Resource& resource, std::vector<Heap>& heaps) const {
+        const auto& requirements = resource.memoryRequirements;
+
+        auto heap = std::find_if(heaps.begin(), heaps.end(), [&](const Heap& heap) {
+            return heap.image == resource.image
+                   && (heap.memoryTypeBits & requirements.memoryTypeBits) != 0;
+        });
+        if (heap == heaps.end()) {
+            heaps.push_back({.image = resource.image,
+                             .memoryTypeBits = requirements.memoryTypeBits,
+                             .resources = {}});
+            heap = std::prev(heaps.end());
+        }
+
+        // NOTE: Ranges of resources alive at the same time, the resource goes in the first gap
+        // that fits, or past the last one.
+        std::vector<std::pair<size_t, size_t>> occupiedRanges;
+        for (const auto* placed : heap->resources) {
+            const bool overlapsInTime
+                = placed->firstUse <= resource.lastUse && resource.firstUse <= placed->lastUse;
+            if (!aliasingEnabled_ || overlapsInTime) {
+                occupiedRanges.emplace_back(placed->offset,
+                                            placed->offset + placed->memoryRequirements.size);
+            }
+        }
+        std::sort(occupiedRanges.begin(), occupiedRanges.end());
+
+        const size_t alignment = std::max(requirements.alignment, size_t(1));
+        size_t offset = 0;
+        for (const auto& [begin, end] : occupiedRanges) {
+            if (offset + requirements.size <= begin) {
+                break;
+            }
+            offset = std::max(offset, (end + alignment - 1) / alignment * alignment);
+        }
+
+        resource.heap = static_cast<size_t>(heap - heaps.begin());
+        resource.offset = offset;
+
+        heap->memoryTypeBits &= requirements.memoryTypeBits;
+        heap->alignment = std::max(heap->alignment, alignment);
+        heap->size = std::max(heap->size, offset + requirements.size);
+        heap->resources.push_back(&resource);
+    }
+}  // namespace aetherion
@@ -0,0 +1,106 @@
+#include "aetherion/gpu/transient_ring_buffer.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <stdexcept>
+
+#include "aetherion/gpu/backend/sync.hpp"
+
+namespace aetherion {
+    TransientRingBuffer::TransientRingBuffer(IGPUAllocator& allocator,
+                                             IGPUTimelineSemaphore& timeline,
+                                             const TransientRingBufferDescription& description)
+        : timeline_(&timeline),
+          frameCapacity_(description.frameCapacity),
+          minAlignment_(description.minAlignment),
+          frames_(std::make_unique<Frame[]>(description.framesInFlight)),
+          framesInFlight_(description.framesInFlight) {
+        if (framesInFlight_ == 0) {
+            throw(std::invalid_argument(
+                "framesInFlight in TransientRingBufferDescription must be greater than zero."));
+        }
+        if (!std::has_single_bit(minAlignment_)) {
+            throw(std::invalid_argument(
+                "minAlignment in TransientRingBufferDescription must be a power of two."));
+        }
+
+        for (uint32_t i = 0; i < framesInFlight_; ++i) {
+            Frame& frame = frames_[i];
+            frame.buffer = allocator.createBuffer(
+                {.size = frameCapacity_,
+                 .usages = description.usages,
+                 .sharingMode = SharingMode::Exclusive,
+                 .queueFamilies = {}},
+                {.properties = AllocationProperty::Mapped | AllocationProperty::SequentialAccess,
+                 .memoryUsage = description.memoryUsage});
+
+            frame.mappedData = frame.buffer->getMappedSpan();
+            if (frame.mappedData.empty()) {
+                throw(std::runtime_error("TransientRingBuffer memory couldn't be mapped."));
+            }
+            if (description.usages.contains(GPUBufferUsage::ShaderDeviceAddress)) {
+                frame.deviceAddress = frame.buffer->getDeviceAddress();
+            }
+        }
+    }
+
+    TransientRingBuffer::~TransientRingBuffer() noexcept {
+        // NOTE: Buffers can't be destroyed while the GPU still reads them.
+        uint64_t lastTimelineValue = 0;
+        for (uint32_t i = 0; i < framesInFlight_; ++i) {
+            lastTimelineValue = std::max(lastTimelineValue, frames_[i].timelineValue);
+        }
+
+        try {
+            timeline_->wait(lastTimelineValue, std::numeric_limits<uint64_t>::max());
+        } catch (...) {
+        }
+    }
+
+    void TransientRingBuffer::beginFrame() {
+        frameIndex_ = static_cast<uint32_t>(frameCount_ % framesInFlight_);
+        ++frameCount_;
+
+        Frame& frame = frames_[frameIndex_];
+        timeline_->wait(frame.timelineValue, std::numeric_limits<uint64_t>::max());
+        frame.offset.store(0, std::memory_order_relaxed);
+    }
+
+    void TransientRingBuffer::endFrame(uint64_t timelineValue) {
+        Frame& frame = frames_[frameIndex_];
+        frame.timelineValue = timelineValue;
+
+        const size_t usedSize = std::min(frame.offset.load(std::memory_order_acquire),
+                                         frameCapacity_);
+        if (usedSize > 0) {
+            frame.buffer->flush(0, usedSize);
+        }
+    }
+
+    TransientAllocation TransientRingBuffer::allocate(size_t size, size_t alignment) {
+        if (alignment != 0 && !std::has_single_bit(alignment)) {
+            throw(std::invalid_argument("Transient allocation alignment must be a power of two."));
+        }
+        alignment = std::max(alignment, minAlignment_);
+
+        Frame& frame = frames_[frameIndex_];
+
+        size_t offset = frame.offset.load(std::memory_order_relaxed);
+        size_t alignedOffset;
+        do {
+            alignedOffset = (offset + alignment - 1) & ~(alignment - 1);
+            if (size > frameCapacity_ || alignedOffset > frameCapacity_ - size) {
+                throw(std::runtime_error("TransientRingBuffer frame capacity exceeded."));
+            }
+        } while (!frame.offset.compare_exchange_weak(offset, alignedOffset + size,
+                                                     std::memory_order_acq_rel,
+                                                     std::memory_order_relaxed));
+
+        return {.buffer = frame.buffer.get(),
+                .offset = alignedOffset,
+                .size = size,
+                .data = frame.mappedData.subspan(alignedOffset, size),
+                .deviceAddress = frame.deviceAddress ? frame.deviceAddress + alignedOffset : 0};
+    }
+}  // namespace aetherion
@@ -0,0 +1,381 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "aetherion/gpu/backend/buffer.hpp"
+#include "aetherion/gpu/backend/command_buffer.hpp"
+#include "aetherion/gpu/backend/descriptor_set.hpp"
+#include "aetherion/gpu/backend/device.hpp"
+#include "aetherion/gpu/backend/image.hpp"
+#include "aetherion/gpu/backend/memory.hpp"
+#include "aetherion/gpu/backend/query_pool.hpp"
+#include "aetherion/gpu/backend/queue.hpp"
+#include "aetherion/gpu/backend/sync.hpp"
+
+// NOTE: Backend fakes for testing engine services without a GPU. Only what the tested services
+// call is implemented, everything else throws.
+namespace aetherion::test {
+    [[noreturn]] inline void notImplemented() {
+        throw(std::logic_error("Not implemented by the fake GPU backend."));
+    }
+
+    class FakeGPUAllocation : public IGPUAllocation {
+      public:
+        explicit FakeGPUAllocation(size_t size) : size(size) {}
+
+        size_t size;
+    };
+
+    class FakeGPUImage : public IGPUImage {
+      public:
+        FakeGPUImage(const FakeGPUAllocation* allocation, size_t offset)
+            : allocation(allocation), offset(offset) {}
+
+        const FakeGPUAllocation* allocation;
+        size_t offset;
+    };
+
+    class FakeGPUBuffer : public IGPUBuffer {
+      public:
+        FakeGPUBuffer(const FakeGPUAllocation* allocation, size_t offset, size_t size)
+            : allocation(allocation), offset(offset), size(size) {}
+
+        void* map() override { notImplemented(); }
+        void unmap() override { notImplemented(); }
+        std::span<std::byte> getMappedSpan() override { return {}; }
+        void flush(size_t, size_t) override {}
+        void invalidate(size_t, size_t) override {}
+        size_t getSize() const override { return size; }
+        uint64_t getDeviceAddress() const override { notImplemented(); }
+
+        const FakeGPUAllocation* allocation;
+        size_t offset;
+        size_t size;
+    };
+
+    class FakeGPUTimelineSemaphore : public IGPUTimelineSemaphore {
+      public:
+        explicit FakeGPUTimelineSemaphore(uint64_t value) : value(value) {}
+
+        void wait(uint64_t, uint64_t) override {}
+        void signal(uint64_t value) override { this->value = value; }
+        uint64_t getCurrentValue() const override { return value; }
+
+        uint64_t value;
+    };
+
+    // NOTE: Records the submissions in order.
+    class FakeGPUQueue : public IGPUQueue {
+      public:
+        void submit(std::span<GPUQueueSubmitDescription> submitDescriptions, IGPUFence*) override {
+            submissions.insert(submissions.end(), submitDescriptions.begin(),
+                               submitDescriptions.end());
+        }
+        std::pair<QueuePresentResultCode, std::vector<QueuePresentResultCode>> present(
+            const GPUQueuePresentDescription&) override {
+            notImplemented();
+        }
+        void waitIdle() override {}
+
+        std::vector<GPUQueueSubmitDescription> submissions;
+    };
+
+    // NOTE: Buffers need their size in memory, images 4 bytes per texel, both in any of two memory
+    // types.
+    class FakeGPUDevice : public IGPUDevice {
+      public:
+        static constexpr size_t BUFFER_ALIGNMENT = 256;
+        static constexpr size_t IMAGE_ALIGNMENT = 4096;
+
+        void waitIdle() override {}
+        void savePipelineCache() override {}
+        void setDeferredDestructionValue(uint64_t) override {}
+        void collectDeferredDestructions(uint64_t) override {}
+        bool supportsBindlessDescriptors() const override { return false; }
+        bool usesDescriptorBuffers() const override { return false; }
+        float getTimestampPeriod() const override { return 0.0f; }
+
+        std::unique_ptr<ICommandPool> createCommandPool(const CommandPoolDescription&) override {
+            notImplemented();
+        }
+        std::unique_ptr<ICommandBuffer> allocateCommandBuffer(
+            ICommandPool&, const CommandGPUBufferDescription&) override {
+            notImplemented();
+        }
+        std::vector<std::unique_ptr<ICommandBuffer>> allocateCommandBuffers(
+            ICommandPool&, uint32_t, const CommandGPUBufferDescription&) override {
+            notImplemented();
+        }
+        void freeCommandBuffers(ICommandPool&,
+                                std::span<std::reference_wrapper<ICommandBuffer>>) override {
+            notImplemented();
+        }
+
+        std::unique_ptr<IGPUAllocator> createAllocator(const GPUAllocatorDescription&) override {
+            notImplemented();
+        }
+        std::unique_ptr<IGPUBuffer> createBuffer(const GPUBufferDescription&) override {
+            notImplemented();
+        }
+        std::unique_ptr<IGPUBufferView> createBufferView(const GPUBufferViewDescription&) override {
+            notImplemented();
+        }
+        std::unique_ptr<IGPUImage> createImage(const GPUImageDescription&) override {
+            notImplemented();
+        }
+
+        GPUAllocationMemoryRequirementsDescription getBufferMemoryRequirements(
+            const GPUBufferDescription& description) const override {
+            return {.size = description.size,
+                    .alignment = BUFFER_ALIGNMENT,
+                    .memoryTypeBits = 0b11};
+        }
+        GPUAllocationMemoryRequirementsDescription getImageMemoryRequirements(
+            const GPUImageDescription& description) const override {
+            return {.size = size_t(description.extent.width) * description.extent.height
+                            * std::max(description.extent.depth, 1u) * description.arrayLayers
+                            * 4,
+                    .alignment = IMAGE_ALIGNMENT,
+                    .memoryTypeBits = 0b11};
+        }
+
+        std::unique_ptr<IGPUImageView> createImageView(const GPUImageViewDescription&) override {
+            notImplemented();
+        }
+        std::unique_ptr<ISampler> createSampler(const SamplerDescription&) override {
+            notImplemented();
+        }
+        std::unique_ptr<IShader> createShader(const ShaderDescription&) override {
+            notImplemented();
+        }
+        std::unique_ptr<IPipelineLayout> createPipelineLayout(
+            const PipelineLayoutDescription&) override {
+            notImplemented();
+        }
+        std::shared_ptr<IPipelineLayout> getOrCreatePipelineLayout(
+            const PipelineLayoutDescription&) override {
+            notImplemented();
+        }
+        std::unique_ptr<IPipeline> createComputePipeline(
+            const ComputePipelineDescription&) override {
+            notImplemented();
+        }
+        std::unique_ptr<IPipeline> createGraphicsPipeline(
+            const GraphicsPipelineDescription&) override {
+            notImplemented();
+        }
+        std::unique_ptr<IDescriptorSetLayout> createDescriptorSetLayout(
+            const DescriptorSetLayoutDescription&) override {
+            notImplemented();
+        }
+        std::shared_ptr<IDescriptorSetLayout> getOrCreateDescriptorSetLayout(
+            const DescriptorSetLayoutDescription&) override {
+            notImplemented();
+        }
+        std::unique_ptr<IDescriptorPool> createDescriptorPool(
+            const DescriptorPoolDescription&) override {
+            notImplemented();
+        }
+        std::unique_ptr<IPushConstantRange> createPushConstantRange(
+            const PushConstantRangeDescription&) override {
+            notImplemented();
+        }
+        std::unique_ptr<ISwapchain> createSwapchain(const SwapchainDescription&) override {
+            notImplemented();
+        }
+        std::unique_ptr<IGPUFence> createGPUFence(const GPUFenceDescription&) override {
+            notImplemented();
+        }
+        std::unique_ptr<IGPUBinarySemaphore> createGPUBinarySemaphore(
+            const GPUBinarySemaphoreDescription&) override {
+            notImplemented();
+        }
+        std::unique_ptr<IGPUTimelineSemaphore> createGPUTimelineSemaphore(
+            const GPUTimelineSemaphoreDescription& description) override {
+            return std::make_unique<FakeGPUTimelineSemaphore>(description.initialValue);
+        }
+        std::unique_ptr<IQueryPool> createQueryPool(const QueryPoolDescription&) override {
+            notImplemented();
+        }
+        std::unique_ptr<IGPUQueue> getQueue(const GPUQueueDescription&) override {
+            notImplemented();
+        }
+
+        std::unique_ptr<IDescriptorSet> allocateDescriptorSet(
+            IDescriptorPool&, const DescriptorSetDescription&) override {
+            notImplemented();
+        }
+        std::vector<std::unique_ptr<IDescriptorSet>> allocateDescriptorSets(
+            IDescriptorPool&, std::span<const DescriptorSetDescription>) override {
+            notImplemented();
+        }
+        void freeDescriptorSets(IDescriptorPool&,
+                                std::span<std::reference_wrapper<IDescriptorSet>>) override {
+            notImplemented();
+        }
+        void updateDescriptorSets(std::span<const DescriptorWriteDescription>,
+                                  std::span<const DescriptorCopyDescription>) override {
+            notImplemented();
+        }
+        std::unique_ptr<IDescriptorUpdateTemplate> createDescriptorUpdateTemplate(
+            const DescriptorUpdateTemplateDescription&) override {
+            notImplemented();
+        }
+        PackedDescriptor packImageDescriptor(IGPUImageView*, ISampler*, GPUImageLayout) override {
+            notImplemented();
+        }
+        PackedDescriptor packBufferDescriptor(IGPUBuffer&, size_t, size_t) override {
+            notImplemented();
+        }
+        PackedDescriptor packTexelBufferDescriptor(IGPUBufferView&) override { notImplemented(); }
+        void updateDescriptorSetWithTemplate(IDescriptorSet&, IDescriptorUpdateTemplate&,
+                                             const void*) override {
+            notImplemented();
+        }
+    };
+
+    // NOTE: Allocations and aliased resources remember their size and placement.
+    class FakeGPUAllocator : public IGPUAllocator {
+      public:
+        std::unique_ptr<IGPUAllocatorPool> createPool(const GPUAllocatorPoolDescription&) override {
+            notImplemented();
+        }
+
+        std::unique_ptr<IGPUAllocation> allocate(
+            const GPUAllocationMemoryRequirementsDescription& memoryRequirements,
+            const GPUAllocationDescription&) override {
+            return std::make_unique<FakeGPUAllocation>(memoryRequirements.size);
+        }
+
+        std::unique_ptr<IGPUAllocation> allocateForImage(IGPUImage&,
+                                                         const GPUAllocationDescription&) override {
+            notImplemented();
+        }
+        std::unique_ptr<IGPUAllocation> allocateForBuffer(
+            IGPUBuffer&, const GPUAllocationDescription&) override {
+            notImplemented();
+        }
+        std::unique_ptr<IGPUImage> createImage(const GPUImageDescription&,
+                                               const GPUAllocationDescription&) override {
+            notImplemented();
+        }
+        std::unique_ptr<IGPUBuffer> createBuffer(const GPUBufferDescription&,
+                                                 const GPUAllocationDescription&) override {
+            notImplemented();
+        }
+
+        std::unique_ptr<IGPUImage> createAliasedImage(IGPUAllocation& allocation,
+                                                      const GPUImageDescription&,
+                                                      size_t offset) override {
+            return std::make_unique<FakeGPUImage>(static_cast<FakeGPUAllocation*>(&allocation),
+                                                  offset);
+        }
+        std::unique_ptr<IGPUBuffer> createAliasedBuffer(IGPUAllocation& allocation,
+                                                        const GPUBufferDescription& description,
+                                                        size_t offset) override {
+            return std::make_unique<FakeGPUBuffer>(static_cast<FakeGPUAllocation*>(&allocation),
+                                                   offset, description.size);
+        }
+
+        std::vector<GPUMemoryHeapBudget> getHeapBudgets() const override { return {}; }
+        void setCurrentFrameIndex(uint32_t) override {}
+
+        std::unique_ptr<IGPUDefragmenter> createDefragmenter(
+            const GPUDefragmenterDescription&) override {
+            notImplemented();
+        }
+    };
+
+    // NOTE: Records the executed render graph passes and barriers in order.
+    class FakeCommandBuffer : public ICommandBuffer {
+      public:
+        struct Barrier {
+            std::vector<GeneralMemoryBarrierDescription> generalBarriers;
+            std::vector<BufferBarrierDescription> bufferBarriers;
+            std::vector<ImageBarrierDescription> imageBarriers;
+        };
+
+        struct Command {
+            std::string pass;  // NOTE: Empty for barriers.
+            Barrier barrier = {};
+        };
+
+        void begin(CommandBufferUsageFlags) override {}
+        void begin(CommandBufferUsageFlags, const CommandBufferInheritanceDescription&) override {}
+        void reset(bool) override { commands.clear(); }
+        void end() override {}
+
+        void beginRendering(const RenderDescription&) override { notImplemented(); }
+        void endRendering() override { notImplemented(); }
+        void executeCommands(std::span<std::reference_wrapper<ICommandBuffer>>) override {
+            notImplemented();
+        }
+
+        void draw(uint32_t, uint32_t, uint32_t, uint32_t) override { notImplemented(); }
+        void drawIndexed(uint32_t, uint32_t, uint32_t, uint32_t, uint32_t) override {
+            notImplemented();
+        }
+        void dispatchCompute(uint32_t, uint32_t, uint32_t) override { notImplemented(); }
+
+        void setViewport(Rect2Df, float, float) override { notImplemented(); }
+        void setScissor(Rect2Di) override { notImplemented(); }
+
+        void clear(IGPUImage&, GPUImageLayout, const std::vector<GPUImageRangeDescription>&,
+                   const ClearValue&) override {
+            notImplemented();
+        }
+
+        void bindPipeline(IPipeline&) override { notImplemented(); }
+        void bindDescriptorSets(IPipelineLayout&, PipelineBindPoint, uint32_t,
+                                std::span<std::reference_wrapper<IDescriptorSet>>,
+                                std::span<const uint32_t>) override {
+            notImplemented();
+        }
+        void pushDescriptorSet(IPipelineLayout&, PipelineBindPoint, uint32_t,
+                               std::span<const DescriptorWriteDescription>) override {
+            notImplemented();
+        }
+        void pushConstantRange(IPipelineLayout&, IPushConstantRange&,
+                               std::span<const std::byte>) override {
+            notImplemented();
+        }
+
+        void bindVertexBuffers(uint32_t, uint32_t,
+                               std::span<const VertexBufferBindingDescription>) override {
+            notImplemented();
+        }
+        void bindIndexBuffer(IGPUBuffer&, size_t, IndexType) override { notImplemented(); }
+
+        void copyBuffer(IGPUBuffer&, IGPUBuffer&, const std::vector<BufferCopyRegion>&) override {
+            notImplemented();
+        }
+        void copyBufferToImage(IGPUBuffer&, IGPUImage&, GPUImageLayout,
+                               std::span<const BufferImageCopyRegion>) override {
+            notImplemented();
+        }
+
+        void barrier(std::span<const GeneralMemoryBarrierDescription> generalBarriers,
+                     std::span<const BufferBarrierDescription> bufferBarriers,
+                     std::span<const ImageBarrierDescription> imageBarriers) override {
+            commands.push_back(
+                {.pass = {},
+                 .barrier = {.generalBarriers = {generalBarriers.begin(), generalBarriers.end()},
+                             .bufferBarriers = {bufferBarriers.begin(), bufferBarriers.end()},
+                             .imageBarriers = {imageBarriers.begin(), imageBarriers.end()}}});
+        }
+
+        void resetQueryPool(IQueryPool&, uint32_t, uint32_t) override { notImplemented(); }
+        void writeTimestamp(IQueryPool&, PipelineStage, uint32_t) override { notImplemented(); }
+
+        void markPass(std::string pass) { commands.push_back({.pass = std::move(pass)}); }
+
+        std::vector<Command> commands;
+    };
+}  // namespace aetherion::test
@@ -0,0 +1,419 @@
+#include <doctest/doctest.h>
+
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "aetherion/gpu/rendering/render_graph.hpp"
+#include "fake_gpu.hpp"
+
+using namespace aetherion;
+using namespace aetherion::test;
+
+namespace {
+    GPUImageDescription colorImage() {
+        return {.format = Format::R8G8B8A8Unorm,
+                .extent = {.width = 64, .height = 64, .depth = 1},
+                .mipLevels = 1,
+                .arrayLayers = 1,
+                .usages = GPUImageUsage::ColorAttachment | GPUImageUsage::Sampled,
+                .sharingMode = SharingMode::Exclusive,
+                .queueFamilies = {}};
+    }
+
+    GPUBufferDescription storageBuffer() {
+        return {.size = 1024,
+                .usages = GPUBufferUsage::Storage,
+                .sharingMode = SharingMode::Exclusive,
+                .queueFamilies = {}};
+    }
+
+    RenderGraphExecuteFunctor markPass(std::string name) {
+        return [name](ICommandBuffer& commandBuffer, const RenderGraph&) {
+            static_cast<FakeCommandBuffer&>(commandBuffer).markPass(name);
+        };
+    }
+
+    template <typename Enum>
+    bool sameFlags(EnumFlags<Enum> flags, std::type_identity_t<EnumFlags<Enum>> expected) {
+        return !(flags & ~expected) && !(expected & ~flags);
+    }
+
+    constexpr uint32_t GRAPHICS_FAMILY = 0;
+    constexpr uint32_t COMPUTE_FAMILY = 1;
+
+    RenderGraphDescription asyncComputeGraph() {
+        return {.transientMemory = {},
+                .graphicsQueueFamilyIndex = GRAPHICS_FAMILY,
+                .computeQueueFamilyIndex = COMPUTE_FAMILY};
+    }
+
+    // NOTE: Hands out a new command buffer for every submission.
+    struct FakeSubmission {
+        FakeGPUQueue graphicsQueue;
+        FakeGPUQueue computeQueue;
+        std::deque<FakeCommandBuffer> commandBuffers;
+
+        RenderGraphSubmitDescription getDescription() {
+            return {.graphicsQueue = &graphicsQueue,
+                    .computeQueue = &computeQueue,
+                    .acquireCommandBuffer = [this](RenderGraphQueue) -> ICommandBuffer& {
+                        return commandBuffers.emplace_back();
+                    }};
+        }
+    };
+
+    const FakeCommandBuffer& getCommandBuffer(const GPUQueueSubmitDescription& submission) {
+        REQUIRE(submission.commandBuffers.size() == 1);
+        return static_cast<const FakeCommandBuffer&>(*submission.commandBuffers[0]);
+    }
+
+    std::vector<std::string> getPasses(const FakeCommandBuffer& commandBuffer) {
+        std::vector<std::string> passes;
+        for (const auto& command : commandBuffer.commands) {
+            if (!command.pass.empty()) {
+                passes.push_back(command.pass);
+            }
+        }
+        return passes;
+    }
+}  // namespace
+
+TEST_CASE("RenderGraph culls passes whose writes are never read") {
+    FakeGPUDevice device;
+    FakeGPUAllocator allocator;
+    RenderGraph graph(device, allocator);
+
+    FakeGPUImage target(nullptr, 0);
+    const auto output = graph.importImage(target, {});
+    const auto unused = graph.createImage(colorImage());
+    const auto unusedChain = graph.createImage(colorImage());
+    const auto intermediate = graph.createImage(colorImage());
+    const auto readback = graph.createBuffer(storageBuffer());
+
+    graph.addPass("unused", {}).write(unused, RenderGraphAccess::ColorAttachmentWrite);
+    graph.addPass("unused producer", {})
+        .write(unusedChain, RenderGraphAccess::ComputeShaderStorageWrite);
+    graph.addPass("unused consumer", {})
+        .read(unusedChain, RenderGraphAccess::FragmentShaderRead)
+        .write(unused, RenderGraphAccess::ColorAttachmentWrite);
+    graph.addPass("producer", {}).write(intermediate, RenderGraphAccess::ColorAttachmentWrite);
+    graph.addPass("consumer", {})
+        .read(intermediate, RenderGraphAccess::FragmentShaderRead)
+        .write(output, RenderGraphAccess::ColorAttachmentWrite);
+    graph.addPass("readback", {})
+        .write(readback, RenderGraphAccess::TransferWrite)
+        .setSideEffects();
+
+    graph.compile();
+
+    CHECK(graph.isPassCulled(0));
+    CHECK(graph.isPassCulled(1));
+    CHECK(graph.isPassCulled(2));
+    CHECK_FALSE(graph.isPassCulled(3));
+    CHECK_FALSE(graph.isPassCulled(4));
+    CHECK_FALSE(graph.isPassCulled(5));
+    CHECK(graph.getSubmissionCount() == 1);
+
+    // NOTE: Transient resources only used by culled passes aren't created.
+    CHECK_THROWS_AS(graph.getImage(unused), std::runtime_error);
+    CHECK_THROWS_AS(graph.getImage(unusedChain), std::runtime_error);
+    CHECK_NOTHROW(graph.getImage(intermediate));
+    CHECK_NOTHROW(graph.getBuffer(readback));
+    CHECK(graph.getTransientMemoryPlan().images.size() == 1);
+    CHECK(graph.getTransientMemoryPlan().buffers.size() == 1);
+}
+
+TEST_CASE("RenderGraph transitions image layouts before each pass") {
+    FakeGPUDevice device;
+    FakeGPUAllocator allocator;
+    RenderGraph graph(device, allocator);
+
+    FakeGPUImage target(nullptr, 0);
+    const auto image = graph.importImage(target, {});
+
+    graph.addPass("draw", markPass("draw"))
+        .write(image, RenderGraphAccess::ColorAttachmentWrite);
+    graph.addPass("sample", markPass("sample"))
+        .read(image, RenderGraphAccess::FragmentShaderRead)
+        .setSideEffects();
+    graph.compile();
+
+    FakeCommandBuffer commandBuffer;
+    graph.execute(commandBuffer);
+
+    const auto& commands = commandBuffer.commands;
+    REQUIRE(commands.size() == 4);
+    CHECK(commands[1].pass == "draw");
+    CHECK(commands[3].pass == "sample");
+
+    const auto& first = commands[0].barrier;
+    CHECK(first.generalBarriers.empty());
+    REQUIRE(first.imageBarriers.size() == 1);
+    CHECK(first.imageBarriers[0].image == &target);
+    CHECK(first.imageBarriers[0].oldLayout == GPUImageLayout::Undefined);
+    CHECK(first.imageBarriers[0].newLayout == GPUImageLayout::ColorAttachmentOptimal);
+
+    const auto& second = commands[2].barrier;
+    CHECK(second.generalBarriers.empty());
+    REQUIRE(second.imageBarriers.size() == 1);
+    const auto& transition = second.imageBarriers[0];
+    CHECK(transition.image == &target);
+    CHECK(transition.oldLayout == GPUImageLayout::ColorAttachmentOptimal);
+    CHECK(transition.newLayout == GPUImageLayout::ShaderReadOnlyOptimal);
+    CHECK(sameFlags(transition.srcStageFlags, PipelineStage::ColorAttachmentOutput));
+    CHECK(sameFlags(transition.srcAccessFlags, AccessType::ColorAttachmentWrite));
+    CHECK(sameFlags(transition.dstStageFlags, PipelineStage::FragmentShader));
+    CHECK(sameFlags(transition.dstAccessFlags, AccessType::ShaderRead));
+}
+
+TEST_CASE("RenderGraph merges buffer hazards into a memory barrier") {
+    FakeGPUDevice device;
+    FakeGPUAllocator allocator;
+    RenderGraph graph(device, allocator);
+
+    FakeGPUBuffer vertices(nullptr, 0, 1024);
+    const auto buffer = graph.importBuffer(vertices, {});
+
+    graph.addPass("upload", markPass("upload"))
+        .write(buffer, RenderGraphAccess::TransferWrite);
+    graph.addPass("draw", markPass("draw"))
+        .read(buffer, RenderGraphAccess::VertexBuffer)
+        .setSideEffects();
+    // NOTE: The upload is already visible to vertex input, no second barrier.
+    graph.addPass("draw again", markPass("draw again"))
+        .read(buffer, RenderGraphAccess::VertexBuffer)
+        .setSideEffects();
+    graph.compile();
+
+    FakeCommandBuffer commandBuffer;
+    graph.execute(commandBuffer);
+
+    const auto& commands = commandBuffer.commands;
+    REQUIRE(commands.size() == 4);
+    CHECK(commands[0].pass == "upload");
+    CHECK(commands[2].pass == "draw");
+    CHECK(commands[3].pass == "draw again");
+
+    const auto& barrier = commands[1].barrier;
+    CHECK(commands[1].pass.empty());
+    CHECK(barrier.bufferBarriers.empty());
+    CHECK(barrier.imageBarriers.empty());
+    REQUIRE(barrier.generalBarriers.size() == 1);
+    CHECK(sameFlags(barrier.generalBarriers[0].srcStageFlags, PipelineStage::Transfer));
+    CHECK(sameFlags(barrier.generalBarriers[0].srcAccessFlags, AccessType::TransferWrite));
+    CHECK(sameFlags(barrier.generalBarriers[0].dstStageFlags, PipelineStage::VertexInput));
+    CHECK(sameFlags(barrier.generalBarriers[0].dstAccessFlags, AccessType::VertexAttributeRead));
+}
+
+TEST_CASE("RenderGraph waits for reads before overwriting a buffer") {
+    FakeGPUDevice device;
+    FakeGPUAllocator allocator;
+    RenderGraph graph(device, allocator);
+
+    FakeGPUBuffer vertices(nullptr, 0, 1024);
+    const auto buffer = graph.importBuffer(vertices, {});
+
+    graph.addPass("draw", markPass("draw"))
+        .read(buffer, RenderGraphAccess::VertexBuffer)
+        .setSideEffects();
+    graph.addPass("upload", markPass("upload"))
+        .write(buffer, RenderGraphAccess::TransferWrite);
+    graph.compile();
+
+    FakeCommandBuffer commandBuffer;
+    graph.execute(commandBuffer);
+
+    const auto& commands = commandBuffer.commands;
+    REQUIRE(commands.size() == 3);
+    CHECK(commands[0].pass == "draw");
+    CHECK(commands[2].pass == "upload");
+
+    // NOTE: Write after read only needs an execution dependency.
+    const auto& barrier = commands[1].barrier;
+    REQUIRE(barrier.generalBarriers.size() == 1);
+    CHECK(sameFlags(barrier.generalBarriers[0].srcStageFlags, PipelineStage::VertexInput));
+    CHECK_FALSE(barrier.generalBarriers[0].srcAccessFlags);
+    CHECK(sameFlags(barrier.generalBarriers[0].dstStageFlags, PipelineStage::Transfer));
+    CHECK(sameFlags(barrier.generalBarriers[0].dstAccessFlags, AccessType::TransferWrite));
+}
+
+TEST_CASE("RenderGraph submits async compute passes to the compute queue") {
+    FakeGPUDevice device;
+    FakeGPUAllocator allocator;
+    RenderGraph graph(device, allocator, asyncComputeGraph());
+
+    FakeGPUImage target(nullptr, 0);
+    const auto output = graph.importImage(target, {});
+    const auto scratch = graph.createBuffer(storageBuffer());
+    const auto particles = graph.createBuffer(storageBuffer());
+
+    graph.addPass("prepare", markPass("prepare"))
+        .write(scratch, RenderGraphAccess::ComputeShaderStorageWrite)
+        .setQueue(RenderGraphQueue::AsyncCompute);
+    graph.addPass("simulate", markPass("simulate"))
+        .read(scratch, RenderGraphAccess::ComputeShaderStorageRead)
+        .write(particles, RenderGraphAccess::ComputeShaderStorageWrite)
+        .setQueue(RenderGraphQueue::AsyncCompute);
+    graph.addPass("draw", markPass("draw"))
+        .read(particles, RenderGraphAccess::VertexShaderRead)
+        .write(output, RenderGraphAccess::ColorAttachmentWrite);
+    graph.compile();
+
+    // NOTE: The graphics queue starts and ends the graph, around the compute submission.
+    CHECK(graph.getSubmissionCount() == 3);
+    FakeCommandBuffer commandBuffer;
+    CHECK_THROWS_AS(graph.execute(commandBuffer), std::runtime_error);
+
+    FakeSubmission submission;
+    graph.submit(submission.getDescription());
+
+    const auto& graphicsSubmissions = submission.graphicsQueue.submissions;
+    const auto& computeSubmissions = submission.computeQueue.submissions;
+    REQUIRE(graphicsSubmissions.size() == 2);
+    REQUIRE(computeSubmissions.size() == 1);
+    CHECK(getPasses(getCommandBuffer(graphicsSubmissions[0])).empty());
+    CHECK(getPasses(getCommandBuffer(computeSubmissions[0]))
+          == std::vector<std::string>{"prepare", "simulate"});
+    CHECK(getPasses(getCommandBuffer(graphicsSubmissions[1])) == std::vector<std::string>{"draw"});
+
+    // NOTE: Transient resources only used by async compute wait for compute accesses only, a
+    // compute queue doesn't support graphics stages.
+    constexpr PipelineStageFlags computeStages = PipelineStage::ComputeShader
+                                                 | PipelineStage::Transfer;
+    for (const auto& command : getCommandBuffer(computeSubmissions[0]).commands) {
+        for (const auto& barrier : command.barrier.generalBarriers) {
+            CHECK_FALSE(barrier.srcStageFlags & ~computeStages);
+            CHECK_FALSE(barrier.dstStageFlags & ~computeStages);
+        }
+        for (const auto& barrier : command.barrier.bufferBarriers) {
+            CHECK_FALSE(barrier.srcStageFlags & ~computeStages);
+            CHECK_FALSE(barrier.dstStageFlags & ~computeStages);
+        }
+    }
+
+    const auto& prepareBarrier = getCommandBuffer(computeSubmissions[0]).commands[0];
+    CHECK(prepareBarrier.pass.empty());
+    REQUIRE(prepareBarrier.barrier.generalBarriers.size() == 1);
+    CHECK(sameFlags(prepareBarrier.barrier.generalBarriers[0].srcStageFlags,
+                    PipelineStage::ComputeShader));
+    CHECK(sameFlags(prepareBarrier.barrier.generalBarriers[0].srcAccessFlags,
+                    AccessType::ShaderWrite));
+}
+
+TEST_CASE("RenderGraph waits on the timeline of the other queue for shared resources") {
+    FakeGPUDevice device;
+    FakeGPUAllocator allocator;
+    RenderGraph graph(device, allocator, asyncComputeGraph());
+
+    FakeGPUImage target(nullptr, 0);
+    const auto output = graph.importImage(target, {});
+    const auto particles = graph.createBuffer(storageBuffer());
+
+    graph.addPass("simulate", markPass("simulate"))
+        .write(particles, RenderGraphAccess::ComputeShaderStorageWrite)
+        .setQueue(RenderGraphQueue::AsyncCompute);
+    graph.addPass("draw", markPass("draw"))
+        .read(particles, RenderGraphAccess::VertexShaderRead)
+        .write(output, RenderGraphAccess::ColorAttachmentWrite);
+    graph.compile();
+
+    FakeSubmission submission;
+    graph.submit(submission.getDescription());
+
+    const auto& graphicsSubmissions = submission.graphicsQueue.submissions;
+    const auto& computeSubmissions = submission.computeQueue.submissions;
+    REQUIRE(graphicsSubmissions.size() == 2);
+    REQUIRE(computeSubmissions.size() == 1);
+
+    // NOTE: Every submission signals the timeline of its queue.
+    REQUIRE(computeSubmissions[0].signalTimelineSemaphores.size() == 1);
+    const auto computeSignal = computeSubmissions[0].signalTimelineSemaphores[0];
+    REQUIRE(graphicsSubmissions[1].signalTimelineSemaphores.size() == 1);
+    const auto graphicsSignal = graphicsSubmissions[1].signalTimelineSemaphores[0];
+    CHECK(computeSignal.semaphore != graphicsSignal.semaphore);
+
+    // NOTE: Nothing overwrote the particles before the first execution, so the compute submission
+    // doesn't wait.
+    CHECK(computeSubmissions[0].waitTimelineSemaphores.empty());
+    REQUIRE(graphicsSubmissions[1].waitTimelineSemaphores.size() == 1);
+    const auto& drawWait = graphicsSubmissions[1].waitTimelineSemaphores[0];
+    CHECK(drawWait.semaphore == computeSignal.semaphore);
+    CHECK(drawWait.value == computeSignal.value);
+    CHECK(sameFlags(drawWait.waitStage, PipelineStage::VertexShader | PipelineStage::AllCommands));
+
+    // NOTE: The next execution overwrites the particles only once the previous draw read them.
+    graph.submit(submission.getDescription());
+    REQUIRE(computeSubmissions.size() == 2);
+    REQUIRE(computeSubmissions[1].waitTimelineSemaphores.size() == 1);
+    const auto& simulateWait = computeSubmissions[1].waitTimelineSemaphores[0];
+    CHECK(simulateWait.semaphore == graphicsSignal.semaphore);
+    CHECK(simulateWait.value == graphicsSignal.value);
+    CHECK(sameFlags(simulateWait.waitStage, PipelineStage::ComputeShader));
+}
+
+TEST_CASE("RenderGraph transfers exclusive resources between the queue families") {
+    FakeGPUDevice device;
+    FakeGPUAllocator allocator;
+    RenderGraph graph(device, allocator, asyncComputeGraph());
+
+    FakeGPUBuffer indirectBuffer(nullptr, 0, 1024);
+    const auto commands = graph.importBuffer(indirectBuffer, {});
+
+    graph.addPass("cull", markPass("cull"))
+        .write(commands, RenderGraphAccess::ComputeShaderStorageWrite)
+        .setQueue(RenderGraphQueue::AsyncCompute);
+    graph.addPass("draw", markPass("draw"))
+        .read(commands, RenderGraphAccess::IndirectBuffer)
+        .setSideEffects();
+    graph.compile();
+
+    FakeSubmission submission;
+    graph.submit(submission.getDescription());
+
+    const auto& graphicsSubmissions = submission.graphicsQueue.submissions;
+    const auto& computeSubmissions = submission.computeQueue.submissions;
+    REQUIRE(graphicsSubmissions.size() == 2);
+    REQUIRE(computeSubmissions.size() == 1);
+
+    // NOTE: Each transfer is a release on the old family and an acquire on the new one.
+    const auto& release = getCommandBuffer(graphicsSubmissions[0]).commands;
+    REQUIRE(release.size() == 1);
+    REQUIRE(release[0].barrier.bufferBarriers.size() == 1);
+    const auto& releaseToCompute = release[0].barrier.bufferBarriers[0];
+    CHECK(releaseToCompute.buffer == &indirectBuffer);
+    CHECK(releaseToCompute.srcQueueFamilyIndex == GRAPHICS_FAMILY);
+    CHECK(releaseToCompute.dstQueueFamilyIndex == COMPUTE_FAMILY);
+
+    const auto& compute = getCommandBuffer(computeSubmissions[0]).commands;
+    REQUIRE(compute.size() == 3);
+    REQUIRE(compute[0].barrier.bufferBarriers.size() == 1);
+    const auto& acquireOnCompute = compute[0].barrier.bufferBarriers[0];
+    CHECK(acquireOnCompute.buffer == &indirectBuffer);
+    CHECK(acquireOnCompute.srcQueueFamilyIndex == GRAPHICS_FAMILY);
+    CHECK(acquireOnCompute.dstQueueFamilyIndex == COMPUTE_FAMILY);
+    CHECK(sameFlags(acquireOnCompute.dstStageFlags, PipelineStage::ComputeShader));
+    CHECK(sameFlags(acquireOnCompute.dstAccessFlags, AccessType::ShaderWrite));
+    CHECK(compute[1].pass == "cull");
+
+    REQUIRE(compute[2].barrier.bufferBarriers.size() == 1);
+    const auto& releaseToGraphics = compute[2].barrier.bufferBarriers[0];
+    CHECK(releaseToGraphics.buffer == &indirectBuffer);
+    CHECK(releaseToGraphics.srcQueueFamilyIndex == COMPUTE_FAMILY);
+    CHECK(releaseToGraphics.dstQueueFamilyIndex == GRAPHICS_FAMILY);
+    CHECK(sameFlags(releaseToGraphics.srcStageFlags, PipelineStage::ComputeShader));
+    CHECK(sameFlags(releaseToGraphics.srcAccessFlags, AccessType::ShaderWrite));
+
+    const auto& graphics = getCommandBuffer(graphicsSubmissions[1]).commands;
+    REQUIRE(graphics.size() == 2);
+    REQUIRE(graphics[0].barrier.bufferBarriers.size() == 1);
+    const auto& acquireOnGraphics = graphics[0].barrier.bufferBarriers[0];
+    CHECK(acquireOnGraphics.buffer == &indirectBuffer);
+    CHECK(acquireOnGraphics.srcQueueFamilyIndex == COMPUTE_FAMILY);
+    CHECK(acquireOnGraphics.dstQueueFamilyIndex == GRAPHICS_FAMILY);
+    CHECK(sameFlags(acquireOnGraphics.dstStageFlags, PipelineStage::DrawIndirect));
+    CHECK(sameFlags(acquireOnGraphics.dstAccessFlags, AccessType::IndirectCommandRead));
+    CHECK(graphics[1].pass == "draw");
+}
@@ -0,0 +1,151 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "aetherion/gpu/transient_memory_planner.hpp"
+#include "fake_gpu.hpp"
+
+using namespace aetherion;
+using namespace aetherion::test;
+
+namespace {
+    TransientBufferDescription transientBuffer(size_t size, uint32_t firstUse, uint32_t lastUse) {
+        return {.description = {.size = size,
+                                .usages = GPUBufferUsage::Storage,
+                                .sharingMode = SharingMode::Exclusive,
+                                .queueFamilies = {}},
+                .firstUse = firstUse,
+                .lastUse = lastUse};
+    }
+
+    TransientImageDescription transientImage(uint32_t width, uint32_t height, uint32_t firstUse,
+                                             uint32_t lastUse) {
+        return {.description = {.format = Format::R8G8B8A8Unorm,
+                                .extent = {.width = width, .height = height, .depth = 1},
+                                .mipLevels = 1,
+                                .arrayLayers = 1,
+                                .usages = GPUImageUsage::ColorAttachment,
+                                .sharingMode = SharingMode::Exclusive,
+                                .queueFamilies = {}},
+                .firstUse = firstUse,
+                .lastUse = lastUse};
+    }
+
+    const FakeGPUBuffer& fakeBuffer(const TransientMemoryPlan& plan, size_t index) {
+        return static_cast<const FakeGPUBuffer&>(*plan.buffers.at(index));
+    }
+
+    const FakeGPUImage& fakeImage(const TransientMemoryPlan& plan, size_t index) {
+        return static_cast<const FakeGPUImage&>(*plan.images.at(index));
+    }
+
+    bool overlapsInMemory(const FakeGPUBuffer& a, const FakeGPUBuffer& b) {
+        return a.allocation == b.allocation && a.offset < b.offset + b.size
+               && b.offset < a.offset + a.size;
+    }
+}  // namespace
+
+TEST_CASE("TransientMemoryPlanner aliases resources with disjoint lifetimes") {
+    FakeGPUDevice device;
+    FakeGPUAllocator allocator;
+    TransientMemoryPlanner planner(device, allocator, {});
+
+    const std::vector<TransientBufferDescription> buffers
+        = {transientBuffer(4096, 0, 1), transientBuffer(1024, 2, 3), transientBuffer(2048, 4, 4)};
+    const auto plan = planner.plan({}, buffers);
+
+    REQUIRE(plan.buffers.size() == 3);
+    REQUIRE(plan.allocations.size() == 1);
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        CHECK(fakeBuffer(plan, i).offset == 0);
+    }
+
+    CHECK(plan.sizeWithoutAliasing == 4096 + 1024 + 2048);
+    CHECK(plan.sizeWithAliasing == 4096);
+    CHECK(plan.peakLiveSize == 4096);
+}
+
+TEST_CASE("TransientMemoryPlanner keeps resources alive at the same time apart") {
+    FakeGPUDevice device;
+    FakeGPUAllocator allocator;
+    TransientMemoryPlanner planner(device, allocator, {});
+
+    // NOTE: Lifetimes are inclusive, the first two share use 2.
+    const std::vector<TransientBufferDescription> buffers
+        = {transientBuffer(1000, 0, 2), transientBuffer(1000, 2, 4), transientBuffer(500, 3, 5)};
+    const auto plan = planner.plan({}, buffers);
+
+    REQUIRE(plan.buffers.size() == 3);
+    CHECK_FALSE(overlapsInMemory(fakeBuffer(plan, 0), fakeBuffer(plan, 1)));
+    CHECK_FALSE(overlapsInMemory(fakeBuffer(plan, 1), fakeBuffer(plan, 2)));
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        CHECK(fakeBuffer(plan, i).offset % FakeGPUDevice::BUFFER_ALIGNMENT == 0);
+    }
+
+    // NOTE: The third buffer reuses the range of the first one, which is dead by then.
+    CHECK(fakeBuffer(plan, 2).offset == fakeBuffer(plan, 0).offset);
+    CHECK(plan.peakLiveSize == 2000);
+    CHECK(plan.sizeWithAliasing == 1024 + 1000);
+}
+
+TEST_CASE("TransientMemoryPlanner places every resource apart without aliasing") {
+    FakeGPUDevice device;
+    FakeGPUAllocator allocator;
+    TransientMemoryPlanner planner(device, allocator, {.aliasingEnabled = false});
+
+    const std::vector<TransientBufferDescription> buffers
+        = {transientBuffer(1024, 0, 0), transientBuffer(1024, 1, 1), transientBuffer(1024, 2, 2)};
+    const auto plan = planner.plan({}, buffers);
+
+    REQUIRE(plan.buffers.size() == 3);
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        for (size_t j = i + 1; j < buffers.size(); ++j) {
+            CHECK_FALSE(overlapsInMemory(fakeBuffer(plan, i), fakeBuffer(plan, j)));
+        }
+    }
+    CHECK(plan.sizeWithAliasing == plan.sizeWithoutAliasing);
+    CHECK(plan.peakLiveSize == 1024);
+}
+
+TEST_CASE("TransientMemoryPlanner never places images and buffers in the same allocation") {
+    FakeGPUDevice device;
+    FakeGPUAllocator allocator;
+    TransientMemoryPlanner planner(device, allocator, {});
+
+    const std::vector<TransientImageDescription> images = {transientImage(16, 16, 0, 0)};
+    const std::vector<TransientBufferDescription> buffers = {transientBuffer(1024, 1, 1)};
+    const auto plan = planner.plan(images, buffers);
+
+    REQUIRE(plan.images.size() == 1);
+    REQUIRE(plan.buffers.size() == 1);
+    CHECK(plan.allocations.size() == 2);
+    CHECK(fakeImage(plan, 0).allocation != fakeBuffer(plan, 0).allocation);
+    CHECK(fakeImage(plan, 0).allocation->size == 16 * 16 * 4);
+}
+
+TEST_CASE("TransientMemoryPlanner handles lifetimes ending at the last use") {
+    FakeGPUDevice device;
+    FakeGPUAllocator allocator;
+    TransientMemoryPlanner planner(device, allocator, {});
+
+    constexpr auto lastUse = std::numeric_limits<uint32_t>::max();
+    const std::vector<TransientBufferDescription> buffers
+        = {transientBuffer(1024, 0, lastUse), transientBuffer(512, lastUse, lastUse)};
+    const auto plan = planner.plan({}, buffers);
+
+    REQUIRE(plan.buffers.size() == 2);
+    CHECK_FALSE(overlapsInMemory(fakeBuffer(plan, 0), fakeBuffer(plan, 1)));
+    CHECK(plan.peakLiveSize == 1024 + 512);
+}
+
+TEST_CASE("TransientMemoryPlanner rejects inverted lifetimes") {
+    FakeGPUDevice device;
+    FakeGPUAllocator allocator;
+    TransientMemoryPlanner planner(device, allocator, {});
+
+    const std::vector<TransientBufferDescription> buffers = {transientBuffer(1024, 2, 1)};
+    CHECK_THROWS_AS(planner.plan({}, buffers), std::invalid_argument);
+}